@@ -49,13 +49,24 @@ public class Audio {
         mixer = Mixer.getMixer();
     }
 
+    /** Creates an instance using the given mixer, e.g. one with a custom {@link AudioSink}. */
+    public Audio(Mixer mixer) {
+        this.mixer = mixer;
+    }
+
     public Mixer getMixer() {
         return mixer;
     }
 
     public Track newTrack(File file) throws IOException
     {
-        Track res = new Track(file);
+        return newTrack(file, Track.DEFAULT_SAMPLE_RATE);
+    }
+
+    /** Creates a track of a raw sound with the given sample rate, resampled to the mixer's rate. */
+    public Track newTrack(File file, int sampleRate) throws IOException
+    {
+        Track res = new Track(file, sampleRate);
         mixer.add(res);
         return res;
     }
@@ -0,0 +1,65 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.audio.windows.waveout;
+
+import java.io.IOException;
+
+/**
+ * Output backend of the {@link Mixer}, consuming periods of 
+ * interleaved signed 16bit little endian PCM.
+ * <p>
+ * Implementations:
+ * <ul>
+ *   <li>{@link WaveOutSink}: Windows waveout device</li>
+ *   <li>{@link NullSink}: Discards the data, optionally in real time</li>
+ *   <li>{@link FileSink}: Writes the data into a WAV file, optionally in real time</li>
+ * </ul>
+ * </p>
+ */
+public interface AudioSink {
+    /**
+     * Opens the sink.
+     * @param sampleRate sample frames per second, e.g. 44100 or 48000
+     * @param channels number of interleaved channels
+     * @param periodFrames sample frames per period, i.e. per {@link #write(byte[], int, int)} call
+     * @param periodCount number of periods queued by the device, determining the latency
+     * @throws IOException if the sink could not be opened
+     */
+    public void open(int sampleRate, int channels, int periodFrames, int periodCount) throws IOException;
+    
+    /**
+     * Writes one period, blocking until the device is able to take it.
+     * @throws IOException if the data could not be written 
+     */
+    public void write(byte[] data, int offset, int length) throws IOException;
+    
+    /** 
+     * Releases the device. A blocked {@link #write(byte[], int, int)} returns.
+     */
+    public void close();
+}
@@ -0,0 +1,129 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.audio.windows.waveout;
+
+import java.io.BufferedOutputStream;
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.io.RandomAccessFile;
+
+/**
+ * {@link AudioSink} writing all data into a WAV file, 
+ * allowing to validate the {@link Mixer} output headless.
+ * <p>
+ * The WAV header's sizes are written at {@link #close()}.
+ * </p>
+ */
+public class FileSink extends NullSink {
+    private static final int HEADER_SIZE = 44;
+    private final File file;
+    private OutputStream out;
+    private long dataSize;
+
+    /**
+     * @param file the WAV file to be written
+     * @param realtime if true, writing is paced in real time, see {@link NullSink}
+     */
+    public FileSink(File file, boolean realtime) {
+        super(realtime);
+        this.file = file;
+    }
+
+    public File getFile() { return file; }
+
+    public synchronized void open(int sampleRate, int channels, int periodFrames, int periodCount) throws IOException {
+        super.open(sampleRate, channels, periodFrames, periodCount);
+        out = new BufferedOutputStream(new FileOutputStream(file));
+        dataSize = 0;
+        final int blockAlign = channels * 2;
+        final byte[] header = new byte[HEADER_SIZE];
+        putTag(header,  0, "RIFF");
+        putInt(header,  4, 0); // patched at close
+        putTag(header,  8, "WAVE");
+        putTag(header, 12, "fmt ");
+        putInt(header, 16, 16);
+        putShort(header, 20, 1); // PCM
+        putShort(header, 22, channels);
+        putInt(header, 24, sampleRate);
+        putInt(header, 28, sampleRate * blockAlign);
+        putShort(header, 32, blockAlign);
+        putShort(header, 34, 16);
+        putTag(header, 36, "data");
+        putInt(header, 40, 0); // patched at close
+        out.write(header);
+    }
+
+    @Override
+    protected synchronized void consume(byte[] data, int offset, int length) throws IOException {
+        if( null != out ) {
+            out.write(data, offset, length);
+            dataSize += length;
+        }
+    }
+
+    public synchronized void close() {
+        super.close();
+        if( null == out ) {
+            return;
+        }
+        try {
+            out.close();
+            final RandomAccessFile raf = new RandomAccessFile(file, "rw");
+            try {
+                final byte[] size = new byte[4];
+                putInt(size, 0, (int) ( HEADER_SIZE - 8 + dataSize ));
+                raf.seek(4);
+                raf.write(size);
+                putInt(size, 0, (int) dataSize);
+                raf.seek(40);
+                raf.write(size);
+            } finally {
+                raf.close();
+            }
+        } catch (IOException e) {
+            e.printStackTrace();
+        }
+        out = null;
+    }
+
+    private static void putTag(byte[] b, int off, String tag) {
+        for(int i=0; i<4; i++) {
+            b[off+i] = (byte) tag.charAt(i);
+        }
+    }
+    private static void putShort(byte[] b, int off, int v) {
+        b[off  ] = (byte)   v;
+        b[off+1] = (byte) ( v >> 8 );
+    }
+    private static void putInt(byte[] b, int off, int v) {
+        putShort(b, off, v);
+        putShort(b, off+2, v >> 16);
+    }
+}
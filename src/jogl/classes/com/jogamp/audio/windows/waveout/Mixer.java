@@ -33,68 +33,152 @@
 package com.jogamp.audio.windows.waveout;
 
 import java.io.*;
-import java.nio.*;
 import java.util.*;
 
-// Needed only for NIO workarounds on CVM
-import java.lang.reflect.*;
-
+import jogamp.opengl.Debug;
+
+import com.jogamp.common.os.Platform;
+
+/**
+ * Mixes all playing {@link Track}s block wise, i.e. one period at a time,
+ * into interleaved stereo signed 16 bit PCM and hands it to an {@link AudioSink}.
+ * <p>
+ * The default mixer, see {@link #getMixer()}, is configured via the properties
+ * <ul>
+ *   <li><code>jogl.audio.rate</code>: sample rate in Hz, defaults to {@link #DEFAULT_SAMPLE_RATE}</li>
+ *   <li><code>jogl.audio.period</code>: sample frames per period, defaults to {@link #DEFAULT_PERIOD_FRAMES}</li>
+ *   <li><code>jogl.audio.periods</code>: number of periods queued by the sink, defaults to {@link #DEFAULT_PERIOD_COUNT}</li>
+ *   <li><code>jogl.audio.sink</code>: <code>waveout</code>, <code>null</code> or <code>file:&lt;path&gt;</code>,
+ *       defaults to <code>waveout</code> on Windows and <code>null</code> elsewhere</li>
+ * </ul>
+ * The latency is <code>period * periods / rate</code> seconds.
+ * </p>
+ */
 public class Mixer {
-    // This class is a singleton
+    public static final int DEFAULT_SAMPLE_RATE = 44100;
+    public static final int DEFAULT_PERIOD_FRAMES = 1024;
+    public static final int DEFAULT_PERIOD_COUNT = 4;
+    // Output is interleaved stereo, signed 16 bit little endian
+    static final int CHANNELS = 2;
+
+    // The default mixer, lazily created
     private static Mixer mixer;
 
-    private volatile boolean shutdown;
-    private volatile Object shutdownLock = new Object();
-    private volatile boolean shutdownDone;
+    private final int sampleRate;
+    private final int periodFrames;
+    private final int periodCount;
+    private final AudioSink sink;
 
-    // Windows Event object
-    private long event;
+    private volatile boolean shutdown;
+    private final MixerThread mixerThread;
 
-    private volatile ArrayList/*<Track>*/ tracks = new ArrayList();
+    private volatile ArrayList<Track> tracks = new ArrayList<Track>();
 
     private Vec3f leftSpeakerPosition  = new Vec3f(-1, 0, 0);
     private Vec3f rightSpeakerPosition = new Vec3f( 1, 0, 0);
 
-    private float falloffFactor = 1.0f;
+    private volatile float falloffFactor = 1.0f;
+
+    /**
+     * Creates a mixer and opens the given sink.
+     * @param sampleRate output sample rate in Hz, e.g. 44100 or 48000
+     * @param periodFrames sample frames mixed per period
+     * @param periodCount number of periods queued by the sink
+     * @param sink the output backend
+     * @throws IOException if the sink could not be opened
+     */
+    public Mixer(int sampleRate, int periodFrames, int periodCount, AudioSink sink) throws IOException {
+        if (sampleRate <= 0 || periodFrames <= 0 || periodCount <= 0) {
+            throw new IllegalArgumentException("Invalid format: "+sampleRate+" Hz, "+periodFrames+" frames x "+periodCount+" periods");
+        }
+        if (null == sink) {
+            throw new IllegalArgumentException("Null sink");
+        }
+        this.sampleRate = sampleRate;
+        this.periodFrames = periodFrames;
+        this.periodCount = periodCount;
+        this.sink = sink;
+        sink.open(sampleRate, CHANNELS, periodFrames, periodCount);
+        new FillerThread().start();
+        mixerThread = new MixerThread();
+        mixerThread.setPriority(Thread.MAX_PRIORITY - 1);
+        mixerThread.start();
+    }
 
-    static {
-        mixer = new Mixer();
+    /** Returns the default mixer, see {@link Mixer} for its configuration. */
+    public static synchronized Mixer getMixer() {
+        if (mixer == null) {
+            mixer = createDefaultMixer();
+        }
+        return mixer;
     }
 
-    private Mixer() {
-        event = CreateEvent();
-        new FillerThread().start();
-        MixerThread m = new MixerThread();
-        m.setPriority(Thread.MAX_PRIORITY - 1);
-        m.start();
+    private static Mixer createDefaultMixer() {
+        final int rate    = Debug.getIntProperty("jogl.audio.rate", true, DEFAULT_SAMPLE_RATE);
+        final int period  = Debug.getIntProperty("jogl.audio.period", true, DEFAULT_PERIOD_FRAMES);
+        final int periods = Debug.getIntProperty("jogl.audio.periods", true, DEFAULT_PERIOD_COUNT);
+        final String sinkName = Debug.getProperty("jogl.audio.sink", true);
+        final AudioSink sink;
+        if (null == sinkName) {
+            sink = Platform.OSType.WINDOWS == Platform.OS_TYPE ? new WaveOutSink() : new NullSink(true);
+        } else if (sinkName.equals("waveout")) {
+            sink = new WaveOutSink();
+        } else if (sinkName.equals("null")) {
+            sink = new NullSink(true);
+        } else if (sinkName.startsWith("file:")) {
+            sink = new FileSink(new File(sinkName.substring(5)), true);
+        } else {
+            throw new IllegalArgumentException("Unknown audio sink: "+sinkName);
+        }
+        try {
+            return new Mixer(rate, period, periods, sink);
+        } catch (IOException e) {
+            if (sink instanceof NullSink) {
+                throw new RuntimeException(e);
+            }
+            System.err.println("Warning: Mixer: "+e.getMessage()+", using null sink");
+            try {
+                return new Mixer(rate, period, periods, new NullSink(true));
+            } catch (IOException e2) {
+                throw new RuntimeException(e2);
+            }
+        }
     }
 
-    public static Mixer getMixer() {
-        return mixer;
+    public int getSampleRate() {
+        return sampleRate;
+    }
+
+    public int getPeriodFrames() {
+        return periodFrames;
+    }
+
+    public int getPeriodCount() {
+        return periodCount;
     }
 
+    public AudioSink getSink() {
+        return sink;
+    }
+
+    @SuppressWarnings("unchecked")
     synchronized void add(Track track) {
-        ArrayList/*<Track>*/ newTracks = (ArrayList) tracks.clone();
+        ArrayList<Track> newTracks = (ArrayList<Track>) tracks.clone();
         newTracks.add(track);
         tracks = newTracks;
     }
 
+    @SuppressWarnings("unchecked")
     synchronized void remove(Track track) {
-        ArrayList/*<Track>*/ newTracks = (ArrayList) tracks.clone();
+        ArrayList<Track> newTracks = (ArrayList<Track>) tracks.clone();
         newTracks.remove(track);
         tracks = newTracks;
     }
 
-    // NOTE: due to a bug on the APX device, we only have mono sounds,
-    // so we currently only pay attention to the position of the left
-    // speaker
     public void setLeftSpeakerPosition(float x, float y, float z) {
         leftSpeakerPosition.set(x, y, z);
     }
 
-    // NOTE: due to a bug on the APX device, we only have mono sounds,
-    // so we currently only pay attention to the position of the left
-    // speaker
     public void setRightSpeakerPosition(float x, float y, float z) {
         rightSpeakerPosition.set(x, y, z);
     }
@@ -113,12 +197,12 @@ public class Mixer {
         falloffFactor = factor;
     }
 
+    /** Stops mixing after the current period and closes the sink. */
     public void shutdown() {
-        synchronized(shutdownLock) {
-            shutdown = true;
-            SetEvent(event);
+        shutdown = true;
+        if (Thread.currentThread() != mixerThread) {
             try {
-                shutdownLock.wait();
+                mixerThread.join();
             } catch (InterruptedException e) {
             }
         }
@@ -126,15 +210,16 @@ public class Mixer {
 
     class FillerThread extends Thread {
         FillerThread() {
-            super("Mixer Thread");
+            super("Mixer Filler Thread");
+            setDaemon(true);
         }
 
         public void run() {
             while (!shutdown) {
-                List/*<Track>*/ curTracks = tracks;
+                List<Track> curTracks = tracks;
 
-                for (Iterator iter = curTracks.iterator(); iter.hasNext(); ) {
-                    Track track = (Track) iter.next();
+                for (int t = 0; t < curTracks.size(); t++) {
+                    Track track = curTracks.get(t);
                     try {
                         track.fill();
                     } catch (IOException e) {
@@ -154,121 +239,102 @@ public class Mixer {
     }
 
     class MixerThread extends Thread {
-        // Temporary mixing buffer
+        // Mixing buffer of one period
         // Interleaved left and right channels
-        float[] mixingBuffer;
-        private Vec3f temp = new Vec3f();
+        private final float[] mixingBuffer = new float[periodFrames * CHANNELS];
+        // Samples of one track for one period
+        private final float[] trackBuffer = new float[periodFrames];
+        // Output period, signed 16 bit little endian
+        private final byte[] outputBuffer = new byte[periodFrames * CHANNELS * 2];
 
         MixerThread() {
             super("Mixer Thread");
-            if (!initializeWaveOut(event)) {
-                throw new InternalError("Error initializing waveout device");
-            }
+            setDaemon(true);
         }
 
         public void run() {
-            while (!shutdown) {
-                // Get the next buffer
-                long mixerBuffer = getNextMixerBuffer();
-                if (mixerBuffer != 0) {
-                    ByteBuffer buf = getMixerBufferData(mixerBuffer);
-
-                    if (buf == null) {
-                        // This is happening on CVM because
-                        // JNI_NewDirectByteBuffer isn't implemented
-                        // by default and isn't compatible with the
-                        // JSR-239 NIO implementation (apparently)
-                        buf = newDirectByteBuffer(getMixerBufferDataAddress(mixerBuffer),
-                                                  getMixerBufferDataCapacity(mixerBuffer));
-                    }
-
-                    if (buf == null) {
-                        throw new InternalError("Couldn't wrap the native address with a direct byte buffer");
-                    }
-
-                    // System.out.println("Mixing buffer");
-
-                    // If we don't have enough samples in our mixing buffer, expand it
-                    // FIXME: knowledge of native output rendering format
-                    if ((mixingBuffer == null) || (mixingBuffer.length < (buf.capacity() / 2 /* bytes / sample */))) {
-                        mixingBuffer = new float[buf.capacity() / 2];
-                    } else {
-                        // Zap it
-                        for (int i = 0; i < mixingBuffer.length; i++) {
-                            mixingBuffer[i] = 0.0f;
-                        }
-                    }
-
-                    // This assertion should be in place if we have stereo
-                    if ((mixingBuffer.length % 2) != 0) {
-                        String msg = "FATAL ERROR: odd number of samples in the mixing buffer";
-                        System.out.println(msg);
-                        throw new InternalError(msg);
-                    }
-
-                    // Run down all of the registered tracks mixing them in
-                    List/*<Track>*/ curTracks = tracks;
-
-                    for (Iterator iter = curTracks.iterator(); iter.hasNext(); ) {
-                        Track track = (Track) iter.next();
-                        // Consider only playing tracks
-                        if (track.isPlaying()) {
-                            // First recompute its gain
-                            Vec3f pos = track.getPosition();
-                            float leftGain  = gain(pos, leftSpeakerPosition);
-                            float rightGain = gain(pos, rightSpeakerPosition);
-                            // Now mix it in
-                            int i = 0;
-                            while (i < mixingBuffer.length) {
-                                if (track.hasNextSample()) {
-                                    float sample = track.nextSample();
-                                    mixingBuffer[i++] = sample * leftGain;
-                                    mixingBuffer[i++] = sample * rightGain;
-                                } else {
-                                    // This allows tracks to stall without being abruptly cancelled
-                                    if (track.done()) {
-                                        remove(track);
-                                    }
-                                    break;
-                                }
-                            }
-                        }
-                    }
-
-                    // Now that we have our data, send it down to the card
-                    int outPos = 0;
-                    for (int i = 0; i < mixingBuffer.length; i++) {
-                        short val = (short) mixingBuffer[i];
-                        buf.put(outPos++, (byte)  val);
-                        buf.put(outPos++, (byte) (val >> 8));
-                    }
-                    if (!prepareMixerBuffer(mixerBuffer)) {
-                        throw new RuntimeException("Error preparing mixer buffer");
-                    }
-                    if (!writeMixerBuffer(mixerBuffer)) {
-                        throw new RuntimeException("Error writing mixer buffer to device");
-                    }
-                } else {
-                    // System.out.println("No mixer buffer available");
+            try {
+                while (!shutdown) {
+                    mix();
+                    sink.write(outputBuffer, 0, outputBuffer.length);
+                }
+            } catch (IOException e) {
+                e.printStackTrace();
+                shutdown = true;
+            } finally {
+                sink.close();
+            }
+        }
 
-                    // Wait for a buffer to become available
-                    if (!WaitForSingleObject(event)) {
-                        throw new RuntimeException("Error while waiting for event object");
+        private void mix() {
+            Arrays.fill(mixingBuffer, 0.0f);
+
+            // Run down all of the registered tracks mixing them in
+            List<Track> curTracks = tracks;
+            for (int t = 0; t < curTracks.size(); t++) {
+                Track track = curTracks.get(t);
+                // Consider only playing tracks
+                if (track.isPlaying()) {
+                    final int n = track.readSamples(trackBuffer, periodFrames, sampleRate);
+                    if (n > 0) {
+                        mixTrack(track, n);
                     }
-
-                    /*
-                    try {
-                        Thread.sleep(10);
-                    } catch (InterruptedException e) {
+                    // This allows tracks to stall without being abruptly cancelled
+                    if (n < periodFrames && track.done()) {
+                        remove(track);
                     }
-                    */
                 }
             }
 
-            // Need to shut down
-            shutdownWaveOut();
-            synchronized(shutdownLock) {
-                shutdownLock.notifyAll();
+            // Clip and convert to signed 16 bit little endian
+            final float[] mix = mixingBuffer;
+            final byte[] out = outputBuffer;
+            for (int i = 0, o = 0; i < mix.length; i++) {
+                final float v = mix[i];
+                final int s = v >= 32767.0f ? 32767 : ( v <= -32768.0f ? -32768 : (int) v );
+                out[o++] = (byte)  s;
+                out[o++] = (byte) (s >> 8);
+            }
+        }
+
+        private void mixTrack(Track track, int n) {
+            // First recompute its gain
+            final Vec3f pos = track.getPosition();
+            final float leftGain  = gain(pos, leftSpeakerPosition);
+            final float rightGain = gain(pos, rightSpeakerPosition);
+            // Ramp from the gains of the last period to avoid clicks while moving
+            final float leftGain0, rightGain0;
+            if (track.getGainsValid()) {
+                leftGain0  = track.getLeftGain();
+                rightGain0 = track.getRightGain();
+            } else {
+                leftGain0  = leftGain;
+                rightGain0 = rightGain;
+            }
+            track.setLeftGain(leftGain);
+            track.setRightGain(rightGain);
+            track.setGainsValid(true);
+
+            // Now mix it in
+            final float[] src = trackBuffer;
+            final float[] mix = mixingBuffer;
+            if (leftGain0 == leftGain && rightGain0 == rightGain) {
+                for (int i = 0, o = 0; i < n; i++) {
+                    final float sample = src[i];
+                    mix[o++] += sample * leftGain;
+                    mix[o++] += sample * rightGain;
+                }
+            } else {
+                final float leftStep  = (leftGain  - leftGain0)  / n;
+                final float rightStep = (rightGain - rightGain0) / n;
+                float lg = leftGain0, rg = rightGain0;
+                for (int i = 0, o = 0; i < n; i++) {
+                    final float sample = src[i];
+                    lg += leftStep;
+                    rg += rightStep;
+                    mix[o++] += sample * lg;
+                    mix[o++] += sample * rg;
+                }
             }
         }
 
@@ -278,85 +344,11 @@ public class Mixer {
         // -------------------
         // falloffFactor + r^2
         private float gain(Vec3f pos, Vec3f speakerPos) {
-            temp.sub(pos, speakerPos);
-            float dotp = temp.dot(temp);
-            return (falloffFactor / (falloffFactor + dotp));
-        }
-    }
-
-    // Initializes waveout device
-    private static native boolean initializeWaveOut(long eventObject);
-    // Shuts down waveout device
-    private static native void shutdownWaveOut();
-
-    // Gets the next (opaque) buffer of data to fill from the native
-    // code, or 0 if none was available yet (it should not happen that
-    // none is available the way the code is written).
-    private static native long getNextMixerBuffer();
-    // Gets the next ByteBuffer to fill out of the mixer buffer. It
-    // requires interleaved left and right channel samples, 16 signed
-    // bits per sample, little endian. Implicit 44.1 kHz sample rate.
-    private static native ByteBuffer getMixerBufferData(long mixerBuffer);
-    // We need these to work around the lack of
-    // JNI_NewDirectByteBuffer in CVM + the JSR 239 NIO classes
-    private static native long getMixerBufferDataAddress(long mixerBuffer);
-    private static native int  getMixerBufferDataCapacity(long mixerBuffer);
-    // Prepares this mixer buffer for writing to the device.
-    private static native boolean prepareMixerBuffer(long mixerBuffer);
-    // Writes this mixer buffer to the device.
-    private static native boolean writeMixerBuffer(long mixerBuffer);
-
-    // Helpers to prevent mixer thread from busy waiting
-    private static native long CreateEvent();
-    private static native boolean WaitForSingleObject(long event);
-    private static native void SetEvent(long event);
-    private static native void CloseHandle(long handle);
-
-    // We need a reflective hack to wrap a direct ByteBuffer around
-    // the native memory because JNI_NewDirectByteBuffer doesn't work
-    // in CVM + JSR-239 NIO
-    private static Class directByteBufferClass;
-    private static Constructor directByteBufferConstructor;
-    private static Map createdBuffers = new HashMap(); // Map Long, ByteBuffer
-
-    private static ByteBuffer newDirectByteBuffer(long address, long capacity) {
-        Long key = new Long(address);
-        ByteBuffer buf = (ByteBuffer) createdBuffers.get(key);
-        if (buf == null) {
-            buf = newDirectByteBufferImpl(address, capacity);
-            if (buf != null) {
-                createdBuffers.put(key, buf);
-            }
-        }
-        return buf;
-    }
-    private static ByteBuffer newDirectByteBufferImpl(long address, long capacity) {
-        if (directByteBufferClass == null) {
-            try {
-                directByteBufferClass = Class.forName("java.nio.DirectByteBuffer");
-                byte[] tmp = new byte[0];
-                directByteBufferConstructor =
-                    directByteBufferClass.getDeclaredConstructor(new Class[] { Integer.TYPE,
-                                                                               tmp.getClass(),
-                                                                               Integer.TYPE });
-                directByteBufferConstructor.setAccessible(true);
-            } catch (Exception e) {
-                e.printStackTrace();
-            }
-        }
-        
-        if (directByteBufferConstructor != null) {
-            try {
-                return (ByteBuffer)
-                    directByteBufferConstructor.newInstance(new Object[] {
-                            new Integer((int) capacity),
-                            null,
-                            new Integer((int) address)
-                        });
-            } catch (Exception e) {
-                e.printStackTrace();
-            }
+            final float dx = pos.x() - speakerPos.x();
+            final float dy = pos.y() - speakerPos.y();
+            final float dz = pos.z() - speakerPos.z();
+            final float falloff = falloffFactor;
+            return (falloff / (falloff + dx * dx + dy * dy + dz * dz));
         }
-        return null;
     }
 }
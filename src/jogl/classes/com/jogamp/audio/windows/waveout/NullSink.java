@@ -0,0 +1,83 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.audio.windows.waveout;
+
+import java.io.IOException;
+
+/**
+ * {@link AudioSink} discarding all data, allowing the {@link Mixer} to run w/o an audio device.
+ * <p>
+ * If <code>realtime</code>, each {@link #write(byte[], int, int)} blocks until the period 
+ * would have been played, hence mixing is paced like with a device.
+ * Otherwise data is consumed as fast as it is produced.
+ * </p>
+ */
+public class NullSink implements AudioSink {
+    private final boolean realtime;
+    private long periodNanos;
+    private long periodCount;
+    /** Deadline of the next period in ns, see {@link System#nanoTime()} */
+    private long deadline;
+    private volatile boolean closed;
+
+    public NullSink(boolean realtime) {
+        this.realtime = realtime;
+    }
+
+    public void open(int sampleRate, int channels, int periodFrames, int periodCount) throws IOException {
+        this.periodNanos = ( periodFrames * 1000000000L ) / sampleRate;
+        this.periodCount = periodCount;
+        this.deadline = 0;
+        this.closed = false;
+    }
+
+    public void write(byte[] data, int offset, int length) throws IOException {
+        consume(data, offset, length);
+        if( realtime && !closed ) {
+            final long now = System.nanoTime();
+            if( 0 == deadline || now - deadline > periodCount * periodNanos ) {
+                // (re)start, allowing to queue periodCount periods ahead like a device
+                deadline = now - ( periodCount - 1 ) * periodNanos;
+            }
+            deadline += periodNanos;
+            final long sleep = ( deadline - now ) / 1000000L;
+            if( 0 < sleep ) {
+                try {
+                    Thread.sleep(sleep);
+                } catch (InterruptedException e) { }
+            }
+        }
+    }
+
+    /** Consumes the data of one period, does nothing in this implementation. */
+    protected void consume(byte[] data, int offset, int length) throws IOException { }
+
+    public void close() {
+        closed = true;
+    }
+}
@@ -121,4 +121,32 @@ class SoundBuffer {
 
         return (float) res;
     }
+
+    // Bulk variant of getSample for the block based mixer,
+    // converting len samples starting at sample into dst.
+    // Returns the number of converted samples.
+    int getSamples(int sample, float[] dst, int dstOff, int len) {
+        len = Math.min(len, numSamples - sample);
+        if (len <= 0) {
+            return 0;
+        }
+        if (bytesPerSample == 2) {
+            // Tight loops for the common 16 bit case
+            int b = sample * 2;
+            if (needsByteSwap) {
+                for (int i = 0; i < len; i++, b += 2) {
+                    dst[dstOff + i] = (short) ((data[b + 1] << 8) | (data[b] & 0xff));
+                }
+            } else {
+                for (int i = 0; i < len; i++, b += 2) {
+                    dst[dstOff + i] = (short) ((data[b] << 8) | (data[b + 1] & 0xff));
+                }
+            }
+        } else {
+            for (int i = 0; i < len; i++) {
+                dst[dstOff + i] = getSample(sample + i);
+            }
+        }
+        return len;
+    }
 }
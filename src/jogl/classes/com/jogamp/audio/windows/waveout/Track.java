@@ -38,6 +38,8 @@ import java.nio.*;
 public class Track {
     // Default number of samples per buffer
     private static final int BUFFER_SIZE = 32768;
+    // Default sample rate of raw sounds
+    public static final int DEFAULT_SAMPLE_RATE = 11025;
     // Number of bytes per sample (FIXME: dependence on audio format)
     static final int BYTES_PER_SAMPLE = 2;
     // Whether we need byte swapping (FIXME: dependence on audio format)
@@ -63,13 +65,23 @@ public class Track {
     private boolean looping;
     // The position of this sound; defaults to being at the origin
     private volatile Vec3f position = new Vec3f();
+    // The sample rate of this sound, resampled to the mixer's rate
+    private final int sampleRate;
 
     Track(File file) throws IOException {
+        this(file, DEFAULT_SAMPLE_RATE);
+    }
+
+    Track(File file, int sampleRate) throws IOException {
         if (!file.getName().endsWith(".rawsound")) {
             throw new IOException("Unsupported file format (currently supports only raw sounds)");
         }
+        if (sampleRate <= 0) {
+            throw new IllegalArgumentException("Invalid sample rate "+sampleRate);
+        }
 
         this.file = file;
+        this.sampleRate = sampleRate;
         openInput();
 
         // Allocate the buffers
@@ -90,6 +102,10 @@ public class Track {
         return file;
     }
 
+    public int getSampleRate() {
+        return sampleRate;
+    }
+
     public synchronized void play() {
         if (input == null) {
             try {
@@ -148,9 +164,18 @@ public class Track {
         }
     }
 
-    // These are only for use by the Mixer
+    // These are only for use by the Mixer, i.e. the gains applied to the last mixed block
     private float leftGain;
     private float rightGain;
+    private boolean gainsValid;
+    
+    void setGainsValid(boolean valid) {
+        gainsValid = valid;
+    }
+
+    boolean getGainsValid() {
+        return gainsValid;
+    }
     
     void setLeftGain(float leftGain) {
         this.leftGain = leftGain;
@@ -192,6 +217,73 @@ public class Track {
         return res;
     }
 
+    // Resampling state, only used by the Mixer:
+    // srcBlock[0..srcAvail) holds source samples not yet consumed,
+    // srcPhase is the fractional resampling position relative to srcBlock[0]
+    private float[] srcBlock = new float[0];
+    private int srcAvail;
+    private double srcPhase;
+
+    // This is called by the mixer once per block.
+    // Reads up to len samples resampled to outRate into dst,
+    // fewer if the track stalls or ends.
+    // Returns the number of samples read.
+    int readSamples(float[] dst, int len, int outRate) {
+        if (outRate == sampleRate && srcAvail == 0) {
+            // No resampling required
+            return pullSamples(dst, 0, len);
+        }
+        final double step = (double) sampleRate / (double) outRate;
+        // Source samples required to interpolate len samples
+        final int need = (int) (srcPhase + (len - 1) * step) + 2;
+        if (srcBlock.length < need) {
+            float[] tmp = new float[need];
+            System.arraycopy(srcBlock, 0, tmp, 0, srcAvail);
+            srcBlock = tmp;
+        }
+        if (srcAvail < need) {
+            srcAvail += pullSamples(srcBlock, srcAvail, need - srcAvail);
+        }
+        // Linear interpolation
+        final float[] src = srcBlock;
+        final int avail = srcAvail;
+        double p = srcPhase;
+        int n = 0;
+        for (; n < len; n++) {
+            final int i = (int) p;
+            if (i + 1 >= avail) {
+                break;
+            }
+            final float s0 = src[i];
+            dst[n] = s0 + (src[i + 1] - s0) * (float) (p - i);
+            p += step;
+        }
+        final int consumed = Math.min((int) p, avail);
+        srcPhase = p - consumed;
+        srcAvail = avail - consumed;
+        System.arraycopy(src, consumed, src, 0, srcAvail);
+        return n;
+    }
+
+    // Bulk variant of nextSample
+    private int pullSamples(float[] dst, int off, int len) {
+        int n = 0;
+        while (n < len && hasNextSample()) {
+            final int m = activeBuffer.getSamples(samplePosition, dst, off + n, len - n);
+            samplePosition += m;
+            samplesRead += m;
+            n += m;
+            if (!hasNextSample()) {
+                swapBuffers();
+                samplePosition = 0;
+                if (done()) {
+                    playing = false;
+                }
+            }
+        }
+        return n;
+    }
+
     synchronized void swapBuffers() {
         SoundBuffer tmp = activeBuffer;
         activeBuffer = fillingBuffer;
@@ -0,0 +1,187 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.audio.windows.waveout;
+
+import java.io.IOException;
+import java.lang.reflect.Constructor;
+import java.nio.ByteBuffer;
+import java.util.HashMap;
+import java.util.Map;
+
+/**
+ * {@link AudioSink} utilizing the Windows waveout device.
+ * <p>
+ * Queues <code>periodCount</code> device buffers of one period each,
+ * {@link #write(byte[], int, int)} blocks until one of them has been played.
+ * </p>
+ */
+public class WaveOutSink implements AudioSink {
+    // Windows Event object
+    private long event;
+    private volatile boolean closed;
+
+    public void open(int sampleRate, int channels, int periodFrames, int periodCount) throws IOException {
+        closed = false;
+        event = CreateEvent();
+        if (!initializeWaveOut(event, sampleRate, channels, periodFrames * channels * 2, periodCount)) {
+            CloseHandle(event);
+            event = 0;
+            throw new IOException("Error initializing waveout device: "+sampleRate+" Hz, "+channels+" channels");
+        }
+    }
+
+    public void write(byte[] data, int offset, int length) throws IOException {
+        while (!closed) {
+            // Get the next buffer
+            long mixerBuffer = getNextMixerBuffer();
+            if (mixerBuffer != 0) {
+                ByteBuffer buf = getMixerBufferData(mixerBuffer);
+
+                if (buf == null) {
+                    // This is happening on CVM because
+                    // JNI_NewDirectByteBuffer isn't implemented
+                    // by default and isn't compatible with the
+                    // JSR-239 NIO implementation (apparently)
+                    buf = newDirectByteBuffer(getMixerBufferDataAddress(mixerBuffer),
+                                              getMixerBufferDataCapacity(mixerBuffer));
+                }
+
+                if (buf == null) {
+                    throw new InternalError("Couldn't wrap the native address with a direct byte buffer");
+                }
+                if (buf.capacity() != length) {
+                    throw new IOException("Period size mismatch: "+length+" bytes, device buffer "+buf.capacity()+" bytes");
+                }
+                buf.clear();
+                buf.put(data, offset, length);
+
+                if (!prepareMixerBuffer(mixerBuffer)) {
+                    throw new IOException("Error preparing mixer buffer");
+                }
+                if (!writeMixerBuffer(mixerBuffer)) {
+                    throw new IOException("Error writing mixer buffer to device");
+                }
+                return;
+            } else {
+                // Wait for a buffer to become available
+                if (!WaitForSingleObject(event)) {
+                    throw new IOException("Error while waiting for event object");
+                }
+            }
+        }
+    }
+
+    public void close() {
+        if (closed) {
+            return;
+        }
+        closed = true;
+        if (0 != event) {
+            SetEvent(event);
+            shutdownWaveOut();
+            CloseHandle(event);
+            event = 0;
+        }
+    }
+
+    // Initializes waveout device for signed 16 bit PCM,
+    // queuing bufferCount buffers of bufferSize bytes
+    private static native boolean initializeWaveOut(long eventObject, int sampleRate, int channels, int bufferSize, int bufferCount);
+    // Shuts down waveout device
+    private static native void shutdownWaveOut();
+
+    // Gets the next (opaque) buffer of data to fill from the native
+    // code, or 0 if none is available, i.e. all buffers are queued.
+    private static native long getNextMixerBuffer();
+    // Gets the next ByteBuffer to fill out of the mixer buffer. It
+    // requires interleaved left and right channel samples, 16 signed
+    // bits per sample, little endian.
+    private static native ByteBuffer getMixerBufferData(long mixerBuffer);
+    // We need these to work around the lack of
+    // JNI_NewDirectByteBuffer in CVM + the JSR 239 NIO classes
+    private static native long getMixerBufferDataAddress(long mixerBuffer);
+    private static native int  getMixerBufferDataCapacity(long mixerBuffer);
+    // Prepares this mixer buffer for writing to the device.
+    private static native boolean prepareMixerBuffer(long mixerBuffer);
+    // Writes this mixer buffer to the device.
+    private static native boolean writeMixerBuffer(long mixerBuffer);
+
+    // Helpers to prevent mixer thread from busy waiting
+    private static native long CreateEvent();
+    private static native boolean WaitForSingleObject(long event);
+    private static native void SetEvent(long event);
+    private static native void CloseHandle(long handle);
+
+    // We need a reflective hack to wrap a direct ByteBuffer around
+    // the native memory because JNI_NewDirectByteBuffer doesn't work
+    // in CVM + JSR-239 NIO
+    private static Class<?> directByteBufferClass;
+    private static Constructor<?> directByteBufferConstructor;
+    private static Map<Long, ByteBuffer> createdBuffers = new HashMap<Long, ByteBuffer>();
+
+    private static ByteBuffer newDirectByteBuffer(long address, long capacity) {
+        Long key = new Long(address);
+        ByteBuffer buf = createdBuffers.get(key);
+        if (buf == null) {
+            buf = newDirectByteBufferImpl(address, capacity);
+            if (buf != null) {
+                createdBuffers.put(key, buf);
+            }
+        }
+        return buf;
+    }
+    private static ByteBuffer newDirectByteBufferImpl(long address, long capacity) {
+        if (directByteBufferClass == null) {
+            try {
+                directByteBufferClass = Class.forName("java.nio.DirectByteBuffer");
+                byte[] tmp = new byte[0];
+                directByteBufferConstructor =
+                    directByteBufferClass.getDeclaredConstructor(new Class[] { Integer.TYPE,
+                                                                               tmp.getClass(),
+                                                                               Integer.TYPE });
+                directByteBufferConstructor.setAccessible(true);
+            } catch (Exception e) {
+                e.printStackTrace();
+            }
+        }
+        
+        if (directByteBufferConstructor != null) {
+            try {
+                return (ByteBuffer)
+                    directByteBufferConstructor.newInstance(new Object[] {
+                            new Integer((int) capacity),
+                            null,
+                            new Integer((int) address)
+                        });
+            } catch (Exception e) {
+                e.printStackTrace();
+            }
+        }
+        return null;
+    }
+}
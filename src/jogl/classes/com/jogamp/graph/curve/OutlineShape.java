@@ -525,13 +525,23 @@ public class OutlineShape implements Comparable<OutlineShape> {
      * which is produced by the combination of the outlines
      */
     public ArrayList<Triangle> triangulate() {
+        return triangulate(Triangulation.create());
+    }
+
+    /**
+     * Triangulate the {@link OutlineShape} generating a list of triangles
+     * using the given triangulator, which is reset afterwards.
+     * @param triangulator2d the triangulator to use, see {@link Triangulation#create(int)}
+     * @return an arraylist of triangles representing the filled region
+     * which is produced by the combination of the outlines
+     */
+    public ArrayList<Triangle> triangulate(Triangulator triangulator2d) {
         if(outlines.size() == 0){
             return null;
         }
         sortOutlines();
         generateVertexIds();
 
-        Triangulator triangulator2d = Triangulation.create();
         for(int index = 0; index<outlines.size(); index++) {
             triangulator2d.addCurve(outlines.get(index));
         }
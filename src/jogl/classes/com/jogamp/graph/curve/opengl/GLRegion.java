@@ -29,12 +29,14 @@ package com.jogamp.graph.curve.opengl;
 
 
 import java.util.ArrayList;
+import java.util.Arrays;
 
 import javax.media.opengl.GL2ES2;
 import com.jogamp.opengl.util.PMVMatrix;
 
 import com.jogamp.graph.curve.OutlineShape;
 import com.jogamp.graph.curve.Region;
+import com.jogamp.graph.curve.tess.Triangulation;
 import com.jogamp.graph.geom.Triangle;
 import com.jogamp.graph.geom.Vertex;
 import jogamp.graph.curve.opengl.RegionFactory;
@@ -53,6 +55,8 @@ public abstract class GLRegion extends Region {
     
     /** Create an ogl {@link GLRegion} defining the list of {@link OutlineShape}.
      * Combining the Shapes into single buffers.
+     * <p>The shapes are triangulated in parallel, see {@link Triangulation#triangulate(java.util.List)},
+     * the vertices are numbered in shape order.</p>
      * @return the resulting Region inclusive the generated region
      */
     public static GLRegion create(OutlineShape[] outlineShapes, int renderModes) {
@@ -60,11 +64,11 @@ public abstract class GLRegion extends Region {
         
         int numVertices = region.getNumVertices();
         
+        final ArrayList<ArrayList<Triangle>> shapeTriangles = Triangulation.triangulate(Arrays.asList(outlineShapes));
         for(int index=0; index<outlineShapes.length; index++) {
             OutlineShape outlineShape = outlineShapes[index];
-            outlineShape.transformOutlines(OutlineShape.VerticesState.QUADRATIC_NURBS);
     
-            ArrayList<Triangle> triangles = outlineShape.triangulate();
+            ArrayList<Triangle> triangles = shapeTriangles.get(index);
             region.addTriangles(triangles);
             
             ArrayList<Vertex> vertices = outlineShape.getVertices();
@@ -27,12 +27,12 @@
  */
 package com.jogamp.graph.curve.opengl;
 
-import java.util.ArrayList;
-import java.util.HashMap;
 import java.util.Iterator;
+import java.util.LinkedHashMap;
 
 import javax.media.opengl.GL2ES2;
 
+import jogamp.graph.curve.text.GlyphMeshCache;
 import jogamp.graph.curve.text.GlyphString;
 
 import com.jogamp.graph.font.Font;
@@ -49,6 +49,7 @@ public abstract class TextRenderer extends Renderer {
     
     protected TextRenderer(RenderState rs, int type) {
         super(rs, type);
+        glyphMeshCache = new GlyphMeshCache(rs.getVertexFactory());
     }
     
 
@@ -68,6 +69,8 @@ public abstract class TextRenderer extends Renderer {
 
     /**Create the resulting {@link GlyphString} that represents
      * the String wrt to the font.
+     * <p>The string is assembled from the triangulated glyphs cached by this renderer,
+     * i.e. only glyphs not used before are triangulated.</p>
      * @param font {@link Font} to be used
      * @param size font size
      * @param str {@link String} to be created
@@ -77,7 +80,7 @@ public abstract class TextRenderer extends Renderer {
         if(DEBUG_INSTANCE) {
             System.err.println("createString: "+getCacheSize()+"/"+getCacheLimit()+" - "+Font.NAME_UNIQUNAME + " - " + str + " - " + size);
         }
-        final GlyphString glyphString = GlyphString.createString(null, rs.getVertexFactory(), font, size, str);        
+        final GlyphString glyphString = GlyphString.createString(glyphMeshCache, font, size, str);        
         glyphString.createRegion(gl, renderModes);        
         return glyphString;
     }
@@ -90,7 +93,6 @@ public abstract class TextRenderer extends Renderer {
            glyphString.destroy(gl, rs);
        }
        stringCacheMap.clear();    
-       stringCacheArray.clear();
    } */
    
    @Override
@@ -102,7 +104,7 @@ public abstract class TextRenderer extends Renderer {
            glyphString.destroy(gl, rs);
        }
        stringCacheMap.clear();    
-       stringCacheArray.clear();
+       glyphMeshCache.clear();
    }
    
    /**
@@ -135,11 +137,17 @@ public abstract class TextRenderer extends Renderer {
    /** 
     * @return the current utilized cache size, <= {@link #getCacheLimit()}
     */
-   public final int getCacheSize() { return stringCacheArray.size(); }
+   public final int getCacheSize() { return stringCacheMap.size(); }
+   
+   /** 
+    * @return the number of triangulated glyphs cached for all fonts, 
+    *         which are shared by all created {@link GlyphString}s.
+    */
+   public final int getGlyphCacheSize() { return glyphMeshCache.getSize(); }
    
    protected final void validateCache(GL2ES2 gl, int space) {
        if ( getCacheLimit() > 0 ) {
-           while ( getCacheSize() + space > getCacheLimit() ) {
+           while ( getCacheSize() > 0 && getCacheSize() + space > getCacheLimit() ) {
                removeCachedGlyphString(gl, 0);
            }
        }
@@ -152,12 +160,11 @@ public abstract class TextRenderer extends Renderer {
    protected final void addCachedGlyphString(GL2ES2 gl, Font font, String str, int fontSize, GlyphString glyphString) {
        if ( 0 != getCacheLimit() ) {
            final String key = getKey(font, str, fontSize);
-           GlyphString oldGlyphString = stringCacheMap.put(key, glyphString);
-           if ( null == oldGlyphString ) {
+           if ( !stringCacheMap.containsKey(key) ) {
                // new entry ..
                validateCache(gl, 1);
-               stringCacheArray.add(stringCacheArray.size(), key);
            } /// else overwrite is nop ..
+           stringCacheMap.put(key, glyphString);
        }
    }
    
@@ -167,12 +174,20 @@ public abstract class TextRenderer extends Renderer {
        if(null != glyphString) {
            glyphString.destroy(gl, rs);
        }       
-       stringCacheArray.remove(key);
    }
 
+   /**
+    * Removes the <code>idx</code>-th cached GlyphString, 
+    * counting from the least recently used one. 
+    */
    protected final void removeCachedGlyphString(GL2ES2 gl, int idx) {
-       final String key = stringCacheArray.remove(idx);
-       final GlyphString glyphString = stringCacheMap.remove(key);
+       final Iterator<String> iterator = stringCacheMap.keySet().iterator();
+       for(int i=0; i<idx; i++) {
+           iterator.next();
+       }
+       final String key = iterator.next();
+       final GlyphString glyphString = stringCacheMap.get(key);
+       iterator.remove();
        if(null != glyphString) {
            glyphString.destroy(gl, rs);
        }
@@ -181,13 +196,14 @@ public abstract class TextRenderer extends Renderer {
    protected final String getKey(Font font, String str, int fontSize) {
        final StringBuilder sb = new StringBuilder();
        return font.getName(sb, Font.NAME_UNIQUNAME)
-              .append(".").append(str.hashCode()).append(".").append(fontSize).toString();
+              .append(".").append(fontSize).append(".").append(str).toString();
    }
 
    /** Default cache limit, see {@link #setCacheLimit(int)} */
    public static final int DEFAULT_CACHE_LIMIT = 256;
    
-   private HashMap<String, GlyphString> stringCacheMap = new HashMap<String, GlyphString>(DEFAULT_CACHE_LIMIT);
-   private ArrayList<String> stringCacheArray = new ArrayList<String>(DEFAULT_CACHE_LIMIT);
+   /** GlyphString cache in access order, i.e. the first entry is the least recently used one */
+   private LinkedHashMap<String, GlyphString> stringCacheMap = new LinkedHashMap<String, GlyphString>(DEFAULT_CACHE_LIMIT, 0.75f, true);
    private int stringCacheLimit = DEFAULT_CACHE_LIMIT;      
+   private final GlyphMeshCache glyphMeshCache;
 }
\ No newline at end of file
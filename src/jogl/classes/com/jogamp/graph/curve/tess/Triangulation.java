@@ -28,17 +28,84 @@
 
 package com.jogamp.graph.curve.tess;
 
+import java.util.ArrayList;
+import java.util.List;
+
 import jogamp.graph.curve.tess.CDTriangulator2D;
+import jogamp.graph.curve.tess.MonotoneTriangulator2D;
+import jogamp.graph.curve.tess.ParallelTriangulator;
+import jogamp.opengl.Debug;
+
+import com.jogamp.graph.curve.OutlineShape;
+import com.jogamp.graph.geom.Triangle;
 
 
 public class Triangulation {
-    /** Create a new instance of a triangulation.
-     *  Currently only a modified version of Constraint Delaunay 
-     *  is implemented.
+    /** Modified Constraint Delaunay triangulation by ear clipping, quadratic or worse in the number of vertices. */
+    public static final int CDT = 0;
+    /** Sweep line decomposition into monotone polygons, O(n log n) in the number of vertices. */
+    public static final int MONOTONE = 1;
+    
+    private static volatile int defaultType = 
+            "monotone".equalsIgnoreCase(Debug.getProperty("jogl.graph.triangulator", true)) ? MONOTONE : CDT;
+    
+    /** Create a new instance of the default triangulation.
+     * <p>
+     * The default is {@link #CDT}, 
+     * property <code>jogl.graph.triangulator</code> set to <code>monotone</code> selects {@link #MONOTONE},
+     * see {@link #setDefaultType(int)}.
+     * </p>
      * @return instance of a triangulator
      * @see Triangulator
      */
     public static Triangulator create() {
-        return new CDTriangulator2D();
+        return create(defaultType);
+    }
+
+    /** Create a new instance of the given triangulation type.
+     * @param type either {@link #CDT} or {@link #MONOTONE}
+     * @return instance of a triangulator
+     * @throws IllegalArgumentException if <code>type</code> is unknown
+     */
+    public static Triangulator create(int type) throws IllegalArgumentException {
+        switch(type) {
+            case CDT:
+                return new CDTriangulator2D();
+            case MONOTONE:
+                return new MonotoneTriangulator2D();
+            default:
+                throw new IllegalArgumentException("Unknown triangulation type: "+type);
+        }
+    }
+    
+    /** Sets the triangulation type used by {@link #create()}, 
+     * i.e. by all subsequent {@link OutlineShape#triangulate()} calls.
+     * @param type either {@link #CDT} or {@link #MONOTONE}
+     * @throws IllegalArgumentException if <code>type</code> is unknown
+     */
+    public static void setDefaultType(int type) throws IllegalArgumentException {
+        if( CDT != type && MONOTONE != type ) {
+            throw new IllegalArgumentException("Unknown triangulation type: "+type);
+        }
+        defaultType = type;
+    }
+    
+    /** @return the triangulation type used by {@link #create()} */
+    public static int getDefaultType() {
+        return defaultType;
+    }
+
+    /** Triangulates a batch of independent shapes in parallel.
+     * <p>
+     * Each shape is transformed to {@link OutlineShape.VerticesState#QUADRATIC_NURBS} 
+     * and triangulated via {@link OutlineShape#triangulate()}. 
+     * The result equals the serial triangulation in shape order, 
+     * property <code>jogl.graph.triangulation.threads</code> sets the number of threads.
+     * </p>
+     * @param shapes the shapes, not sharing any outline or vertex
+     * @return the triangles of each shape, in the order of <code>shapes</code>
+     */
+    public static ArrayList<ArrayList<Triangle>> triangulate(List<OutlineShape> shapes) {
+        return ParallelTriangulator.triangulate(shapes);
     }
 }
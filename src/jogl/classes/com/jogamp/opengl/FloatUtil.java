@@ -163,7 +163,86 @@ public class FloatUtil {
         d.put(dP+i+3*4 , ai0 * b.get(bP+0+3*4) + ai1 * b.get(bP+1+3*4) + ai2 * b.get(bP+2+3*4) + ai3 * b.get(bP+3+3*4) );
      }
   }
-  
+
+  /**
+   * Inverts a rigid body transformation, i.e. an orthonormal rotation followed by a translation,
+   * by transposing the rotation and rotating back the negated translation.
+   * <p>
+   * The result is undefined if <code>src</code> is not a rigid body transformation.
+   * <code>src</code> and <code>dst</code> may be the same matrix.
+   * </p>
+   * @param src 4x4 matrix in column-major order
+   * @param dst inverse of <code>src</code> in column-major order
+   */
+  public static final void invertRigidMatrixf(final float[] src, int src_off, float[] dst, int dst_off) {
+     final float r00=src[src_off+0+0*4], r10=src[src_off+1+0*4], r20=src[src_off+2+0*4];
+     final float r01=src[src_off+0+1*4], r11=src[src_off+1+1*4], r21=src[src_off+2+1*4];
+     final float r02=src[src_off+0+2*4], r12=src[src_off+1+2*4], r22=src[src_off+2+2*4];
+     final float tx=src[src_off+0+3*4], ty=src[src_off+1+3*4], tz=src[src_off+2+3*4];
+
+     dst[dst_off+0+0*4] = r00; dst[dst_off+1+0*4] = r01; dst[dst_off+2+0*4] = r02; dst[dst_off+3+0*4] = 0f;
+     dst[dst_off+0+1*4] = r10; dst[dst_off+1+1*4] = r11; dst[dst_off+2+1*4] = r12; dst[dst_off+3+1*4] = 0f;
+     dst[dst_off+0+2*4] = r20; dst[dst_off+1+2*4] = r21; dst[dst_off+2+2*4] = r22; dst[dst_off+3+2*4] = 0f;
+     dst[dst_off+0+3*4] = -( r00*tx + r10*ty + r20*tz );
+     dst[dst_off+1+3*4] = -( r01*tx + r11*ty + r21*tz );
+     dst[dst_off+2+3*4] = -( r02*tx + r12*ty + r22*tz );
+     dst[dst_off+3+3*4] = 1f;
+  }
+
+  /**
+   * Inverts an affine transformation, i.e. a matrix with the last row <code>[0 0 0 1]</code>,
+   * using the adjugate of its upper 3x3 matrix.
+   * <p>
+   * The result is undefined if <code>src</code> is not affine.
+   * <code>src</code> and <code>dst</code> may be the same matrix.
+   * </p>
+   * @param src 4x4 matrix in column-major order
+   * @param dst inverse of <code>src</code> in column-major order
+   * @return false if <code>src</code> is singular, in which case <code>dst</code> is left untouched
+   */
+  public static final boolean invertAffineMatrixf(final float[] src, int src_off, float[] dst, int dst_off) {
+     final float a00=src[src_off+0+0*4], a10=src[src_off+1+0*4], a20=src[src_off+2+0*4];
+     final float a01=src[src_off+0+1*4], a11=src[src_off+1+1*4], a21=src[src_off+2+1*4];
+     final float a02=src[src_off+0+2*4], a12=src[src_off+1+2*4], a22=src[src_off+2+2*4];
+     final float tx=src[src_off+0+3*4], ty=src[src_off+1+3*4], tz=src[src_off+2+3*4];
+
+     // adjugate, b_ij
+     final float b00 = a11*a22 - a12*a21, b01 = a02*a21 - a01*a22, b02 = a01*a12 - a02*a11;
+     final float b10 = a12*a20 - a10*a22, b11 = a00*a22 - a02*a20, b12 = a02*a10 - a00*a12;
+     final float b20 = a10*a21 - a11*a20, b21 = a01*a20 - a00*a21, b22 = a00*a11 - a01*a10;
+     final float det = a00*b00 + a01*b10 + a02*b20;
+     if( 0f == det ) {
+         return false;
+     }
+     final float s = 1f / det;
+
+     dst[dst_off+0+0*4] = b00*s; dst[dst_off+1+0*4] = b10*s; dst[dst_off+2+0*4] = b20*s; dst[dst_off+3+0*4] = 0f;
+     dst[dst_off+0+1*4] = b01*s; dst[dst_off+1+1*4] = b11*s; dst[dst_off+2+1*4] = b21*s; dst[dst_off+3+1*4] = 0f;
+     dst[dst_off+0+2*4] = b02*s; dst[dst_off+1+2*4] = b12*s; dst[dst_off+2+2*4] = b22*s; dst[dst_off+3+2*4] = 0f;
+     dst[dst_off+0+3*4] = -( b00*tx + b01*ty + b02*tz ) * s;
+     dst[dst_off+1+3*4] = -( b10*tx + b11*ty + b12*tz ) * s;
+     dst[dst_off+2+3*4] = -( b20*tx + b21*ty + b22*tz ) * s;
+     dst[dst_off+3+3*4] = 1f;
+     return true;
+  }
+
+  /**
+   * @param m 4x4 matrix in column-major order
+   * @return true if the last row of <code>m</code> is <code>[0 0 0 1]</code>, i.e. <code>m</code> is an affine transformation
+   */
+  public static final boolean isAffineMatrixf(final float[] m, int m_off) {
+     return 0f == m[m_off+3+0*4] && 0f == m[m_off+3+1*4] && 0f == m[m_off+3+2*4] && 1f == m[m_off+3+3*4];
+  }
+
+  /**
+   * @param m 4x4 matrix in column-major order
+   * @return true if the last row of <code>m</code> is <code>[0 0 0 1]</code>, i.e. <code>m</code> is an affine transformation
+   */
+  public static final boolean isAffineMatrixf(final FloatBuffer m) {
+     final int mP = m.position();
+     return 0f == m.get(mP+3+0*4) && 0f == m.get(mP+3+1*4) && 0f == m.get(mP+3+2*4) && 1f == m.get(mP+3+3*4);
+  }
+
   
   /**
    * Normalize vector
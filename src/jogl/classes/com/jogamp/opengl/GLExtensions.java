@@ -67,8 +67,11 @@ public class GLExtensions {
   public static final String IMG_texture_format_BGRA8888     = "GL_IMG_texture_format_BGRA8888";
   public static final String EXT_texture_compression_s3tc    = "GL_EXT_texture_compression_s3tc";
   public static final String NV_texture_compression_vtc      = "GL_NV_texture_compression_vtc";
+  public static final String ARB_texture_compression_rgtc   = "GL_ARB_texture_compression_rgtc";
+  public static final String EXT_texture_compression_rgtc   = "GL_EXT_texture_compression_rgtc";
   public static final String SGIS_generate_mipmap            = "GL_SGIS_generate_mipmap";
   public static final String OES_read_format                 = "GL_OES_read_format";
+  public static final String ARB_pixel_buffer_object         = "GL_ARB_pixel_buffer_object";
   
   public static final String OES_EGL_image_external          = "GL_OES_EGL_image_external";
   
@@ -183,6 +183,26 @@ public abstract class AnimatorBase implements GLAnimatorControl {
         return fpsCounter.getTotalFPS();
     }        
 
+    public final float getLastFrameTimeMin() {
+        return fpsCounter.getLastFrameTimeMin();
+    }
+
+    public final float getLastFrameTimeAvg() {
+        return fpsCounter.getLastFrameTimeAvg();
+    }
+
+    public final float getLastFrameTimeP99() {
+        return fpsCounter.getLastFrameTimeP99();
+    }
+
+    public final float getLastFrameTimeMax() {
+        return fpsCounter.getLastFrameTimeMax();
+    }
+
+    public final int getTotalMissedDeadlines() {
+        return fpsCounter.getTotalMissedDeadlines();
+    }
+
     public final Thread getThread() {
         stateSync.lock();
         try {
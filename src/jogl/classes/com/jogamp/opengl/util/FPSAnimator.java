@@ -42,14 +42,54 @@ package com.jogamp.opengl.util;
 import java.util.*;
 import javax.media.opengl.*;
 
+import jogamp.opengl.Debug;
+
 /** An Animator subclass which attempts to achieve a target
 frames-per-second rate to avoid using all CPU time. The target FPS
-is only an estimate and is not guaranteed. */
+is only an estimate and is not guaranteed. 
+<p>
+With {@link Pacing#Deadline} pacing, frames are driven by a dedicated thread
+against <code>System.nanoTime()</code> deadlines, which hits fractional
+periods like 16.67 ms exactly and does not drift.
+Missed deadlines and frame time statistics are reported via the {@link FPSCounter} 
+methods, if enabled with {@link #setUpdateFPSFrames(int, java.io.PrintStream)}.
+</p> */
 public class FPSAnimator extends AnimatorBase {
+    /** Frame pacing strategy, see {@link FPSAnimator#setPacing(Pacing)}. */
+    public enum Pacing {
+        /** 
+         * A {@link java.util.Timer} with an integer millisecond period, 
+         * the default.
+         */
+        Timer,
+        /** 
+         * Deadlines of a nanosecond period, waited for by sleeping and spinning the remaining 
+         * {@link FPSAnimator#SPIN_MICROS} microseconds. 
+         * <p>
+         * A frame finishing after the next deadline counts as a missed deadline.
+         * With fixed rate scheduling, late frames are caught up back to back up to  
+         * {@link FPSAnimator#setMaxCatchUpFrames(int) max catch up frames}, 
+         * beyond that the deadlines in the past are skipped.
+         * Otherwise the next frame is scheduled relative to the late one.
+         * </p>
+         */
+        Deadline
+    }
+    
+    /** 
+     * Remaining time to a deadline in microseconds, which is spent spinning instead of sleeping,
+     * property <code>jogl.fpsanimator.spin</code>, default 1500.
+     */
+    public static final int SPIN_MICROS = Debug.getIntProperty("jogl.fpsanimator.spin", true, 1500);
+    
     private Timer timer = null;
     private TimerTask task = null;
+    private DeadlinePacer pacer = null;
+    private boolean pacerStarted = false;
     private int fps;
     private boolean scheduleAtFixedRate;
+    private Pacing pacing = Pacing.Timer;
+    private volatile int maxCatchUpFrames = 2;
     private volatile boolean shouldRun;
 
     protected String getBaseName(String prefix) {
@@ -88,10 +128,46 @@ public class FPSAnimator extends AnimatorBase {
         this.scheduleAtFixedRate = scheduleAtFixedRate;
     }
 
+    /**
+     * Sets the frame pacing strategy, defaults to {@link Pacing#Timer}.
+     * @throws GLException if this animator is started
+     */
+    public final void setPacing(Pacing pacing) throws GLException {
+        stateSync.lock();
+        try {
+            if(isStartedImpl()) {
+                throw new GLException("Pacing can't be changed while started: "+this);
+            }
+            this.pacing = pacing;
+        } finally {
+            stateSync.unlock();
+        }
+    }
+    
+    public final Pacing getPacing() {
+        return pacing;
+    }
+    
+    /**
+     * Sets the number of late frames {@link Pacing#Deadline} pacing with fixed rate scheduling
+     * renders back to back to catch up, defaults to 2. 0 skips all deadlines in the past.
+     */
+    public final void setMaxCatchUpFrames(int frames) {
+        maxCatchUpFrames = Math.max(0, frames);
+    }
+    
+    public final int getMaxCatchUpFrames() {
+        return maxCatchUpFrames;
+    }
+
+    private boolean isStartedImpl() {
+        return (timer != null) || pacerStarted;
+    }
+    
     public final boolean isStarted() {
         stateSync.lock();
         try {
-            return (timer != null);
+            return isStartedImpl();
         } finally {
             stateSync.unlock();
         }
@@ -100,7 +176,7 @@ public class FPSAnimator extends AnimatorBase {
     public final boolean isAnimating() {
         stateSync.lock();
         try {
-            return (timer != null) && (task != null);
+            return isStartedImpl() && (task != null || pacer != null);
         } finally {
             stateSync.unlock();
         }
@@ -109,14 +185,106 @@ public class FPSAnimator extends AnimatorBase {
     public final boolean isPaused() {
         stateSync.lock();
         try {
-            return (timer != null) && (task == null);
+            return isStartedImpl() && (task == null && pacer == null);
         } finally {
             stateSync.unlock();
         }
     }
 
+    private class DeadlinePacer extends Thread {
+        private final long period;
+        private volatile boolean cancelled = false;
+        /** Guards {@link #sleeping}, so only a sleep is interrupted, never {@link FPSAnimator#display()} */
+        private final Object sleepLock = new Object();
+        private boolean sleeping = false;
+        
+        DeadlinePacer() {
+            super(baseName+"-Pacer");
+            setDaemon(true);
+            period = 1000000000L / fps;
+        }
+        
+        /** Cancels pacing and interrupts a pending sleep, so the thread ends without waiting for the next deadline */
+        void cancel() {
+            cancelled = true;
+            synchronized( sleepLock ) {
+                if( sleeping ) {
+                    interrupt();
+                }
+            }
+        }
+        
+        private boolean isRunning() {
+            return !cancelled && FPSAnimator.this.shouldRun;
+        }
+        
+        /** Sleeps until {@link FPSAnimator#SPIN_MICROS} before the deadline, then spins */
+        private void waitUntil(long deadline) {
+            final long spin = SPIN_MICROS * 1000L;
+            long remaining;
+            while( isRunning() && ( remaining = deadline - System.nanoTime() ) > 0 ) {
+                if( remaining > spin ) {
+                    final long sleep = remaining - spin;
+                    synchronized( sleepLock ) {
+                        if( !isRunning() ) {
+                            break;
+                        }
+                        sleeping = true;
+                    }
+                    try {
+                        Thread.sleep(sleep / 1000000L, (int) ( sleep % 1000000L ));
+                    } catch (InterruptedException ie) {
+                    } finally {
+                        synchronized( sleepLock ) {
+                            sleeping = false;
+                            Thread.interrupted(); // clear a cancel interrupt arriving after the sleep
+                        }
+                    }
+                } else {
+                    Thread.yield();
+                }
+            }
+        }
+        
+        public void run() {
+            long deadline = System.nanoTime();
+            while( isRunning() ) {
+                waitUntil(deadline);
+                if( !isRunning() ) {
+                    break;
+                }
+                FPSAnimator.this.animThread = this;
+                // display impl. uses synchronized block on the animator instance
+                display();
+                
+                deadline += period;
+                final long late = System.nanoTime() - deadline;
+                if( late > 0 ) {
+                    // this frame ended after the next one's deadline
+                    final long behind = late / period; // further deadlines passed
+                    if( !scheduleAtFixedRate ) {
+                        deadline += late;
+                        fpsCounter.addMissedDeadlines(1);
+                    } else if( behind > maxCatchUpFrames ) {
+                        deadline += behind * period;
+                        fpsCounter.addMissedDeadlines(1 + (int) behind);
+                    } else {
+                        fpsCounter.addMissedDeadlines(1);
+                    }
+                }
+            }
+        }
+    }
+    
     private void startTask() {
-        if(null != task) {
+        if(null != task || null != pacer) {
+            return;
+        }
+        if(Pacing.Deadline == pacing) {
+            fpsCounter.resetFPSCounter();
+            shouldRun = true;
+            pacer = new DeadlinePacer();
+            pacer.start();
             return;
         }
         long delay = (long) (1000.0f / (float) fps);
@@ -141,12 +309,16 @@ public class FPSAnimator extends AnimatorBase {
     }
 
     public synchronized boolean  start() {
-        if (timer != null) {
+        if (isStartedImpl()) {
             return false;
         }
         stateSync.lock();
         try {
-            timer = new Timer();
+            if(Pacing.Deadline == pacing) {
+                pacerStarted = true;
+            } else {
+                timer = new Timer();
+            }
             startTask();
         } finally {
             stateSync.unlock();
@@ -158,7 +330,7 @@ public class FPSAnimator extends AnimatorBase {
     FPSAnimator it is not guaranteed that the FPSAnimator will be
     completely stopped by the time this method returns. */
     public synchronized boolean stop() {
-        if (timer == null) {
+        if (!isStartedImpl()) {
             return false;
         }
         stateSync.lock();
@@ -168,6 +340,11 @@ public class FPSAnimator extends AnimatorBase {
                 task.cancel();
                 task = null;
             }
+            if(null != pacer) {
+                pacer.cancel();
+                pacer = null;
+            }
+            pacerStarted = false;
             if(null != timer) {
                 timer.cancel();
                 timer = null;
@@ -183,7 +360,7 @@ public class FPSAnimator extends AnimatorBase {
     }
 
     public synchronized boolean pause() {
-        if (timer == null) {
+        if (!isStartedImpl()) {
             return false;
         }
         stateSync.lock();
@@ -193,6 +370,10 @@ public class FPSAnimator extends AnimatorBase {
                 task.cancel();
                 task = null;
             }
+            if(null != pacer) {
+                pacer.cancel();
+                pacer = null;
+            }
             animThread = null;
             try {
                 Thread.sleep(20); // ~ 1/60 hz wait, since we can't ctrl stopped threads
@@ -204,7 +385,7 @@ public class FPSAnimator extends AnimatorBase {
     }
 
     public synchronized boolean resume() {
-        if (timer == null) {
+        if (!isStartedImpl()) {
             return false;
         }
         stateSync.lock();
@@ -29,6 +29,7 @@
 package com.jogamp.opengl.util;
 
 import com.jogamp.common.nio.Buffers;
+import com.jogamp.common.util.IOUtil;
 
 import java.io.File;
 import java.io.IOException;
@@ -39,19 +40,60 @@ import com.jogamp.opengl.GLExtensions;
 import com.jogamp.opengl.util.texture.Texture;
 import com.jogamp.opengl.util.texture.TextureData;
 import com.jogamp.opengl.util.texture.TextureIO;
+import com.jogamp.opengl.util.texture.spi.PNGImage;
 
 /**
  * Utility to read out the current FB to TextureData, optionally writing the data back to a texture object.
  * <p>May be used directly to write the TextureData to file (screenshot).</p>
+ * <p>
+ * With {@link #setAsyncBufferCount(int) asynchronous readback} enabled, 
+ * {@link #readPixels(GL, boolean)} reads into a ring of <code>N</code> pixel pack buffer objects (PBO)
+ * without waiting for the GPU. The readback of frame <code>K</code> is mapped at frame <code>K+N-1</code>,
+ * i.e. the TextureData lags <code>N-1</code> frames behind and is delivered 
+ * to the {@link FrameListener}, if set, with its frame number.
+ * Without PBO support, the synchronous path is used.
+ * </p>
  */
 public class GLReadBufferUtil {
+    /**
+     * Receives each frame completed by {@link GLReadBufferUtil#readPixels(GL, boolean)}
+     * or {@link GLReadBufferUtil#flushAsync(GL)} on the GL thread.
+     */
+    public static interface FrameListener {
+        /**
+         * @param reader the source
+         * @param frameNumber the number of the {@link GLReadBufferUtil#readPixels(GL, boolean)} call which read the frame, starting w/ 0 
+         * @param data the reader's {@link GLReadBufferUtil#getTextureData() TextureData}, 
+         *        valid until the next {@link GLReadBufferUtil#readPixels(GL, boolean)} call 
+         */
+        public void frameRead(GLReadBufferUtil reader, long frameNumber, TextureData data);
+    }
+    
+    /** One PBO of the asynchronous readback ring and the attributes of the frame it holds. */
+    private static class PackBuffer {
+        int name = 0;
+        int capacity = 0;
+        boolean pending = false;
+        long frameNumber;
+        int width, height, internalFormat, dataFormat, dataType, size;
+        boolean flip;
+    }
+    
     protected final int components, alignment; 
     protected final Texture readTexture;
     protected final GLPixelStorageModes psm;
     
+    protected int pngEncoderThreads = 1;
+    
     protected int readPixelSizeLast = 0;
     protected ByteBuffer readPixelBuffer = null;
     protected TextureData readTextureData = null;
+    
+    protected int asyncBufferCount = 0;
+    protected FrameListener frameListener = null;
+    private PackBuffer[] packBuffers = null;
+    private long frameCounter = 0;
+    private long frameNumber = -1;
 
     /**
      * @param alpha true for RGBA readPixels, otherwise RGB readPixels. Disclaimer: Alpha maybe forced on ES platforms! 
@@ -94,24 +136,101 @@ public class GLReadBufferUtil {
      */
     public Texture getTexture() { return readTexture; }
 
+    /**
+     * Sets the number of threads used to encode PNG files in {@link #write(File)}, defaults to 1.
+     * <p>
+     * With more than one thread, the image is encoded in parallel stripes by a shared encoder,
+     * which reuses its buffers for subsequent frames, see {@link PNGImage#write(File, boolean, int)}.
+     * </p>
+     * @param threadCount number of encoding threads, 0 for the number of available processors
+     */
+    public void setPNGEncoderThreads(int threadCount) { pngEncoderThreads = threadCount; }
+    
+    public int getPNGEncoderThreads() { return pngEncoderThreads; }
+    
+    /**
+     * Enables asynchronous readback through a ring of <code>count</code> PBOs, 0 disables it (default).
+     * <p>
+     * Takes effect with the next {@link #readPixels(GL, boolean)} call, which drops frames still pending 
+     * in a ring of a different size. Use {@link #flushAsync(GL)} before to retrieve them.
+     * </p>
+     */
+    public void setAsyncBufferCount(int count) { asyncBufferCount = Math.max(0, count); }
+    
+    public int getAsyncBufferCount() { return asyncBufferCount; }
+    
+    public void setFrameListener(FrameListener l) { frameListener = l; }
+    
+    public FrameListener getFrameListener() { return frameListener; }
+    
+    /** @return the frame number of the current {@link #getTextureData() TextureData}, -1 if none has been read yet. */
+    public long getFrameNumber() { return frameNumber; }
+    
+    /**
+     * @return true if the given GL supports pixel pack buffer objects and buffer mapping, 
+     *         required for {@link #setAsyncBufferCount(int) asynchronous readback}.
+     */
+    public static boolean isPBOAvailable(GL gl) {
+        if( !gl.isGL2GL3() || !gl.isFunctionAvailable("glMapBuffer") ) {
+            return false;
+        }
+        final GLContext ctx = gl.getContext();
+        return ctx.getGLVersionMajor() > 2 || 
+               ( 2 == ctx.getGLVersionMajor() && ctx.getGLVersionMinor() >= 1 ) ||
+               gl.isExtensionAvailable(GLExtensions.ARB_pixel_buffer_object);
+    }
+    
     /**
      * Write the TextureData filled by {@link #readPixels(GLAutoDrawable, boolean)} to file
      */
     public void write(File dest) {
         try {
-            TextureIO.write(readTextureData, dest);
+            if( 1 == pngEncoderThreads || !writePNG(dest) ) {
+                TextureIO.write(readTextureData, dest);
+            }
             rewindPixelBuffer();
         } catch (IOException ex) {
             throw new RuntimeException("can not write to file: " + dest.getAbsolutePath(), ex);
         }
     }
 
+    /** 
+     * Writes the data as PNG w/ {@link #pngEncoderThreads}, if <code>dest</code> has the PNG suffix 
+     * and the data is RGB[A] or BGR[A] bytes, otherwise returns false. 
+     */
+    private boolean writePNG(File dest) throws IOException {
+        if( !TextureIO.PNG.equals(IOUtil.getFileSuffix(dest)) || GL.GL_UNSIGNED_BYTE != readTextureData.getPixelType() ) {
+            return false;
+        }
+        final int bytesPerPixel;
+        final boolean reversedChannels;
+        switch( readTextureData.getPixelFormat() ) {
+            case GL.GL_RGB:    bytesPerPixel = 3; reversedChannels = false; break;
+            case GL.GL_RGBA:   bytesPerPixel = 4; reversedChannels = false; break;
+            case GL2.GL_BGR:   bytesPerPixel = 3; reversedChannels = true; break;
+            case GL.GL_BGRA:   bytesPerPixel = 4; reversedChannels = true; break;
+            default: return false;
+        }
+        readPixelBuffer.rewind();
+        final PNGImage image = PNGImage.createFromData(readTextureData.getWidth(), readTextureData.getHeight(), -1f, -1f,
+                                                       bytesPerPixel, reversedChannels, readPixelBuffer);
+        image.write(dest, true, pngEncoderThreads);
+        return true;
+    }
+    
     /**
      * Read the drawable's pixels to TextureData and Texture, if requested at construction
+     * <p>
+     * With {@link #setAsyncBufferCount(int) asynchronous readback}, the pixels are only requested
+     * and the TextureData and Texture receive the oldest pending frame, if its readback has been
+     * requested <code>N-1</code> calls before.
+     * </p>
      * 
      * @param gl the current GL context object. It's read drawable is being used as the pixel source.
      * @param drawable the drawable to read from
      * @param flip weather to flip the data vertically or not
+     * @return true if a frame has been read to TextureData, 
+     *         false on error or while the asynchronous readback ring is being filled.
      * 
      * @see #GLReadBufferUtil(boolean, boolean)
      */
@@ -145,6 +264,141 @@ public class GLReadBufferUtil {
         final int readPixelSize = GLBuffers.sizeof(gl, tmp, textureDataFormat, textureDataType, 
                                                    drawable.getWidth(), drawable.getHeight(), 1, true);
         
+        if( 0 < asyncBufferCount && isPBOAvailable(gl) ) {
+            return readPixelsAsync(gl, drawable.getWidth(), drawable.getHeight(), 
+                                   textureInternalFormat, textureDataFormat, textureDataType, readPixelSize, flip);
+        }
+        
+        final boolean newData = updateTextureData(gl, drawable.getWidth(), drawable.getHeight(), 
+                                                  textureInternalFormat, textureDataFormat, textureDataType, readPixelSize, flip);
+        boolean res = null!=readPixelBuffer;
+        if(res) {
+            psm.setAlignment(gl, alignment, alignment);
+            readPixelBuffer.clear();
+            gl.glReadPixels(0, 0, drawable.getWidth(), drawable.getHeight(), textureDataFormat, textureDataType, readPixelBuffer);
+            readPixelBuffer.position(readPixelSize);
+            readPixelBuffer.flip();
+            final int glerr1 = gl.glGetError();
+            if(GL.GL_NO_ERROR != glerr1) {
+                System.err.println("GLReadBufferUtil.readPixels: readPixels error 0x"+Integer.toHexString(glerr1)+
+                                   " "+drawable.getWidth()+"x"+drawable.getHeight()+
+                                   ", fmt 0x"+Integer.toHexString(textureDataFormat)+", type 0x"+Integer.toHexString(textureDataType)+
+                                   ", impl-fmt 0x"+Integer.toHexString(glImplColorReadVals[0])+", impl-type 0x"+Integer.toHexString(glImplColorReadVals[1])+
+                                   ", "+readPixelBuffer+", sz "+readPixelSize);
+                res = false;                
+            }
+            if(res) {
+                updateTexture(gl, newData, drawable.getWidth(), drawable.getHeight());
+            }
+            psm.restore(gl);
+            if(res) {
+                frameRead(frameCounter++);
+            }
+        }
+        return res;
+    }
+    
+    /**
+     * Requests the readback of the current frame into the next PBO of the ring 
+     * and delivers the oldest pending frame.
+     */
+    private boolean readPixelsAsync(GL gl, int width, int height, int internalFormat, int dataFormat, int dataType, 
+                                    int readPixelSize, boolean flip) {
+        if( null == packBuffers || packBuffers.length != asyncBufferCount ) {
+            disposePackBuffers(gl);
+            packBuffers = new PackBuffer[asyncBufferCount];
+            final int[] names = new int[asyncBufferCount];
+            gl.glGenBuffers(asyncBufferCount, names, 0);
+            for(int i=0; i<asyncBufferCount; i++) {
+                packBuffers[i] = new PackBuffer();
+                packBuffers[i].name = names[i];
+            }
+        }
+        // The slot of frame K held frame K-N, already delivered by the call of frame K-1
+        final PackBuffer pb = packBuffers[(int) ( frameCounter % packBuffers.length )];
+        gl.glBindBuffer(GL2GL3.GL_PIXEL_PACK_BUFFER, pb.name);
+        if( readPixelSize > pb.capacity ) {
+            gl.glBufferData(GL2GL3.GL_PIXEL_PACK_BUFFER, readPixelSize, null, GL2GL3.GL_STREAM_READ);
+            pb.capacity = readPixelSize;
+        }
+        psm.setAlignment(gl, alignment, alignment);
+        gl.getGL2GL3().glReadPixels(0, 0, width, height, dataFormat, dataType, 0L);
+        psm.restore(gl);
+        gl.glBindBuffer(GL2GL3.GL_PIXEL_PACK_BUFFER, 0);
+        final int glerr1 = gl.glGetError();
+        if(GL.GL_NO_ERROR != glerr1) {
+            System.err.println("GLReadBufferUtil.readPixels: async readPixels error 0x"+Integer.toHexString(glerr1)+
+                               " "+width+"x"+height+
+                               ", fmt 0x"+Integer.toHexString(dataFormat)+", type 0x"+Integer.toHexString(dataType)+
+                               ", sz "+readPixelSize);
+            return false;
+        }
+        pb.pending = true;
+        pb.frameNumber = frameCounter++;
+        pb.width = width;
+        pb.height = height;
+        pb.internalFormat = internalFormat;
+        pb.dataFormat = dataFormat;
+        pb.dataType = dataType;
+        pb.size = readPixelSize;
+        pb.flip = flip;
+        return deliver(gl, packBuffers[(int) ( frameCounter % packBuffers.length )]);
+    }
+    
+    /**
+     * Delivers all frames pending in the asynchronous readback ring in order, 
+     * blocking until their readback has been completed.
+     * 
+     * @return the number of delivered frames
+     */
+    public int flushAsync(GL gl) {
+        int n = 0;
+        if( null != packBuffers ) {
+            for(int i=0; i<packBuffers.length; i++) {
+                if( deliver(gl, packBuffers[(int) ( ( frameCounter + i ) % packBuffers.length )]) ) {
+                    n++;
+                }
+            }
+        }
+        return n;
+    }
+    
+    /** Maps the given PBO, if pending, and copies its frame to TextureData and Texture. */
+    private boolean deliver(GL gl, PackBuffer pb) {
+        if( !pb.pending ) {
+            return false;
+        }
+        pb.pending = false;
+        gl.glBindBuffer(GL2GL3.GL_PIXEL_PACK_BUFFER, pb.name);
+        final ByteBuffer mapped = gl.glMapBuffer(GL2GL3.GL_PIXEL_PACK_BUFFER, GL2GL3.GL_READ_ONLY);
+        boolean newData = false;
+        if( null != mapped ) {
+            newData = updateTextureData(gl, pb.width, pb.height, pb.internalFormat, pb.dataFormat, pb.dataType, pb.size, pb.flip);
+            mapped.clear();
+            mapped.limit(pb.size);
+            readPixelBuffer.clear();
+            readPixelBuffer.put(mapped);
+            readPixelBuffer.flip();
+            gl.glUnmapBuffer(GL2GL3.GL_PIXEL_PACK_BUFFER);
+        } else {
+            System.err.println("GLReadBufferUtil.readPixels: mapping PBO of frame "+pb.frameNumber+
+                               " failed, error 0x"+Integer.toHexString(gl.glGetError()));
+        }
+        gl.glBindBuffer(GL2GL3.GL_PIXEL_PACK_BUFFER, 0);
+        if( null == mapped ) {
+            return false;
+        }
+        updateTexture(gl, newData, pb.width, pb.height);
+        frameRead(pb.frameNumber);
+        return true;
+    }
+    
+    /**
+     * Adjusts TextureData to the given attributes, allocating a larger pixel buffer if required.
+     * @return true if new TextureData has been created
+     */
+    private boolean updateTextureData(GL gl, int width, int height, int textureInternalFormat, 
+                                      int textureDataFormat, int textureDataType, int readPixelSize, boolean flip) {
         boolean newData = false;
         if(readPixelSize>readPixelSizeLast) {
             readPixelBuffer = Buffers.newDirectByteBuffer(readPixelSize);
@@ -153,7 +407,7 @@ public class GLReadBufferUtil {
                 readTextureData = new TextureData(
                            gl.getGLProfile(),
                            textureInternalFormat,
-                           drawable.getWidth(), drawable.getHeight(),
+                           width, height,
                            0, 
                            textureDataFormat,
                            textureDataType,
@@ -170,44 +424,51 @@ public class GLReadBufferUtil {
             }
         } else {
             readTextureData.setInternalFormat(textureInternalFormat);
-            readTextureData.setWidth(drawable.getWidth());
-            readTextureData.setHeight(drawable.getHeight());
+            readTextureData.setWidth(width);
+            readTextureData.setHeight(height);
             readTextureData.setPixelFormat(textureDataFormat);
             readTextureData.setPixelType(textureDataType);
+            readTextureData.setMustFlipVertically(flip);
         }
-        boolean res = null!=readPixelBuffer;
-        if(res) {
-            psm.setAlignment(gl, alignment, alignment);
-            readPixelBuffer.clear();
-            gl.glReadPixels(0, 0, drawable.getWidth(), drawable.getHeight(), textureDataFormat, textureDataType, readPixelBuffer);
-            readPixelBuffer.position(readPixelSize);
-            readPixelBuffer.flip();
-            final int glerr1 = gl.glGetError();
-            if(GL.GL_NO_ERROR != glerr1) {
-                System.err.println("GLReadBufferUtil.readPixels: readPixels error 0x"+Integer.toHexString(glerr1)+
-                                   " "+drawable.getWidth()+"x"+drawable.getHeight()+
-                                   ", fmt 0x"+Integer.toHexString(textureDataFormat)+", type 0x"+Integer.toHexString(textureDataType)+
-                                   ", impl-fmt 0x"+Integer.toHexString(glImplColorReadVals[0])+", impl-type 0x"+Integer.toHexString(glImplColorReadVals[1])+
-                                   ", "+readPixelBuffer+", sz "+readPixelSize);
-                res = false;                
+        return newData;
+    }
+    
+    private void updateTexture(GL gl, boolean newData, int width, int height) {
+        if(null != readTexture) {
+            if(newData) {
+                readTexture.updateImage(gl, readTextureData);
+            } else {
+                readTexture.updateSubImage(gl, readTextureData, 0, 
+                                           0, 0, // src offset
+                                           0, 0, // dst offset
+                                           width, height);
             }
-            if(res && null != readTexture) {
-                if(newData) {
-                    readTexture.updateImage(gl, readTextureData);
-                } else {
-                    readTexture.updateSubImage(gl, readTextureData, 0, 
-                                               0, 0, // src offset
-                                               0, 0, // dst offset
-                                               drawable.getWidth(), drawable.getHeight());
-                }
-                readPixelBuffer.rewind();
+            readPixelBuffer.rewind();
+        }
+    }
+    
+    private void frameRead(long frameNumber) {
+        this.frameNumber = frameNumber;
+        final FrameListener l = frameListener;
+        if( null != l ) {
+            l.frameRead(this, frameNumber, readTextureData);
+            readPixelBuffer.rewind();
+        }
+    }
+    
+    private void disposePackBuffers(GL gl) {
+        if( null != packBuffers ) {
+            final int[] names = new int[packBuffers.length];
+            for(int i=0; i<packBuffers.length; i++) {
+                names[i] = packBuffers[i].name;
             }
-            psm.restore(gl);
+            gl.glDeleteBuffers(names.length, names, 0);
+            packBuffers = null;
         }
-        return res;
     }
 
     public void dispose(GL gl) {  
+        disposePackBuffers(gl);
         if(null != readTexture) {
             readTexture.destroy(gl);
             readTextureData = null;
@@ -3,6 +3,7 @@ package com.jogamp.opengl.util;
 
 import java.nio.Buffer;
 import java.nio.ByteBuffer;
+import java.nio.IntBuffer;
 import java.nio.ShortBuffer;
 import java.util.ArrayList;
 import java.util.Iterator;
@@ -21,8 +22,11 @@ public class ImmModeSink {
   public static final boolean DEBUG_BEGIN_END = false;
   public static final boolean DEBUG_DRAW = false;
 
-  // public static final int GL_QUADS      = 0x0007; // Needs data manipulation
+  /** Drawn as {@link GL#GL_TRIANGLES}, using generated indices splitting each quad into two triangles. */
+  public static final int GL_QUADS      = 0x0007;
+  /** Drawn as {@link GL#GL_TRIANGLE_STRIP}. */
   public static final int GL_QUAD_STRIP = 0x0008;
+  /** Drawn as {@link GL#GL_TRIANGLE_FAN}, hence the polygon must be convex. */
   public static final int GL_POLYGON    = 0x0009;
 
   /**
@@ -120,15 +124,14 @@ public class ImmModeSink {
     }
     vboSet.modeOrig = mode;
     switch(mode) {
-        // Needs data manipulation ..
-        //case GL_QUADS:
-        //    mode=GL.GL_LINES;
-        //    break;
+        case GL_QUADS:
+            mode=GL.GL_TRIANGLES;
+            break;
         case GL_QUAD_STRIP:
             mode=GL.GL_TRIANGLE_STRIP;
             break;
         case GL_POLYGON:
-            mode=GL.GL_LINES;
+            mode=GL.GL_TRIANGLE_FAN;
             break;
     }
     vboSet.mode = mode;
@@ -343,7 +346,16 @@ public class ImmModeSink {
 
         if (buffer!=null) {
             if(null==indices) {
-                gl.glDrawArrays(mode, 0, count);
+                if(GL_QUADS==modeOrig) {
+                    final int quads = elements / 4;
+                    final int type = quads * 4 <= 0x10000 ? GL.GL_UNSIGNED_SHORT : GL.GL_UNSIGNED_INT;
+                    if( GL.GL_UNSIGNED_INT == type && !gl.isGL2GL3() && !gl.isExtensionAvailable("GL_OES_element_index_uint") ) {
+                        throw new GLException("GL_QUADS with "+elements+" vertices exceeds GL_UNSIGNED_SHORT indices:\n\t"+this);
+                    }
+                    gl.glDrawElements(mode, quads * 6, type, getQuadIndices(quads, type));
+                } else {
+                    gl.glDrawArrays(mode, 0, elements);
+                }
             } else {
                 Class<?> clazz = indices.getClass();
                 int type=-1;
@@ -355,6 +367,9 @@ public class ImmModeSink {
                 if(0>type) {
                     throw new GLException("Given Buffer Class not supported: "+clazz+", should be ubyte or ushort:\n\t"+this);
                 }
+                if(GL_QUADS==modeOrig) {
+                    indices = getTriangulatedQuadIndices(indices);
+                }
                 gl.glDrawElements(mode, indices.remaining(), type, indices);
                 // GL2: gl.glDrawRangeElements(mode, 0, indices.remaining()-1, indices.remaining(), type, indices);
             }
@@ -367,18 +382,22 @@ public class ImmModeSink {
 
     public void glVertexv(Buffer v) {
         checkSeal(false);
+        growBufferIfNecessary(VERTEX, v.remaining());
         GLBuffers.put(vertexArray, v);
     }
     public void glNormalv(Buffer v) {
         checkSeal(false);
+        growBufferIfNecessary(NORMAL, v.remaining());
         GLBuffers.put(normalArray, v);
     }
     public void glColorv(Buffer v) {
         checkSeal(false);
+        growBufferIfNecessary(COLOR, v.remaining());
         GLBuffers.put(colorArray, v);
     }
     public void glTexCoordv(Buffer v) {
         checkSeal(false);
+        growBufferIfNecessary(TEXTCOORD, v.remaining());
         GLBuffers.put(textCoordArray, v);
     }
 
@@ -632,7 +651,9 @@ public class ImmModeSink {
         vertexArray=null; colorArray=null; normalArray=null; textCoordArray=null;
         vArrayData=null; cArrayData=null; nArrayData=null; tArrayData=null;
         buffer=null;
-        bSize=0; count=0;
+        quadIndices=null; quadIndicesCount=0;
+        triIndices=null; triIndicesSrc=null;
+        bSize=0; count=0; elements=0;
     }
 
     public void reset(GL gl) {
@@ -648,6 +669,7 @@ public class ImmModeSink {
 
         this.mode = 0;
         this.modeOrig = 0;
+        this.elements = 0;
         this.sealed=false;
         this.bufferEnabled=false;
         this.bufferWritten=false;
@@ -684,6 +706,7 @@ public class ImmModeSink {
         if(sealed==seal) return;
         sealed = seal;
         if(seal) {
+            elements = null!=vertexArray ? vertexArray.position() / vComps : 0;
             bufferWritten=false;
         }
     }
@@ -802,6 +825,7 @@ public class ImmModeSink {
     public String toString() {
         return "VBOSet[mode "+mode+ 
                        ", modeOrig "+modeOrig+ 
+                       ", elements "+elements+"/"+count+ 
                        ", sealed "+sealed+ 
                        ", bufferEnabled "+bufferEnabled+ 
                        ", bufferWritten "+bufferWritten+ 
@@ -892,9 +916,21 @@ public class ImmModeSink {
 
     }
 
+    /**
+     * Grows all arrays if the array of the given type can't hold <code>spare</code> more components,
+     * at least by the current element count, i.e. the capacity doubles and the copy cost per element stays constant.
+     */
     protected final boolean growBufferIfNecessary(int type, int spare) {
-        if(buffer==null || count < spare) { 
-            growBuffer(type, initialElementCount);
+        final int comps = getComps(type);
+        if( 0 == comps ) {
+            return false; // attribute not stored
+        }
+        final Buffer dest = getArray(type);
+        final int remaining = null != dest ? dest.remaining() : 0;
+        final int required = Math.max(spare, comps);
+        if( remaining < required ) {
+            final int minAdditional = ( required - remaining + comps - 1 ) / comps;
+            growBuffer(type, Math.max(minAdditional, Math.max(count, initialElementCount)));
             return true;
         }
         return false;
@@ -926,25 +962,143 @@ public class ImmModeSink {
         }
     }
 
-    protected void padding(int type, int fill) {
-        if ( sealed ) return;
-
-        Buffer dest = null;
+    protected final Buffer getArray(int type) {
+        switch (type) {
+            case VERTEX:
+                return vertexArray;
+            case COLOR:
+                return colorArray;
+            case NORMAL:
+                return normalArray;
+            case TEXTCOORD:
+                return textCoordArray;
+        }
+        return null;
+    }
 
+    protected final int getComps(int type) {
         switch (type) {
             case VERTEX:
-                dest = vertexArray;
-                break;
+                return vComps;
             case COLOR:
-                dest = colorArray;
-                break;
+                return cComps;
             case NORMAL:
-                dest = normalArray;
-                break;
+                return nComps;
             case TEXTCOORD:
-                dest = textCoordArray;
-                break;
+                return tComps;
         }
+        return 0;
+    }
+
+    /**
+     * Returns indices splitting each quad <code>[v0, v1, v2, v3]</code> into 
+     * the triangles <code>[v0, v1, v2]</code> and <code>[v0, v2, v3]</code>.
+     * <p>
+     * The indices are generated on demand and reused, since the indices of less quads are a prefix.
+     * </p>
+     * @param quads number of quads
+     * @param type {@link GL#GL_UNSIGNED_SHORT} or {@link GL#GL_UNSIGNED_INT}
+     */
+    protected final Buffer getQuadIndices(int quads, int type) {
+        if( null == quadIndices || quadIndicesType != type || quadIndicesCount < quads ) {
+            int n = Math.max(quads, 2*quadIndicesCount);
+            if( GL.GL_UNSIGNED_SHORT == type ) {
+                n = Math.min(n, 0x10000 / 4);
+                final ShortBuffer sb = GLBuffers.newDirectShortBuffer(n*6);
+                for(int i=0; i<n; i++) {
+                    final int v = i*4;
+                    sb.put((short)v).put((short)(v+1)).put((short)(v+2));
+                    sb.put((short)v).put((short)(v+2)).put((short)(v+3));
+                }
+                quadIndices = sb;
+            } else {
+                final IntBuffer ib = GLBuffers.newDirectIntBuffer(n*6);
+                for(int i=0; i<n; i++) {
+                    final int v = i*4;
+                    ib.put(v).put(v+1).put(v+2);
+                    ib.put(v).put(v+2).put(v+3);
+                }
+                quadIndices = ib;
+            }
+            quadIndices.rewind();
+            quadIndicesType = type;
+            quadIndicesCount = n;
+        }
+        return quadIndices;
+    }
+
+    /**
+     * Returns the given quad indices, from their position to their limit, as triangle indices.
+     * <p>
+     * The triangle indices are cached and only rebuilt if the given quad indices have changed,
+     * i.e. another buffer, range or content is given. The cached buffer is reused if large enough.
+     * </p>
+     * @see #getQuadIndices(int, int)
+     */
+    protected final Buffer getTriangulatedQuadIndices(Buffer indices) {
+        final int quads = indices.remaining() / 4;
+        final boolean isShort = indices instanceof ShortBuffer;
+        if( triIndicesSrc == indices && triIndicesSrcPos == indices.position() && triIndicesSrcLimit == indices.limit() && 
+            matchesTriangulatedQuadIndices(indices, triIndices, quads) ) {
+            return triIndices;
+        }
+        if( null == triIndices || isShort != ( triIndices instanceof ShortBuffer ) || triIndices.capacity() < quads*6 ) {
+            triIndices = isShort ? GLBuffers.newDirectShortBuffer(quads*6) : GLBuffers.newDirectByteBuffer(quads*6);
+        }
+        triIndices.clear();
+        if( isShort ) {
+            final ShortBuffer src = (ShortBuffer) indices;
+            final ShortBuffer dst = (ShortBuffer) triIndices;
+            int p = src.position();
+            for(int i=0; i<quads; i++, p+=4) {
+                dst.put(src.get(p)).put(src.get(p+1)).put(src.get(p+2));
+                dst.put(src.get(p)).put(src.get(p+2)).put(src.get(p+3));
+            }
+        } else {
+            final ByteBuffer src = (ByteBuffer) indices;
+            final ByteBuffer dst = (ByteBuffer) triIndices;
+            int p = src.position();
+            for(int i=0; i<quads; i++, p+=4) {
+                dst.put(src.get(p)).put(src.get(p+1)).put(src.get(p+2));
+                dst.put(src.get(p)).put(src.get(p+2)).put(src.get(p+3));
+            }
+        }
+        triIndices.flip();
+        triIndicesSrc = indices;
+        triIndicesSrcPos = indices.position();
+        triIndicesSrcLimit = indices.limit();
+        return triIndices;
+    }
+
+    /** Returns true if <code>tri</code> holds the triangulated <code>quads</code> of <code>indices</code>, read w/o modification. */
+    private static boolean matchesTriangulatedQuadIndices(Buffer indices, Buffer tri, int quads) {
+        if( tri.remaining() != quads*6 ) {
+            return false;
+        }
+        if( indices instanceof ShortBuffer ) {
+            final ShortBuffer src = (ShortBuffer) indices;
+            final ShortBuffer dst = (ShortBuffer) tri;
+            for(int i=0, p=src.position(), t=0; i<quads; i++, p+=4, t+=6) {
+                if( dst.get(t) != src.get(p) || dst.get(t+1) != src.get(p+1) || dst.get(t+2) != src.get(p+2) || dst.get(t+5) != src.get(p+3) ) {
+                    return false;
+                }
+            }
+        } else {
+            final ByteBuffer src = (ByteBuffer) indices;
+            final ByteBuffer dst = (ByteBuffer) tri;
+            for(int i=0, p=src.position(), t=0; i<quads; i++, p+=4, t+=6) {
+                if( dst.get(t) != src.get(p) || dst.get(t+1) != src.get(p+1) || dst.get(t+2) != src.get(p+2) || dst.get(t+5) != src.get(p+3) ) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    protected void padding(int type, int fill) {
+        if ( sealed ) return;
+
+        final Buffer dest = getArray(type);
 
         if ( null==dest ) return;
 
@@ -957,7 +1111,14 @@ public class ImmModeSink {
     protected int glBufferUsage, initialElementCount;
 
     protected ByteBuffer buffer;
-    protected int bSize, count, vboName;
+    /** <code>count</code> is the capacity in elements, <code>elements</code> the number of vertices written, valid once sealed. */
+    protected int bSize, count, elements, vboName;
+
+    protected Buffer quadIndices;
+    protected int quadIndicesType, quadIndicesCount;
+    /** Cached triangulation of user given quad indices, see {@link #getTriangulatedQuadIndices(Buffer)} */
+    protected Buffer triIndices, triIndicesSrc;
+    protected int triIndicesSrcPos, triIndicesSrcLimit;
 
     public static final int VERTEX = 0;
     public static final int COLOR = 1;
@@ -37,8 +37,6 @@ package com.jogamp.opengl.util;
 import java.nio.Buffer;
 import java.nio.FloatBuffer;
 import java.nio.IntBuffer;
-import java.util.ArrayList;
-import java.util.List;
 
 import javax.media.opengl.GL;
 import javax.media.opengl.GLException;
@@ -111,19 +109,15 @@ public class PMVMatrix implements GLMatrixFunc {
           
           vec3f         = new float[3];
           matrixMult    = new float[16];
-          matrixTrans   = new float[16];
-          matrixRot     = new float[16];
-          matrixScale   = new float[16];
           matrixOrtho   = new float[16];
           matrixFrustum = new float[16];
-          FloatUtil.makeIdentityf(matrixTrans, 0);
-          FloatUtil.makeIdentityf(matrixRot, 0);
-          FloatUtil.makeIdentityf(matrixScale, 0);
           FloatUtil.makeIdentityf(matrixOrtho, 0);
           FloatUtil.makeZero(matrixFrustum, 0);
 
-          matrixPStack = new ArrayList<float[]>();
-          matrixMvStack= new ArrayList<float[]>();
+          // initial depths as guaranteed by GL, grown on demand
+          matrixTStack = new MatrixStack(2);
+          matrixPStack = new MatrixStack(2);
+          matrixMvStack= new MatrixStack(32);
 
           // default values and mode
           glMatrixMode(GL_PROJECTION);
@@ -149,24 +143,12 @@ public class PMVMatrix implements GLMatrixFunc {
 
         vec3f         = null;
         matrixMult    = null;
-        matrixTrans   = null;
-        matrixRot     = null;
-        matrixScale   = null;
         matrixOrtho   = null;
         matrixFrustum = null;
         
-        if(null!=matrixPStack) {
-            matrixPStack.clear(); matrixPStack=null;
-        }
-        if(null!=matrixMvStack) {
-            matrixMvStack.clear(); matrixMvStack=null;
-        }
-        if(null!=matrixPStack) {
-            matrixPStack.clear(); matrixPStack=null;
-        }
-        if(null!=matrixTStack) {
-            matrixTStack.clear(); matrixTStack=null;
-        }
+        matrixTStack = null;
+        matrixPStack = null;
+        matrixMvStack= null;
     }
 
 
@@ -386,6 +368,7 @@ public class PMVMatrix implements GLMatrixFunc {
         if(matrixMode==GL_MODELVIEW) {
             matrixMv.put(values, offset, len);
             matrixMv.reset();
+            matrixMvType = FloatUtil.isAffineMatrixf(values, offset) ? MV_AFFINE : MV_GENERAL;
             modified |= DIRTY_MODELVIEW ;
         } else if(matrixMode==GL_PROJECTION) {
             matrixP.put(values, offset, len);
@@ -401,6 +384,7 @@ public class PMVMatrix implements GLMatrixFunc {
     public final void glLoadMatrixf(java.nio.FloatBuffer m) {
         int spos = m.position();
         if(matrixMode==GL_MODELVIEW) {
+            matrixMvType = FloatUtil.isAffineMatrixf(m) ? MV_AFFINE : MV_GENERAL;
             matrixMv.put(m);
             matrixMv.reset();
             modified |= DIRTY_MODELVIEW ;
@@ -417,31 +401,38 @@ public class PMVMatrix implements GLMatrixFunc {
     }
 
     public final void glPopMatrix() {
-        float[] stackEntry=null;
         if(matrixMode==GL_MODELVIEW) {
-            stackEntry = matrixMvStack.remove(0);
+            matrixMvType = matrixMvStack.pop(matrixMv);
+            modified |= DIRTY_MODELVIEW ;
         } else if(matrixMode==GL_PROJECTION) {
-            stackEntry = matrixPStack.remove(0);
+            matrixPStack.pop(matrixP);
+            modified |= DIRTY_PROJECTION ;
         } else if(matrixMode==GL.GL_TEXTURE) {
-            stackEntry = matrixTStack.remove(0);
+            matrixTStack.pop(matrixTex);
+            modified |= DIRTY_TEXTURE ;
         } 
-        glLoadMatrixf(stackEntry, 0);
     }
 
     public final void glPushMatrix() {
-        float[] stackEntry = new float[1*16];
         if(matrixMode==GL_MODELVIEW) {
-            matrixMv.get(stackEntry);
-            matrixMv.reset();
-            matrixMvStack.add(0, stackEntry);
+            matrixMvStack.push(matrixMv, matrixMvType);
         } else if(matrixMode==GL_PROJECTION) {
-            matrixP.get(stackEntry);
-            matrixP.reset();
-            matrixPStack.add(0, stackEntry);
+            matrixPStack.push(matrixP, 0);
         } else if(matrixMode==GL.GL_TEXTURE) {
-            matrixTex.get(stackEntry);
-            matrixTex.reset();
-            matrixTStack.add(0, stackEntry);
+            matrixTStack.push(matrixTex, 0);
+        }
+    }
+
+    /** @return the number of matrices pushed on the stack of the given matrix mode, see {@link #glPushMatrix()} */
+    public final int getStackDepth(final int matrixName) {
+        if(matrixName==GL_MODELVIEW) {
+            return matrixMvStack.depth();
+        } else if(matrixName==GL_PROJECTION) {
+            return matrixPStack.depth();
+        } else if(matrixName==GL.GL_TEXTURE) {
+            return matrixTStack.depth();
+        } else {
+            throw new GLException("unsupported matrixName: "+matrixName);
         }
     }
 
@@ -449,6 +440,7 @@ public class PMVMatrix implements GLMatrixFunc {
         if(matrixMode==GL_MODELVIEW) {
             matrixMv.put(matrixIdent);
             matrixMv.reset();
+            matrixMvType = MV_RIGID;
             modified |= DIRTY_MODELVIEW ;
         } else if(matrixMode==GL_PROJECTION) {
             matrixP.put(matrixIdent);
@@ -465,6 +457,11 @@ public class PMVMatrix implements GLMatrixFunc {
     public final void glMultMatrixf(final FloatBuffer m) {
         if(matrixMode==GL_MODELVIEW) {
             FloatUtil.multMatrixf(matrixMv, m, matrixMv);
+            if( !FloatUtil.isAffineMatrixf(m) ) {
+                matrixMvType = MV_GENERAL;
+            } else if( MV_RIGID == matrixMvType ) {
+                matrixMvType = MV_AFFINE;
+            }
             modified |= DIRTY_MODELVIEW ;
         } else if(matrixMode==GL_PROJECTION) {
             FloatUtil.multMatrixf(matrixP, m, matrixP);
@@ -478,6 +475,11 @@ public class PMVMatrix implements GLMatrixFunc {
     public void glMultMatrixf(float[] m, int m_offset) {
         if(matrixMode==GL_MODELVIEW) {
             FloatUtil.multMatrixf(matrixMv, m, m_offset, matrixMv);
+            if( !FloatUtil.isAffineMatrixf(m, m_offset) ) {
+                matrixMvType = MV_GENERAL;
+            } else if( MV_RIGID == matrixMvType ) {
+                matrixMvType = MV_AFFINE;
+            }
             modified |= DIRTY_MODELVIEW ;
         } else if(matrixMode==GL_PROJECTION) {
             FloatUtil.multMatrixf(matrixP, m, m_offset, matrixP);
@@ -494,10 +496,14 @@ public class PMVMatrix implements GLMatrixFunc {
         //  0 1 0 y
         //  0 0 1 z
         //  0 0 0 1
-        matrixTrans[0+4*3] = x;
-        matrixTrans[1+4*3] = y;
-        matrixTrans[2+4*3] = z;
-        glMultMatrixf(matrixTrans, 0);
+        // M * T only changes the 4th column: c3 += c0*x + c1*y + c2*z
+        final FloatBuffer m = getModifiedMatrixf();
+        final float[] a = getMatrixArrayf(m);
+        final int o = getMatrixArrayOffset(m);
+        for(int i=0; i<4; i++) {
+            a[o+i+3*4] += a[o+i+0*4]*x + a[o+i+1*4]*y + a[o+i+2*4]*z;
+        }
+        putMatrixArrayf(m, a);
     }
 
     public final void glRotatef(final float angdeg, float x, float y, float z) {
@@ -521,19 +527,21 @@ public class PMVMatrix implements GLMatrixFunc {
         final float ys = y*s;
         final float yz = y*z;
         final float zs = z*s;
-        matrixRot[0*4+0] = x*x*ic+c;
-        matrixRot[0*4+1] = xy*ic+zs;
-        matrixRot[0*4+2] = xz*ic-ys;
-
-        matrixRot[1*4+0] = xy*ic-zs;
-        matrixRot[1*4+1] = y*y*ic+c;
-        matrixRot[1*4+2] = yz*ic+xs;
-
-        matrixRot[2*4+0] = xz*ic+ys;
-        matrixRot[2*4+1] = yz*ic-xs;
-        matrixRot[2*4+2] = z*z*ic+c;
-
-        glMultMatrixf(matrixRot, 0);
+        final float r00 = x*x*ic+c, r10 = xy*ic+zs,  r20 = xz*ic-ys; // column 0
+        final float r01 = xy*ic-zs, r11 = y*y*ic+c,  r21 = yz*ic+xs; // column 1
+        final float r02 = xz*ic+ys, r12 = yz*ic-xs,  r22 = z*z*ic+c; // column 2
+
+        // M * R only changes the first 3 columns
+        final FloatBuffer m = getModifiedMatrixf();
+        final float[] a = getMatrixArrayf(m);
+        final int o = getMatrixArrayOffset(m);
+        for(int i=0; i<4; i++) {
+            final float ai0=a[o+i+0*4], ai1=a[o+i+1*4], ai2=a[o+i+2*4]; // row-i of M
+            a[o+i+0*4] = ai0 * r00 + ai1 * r10 + ai2 * r20;
+            a[o+i+1*4] = ai0 * r01 + ai1 * r11 + ai2 * r21;
+            a[o+i+2*4] = ai0 * r02 + ai1 * r12 + ai2 * r22;
+        }
+        putMatrixArrayf(m, a);
     }
 
     public final void glScalef(final float x, final float y, final float z) {
@@ -542,11 +550,19 @@ public class PMVMatrix implements GLMatrixFunc {
         //  0 y 0 0
         //  0 0 z 0
         //  0 0 0 1
-        matrixScale[0+4*0] = x;
-        matrixScale[1+4*1] = y;
-        matrixScale[2+4*2] = z;
-
-        glMultMatrixf(matrixScale, 0);
+        // M * S only scales the first 3 columns
+        final FloatBuffer m = getModifiedMatrixf();
+        final float[] a = getMatrixArrayf(m);
+        final int o = getMatrixArrayOffset(m);
+        for(int i=0; i<4; i++) {
+            a[o+i+0*4] *= x;
+            a[o+i+1*4] *= y;
+            a[o+i+2*4] *= z;
+        }
+        putMatrixArrayf(m, a);
+        if( matrixMode==GL_MODELVIEW && MV_RIGID == matrixMvType && ( 1f != x || 1f != y || 1f != z ) ) {
+            matrixMvType = MV_AFFINE;
+        }
     }
 
     public final void glOrthof(final float left, final float right, final float bottom, final float top, final float zNear, final float zFar) {
@@ -692,6 +708,44 @@ public class PMVMatrix implements GLMatrixFunc {
     private int nioBackupArraySupported = 0; // -1 not supported, 0 - TBD, 1 - supported
     private final String msgCantComputeInverse = "Invalid source Mv matrix, can't compute inverse";
 
+    /** @return the current matrix, flagged as modified */
+    private final FloatBuffer getModifiedMatrixf() {
+        if(matrixMode==GL_MODELVIEW) {
+            modified |= DIRTY_MODELVIEW ;
+            return matrixMv;
+        } else if(matrixMode==GL_PROJECTION) {
+            modified |= DIRTY_PROJECTION ;
+            return matrixP;
+        } else {
+            modified |= DIRTY_TEXTURE ;
+            return matrixTex;
+        }
+    }
+
+    /** 
+     * @return the backing array of the given matrix, 
+     *         or {@link #matrixMult} holding a copy of it, which must be written back via {@link #putMatrixArrayf(FloatBuffer, float[])}. 
+     */
+    private final float[] getMatrixArrayf(final FloatBuffer m) {
+        if( m.hasArray() ) {
+            return m.array();
+        }
+        m.get(matrixMult, 0, 16);
+        m.reset();
+        return matrixMult;
+    }
+
+    private final int getMatrixArrayOffset(final FloatBuffer m) {
+        return m.hasArray() ? m.arrayOffset() + m.position() : 0;
+    }
+
+    private final void putMatrixArrayf(final FloatBuffer m, final float[] a) {
+        if( a == matrixMult ) {
+            m.put(matrixMult, 0, 16);
+            m.reset();
+        }
+    }
+
     private final void setMviMvit() {
         if( 0 != (usesMviMvit & 1) ) {
             if(nioBackupArraySupported>=0) {
@@ -709,7 +763,7 @@ public class PMVMatrix implements GLMatrixFunc {
     private final void setMviMvitNIOBackupArray() {
         final float[] _matrixMvi = matrixMvi.array();
         final int _matrixMviOffset = matrixMvi.position();
-        if(!projectFloat.gluInvertMatrixf(matrixMv.array(), matrixMv.position(), _matrixMvi, _matrixMviOffset)) {
+        if(!invertMvf(matrixMv.array(), matrixMv.position(), _matrixMvi, _matrixMviOffset)) {
             throw new GLException(msgCantComputeInverse);
         }
         if( 0 != (usesMviMvit & 2) ) {
@@ -725,8 +779,18 @@ public class PMVMatrix implements GLMatrixFunc {
     }
     
     private final void setMviMvitNIODirectAccess() {
-        if(!projectFloat.gluInvertMatrixf(matrixMv, matrixMvi)) {
-            throw new GLException(msgCantComputeInverse);
+        if( MV_GENERAL == matrixMvType ) {
+            if(!projectFloat.gluInvertMatrixf(matrixMv, matrixMvi)) {
+                throw new GLException(msgCantComputeInverse);
+            }
+        } else {
+            matrixMv.get(matrixMult, 0, 16);
+            matrixMv.reset();
+            if(!invertMvf(matrixMult, 0, matrixMult, 0)) {
+                throw new GLException(msgCantComputeInverse);
+            }
+            matrixMvi.put(matrixMult, 0, 16);
+            matrixMvi.reset();
         }
         if( 0 != (usesMviMvit & 2) ) {
             // transpose matrix 
@@ -738,12 +802,27 @@ public class PMVMatrix implements GLMatrixFunc {
         }        
     }
 
+    /** Inverts Mv using the cheapest method allowed by {@link #matrixMvType}. */
+    private final boolean invertMvf(final float[] src, final int srcOffset, final float[] inverse, final int inverseOffset) {
+        switch( matrixMvType ) {
+            case MV_RIGID:
+                FloatUtil.invertRigidMatrixf(src, srcOffset, inverse, inverseOffset);
+                return true;
+            case MV_AFFINE:
+                return FloatUtil.invertAffineMatrixf(src, srcOffset, inverse, inverseOffset);
+            default:
+                return projectFloat.gluInvertMatrixf(src, srcOffset, inverse, inverseOffset);
+        }
+    }
+
     protected final boolean usesBackingArray;
     protected Buffer matrixBuffer;
     protected FloatBuffer matrixIdent, matrixPMvMvit, matrixPMvMvi, matrixPMv, matrixP, matrixTex, matrixMv, matrixMvi, matrixMvit;
-    protected float[] matrixMult, matrixTrans, matrixRot, matrixScale, matrixOrtho, matrixFrustum, vec3f;
-    protected List<float[]> matrixTStack, matrixPStack, matrixMvStack;
+    protected float[] matrixMult, matrixOrtho, matrixFrustum, vec3f;
+    protected MatrixStack matrixTStack, matrixPStack, matrixMvStack;
     protected int matrixMode = GL_MODELVIEW;
+    /** Kind of transformation hold by Mv, one of {@link #MV_RIGID}, {@link #MV_AFFINE} or {@link #MV_GENERAL}. */
+    protected int matrixMvType = MV_RIGID;
     protected int modified = 0;
     protected int usesMviMvit = 0; // 0 - none, 1 - Mvi, 2 - Mvit, 3 - MviMvit (ofc no Mvit w/o Mvi!)
     protected ProjectFloat projectFloat;
@@ -751,4 +830,62 @@ public class PMVMatrix implements GLMatrixFunc {
     public static final int DIRTY_MODELVIEW  = 1 << 0;
     public static final int DIRTY_PROJECTION = 1 << 1;
     public static final int DIRTY_TEXTURE    = 1 << 2;
+
+    /** Mv is composed of rotations and translations only, hence its inverse is its transposed rotation. */
+    protected static final int MV_RIGID   = 0;
+    /** Mv is affine, i.e. its last row is <code>[0 0 0 1]</code>, hence its inverse is reduced to a 3x3 inverse. */
+    protected static final int MV_AFFINE  = 1;
+    /** Mv is a general 4x4 matrix. */
+    protected static final int MV_GENERAL = 2;
+
+    /**
+     * Contiguous stack of 4x4 matrices with a tag each.
+     * <p>
+     * Storage is doubled if exhausted, hence pushing and popping never allocates
+     * once the maximum depth in use has been reached.
+     * </p>
+     */
+    protected static final class MatrixStack {
+        private float[] matrices;
+        private int[] tags;
+        private int depth;
+
+        MatrixStack(int initialDepth) {
+            matrices = new float[initialDepth*16];
+            tags = new int[initialDepth];
+            depth = 0;
+        }
+
+        /** Copies the matrix at the marked position of <code>m</code> on top of the stack. */
+        final void push(final FloatBuffer m, final int tag) {
+            if( depth == tags.length ) {
+                final float[] _matrices = new float[2*matrices.length];
+                System.arraycopy(matrices, 0, _matrices, 0, matrices.length);
+                final int[] _tags = new int[2*tags.length];
+                System.arraycopy(tags, 0, _tags, 0, tags.length);
+                matrices = _matrices;
+                tags = _tags;
+            }
+            m.get(matrices, depth*16, 16);
+            m.reset();
+            tags[depth++] = tag;
+        }
+
+        /** 
+         * Copies the top of the stack to the marked position of <code>m</code> and removes it.
+         * @return the tag of the removed matrix
+         * @throws GLException if the stack is empty
+         */
+        final int pop(final FloatBuffer m) {
+            if( 0 == depth ) {
+                throw new GLException("GL_STACK_UNDERFLOW: matrix stack is empty");
+            }
+            depth--;
+            m.put(matrices, depth*16, 16);
+            m.reset();
+            return tags[depth];
+        }
+
+        final int depth() { return depth; }
+    }
 }
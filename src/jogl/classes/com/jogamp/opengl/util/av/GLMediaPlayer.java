@@ -95,8 +95,28 @@ public interface GLMediaPlayer extends TextureSequence {
         }
     }
     
+    /** Seek modes, see {@link GLMediaPlayer#setSeekMode(SeekMode)}. */
+    public enum SeekMode {
+        /** Lands on the nearest key frame preceding the desired position, i.e. fast but imprecise. Useful for scrubbing. */
+        Fast,
+        /** Lands on the frame displayed at the desired position, i.e. decodes all frames from the preceding key frame on. */
+        Accurate;
+    }
+    
     public int getTextureCount();
     
+    /**
+     * Sets the desired number of {@link TextureSequence.TextureFrame}s, 
+     * used as a ring of decoded frames by the implementation.
+     * <p>
+     * The implementation may adjust the given count to its capabilities,
+     * query the used count via {@link #getTextureCount()}. 
+     * </p>
+     * @throws IllegalStateException if not invoked in state Uninitialized, 
+     *         i.e. before {@link #initGLStream(GL, URLConnection)}
+     */
+    public void setTextureCount(int textureCount) throws IllegalStateException;
+    
     /** Defaults to 0 */
     public void setTextureUnit(int u);
     /** Sets the texture min-mag filter, defaults to {@link GL#GL_NEAREST}. */
@@ -159,12 +179,29 @@ public interface GLMediaPlayer extends TextureSequence {
 
     /**
      * Allowed in state Stopped, Playing and Paused, otherwise ignored.
+     * <p>
+     * The resulting position depends on the {@link #setSeekMode(SeekMode) seek mode}.
+     * If not {@link State#Playing}, the frame at the resulting position is 
+     * returned by the next {@link #getNextTexture(GL, boolean)} call.
+     * </p>
      * 
      * @param msec absolute desired time position in milliseconds 
-     * @return time current position in milliseconds, after seeking to the desired position  
+     * @return time current position in milliseconds, after seeking to the desired position,
+     *         or the {@link #getDuration() duration} if the end of stream has been reached w/o a frame at the desired position.
      **/
     public int seek(int msec);
 
+    /**
+     * Sets the mode used by {@link #seek(int)}, defaults to {@link SeekMode#Accurate}.
+     * <p>
+     * <i>Warning:</i> Optional, implementations may always use their native seek behavior.
+     * </p>
+     */
+    public void setSeekMode(SeekMode mode);
+
+    /** @return the mode used by {@link #seek(int)}, see {@link #setSeekMode(SeekMode)}. */
+    public SeekMode getSeekMode();
+
     /**
      * {@inheritDoc}
      */
@@ -175,7 +212,8 @@ public interface GLMediaPlayer extends TextureSequence {
      * {@inheritDoc}
      * 
      * <p>
-     * In case the current state is not {@link State#Playing}, {@link #getLastTexture()} is returned.
+     * In case the current state is not {@link State#Playing}, {@link #getLastTexture()} is returned,
+     * unless the frame at the position of a preceding {@link #seek(int)} is pending and available.
      * </p>
      * 
      * @see #addEventListener(GLMediaEventListener)
@@ -233,6 +271,35 @@ public interface GLMediaPlayer extends TextureSequence {
      */
     public float getFramerate();
 
+    /**
+     * <i>Warning:</i> Optional information, may not be supported by implementation.
+     * @return the number of decoded video frames currently queued ahead of presentation,
+     *         i.e. the depth of the decoder's frame queue. Zero if not supported.
+     */
+    public int getQueuedFrameCount();
+
+    /**
+     * <i>Warning:</i> Optional information, may not be supported by implementation.
+     * @return the number of decoded video frames dropped since {@link #initGLStream(GL, URLConnection)},
+     *         because they were not presented in time.
+     */
+    public int getDroppedFrameCount();
+
+    /**
+     * <i>Warning:</i> Optional information, may not be supported by implementation.
+     * @return the number of {@link #getNextTexture(GL, boolean)} calls since {@link #initGLStream(GL, URLConnection)}
+     *         while {@link State#Playing}, which found no decoded frame available and hence returned the last frame.
+     */
+    public int getUnderrunCount();
+
+    /**
+     * <i>Warning:</i> Optional information, may not be supported by implementation.
+     * @return the measured audio/video synchronization offset in milliseconds, 
+     *         i.e. the PTS of the last presented video frame minus the PTS of the audio being played at that time.
+     *         A positive value denotes video ahead of audio. Zero if there is no audio or if not supported.
+     */
+    public int getAVSyncOffset();
+
     public int getWidth();
 
     public int getHeight();
@@ -57,6 +57,16 @@ public class ShaderProgram {
      */
     public int        id() { return id; }
 
+    /**
+     * Returns the number of link operations performed on this program,
+     * via {@link #link(GL2ES2, PrintStream)} or {@link #replaceShader(GL2ES2, ShaderCode, ShaderCode, PrintStream)}.
+     * <p>
+     * Allows detecting a relink, which invalidates all queried uniform and attribute locations
+     * as well as all uniform values.
+     * </p>
+     */
+    public int linkCount() { return linkCount; }
+
     /**
      * Detaches all shader codes and deletes the program.
      * Destroys the shader codes as well.
@@ -213,6 +223,7 @@ public class ShaderProgram {
         }
         
         gl.glLinkProgram(shaderProgram);
+        linkCount++;
         
         programLinked = ShaderUtil.isProgramLinkStatusValid(gl, shaderProgram, System.err);
         if ( programLinked && shaderWasInUse )  {
@@ -249,6 +260,7 @@ public class ShaderProgram {
 
         // Link the program
         gl.glLinkProgram(shaderProgram);
+        linkCount++;
 
         programLinked = ShaderUtil.isProgramLinkStatusValid(gl, shaderProgram, System.err);
 
@@ -305,6 +317,7 @@ public class ShaderProgram {
     protected HashSet<ShaderCode> allShaderCode = new HashSet<ShaderCode>();
     protected HashSet<ShaderCode> attachedShaderCode = new HashSet<ShaderCode>();
     protected int id = -1;
+    protected int linkCount = 0;
 
     private static synchronized int getNextID() {
         return nextID++;
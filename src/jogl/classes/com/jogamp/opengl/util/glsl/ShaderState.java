@@ -28,12 +28,15 @@
 
 package com.jogamp.opengl.util.glsl;
 
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
 import java.util.ArrayList;
 import java.util.HashMap;
 import java.util.Iterator;
 
 import javax.media.opengl.GL;
 import javax.media.opengl.GL2ES2;
+import javax.media.opengl.GL2GL3;
 import javax.media.opengl.GLArrayData;
 import javax.media.opengl.GLContext;
 import javax.media.opengl.GLException;
@@ -47,7 +50,9 @@ import com.jogamp.opengl.util.GLArrayDataEditable;
 
 public class ShaderState {
     public static final boolean DEBUG = Debug.isPropertyDefined("jogl.debug.GLSLState", true);
+    private static final boolean UNIFORM_DIRTY_TRACKING = Debug.isPropertyDefined("jogl.glsl.uniformcache", true);
     private static final String currentStateKey = "jogamp.opengl.glsl.ShaderState" ;
+    private static final int INVALID_INDEX = 0xFFFFFFFF; // GL_INVALID_INDEX
     
     public ShaderState() {
     }
@@ -56,6 +61,30 @@ public class ShaderState {
 
     public void setVerbose(boolean v) { verbose=v; }
 
+    /**
+     * Enables or disables uniform dirty tracking, disabled by default.
+     * <p>
+     * If enabled, {@link #uniform(GL2ES2, GLUniformData)} and {@link #uniform(GL2ES2, int, GLUniformData)}
+     * compare the uniform's value with the one last passed to the current program
+     * and skip the transfer if unchanged. In place modifications of the uniform's buffer,
+     * e.g. of a {@link com.jogamp.opengl.util.PMVMatrix}'s matrices, are recognized.
+     * </p>
+     * <p>
+     * Uniform values set by other means than this ShaderState, e.g. directly via {@link GL2ES2#glUniform(GLUniformData)},
+     * are not recognized. Calling this method invalidates all tracked values.
+     * </p>
+     * <p>
+     * Dirty tracking can be enabled by default via the property <code>jogl.glsl.uniformcache</code>.
+     * </p>
+     */
+    public synchronized void setUniformDirtyTracking(boolean v) {
+        uniformDirtyTracking = v;
+        invalidateUniformLocations();
+    }
+
+    /** @see #setUniformDirtyTracking(boolean) */
+    public boolean getUniformDirtyTracking() { return uniformDirtyTracking; }
+
     /**
      * Fetches the current shader state from this thread (TLS) current GLContext
      *
@@ -235,6 +264,11 @@ public class ShaderState {
         // register new one
         shaderProgram = prog;
 
+        // locations and uniform values belong to the program
+        invalidateAttribLocations();
+        invalidateUniformLocations();
+        programLinkCount = (null!=shaderProgram) ? shaderProgram.linkCount() : 0;
+
         if(null!=shaderProgram) {
             // [re]set all data and use program if switching program, 
             // or  use program if program is linked
@@ -313,8 +347,32 @@ public class ShaderState {
      * @see GL2ES2#glGetAttribLocation(int, String)
      */
     public int getCachedAttribLocation(String name) {
-        Integer idx = activeAttribLocationMap.get(name);
-        return (null!=idx)?idx.intValue():-1;
+        final Integer handle = attribHandleMap.get(name);
+        if(null!=handle && null!=shaderProgram) {
+            validateLinkCount();
+            final LocationSlot slot = attribSlots.get(handle.intValue());
+            if(slot.generation == attribGeneration) {
+                return slot.location;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * Returns the handle of the named shader attribute, 
+     * allowing to query its location via {@link #getAttribLocation(GL2ES2, int)} w/o any name lookup.
+     * <p>
+     * The handle is stable for the lifetime of this ShaderState, 
+     * i.e. it stays valid across program switches and relinks, while the location is re-queried on demand.
+     * </p>
+     * <p>
+     * No GL call is issued, hence handles may be retrieved at any time, e.g. before attaching a program.
+     * </p>
+     *
+     * @see #getAttribLocation(GL2ES2, int)
+     */
+    public final int getAttribHandle(String name) {
+        return getHandle(attribHandleMap, attribSlots, name);
     }
     
     /**
@@ -385,8 +443,9 @@ public class ShaderState {
     public void bindAttribLocation(GL2ES2 gl, int location, String name) {
         if(null==shaderProgram) throw new GLException("No program is attached");
         if(shaderProgram.linked()) throw new GLException("Program is already linked");        
-        final Integer loc = new Integer(location);
-        activeAttribLocationMap.put(name, loc);
+        final LocationSlot slot = attribSlots.get(getAttribHandle(name));
+        slot.location = location;
+        slot.generation = attribGeneration;
         gl.glBindAttribLocation(shaderProgram.program(), location, name);
     }
 
@@ -429,22 +488,41 @@ public class ShaderState {
      */
     public int getAttribLocation(GL2ES2 gl, String name) {
         if(null==shaderProgram) throw new GLException("No program is attached");
-        int location = getCachedAttribLocation(name);
-        if(0>location) {
+        return getAttribLocation(gl, getAttribHandle(name));
+    }
+
+    /**
+     * Gets the location of a shader attribute by its handle, see {@link #getAttribHandle(String)}.<br>
+     * Uses either the cached value if valid for the current program,
+     * or the GLSL queried via {@link GL2ES2#glGetAttribLocation(int, String)}.<br>
+     * The location will be cached.
+     *
+     * @return -1 if there is no such attribute available, 
+     *         otherwise >= 0
+     * @throws GLException if no program is attached
+     * @throws GLException if the program is not linked and no location was cached.
+     *
+     * @see #getAttribHandle(String)
+     * @see #getAttribLocation(GL2ES2, String)
+     */
+    public int getAttribLocation(GL2ES2 gl, int handle) {
+        if(null==shaderProgram) throw new GLException("No program is attached");
+        validateLinkCount();
+        final LocationSlot slot = attribSlots.get(handle);
+        if(slot.generation != attribGeneration) {
             if(!shaderProgram.linked()) throw new GLException("Program is not linked");
-            location = gl.glGetAttribLocation(shaderProgram.program(), name);
-            if(0<=location) {
-                Integer idx = new Integer(location);
-                activeAttribLocationMap.put(name, idx);
+            slot.location = gl.glGetAttribLocation(shaderProgram.program(), slot.name);
+            slot.generation = attribGeneration;
+            if(0<=slot.location) {
                 if(DEBUG) {
-                    System.err.println("Info: glGetAttribLocation: "+name+", loc: "+location);
+                    System.err.println("Info: glGetAttribLocation: "+slot.name+", loc: "+slot.location);
                 }
             } else if(verbose) {
-                Throwable tX = new Throwable("Info: glGetAttribLocation failed, no location for: "+name+", loc: "+location);
+                Throwable tX = new Throwable("Info: glGetAttribLocation failed, no location for: "+slot.name+", loc: "+slot.location);
                 tX.printStackTrace();
             }
         }
-        return location;
+        return slot.location;
     }
 
     /**
@@ -692,7 +770,7 @@ public class ShaderState {
         }
         activeAttribDataMap.clear();
         activedAttribEnabledMap.clear();
-        activeAttribLocationMap.clear();
+        invalidateAttribLocations();
         managedAttributes.clear();        
     }
         
@@ -762,7 +840,7 @@ public class ShaderState {
      */
     private final void resetAllAttributes(GL2ES2 gl) {
         if(!shaderProgram.linked()) throw new GLException("Program is not linked");
-        activeAttribLocationMap.clear();
+        invalidateAttribLocations();
         
         for(Iterator<GLArrayData> iter = managedAttributes.iterator(); iter.hasNext(); ) {
             iter.next().setLocation(-1);
@@ -813,8 +891,33 @@ public class ShaderState {
      *         otherwise >= 0
      */
     public final int getCachedUniformLocation(String name) {
-        Integer idx = (Integer) activeUniformLocationMap.get(name);
-        return (null!=idx)?idx.intValue():-1;
+        final Integer handle = uniformHandleMap.get(name);
+        if(null!=handle && null!=shaderProgram) {
+            validateLinkCount();
+            final LocationSlot slot = uniformSlots.get(handle.intValue());
+            if(slot.generation == uniformGeneration) {
+                return slot.location;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * Returns the handle of the named shader uniform, 
+     * allowing to pass its data via {@link #uniform(GL2ES2, int, GLUniformData)} w/o any name lookup.
+     * <p>
+     * The handle is stable for the lifetime of this ShaderState, 
+     * i.e. it stays valid across program switches and relinks, while the location is re-queried on demand.
+     * </p>
+     * <p>
+     * No GL call is issued, hence handles may be retrieved at any time, e.g. at construction of a renderer.
+     * </p>
+     *
+     * @see #getUniformLocation(GL2ES2, int)
+     * @see #uniform(GL2ES2, int, GLUniformData)
+     */
+    public final int getUniformHandle(String name) {
+        return getHandle(uniformHandleMap, uniformSlots, name);
     }
 
     /**
@@ -865,18 +968,41 @@ public class ShaderState {
      */
     public final int getUniformLocation(GL2ES2 gl, String name) {
         if(!shaderProgram.inUse()) throw new GLException("Program is not in use");
-        int location = getCachedUniformLocation(name);
-        if(0>location) {
-            location = gl.glGetUniformLocation(shaderProgram.program(), name);
-            if(0<=location) {
-                Integer idx = new Integer(location);
-                activeUniformLocationMap.put(name, idx);
+        return getUniformLocation(gl, getUniformHandle(name));
+    }
+
+    /**
+     * Gets the location of a shader uniform by its handle, see {@link #getUniformHandle(String)}.<br>
+     * Uses either the cached value if valid for the current program, 
+     * or the GLSL queried via {@link GL2ES2#glGetUniformLocation(int, String)}.<br>
+     * The location will be cached.
+     * <p>
+     * The current shader program ({@link #attachShaderProgram(GL2ES2, ShaderProgram)}) 
+     * must be in use ({@link #useProgram(GL2ES2, boolean) }) !</p>
+     *
+     * @return -1 if there is no such uniform available,
+     *         otherwise >= 0
+     *
+     * @throws GLException is the program is not in use
+     *
+     * @see #getUniformHandle(String)
+     * @see #getUniformLocation(GL2ES2, String)
+     */
+    public final int getUniformLocation(GL2ES2 gl, int handle) {
+        if(!shaderProgram.inUse()) throw new GLException("Program is not in use");
+        validateLinkState(gl);
+        final LocationSlot slot = uniformSlots.get(handle);
+        if(slot.generation != uniformGeneration) {
+            slot.location = gl.glGetUniformLocation(shaderProgram.program(), slot.name);
+            slot.generation = uniformGeneration;
+            if(0<=slot.location) {
+                uniformSlotsByLocation.put(slot.location, slot);
             } else if(verbose) {
-                Throwable tX = new Throwable("Info: glUniform failed, no location for: "+name+", index: "+location);
+                Throwable tX = new Throwable("Info: glUniform failed, no location for: "+slot.name+", index: "+slot.location);
                 tX.printStackTrace();
             }
         }
-        return location;
+        return slot.location;
     }
 
     /**
@@ -929,20 +1055,74 @@ public class ShaderState {
      */
     public boolean uniform(GL2ES2 gl, GLUniformData data) {
         if(!shaderProgram.inUse()) throw new GLException("Program is not in use");
+        validateLinkState(gl);
         int location = data.getLocation();
         if(0>location) {
             location = getUniformLocation(gl, data);
         }
         if(0<=location) {
             // only pass the data, if the uniform exists in the current shader
-            if(DEBUG) {
-                System.err.println("Info: glUniform: "+data);
-            }
-            gl.glUniform(data);
+            transferUniform(gl, (LocationSlot) uniformSlotsByLocation.get(location), data);
         }
         return true;
     }
 
+    /**
+     * Set the uniform data by its handle, see {@link #getUniformHandle(String)}.
+     * <p>
+     * Same as {@link #uniform(GL2ES2, GLUniformData)}, but w/o any name lookup 
+     * and always using the location valid for the current program.
+     * </p>
+     * <p>
+     * Even if the uniform is not found in the current shader,
+     * it is stored in this state.
+     * </p>
+     *
+     * @param handle the uniform's handle as retrieved via {@link #getUniformHandle(String)}
+     * @param data the GLUniforms's name must match the handle's one,
+     *      it's index will be set with the uniforms's location.
+     *
+     * @return false, if the uniform is not found in the current shader, otherwise true
+     *
+     * @throws GLException if the program is not in use
+     *
+     * @see #getUniformHandle(String)
+     * @see #setUniformDirtyTracking(boolean)
+     */
+    public boolean uniform(GL2ES2 gl, int handle, GLUniformData data) {
+        final int location = getUniformLocation(gl, handle);
+        final LocationSlot slot = uniformSlots.get(handle);
+        if(slot.data != data) {
+            // new data object, keep it for program switches
+            slot.data = data;
+            activeUniformDataMap.put(slot.name, data);
+        }
+        data.setLocation(location);
+        if(0<=location) {
+            transferUniform(gl, slot, data);
+            return true;
+        }
+        return false;
+    }
+
+    private final void transferUniform(GL2ES2 gl, LocationSlot slot, GLUniformData data) {
+        final boolean tracked = uniformDirtyTracking && null != slot;
+        if(tracked) {
+            // always fetch the value, skip the transfer if unchanged for the current program
+            if( !slot.updateValue(data) && slot.valueGeneration == uniformGeneration ) {
+                return;
+            }
+            slot.valueGeneration = -1;
+        }
+        if(DEBUG) {
+            System.err.println("Info: glUniform: "+data);
+        }
+        gl.glUniform(data);
+        if(tracked) {
+            slot.valueGeneration = uniformGeneration;
+        }
+    }
+
     /**
      * Get the uniform data, previously set.
      *
@@ -958,8 +1138,12 @@ public class ShaderState {
      */
     public void releaseAllUniforms(GL2ES2 gl) {
         activeUniformDataMap.clear();
-        activeUniformLocationMap.clear();
         managedUniforms.clear();
+        managedUniformBlocks.clear();
+        for(int i=0; i<uniformSlots.size(); i++) {
+            uniformSlots.get(i).data = null;
+        }
+        invalidateUniformLocations();
     }
         
     /**
@@ -974,7 +1158,9 @@ public class ShaderState {
      */
     private final void resetAllUniforms(GL2ES2 gl) {
         if(!shaderProgram.inUse()) throw new GLException("Program is not in use");        
-        activeUniformLocationMap.clear();
+        programLinkCount = shaderProgram.linkCount();
+        invalidateUniformLocations();
+        bindAllUniformBlocks(gl);
         for(Iterator<GLUniformData> iter = managedUniforms.iterator(); iter.hasNext(); ) {
             iter.next().setLocation(-1);
         }        
@@ -985,6 +1171,180 @@ public class ShaderState {
         }
     }
 
+    //
+    // Uniform blocks
+    //
+
+    /**
+     * Bind the {@link UniformBlock} lifecycle to this ShaderState.
+     * <p>
+     * The block's binding point is assigned to the uniform block of the same name
+     * of the current program via {@link #uniformBlock(GL2ES2, UniformBlock)},
+     * and will be reassigned when switching or relinking the program.
+     * </p>
+     * <p>
+     * The block's buffer object is not owned, i.e. it may be shared by multiple ShaderStates
+     * and has to be {@link UniformBlock#update(GL2GL3) updated} and {@link UniformBlock#destroy(GL2GL3) destroyed} by the user.
+     * </p>
+     *
+     * @return false, if the block is not declared by the current program, otherwise true
+     *
+     * @throws GLException if the program is not linked
+     * @throws GLException if uniform blocks are not supported, i.e. the GL is not a {@link GL2GL3}
+     *
+     * @see #uniformBlock(GL2ES2, UniformBlock)
+     */
+    public boolean ownUniformBlock(GL2ES2 gl, UniformBlock block) {
+        if(!managedUniformBlocks.contains(block)) {
+            managedUniformBlocks.add(block);
+        }
+        return uniformBlock(gl, block);
+    }
+
+    public boolean ownsUniformBlock(UniformBlock block) {
+        return managedUniformBlocks.contains(block);
+    }
+
+    /**
+     * Assigns the block's binding point to the uniform block of the same name of the current program.
+     *
+     * @return false, if the block is not declared by the current program, otherwise true
+     *
+     * @throws GLException if no program is attached or the program is not linked
+     * @throws GLException if uniform blocks are not supported, i.e. the GL is not a {@link GL2GL3}
+     *
+     * @see GL2GL3#glGetUniformBlockIndex(int, String)
+     * @see GL2GL3#glUniformBlockBinding(int, int, int)
+     */
+    public boolean uniformBlock(GL2ES2 gl, UniformBlock block) {
+        if(null==shaderProgram) throw new GLException("No program is attached");
+        if(!shaderProgram.linked()) throw new GLException("Program is not linked");
+        final GL2GL3 gl23 = gl.getGL2GL3();
+        final int index = gl23.glGetUniformBlockIndex(shaderProgram.program(), block.getName());
+        if(INVALID_INDEX == index) {
+            if(verbose) {
+                Throwable tX = new Throwable("Info: glUniformBlockBinding failed, no index for: "+block.getName());
+                tX.printStackTrace();
+            }
+            return false;
+        }
+        if(DEBUG) {
+            System.err.println("Info: glUniformBlockBinding: "+block+", index: "+index);
+        }
+        gl23.glUniformBlockBinding(shaderProgram.program(), index, block.getBindingPoint());
+        return true;
+    }
+
+    private final void bindAllUniformBlocks(GL2ES2 gl) {
+        uniformBlocksUnbound = false;
+        for(int i=0; i<managedUniformBlocks.size(); i++) {
+            uniformBlock(gl, managedUniformBlocks.get(i));
+        }
+    }
+
+    //
+    // Location handle and cache
+    //
+
+    /** Location of a named attribute or uniform, valid for the current program if its generation matches. */
+    private static final class LocationSlot {
+        final String name;
+        int location = -1;
+        int generation = -1;
+
+        // uniform only: last data object passed by handle and last value transferred
+        GLUniformData data = null;
+        int valueGeneration = -1;
+        int[] value = null; // raw float bits or int values
+        boolean floatValue;
+
+        LocationSlot(String name) {
+            this.name = name;
+        }
+
+        /** Copies the given uniform's value, returns true if it differs from the previous one. */
+        final boolean updateValue(GLUniformData data) {
+            final Object o = data.getObject();
+            final int n = data.count() * data.components();
+            final boolean isFloat = o instanceof FloatBuffer || o instanceof Float;
+            boolean changed = false;
+            if( null == value || value.length != n || floatValue != isFloat ) {
+                value = new int[n];
+                floatValue = isFloat;
+                changed = true;
+            }
+            if( o instanceof FloatBuffer ) {
+                final FloatBuffer fb = (FloatBuffer)o;
+                for(int i=0, j=fb.position(); i<n; i++, j++) {
+                    final int v = Float.floatToRawIntBits(fb.get(j));
+                    if( value[i] != v ) {
+                        value[i] = v;
+                        changed = true;
+                    }
+                }
+            } else if( o instanceof IntBuffer ) {
+                final IntBuffer ib = (IntBuffer)o;
+                for(int i=0, j=ib.position(); i<n; i++, j++) {
+                    final int v = ib.get(j);
+                    if( value[i] != v ) {
+                        value[i] = v;
+                        changed = true;
+                    }
+                }
+            } else if( o instanceof Float || o instanceof Integer ) {
+                final int v = isFloat ? Float.floatToRawIntBits(((Float)o).floatValue()) : ((Integer)o).intValue();
+                if( value[0] != v ) {
+                    value[0] = v;
+                    changed = true;
+                }
+            } else {
+                changed = true;
+            }
+            return changed;
+        }
+    }
+
+    private static int getHandle(HashMap<String, Integer> handleMap, ArrayList<LocationSlot> slots, String name) {
+        final Integer handle = handleMap.get(name);
+        if(null != handle) {
+            return handle.intValue();
+        }
+        final int h = slots.size();
+        slots.add(new LocationSlot(name));
+        handleMap.put(name, new Integer(h));
+        return h;
+    }
+
+    private final void invalidateAttribLocations() {
+        attribGeneration++;
+    }
+
+    private final void invalidateUniformLocations() {
+        uniformGeneration++;
+        uniformSlotsByLocation.clear();
+        uniformBlocksUnbound = 0 < managedUniformBlocks.size();
+    }
+
+    /** Invalidates the cached locations and values if the program has been [re]linked since, e.g. via {@link ShaderProgram#replaceShader(GL2ES2, ShaderCode, ShaderCode, java.io.PrintStream)}. */
+    private final void validateLinkCount() {
+        final int linkCount = shaderProgram.linkCount();
+        if(linkCount != programLinkCount) {
+            if(0 < programLinkCount) {
+                // relinked, locations not bound explicitly may have changed
+                invalidateAttribLocations();
+            }
+            invalidateUniformLocations();
+            programLinkCount = linkCount;
+        }
+    }
+
+    private final void validateLinkState(GL2ES2 gl) {
+        validateLinkCount();
+        if(uniformBlocksUnbound) {
+            bindAllUniformBlocks(gl);
+        }
+    }
+
     public StringBuilder toString(StringBuilder sb) {
         if(null==sb) {
             sb = new StringBuilder();
@@ -1035,13 +1395,22 @@ public class ShaderState {
     private ShaderProgram shaderProgram=null;
     
     private HashMap<String, Boolean> activedAttribEnabledMap = new HashMap<String, Boolean>();
-    private HashMap<String, Integer> activeAttribLocationMap = new HashMap<String, Integer>();
+    private HashMap<String, Integer> attribHandleMap = new HashMap<String, Integer>();
+    private ArrayList<LocationSlot> attribSlots = new ArrayList<LocationSlot>();
+    private int attribGeneration = 0;
     private HashMap<String, GLArrayData> activeAttribDataMap = new HashMap<String, GLArrayData>();
     private ArrayList<GLArrayData> managedAttributes = new ArrayList<GLArrayData>();
     
-    private HashMap<String, Integer> activeUniformLocationMap = new HashMap<String, Integer>();
+    private HashMap<String, Integer> uniformHandleMap = new HashMap<String, Integer>();
+    private ArrayList<LocationSlot> uniformSlots = new ArrayList<LocationSlot>();
+    private IntObjectHashMap uniformSlotsByLocation = new IntObjectHashMap();
+    private int uniformGeneration = 0;
+    private boolean uniformDirtyTracking = UNIFORM_DIRTY_TRACKING;
     private HashMap<String, GLUniformData> activeUniformDataMap = new HashMap<String, GLUniformData>();
     private ArrayList<GLUniformData> managedUniforms = new ArrayList<GLUniformData>();
+    private ArrayList<UniformBlock> managedUniformBlocks = new ArrayList<UniformBlock>();
+    private boolean uniformBlocksUnbound = false;
+    private int programLinkCount = 0;
     
     private HashMap<String, Object> attachedObjectsByString = new HashMap<String, Object>();    
     private IntObjectHashMap attachedObjectsByInt = new IntObjectHashMap();   
@@ -0,0 +1,264 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+
+package com.jogamp.opengl.util.glsl;
+
+import java.nio.ByteBuffer;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
+import java.util.ArrayList;
+
+import javax.media.opengl.GL;
+import javax.media.opengl.GL2GL3;
+import javax.media.opengl.GLException;
+import javax.media.opengl.GLUniformData;
+
+import com.jogamp.common.nio.Buffers;
+
+/**
+ * A uniform block backed by a uniform buffer object (UBO), 
+ * laid out using the <code>std140</code> rules.
+ * <p>
+ * Allows sharing uniform data, e.g. the matrices of a {@link com.jogamp.opengl.util.PMVMatrix},
+ * between all programs declaring the block, while uploading it only once per frame:
+ * <pre>
+ *   // GLSL: layout(std140) uniform PMVBlock { mat4 mgl_PMVMatrix[2]; };
+ *   final UniformBlock pmvBlock = new UniformBlock("PMVBlock", 0);
+ *   pmvBlock.addUniform(new GLUniformData("mgl_PMVMatrix", 4, 4, pmvMatrix.glGetPMvMatrixf()));
+ *   pmvBlock.init(gl);
+ *   st.ownUniformBlock(gl, pmvBlock); // for each ShaderState
+ *   ..
+ *   // once per frame, before drawing w/ any of the programs
+ *   pmvBlock.update(gl);
+ * </pre>
+ * </p>
+ * <p>
+ * The members' current data is fetched at each {@link #update(GL2GL3)},
+ * hence in place modifications of the {@link GLUniformData}'s buffers are recognized.
+ * The buffer object is only written if the data has changed since the last update.
+ * </p>
+ * <p>
+ * Supported members are float and int scalars, vectors and arrays thereof 
+ * as well as float matrices and arrays thereof, see {@link GLUniformData}.
+ * </p>
+ * 
+ * @see ShaderState#ownUniformBlock(javax.media.opengl.GL2ES2, UniformBlock)
+ */
+public class UniformBlock {
+    private final String name;
+    private final int bindingPoint;
+    private final ArrayList<GLUniformData> members = new ArrayList<GLUniformData>();
+    private final ArrayList<int[]> layouts = new ArrayList<int[]>(); // offset, element stride, column stride
+    private int size = 0;
+    private ByteBuffer data = null;
+    private int bufferName = 0;
+    private boolean dirty = true;
+
+    /**
+     * @param name the name of the uniform block as declared in the shader
+     * @param bindingPoint the uniform buffer binding point to be used, i.e. the index for {@link GL2GL3#glBindBufferBase(int, int, int)}
+     */
+    public UniformBlock(String name, int bindingPoint) {
+        this.name = name;
+        this.bindingPoint = bindingPoint;
+    }
+
+    /**
+     * Appends the given uniform to this block, in declaration order.
+     * 
+     * @return the <code>std140</code> byte offset of the uniform within the block
+     * @throws GLException if already {@link #init(GL2GL3) initialized} or if the uniform type is not supported
+     */
+    public final int addUniform(GLUniformData uniform) throws GLException {
+        if(null != data) {
+            throw new GLException("UniformBlock already initialized: "+this);
+        }
+        final int vecComps = uniform.isMatrix() ? uniform.rows() : uniform.columns();
+        final int columns = uniform.isMatrix() ? uniform.columns() : 1;
+        final int vecSize = 4 * vecComps;
+        final int align, colStride, elemStride;
+        if( uniform.isMatrix() || 1 < uniform.count() ) {
+            // matrix columns and array elements are aligned to vec4
+            align = 16;
+            colStride = 16;
+            elemStride = 16 * columns;
+        } else {
+            align = ( 1 == vecComps ) ? 4 : ( 2 == vecComps ? 8 : 16 );
+            colStride = vecSize;
+            elemStride = vecSize;
+        }
+        if( uniform.isMatrix() && !(uniform.getObject() instanceof FloatBuffer) ) {
+            throw new GLException("Only float matrices supported: "+uniform);
+        }
+        final int offset = ( size + align - 1 ) & ~( align - 1 );
+        members.add(uniform);
+        layouts.add(new int[] { offset, elemStride, colStride });
+        size = ( 1 < uniform.count() || uniform.isMatrix() ) ? offset + elemStride * uniform.count() : offset + vecSize;
+        return offset;
+    }
+
+    public final String getName() { return name; }
+
+    public final int getBindingPoint() { return bindingPoint; }
+
+    /** @return the <code>std140</code> size of this block in bytes, a multiple of 16 */
+    public final int getSize() { return ( size + 15 ) & ~15; }
+
+    /** @return the <code>std140</code> byte offset of the given member, or -1 if not a member */
+    public final int getOffset(GLUniformData uniform) {
+        final int i = members.indexOf(uniform);
+        return 0 <= i ? layouts.get(i)[0] : -1;
+    }
+
+    /** @return the uniform buffer object name, 0 if not {@link #init(GL2GL3) initialized} */
+    public final int getBufferName() { return bufferName; }
+
+    /**
+     * Creates the uniform buffer object, uploads the current data of all members
+     * and binds it to this block's binding point.
+     * 
+     * @throws GLException if already initialized or no members were added
+     */
+    public final void init(GL2GL3 gl) throws GLException {
+        if(null != data) {
+            throw new GLException("UniformBlock already initialized: "+this);
+        }
+        if(0 == members.size()) {
+            throw new GLException("UniformBlock has no members: "+this);
+        }
+        data = Buffers.newDirectByteBuffer(getSize());
+        final int[] tmp = new int[1];
+        gl.glGenBuffers(1, tmp, 0);
+        bufferName = tmp[0];
+        fetchData();
+        gl.glBindBuffer(GL2GL3.GL_UNIFORM_BUFFER, bufferName);
+        gl.glBufferData(GL2GL3.GL_UNIFORM_BUFFER, data.capacity(), data, GL.GL_DYNAMIC_DRAW);
+        gl.glBindBuffer(GL2GL3.GL_UNIFORM_BUFFER, 0);
+        gl.glBindBufferBase(GL2GL3.GL_UNIFORM_BUFFER, bindingPoint, bufferName);
+        dirty = false;
+    }
+
+    /**
+     * Uploads the members' data if changed since the last upload 
+     * and binds the buffer object to this block's binding point.
+     * <p>
+     * Shall be called once per frame before rendering with any program using this block.
+     * </p>
+     * @return true if the data has been uploaded, otherwise false
+     * @throws GLException if not initialized
+     */
+    public final boolean update(GL2GL3 gl) throws GLException {
+        if(null == data) {
+            throw new GLException("UniformBlock not initialized: "+this);
+        }
+        final boolean upload = fetchData() || dirty;
+        if( upload ) {
+            gl.glBindBuffer(GL2GL3.GL_UNIFORM_BUFFER, bufferName);
+            gl.glBufferSubData(GL2GL3.GL_UNIFORM_BUFFER, 0, data.capacity(), data);
+            gl.glBindBuffer(GL2GL3.GL_UNIFORM_BUFFER, 0);
+            dirty = false;
+        }
+        gl.glBindBufferBase(GL2GL3.GL_UNIFORM_BUFFER, bindingPoint, bufferName);
+        return upload;
+    }
+
+    /** Marks the data for upload at the next {@link #update(GL2GL3)}, regardless of changes. */
+    public final void markDirty() {
+        dirty = true;
+    }
+
+    /** Deletes the uniform buffer object, the members are kept and the block may be {@link #init(GL2GL3) initialized} again. */
+    public final void destroy(GL2GL3 gl) {
+        if(0 != bufferName) {
+            gl.glDeleteBuffers(1, new int[] { bufferName }, 0);
+            bufferName = 0;
+        }
+        data = null;
+        dirty = true;
+    }
+
+    /** Copies the members' data into the std140 staging buffer, returns true if any value has changed. */
+    private final boolean fetchData() {
+        boolean changed = false;
+        for(int i=0; i<members.size(); i++) {
+            final GLUniformData u = members.get(i);
+            final int[] l = layouts.get(i);
+            final Object o = u.getObject();
+            final int vecComps = u.isMatrix() ? u.rows() : u.columns();
+            final int columns = u.isMatrix() ? u.columns() : 1;
+            if( o instanceof FloatBuffer ) {
+                final FloatBuffer fb = (FloatBuffer)o;
+                int src = fb.position();
+                for(int e=0; e<u.count(); e++) {
+                    for(int c=0; c<columns; c++) {
+                        int dst = l[0] + e*l[1] + c*l[2];
+                        for(int k=0; k<vecComps; k++, dst+=4) {
+                            final int v = Float.floatToRawIntBits(fb.get(src++));
+                            if( data.getInt(dst) != v ) {
+                                data.putInt(dst, v);
+                                changed = true;
+                            }
+                        }
+                    }
+                }
+            } else if( o instanceof IntBuffer ) {
+                final IntBuffer ib = (IntBuffer)o;
+                int src = ib.position();
+                for(int e=0; e<u.count(); e++) {
+                    int dst = l[0] + e*l[1];
+                    for(int k=0; k<vecComps; k++, dst+=4) {
+                        final int v = ib.get(src++);
+                        if( data.getInt(dst) != v ) {
+                            data.putInt(dst, v);
+                            changed = true;
+                        }
+                    }
+                }
+            } else if( o instanceof Float ) {
+                final int v = Float.floatToRawIntBits(((Float)o).floatValue());
+                if( data.getInt(l[0]) != v ) {
+                    data.putInt(l[0], v);
+                    changed = true;
+                }
+            } else if( o instanceof Integer ) {
+                final int v = ((Integer)o).intValue();
+                if( data.getInt(l[0]) != v ) {
+                    data.putInt(l[0], v);
+                    changed = true;
+                }
+            } else {
+                throw new GLException("Unsupported uniform data: "+u);
+            }
+        }
+        return changed;
+    }
+
+    public String toString() {
+        return "UniformBlock["+name+", binding "+bindingPoint+", members "+members.size()+", size "+getSize()+", buffer "+bufferName+"]";
+    }
+}
@@ -176,6 +176,7 @@ public class Texture {
     // For testing alternate code paths on more capable hardware
     private static final boolean disableNPOT    = Debug.isPropertyDefined("jogl.texture.nonpot", true);
     private static final boolean disableTexRect = Debug.isPropertyDefined("jogl.texture.notexrect", true);
+    private static final boolean forceSoftwareDecompression = Debug.isPropertyDefined("jogl.texture.softdxt", true);
 
     public Texture(GL gl, TextureData data) throws GLException {
         texID = 0;
@@ -433,12 +434,20 @@ public class Texture {
      * Updates the content area of the specified target of this texture
      * using the data in the given image. In general this is intended
      * for construction of cube maps.
+     * <p>
+     * S3TC and RGTC compressed data is decoded in software and uploaded as RGBA8,
+     * if the graphics card lacks the required compression extension.
+     * </p>
      * 
      * @throws GLException if any OpenGL-related errors occurred
      */
     public void updateImage(GL gl, TextureData data, int targetOverride) throws GLException {
         validateTexID(gl, true);
 
+        if (needsSoftwareDecompression(gl, data)) {
+            data = decompress(gl, data, -1);
+        }
+
         imgWidth = data.getWidth();
         imgHeight = data.getHeight();
         aspectRatio = (float) imgWidth / (float) imgHeight;
@@ -929,6 +938,10 @@ public class Texture {
         data.setHaveEXTABGR(gl.isExtensionAvailable(GLExtensions.EXT_abgr));
         data.setHaveGL12(gl.isExtensionAvailable(GLExtensions.VERSION_1_2));
 
+        if (needsSoftwareDecompression(gl, data)) {
+            data = decompress(gl, data, mipmapLevel);
+        }
+
         Buffer buffer = data.getBuffer();
         if (buffer == null && data.getMipmapData() == null) {
             // Assume user just wanted to get the Texture object allocated
@@ -1058,6 +1071,99 @@ public class Texture {
         }
     }
 
+    /**
+     * @return true if <code>data</code> is compressed in a format the graphics card does not support,
+     *         but {@link DXTDecompressor} is able to decode
+     */
+    private static boolean needsSoftwareDecompression(GL gl, TextureData data) {
+        if (!data.isDataCompressed() || !DXTDecompressor.isSupported(data.getInternalFormat())) {
+            return false;
+        }
+        if (forceSoftwareDecompression) {
+            return true;
+        }
+        switch (data.getInternalFormat()) {
+        case KTXImage.GL_COMPRESSED_RED_RGTC1:
+        case KTXImage.GL_COMPRESSED_SIGNED_RED_RGTC1:
+        case KTXImage.GL_COMPRESSED_RG_RGTC2:
+        case KTXImage.GL_COMPRESSED_SIGNED_RG_RGTC2:
+            return !gl.isGL3() &&
+                   !gl.isExtensionAvailable(GLExtensions.ARB_texture_compression_rgtc) &&
+                   !gl.isExtensionAvailable(GLExtensions.EXT_texture_compression_rgtc);
+        default:
+            return !gl.isExtensionAvailable(GLExtensions.EXT_texture_compression_s3tc) &&
+                   !gl.isExtensionAvailable(GLExtensions.NV_texture_compression_vtc);
+        }
+    }
+
+    /**
+     * Decodes the compressed <code>data</code> into the 
+     * {@link DXTDecompressor#getScratchBuffer(int) scratch buffer} of the current thread.
+     * 
+     * @param level the only mipmap level of mipmapped <code>data</code> to decode, the others are left <code>null</code>,
+     *              or -1 to decode all levels
+     * @return uncompressed RGBA8 texture data, only valid until the next decompression on this thread
+     */
+    private static TextureData decompress(GL gl, TextureData data, int level) throws GLException {
+        final int format = data.getInternalFormat();
+        final Buffer[] mipmapData = data.getMipmapData();
+        final int levels = null != mipmapData ? mipmapData.length : 1;
+        if (null == mipmapData) {
+            level = -1; // single level, regardless of the target level
+        }
+        int size = 0;
+        for (int i = 0, w = data.getWidth(), h = data.getHeight(); i < levels; i++) {
+            if (0 > level || i == level) {
+                size += w * h * 4;
+            }
+            w = Math.max(w / 2, 1);
+            h = Math.max(h / 2, 1);
+        }
+        if (DEBUG) {
+            System.err.println("Decompressing texture 0x" + Integer.toHexString(format) + " " +
+                               data.getWidth() + "x" + data.getHeight() + ", " + 
+                               ( 0 > level ? levels + " level(s)" : "level " + level ) + " in software");
+        }
+        final ByteBuffer dst = DXTDecompressor.getScratchBuffer(size);
+        final ByteBuffer[] decoded = new ByteBuffer[levels];
+        int offset = 0;
+        for (int i = 0, w = data.getWidth(), h = data.getHeight(); i < levels; i++) {
+            if (0 <= level && i != level) {
+                w = Math.max(w / 2, 1);
+                h = Math.max(h / 2, 1);
+                continue;
+            }
+            final Buffer src = null != mipmapData ? mipmapData[i] : data.getBuffer();
+            if (!(src instanceof ByteBuffer)) {
+                throw new GLException("Compressed texture data must be a ByteBuffer: " + src);
+            }
+            dst.limit(offset + w * h * 4);
+            dst.position(offset);
+            decoded[i] = dst.slice();
+            try {
+                DXTDecompressor.decompress(format, w, h, (ByteBuffer) src, decoded[i]);
+            } catch (IllegalArgumentException iae) {
+                throw new GLException(iae);
+            }
+            offset += w * h * 4;
+            w = Math.max(w / 2, 1);
+            h = Math.max(h / 2, 1);
+        }
+        // GLES requires internalFormat == pixelFormat
+        final int internalFormat = gl.isGL2GL3() ? GL.GL_RGBA8 : GL.GL_RGBA;
+        final TextureData res;
+        if (null != mipmapData) {
+            res = new TextureData(data.getGLProfile(), internalFormat, data.getWidth(), data.getHeight(), data.getBorder(),
+                                  GL.GL_RGBA, GL.GL_UNSIGNED_BYTE, false, data.getMustFlipVertically(), decoded, null);
+        } else {
+            res = new TextureData(data.getGLProfile(), internalFormat, data.getWidth(), data.getHeight(), data.getBorder(),
+                                  GL.GL_RGBA, GL.GL_UNSIGNED_BYTE, data.getMipmap(), false, data.getMustFlipVertically(), 
+                                  decoded[0], null);
+        }
+        res.setAlignment(4);
+        return res;
+    }
+
     private boolean validateTexID(GL gl, boolean throwException) {
         if( 0 == texID ) {
             if( null != gl ) {
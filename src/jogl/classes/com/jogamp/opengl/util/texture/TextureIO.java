@@ -61,8 +61,10 @@ import javax.media.opengl.GLProfile;
 
 import jogamp.opengl.Debug;
 
+import com.jogamp.common.nio.Buffers;
 import com.jogamp.common.util.IOUtil;
 import com.jogamp.opengl.util.texture.spi.DDSImage;
+import com.jogamp.opengl.util.texture.spi.KTXImage;
 import com.jogamp.opengl.util.texture.spi.NetPbmTextureWriter;
 import com.jogamp.opengl.util.texture.spi.PNGImage;
 import com.jogamp.opengl.util.texture.spi.SGIImage;
@@ -95,7 +97,9 @@ import com.jogamp.opengl.util.texture.spi.TextureWriter;
     the time of this writing. One handles SGI RGB (".sgi", ".rgb")
     images from both files and streams. One handles DirectDraw Surface
     (".dds") images read from files, though can not read these images
-    from streams. One handles Targa (".tga") images read from both
+    from streams. One handles Khronos texture (".ktx", ".ktx2") files,
+    memory mapping them and passing each mipmap level to the GL w/o copying it.
+    One handles Targa (".tga") images read from both
     files and streams. These providers are executed in an arbitrary
     order. Some of these providers require the file's suffix to either
     be specified via the newTextureData methods or for the file to be
@@ -127,6 +131,14 @@ public class TextureIO {
         DirectDraw Surface file. */
     public static final String DDS     = "dds";
 
+    /** Constant which can be used as a file suffix to indicate a
+        Khronos texture file, KTX version 1. */
+    public static final String KTX     = "ktx";
+
+    /** Constant which can be used as a file suffix to indicate a
+        Khronos texture file, KTX version 2. */
+    public static final String KTX2    = "ktx2";
+
     /** Constant which can be used as a file suffix to indicate an SGI
         RGB file. */
     public static final String SGI     = "sgi";
@@ -785,6 +797,7 @@ public class TextureIO {
 
         // Other special-case providers
         addTextureProvider(new DDSTextureProvider());
+        addTextureProvider(new KTXTextureProvider());
         addTextureProvider(new SGITextureProvider());
         addTextureProvider(new TGATextureProvider());
         addTextureProvider(new PNGTextureProvider());
@@ -971,6 +984,23 @@ public class TextureIO {
                 case DDSImage.D3DFMT_DXT5:
                     internalFormat = GL.GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
                     break;
+                case DDSImage.D3DFMT_ATI1:
+                case DDSImage.D3DFMT_BC4U:
+                    internalFormat = KTXImage.GL_COMPRESSED_RED_RGTC1;
+                    break;
+                case DDSImage.D3DFMT_BC4S:
+                    internalFormat = KTXImage.GL_COMPRESSED_SIGNED_RED_RGTC1;
+                    break;
+                case DDSImage.D3DFMT_ATI2:
+                case DDSImage.D3DFMT_BC5U:
+                    internalFormat = KTXImage.GL_COMPRESSED_RG_RGTC2;
+                    break;
+                case DDSImage.D3DFMT_BC5S:
+                    internalFormat = KTXImage.GL_COMPRESSED_SIGNED_RG_RGTC2;
+                    break;
+                case DDSImage.D3DFMT_DX10:
+                    internalFormat = getDX10InternalFormat(image.getDXGIFormat());
+                    break;
                 default:
                     throw new RuntimeException("Unsupported DDS compression format \"" +
                                                DDSImage.getCompressionFormatName(info.getCompressionFormat()) + "\"");
@@ -1025,6 +1055,133 @@ public class TextureIO {
             }
             return data;
         }
+
+        private int getDX10InternalFormat(int dxgiFormat) {
+            switch (dxgiFormat) {
+            case DDSImage.DXGI_FORMAT_BC1_UNORM:      return GL.GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+            case DDSImage.DXGI_FORMAT_BC1_UNORM_SRGB: return KTXImage.GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+            case DDSImage.DXGI_FORMAT_BC2_UNORM:      return GL.GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+            case DDSImage.DXGI_FORMAT_BC2_UNORM_SRGB: return KTXImage.GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+            case DDSImage.DXGI_FORMAT_BC3_UNORM:      return GL.GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case DDSImage.DXGI_FORMAT_BC3_UNORM_SRGB: return KTXImage.GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+            case DDSImage.DXGI_FORMAT_BC4_UNORM:      return KTXImage.GL_COMPRESSED_RED_RGTC1;
+            case DDSImage.DXGI_FORMAT_BC4_SNORM:      return KTXImage.GL_COMPRESSED_SIGNED_RED_RGTC1;
+            case DDSImage.DXGI_FORMAT_BC5_UNORM:      return KTXImage.GL_COMPRESSED_RG_RGTC2;
+            case DDSImage.DXGI_FORMAT_BC5_SNORM:      return KTXImage.GL_COMPRESSED_SIGNED_RG_RGTC2;
+            case DDSImage.DXGI_FORMAT_BC6H_UF16:      return KTXImage.GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+            case DDSImage.DXGI_FORMAT_BC6H_SF16:      return KTXImage.GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT;
+            case DDSImage.DXGI_FORMAT_BC7_UNORM:      return KTXImage.GL_COMPRESSED_RGBA_BPTC_UNORM;
+            case DDSImage.DXGI_FORMAT_BC7_UNORM_SRGB: return KTXImage.GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+            default:
+                throw new RuntimeException("Unsupported DDS DX10 format " + dxgiFormat);
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------
+    // KTX provider, files are memory mapped
+    static class KTXTextureProvider implements TextureProvider {
+        public TextureData newTextureData(GLProfile glp, File file,
+                                          int internalFormat,
+                                          int pixelFormat,
+                                          boolean mipmap,
+                                          String fileSuffix) throws IOException {
+            if (KTX.equals(fileSuffix) || KTX2.equals(fileSuffix) ||
+                KTX.equals(IOUtil.getFileSuffix(file)) || KTX2.equals(IOUtil.getFileSuffix(file))) {
+                KTXImage image = KTXImage.read(file);
+                return newTextureData(glp, image, internalFormat, pixelFormat, mipmap);
+            }
+
+            return null;
+        }
+
+        public TextureData newTextureData(GLProfile glp, InputStream stream,
+                                          int internalFormat,
+                                          int pixelFormat,
+                                          boolean mipmap,
+                                          String fileSuffix) throws IOException {
+            if (KTX.equals(fileSuffix) || KTX2.equals(fileSuffix) ||
+                KTXImage.isKTXImage(stream)) {
+                byte[] data = IOUtil.copyStream2ByteArray(stream);
+                ByteBuffer buf = ByteBuffer.wrap(data);
+                KTXImage image = KTXImage.read(buf);
+                return newTextureData(glp, image, internalFormat, pixelFormat, mipmap);
+            }
+
+            return null;
+        }
+
+        public TextureData newTextureData(GLProfile glp, URL url,
+                                          int internalFormat,
+                                          int pixelFormat,
+                                          boolean mipmap,
+                                          String fileSuffix) throws IOException {
+            InputStream stream = new BufferedInputStream(url.openStream());
+            try {
+                return newTextureData(glp, stream, internalFormat, pixelFormat, mipmap, fileSuffix);
+            } finally {
+                stream.close();
+            }
+        }
+
+        private TextureData newTextureData(GLProfile glp, final KTXImage image,
+                                           int internalFormat,
+                                           int pixelFormat,
+                                           boolean mipmap) {
+            final boolean compressed = image.isCompressed();
+            final int pixelType;
+            if (compressed) {
+                // the stored format can't be converted
+                internalFormat = image.getGLInternalFormat();
+                pixelFormat = 0 != image.getGLBaseInternalFormat() ? image.getGLBaseInternalFormat() : GL.GL_RGBA;
+                pixelType = GL.GL_UNSIGNED_BYTE;
+            } else {
+                if (internalFormat == 0) {
+                    internalFormat = image.getGLInternalFormat();
+                }
+                pixelFormat = image.getGLFormat();
+                pixelType = image.getGLType();
+            }
+            TextureData.Flusher flusher = new TextureData.Flusher() {
+                    public void flush() {
+                        image.close();
+                    }
+                };
+            TextureData data;
+            if (mipmap && image.getNumMipMaps() > 1) {
+                Buffer[] mipmapData = new Buffer[image.getNumMipMaps()];
+                for (int i = 0; i < image.getNumMipMaps(); i++) {
+                    mipmapData[i] = image.getMipMap(i);
+                }
+                data = new TextureData(glp, internalFormat,
+                                       image.getWidth(),
+                                       image.getHeight(),
+                                       0,
+                                       pixelFormat,
+                                       pixelType,
+                                       compressed,
+                                       image.isUpperLeftOrigin(),
+                                       mipmapData,
+                                       flusher);
+            } else {
+                // mipmaps can't be generated for compressed textures
+                data = new TextureData(glp, internalFormat,
+                                       image.getWidth(),
+                                       image.getHeight(),
+                                       0,
+                                       pixelFormat,
+                                       pixelType,
+                                       mipmap && !compressed,
+                                       compressed,
+                                       image.isUpperLeftOrigin(),
+                                       image.getMipMap(0),
+                                       flusher);
+            }
+            if (1 == image.getVersion()) {
+                data.setAlignment(4); // KTX 1 rows are 4 byte aligned
+            }
+            return data;
+        }
     }
 
     //----------------------------------------------------------------------
@@ -1146,14 +1303,25 @@ public class TextureIO {
                                           String fileSuffix) throws IOException {
             if (PNG.equals(fileSuffix)) {
                 PNGImage image = PNGImage.read(/*glp, */ stream);
+                int bytesPerPixel = image.getBytesPerPixel();
+                int glFormat = image.getGLFormat();
+                ByteBuffer data = image.getData();
+                if( bytesPerPixel < 3 && pixelFormat == 0 && glp.isGL3() && !glp.isGL2() ) {
+                    // GL_LUMINANCE[_ALPHA] is not available in core profiles
+                    data = expandLuminance(data, image.getWidth() * image.getHeight(), 2 == bytesPerPixel);
+                    bytesPerPixel += 2;
+                    glFormat = ( 4 == bytesPerPixel ) ? GL.GL_RGBA : GL.GL_RGB;
+                }
                 if (pixelFormat == 0) {
-                    pixelFormat = image.getGLFormat();
+                    pixelFormat = glFormat;
                 }
                 if (internalFormat == 0) {
-                    if(glp.isGL2GL3()) {
-                        internalFormat = (image.getBytesPerPixel()==4)?GL.GL_RGBA8:GL.GL_RGB8;
+                    if(bytesPerPixel<3) {
+                        internalFormat = glFormat; // GL_LUMINANCE or GL_LUMINANCE_ALPHA
+                    } else if(glp.isGL2GL3()) {
+                        internalFormat = (bytesPerPixel==4)?GL.GL_RGBA8:GL.GL_RGB8;
                     } else {
-                        internalFormat = (image.getBytesPerPixel()==4)?GL.GL_RGBA:GL.GL_RGB;
+                        internalFormat = (bytesPerPixel==4)?GL.GL_RGBA:GL.GL_RGB;
                     }
                 }
                 return new TextureData(glp, internalFormat,
@@ -1165,12 +1333,29 @@ public class TextureIO {
                                        mipmap,
                                        false,
                                        false,
-                                       image.getData(),
+                                       data,
                                        null);
             }
 
             return null;
         }
+
+        /** Expands <code>pixels</code> luminance[-alpha] pixels to RGB[A], i.e. L -> LLL and LA -> LLLA. */
+        private static ByteBuffer expandLuminance(ByteBuffer src, int pixels, boolean hasAlpha) {
+            final int srcBpp = hasAlpha ? 2 : 1;
+            final int dstBpp = srcBpp + 2;
+            final ByteBuffer dst = Buffers.newDirectByteBuffer(pixels * dstBpp);
+            for(int i=0, s=0, d=0; i<pixels; i++, s+=srcBpp, d+=dstBpp) {
+                final byte l = src.get(s);
+                dst.put(d  , l);
+                dst.put(d+1, l);
+                dst.put(d+2, l);
+                if(hasAlpha) {
+                    dst.put(d+3, src.get(s+1));
+                }
+            }
+            return dst;
+        }
     }
 
     //----------------------------------------------------------------------
@@ -92,6 +92,7 @@ public class DDSImage {
     private FileChannel     chan;
     private ByteBuffer buf;
     private Header header;
+    private Header10 header10;
 
     //
     // Selected bits in header flags
@@ -155,6 +156,33 @@ public class DDSImage {
     public static final int D3DFMT_DXT3      =  0x33545844;
     public static final int D3DFMT_DXT4      =  0x34545844;
     public static final int D3DFMT_DXT5      =  0x35545844;
+    /** BC4, alias of {@link #D3DFMT_BC4U} */
+    public static final int D3DFMT_ATI1      =  0x31495441;
+    /** BC5, alias of {@link #D3DFMT_BC5U} */
+    public static final int D3DFMT_ATI2      =  0x32495441;
+    public static final int D3DFMT_BC4U      =  0x55344342;
+    public static final int D3DFMT_BC4S      =  0x53344342;
+    public static final int D3DFMT_BC5U      =  0x55354342;
+    public static final int D3DFMT_BC5S      =  0x53354342;
+    /** The format is given by the DX10 header extension, see {@link #getDXGIFormat()} */
+    public static final int D3DFMT_DX10      =  0x30315844;
+
+    // DXGI formats of the DX10 header extension (block compressed only)
+    public static final int DXGI_FORMAT_UNKNOWN        =  0;
+    public static final int DXGI_FORMAT_BC1_UNORM      = 71;
+    public static final int DXGI_FORMAT_BC1_UNORM_SRGB = 72;
+    public static final int DXGI_FORMAT_BC2_UNORM      = 74;
+    public static final int DXGI_FORMAT_BC2_UNORM_SRGB = 75;
+    public static final int DXGI_FORMAT_BC3_UNORM      = 77;
+    public static final int DXGI_FORMAT_BC3_UNORM_SRGB = 78;
+    public static final int DXGI_FORMAT_BC4_UNORM      = 80;
+    public static final int DXGI_FORMAT_BC4_SNORM      = 81;
+    public static final int DXGI_FORMAT_BC5_UNORM      = 83;
+    public static final int DXGI_FORMAT_BC5_SNORM      = 84;
+    public static final int DXGI_FORMAT_BC6H_UF16      = 95;
+    public static final int DXGI_FORMAT_BC6H_SF16      = 96;
+    public static final int DXGI_FORMAT_BC7_UNORM      = 98;
+    public static final int DXGI_FORMAT_BC7_UNORM_SRGB = 99;
 
     /** Reads a DirectDraw surface from the specified file name,
         returning the resulting DDSImage.
@@ -367,11 +395,23 @@ public class DDSImage {
     }
 
     /** If this surface is compressed, returns the kind of compression
-        used (DXT1..DXT5). */
+        used (DXT1..DXT5, ATI1, ATI2, BC4U .. BC5S or DX10). */
     public int getCompressionFormat() {
         return header.pfFourCC;
     }
 
+    /** Indicates whether this surface has a DX10 header extension,
+        i.e. the format is given by {@link #getDXGIFormat()}. */
+    public boolean isDX10() {
+        return null != header10;
+    }
+
+    /** Returns the DXGI_FORMAT_* of the DX10 header extension,
+        or DXGI_FORMAT_UNKNOWN if not {@link #isDX10()}. */
+    public int getDXGIFormat() {
+        return null != header10 ? header10.dxgiFormat : DXGI_FORMAT_UNKNOWN;
+    }
+
     /** Width of the texture (or the top-most mipmap if mipmaps are
         present) */
     public int getWidth() {
@@ -426,6 +466,9 @@ public class DDSImage {
 
         // Figure out how far to seek
         int seek = Header.writtenSize();
+        if (isDX10()) {
+            seek += Header10.size();
+        }
         if (isCubemap()) {
             seek += sideShiftInBytes(side);
         }
@@ -488,8 +531,9 @@ public class DDSImage {
         NPOT texture extension. The specified OpenGL internal format
         must be one of GL_COMPRESSED_RGB_S3TC_DXT1_EXT,
         GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,
-        GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, or
-        GL_COMPRESSED_RGBA_S3TC_DXT5_EXT.
+        GL_COMPRESSED_RGBA_S3TC_DXT3_EXT,
+        GL_COMPRESSED_RGBA_S3TC_DXT5_EXT or one of the RGTC and BPTC
+        formats, see {@link KTXImage}.
     */
     public static ByteBuffer allocateBlankBuffer(int width,
                                                  int height,
@@ -501,8 +545,19 @@ public class DDSImage {
             size /= 2;
             break;
 
+        case KTXImage.GL_COMPRESSED_RED_RGTC1:
+        case KTXImage.GL_COMPRESSED_SIGNED_RED_RGTC1:
+            size /= 2;
+            break;
+
         case GL.GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
         case GL.GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+        case KTXImage.GL_COMPRESSED_RG_RGTC2:
+        case KTXImage.GL_COMPRESSED_SIGNED_RG_RGTC2:
+        case KTXImage.GL_COMPRESSED_RGBA_BPTC_UNORM:
+        case KTXImage.GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+        case KTXImage.GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT:
+        case KTXImage.GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:
             break;
 
         default:
@@ -521,6 +576,10 @@ public class DDSImage {
             int fmt = getCompressionFormat();
             String name = getCompressionFormatName(fmt);
             tty.println("Compression format: 0x" + Integer.toHexString(fmt) + " (" + name + ")");
+            if (isDX10()) {
+                tty.println("DXGI format: " + header10.dxgiFormat + ", resource dimension " + header10.resourceDimension +
+                            ", array size " + header10.arraySize);
+            }
         }
         tty.println("Width: " + header.width + " Height: " + header.height);
         tty.println("header.pitchOrLinearSize: " + header.pitchOrLinearSize);
@@ -578,6 +637,13 @@ public class DDSImage {
         case D3DFMT_DXT3:     tty.println("D3DFMT_DXT3"); break;
         case D3DFMT_DXT4:     tty.println("D3DFMT_DXT4"); break;
         case D3DFMT_DXT5:     tty.println("D3DFMT_DXT5"); break;
+        case D3DFMT_ATI1:     tty.println("D3DFMT_ATI1"); break;
+        case D3DFMT_ATI2:     tty.println("D3DFMT_ATI2"); break;
+        case D3DFMT_BC4U:     tty.println("D3DFMT_BC4U"); break;
+        case D3DFMT_BC4S:     tty.println("D3DFMT_BC4S"); break;
+        case D3DFMT_BC5U:     tty.println("D3DFMT_BC5U"); break;
+        case D3DFMT_BC5S:     tty.println("D3DFMT_BC5S"); break;
+        case D3DFMT_DX10:     tty.println("D3DFMT_DX10"); break;
         case D3DFMT_UNKNOWN:  tty.println("D3DFMT_UNKNOWN"); break;
         default:              tty.println("(unknown pixel format " + fmt + ")"); break;
         }
@@ -719,6 +785,27 @@ public class DDSImage {
         }
     }
 
+    /** DDS_HEADER_DXT10, following the header if the FourCC is DX10 */
+    static class Header10 {
+        int dxgiFormat;
+        int resourceDimension;
+        int miscFlag;
+        int arraySize;
+        int miscFlags2;
+
+        void read(ByteBuffer buf) throws IOException {
+            dxgiFormat        = buf.getInt();
+            resourceDimension = buf.getInt();
+            miscFlag          = buf.getInt();
+            arraySize         = buf.getInt();
+            miscFlags2        = buf.getInt();
+        }
+
+        private static int size() {
+            return 20;
+        }
+    }
+
     private DDSImage() {
     }
 
@@ -735,6 +822,13 @@ public class DDSImage {
         buf.order(ByteOrder.LITTLE_ENDIAN);
         header = new Header();
         header.read(buf);
+        if (isCompressed() && getCompressionFormat() == D3DFMT_DX10) {
+            if (buf.remaining() < Header10.size()) {
+                throw new IOException("Truncated DX10 header");
+            }
+            header10 = new Header10();
+            header10.read(buf);
+        }
         fixupHeader();
     }
 
@@ -756,7 +850,7 @@ public class DDSImage {
         case D3DFMT_DXT3:
         case D3DFMT_DXT4:
         case D3DFMT_DXT5:
-            topmostMipmapSize = computeCompressedBlockSize(width, height, 1, d3dFormat);
+            topmostMipmapSize = computeCompressedBlockSize(width, height, 1, blockSizeInBytes(d3dFormat, DXGI_FORMAT_UNKNOWN));
             pitchOrLinearSize = topmostMipmapSize;
             isCompressed = true;
             break;
@@ -835,7 +929,8 @@ public class DDSImage {
                 depth = 1;
             }
 
-            header.pitchOrLinearSize = computeCompressedBlockSize(getWidth(), getHeight(), depth, getCompressionFormat());
+            header.pitchOrLinearSize = computeCompressedBlockSize(getWidth(), getHeight(), depth,
+                                                                  blockSizeInBytes(getCompressionFormat(), getDXGIFormat()));
             header.flags |= DDSD_LINEARSIZE;
         }
     }
@@ -843,13 +938,29 @@ public class DDSImage {
     private static int computeCompressedBlockSize(int width,
                                                   int height,
                                                   int depth,
-                                                  int compressionFormat) {
-        int blockSize = ((width + 3)/4) * ((height + 3)/4) * ((depth + 3)/4);
+                                                  int blockSizeInBytes) {
+        return ((width + 3)/4) * ((height + 3)/4) * ((depth + 3)/4) * blockSizeInBytes;
+    }
+
+    /** Bytes per 4x4 block: 8 for BC1 and BC4, 16 otherwise */
+    private static int blockSizeInBytes(int compressionFormat, int dxgiFormat) {
         switch (compressionFormat) {
-        case D3DFMT_DXT1:  blockSize *=  8; break;
-        default:           blockSize *= 16; break;
+        case D3DFMT_DXT1:
+        case D3DFMT_ATI1:
+        case D3DFMT_BC4U:
+        case D3DFMT_BC4S:
+            return 8;
+        case D3DFMT_DX10:
+            switch (dxgiFormat) {
+            case DXGI_FORMAT_BC1_UNORM:
+            case DXGI_FORMAT_BC1_UNORM_SRGB:
+            case DXGI_FORMAT_BC4_UNORM:
+            case DXGI_FORMAT_BC4_SNORM:
+                return 8;
+            }
+            break;
         }
-        return blockSize;
+        return 16;
     }
 
     private int mipMapWidth(int map) {
@@ -872,7 +983,7 @@ public class DDSImage {
         int width  = mipMapWidth(map);
         int height = mipMapHeight(map);
         if (isCompressed()) {
-            int blockSize = (getCompressionFormat() == D3DFMT_DXT1 ? 8 : 16);
+            int blockSize = blockSizeInBytes(getCompressionFormat(), getDXGIFormat());
             return ((width+3)/4)*((height+3)/4)*blockSize;
         } else {
             return width * height * (getDepth() / 8);
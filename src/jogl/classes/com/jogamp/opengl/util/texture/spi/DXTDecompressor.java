@@ -0,0 +1,379 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.util.texture.spi;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.ThreadFactory;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import javax.media.opengl.GL;
+import javax.media.opengl.GLException;
+
+import jogamp.opengl.Debug;
+
+/**
+ * Software decoder of S3TC / RGTC block compressed images to RGBA8, 
+ * used by {@link com.jogamp.opengl.util.texture.Texture} if the graphics card lacks the compression extension.
+ * <p>
+ * Supported formats are DXT1 (BC1, RGB and RGBA), DXT3 (BC2), DXT5 (BC3), 
+ * RGTC1 (BC4) and RGTC2 (BC5), unsigned and signed.
+ * RGTC1 decodes to <code>(r, 0, 0, 1)</code> and RGTC2 to <code>(r, g, 0, 1)</code>.
+ * Signed RGTC values are biased to the unsigned range, i.e. <code>-1 .. 1</code> maps to <code>0 .. 255</code>.
+ * </p>
+ * <p>
+ * Each 4x4 block is written straight to its destination pixels. 
+ * The calling thread and up to <code>threadCount-1</code> threads of a shared daemon pool
+ * take the next block row from a common index.
+ * Property <code>jogl.texture.decompress.threads</code> sets the thread count, 
+ * default is the number of available processors, 1 disables parallel decoding.
+ * </p>
+ */
+public class DXTDecompressor {
+    public static final int THREAD_COUNT = Math.max(1, 
+            Debug.getIntProperty("jogl.texture.decompress.threads", true, Runtime.getRuntime().availableProcessors()));
+    
+    /** Minimum number of block rows decoded in parallel, smaller images are decoded by the caller */
+    public static final int MIN_PARALLEL_BLOCK_ROWS = 16;
+    
+    private static ExecutorService executor = null;
+    
+    private static synchronized ExecutorService getExecutor() {
+        if(null == executor) {
+            executor = Executors.newFixedThreadPool(THREAD_COUNT - 1, new DecompressorThreadFactory());
+        }
+        return executor;
+    }
+    
+    private static class DecompressorThreadFactory implements ThreadFactory {
+        private int count = 0;
+
+        public synchronized Thread newThread(Runnable r) {
+            Thread t = new Thread(r, "DXTDecompressor-" + (count++));
+            t.setDaemon(true);
+            return t;
+        }
+    }
+    
+    private static final ThreadLocal<ByteBuffer> scratch = new ThreadLocal<ByteBuffer>();
+    
+    /**
+     * @return true if the given compressed internal format can be decoded
+     */
+    public static boolean isSupported(int internalFormat) {
+        switch(internalFormat) {
+            case GL.GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+            case GL.GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+            case GL.GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+            case GL.GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+            case KTXImage.GL_COMPRESSED_RED_RGTC1:
+            case KTXImage.GL_COMPRESSED_SIGNED_RED_RGTC1:
+            case KTXImage.GL_COMPRESSED_RG_RGTC2:
+            case KTXImage.GL_COMPRESSED_SIGNED_RG_RGTC2:
+                return true;
+            default:
+                return false;
+        }
+    }
+    
+    /** @return the size of one 4x4 block of the given compressed internal format in bytes */
+    public static int getBlockSize(int internalFormat) {
+        switch(internalFormat) {
+            case GL.GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+            case GL.GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+            case KTXImage.GL_COMPRESSED_RED_RGTC1:
+            case KTXImage.GL_COMPRESSED_SIGNED_RED_RGTC1:
+                return 8;
+            default:
+                return 16;
+        }
+    }
+    
+    /** @return the size of a compressed image of the given dimension in bytes */
+    public static int getCompressedSize(int internalFormat, int width, int height) {
+        return ( ( width + 3 ) / 4 ) * ( ( height + 3 ) / 4 ) * getBlockSize(internalFormat);
+    }
+    
+    /**
+     * Returns a direct buffer of at least <code>size</code> bytes, owned by the current thread. 
+     * The buffer is reused by subsequent calls of the same thread, hence its content 
+     * must be consumed, e.g. uploaded via <code>glTexImage2D</code>, before the next call. 
+     * 
+     * @return the cleared buffer with <code>limit</code> set to <code>size</code>
+     */
+    public static ByteBuffer getScratchBuffer(int size) {
+        ByteBuffer buf = scratch.get();
+        if( null == buf || buf.capacity() < size ) {
+            buf = ByteBuffer.allocateDirect(size).order(ByteOrder.nativeOrder());
+            scratch.set(buf);
+        }
+        buf.clear();
+        buf.limit(size);
+        return buf;
+    }
+    
+    /**
+     * Decodes the compressed image <code>src</code>, starting at its position, 
+     * to tightly packed RGBA8 pixels in <code>dst</code>, starting at its position.
+     * Rows are stored in the same order as the blocks, the positions of both buffers are not changed. 
+     * 
+     * @param internalFormat one of the {@link #isSupported(int) supported} compressed formats
+     * @param width image width in pixels
+     * @param height image height in pixels
+     * @param src compressed blocks, at least {@link #getCompressedSize(int, int, int)} bytes remaining
+     * @param dst destination, at least <code>width*height*4</code> bytes remaining
+     * @throws IllegalArgumentException if the format is not supported or a buffer is too small 
+     */
+    public static void decompress(int internalFormat, int width, int height, ByteBuffer src, ByteBuffer dst) 
+            throws IllegalArgumentException {
+        if( !isSupported(internalFormat) ) {
+            throw new IllegalArgumentException("Unsupported compressed format 0x"+Integer.toHexString(internalFormat));
+        }
+        if( src.remaining() < getCompressedSize(internalFormat, width, height) ) {
+            throw new IllegalArgumentException("Compressed data too small: "+src.remaining()+" < "+getCompressedSize(internalFormat, width, height));
+        }
+        if( dst.remaining() < width * height * 4 ) {
+            throw new IllegalArgumentException("Destination too small: "+dst.remaining()+" < "+(width * height * 4));
+        }
+        final Job job = new Job(internalFormat, width, height, src, dst);
+        final int workers = Math.min(THREAD_COUNT, job.blockRows) - 1;
+        if( workers > 0 && job.blockRows >= MIN_PARALLEL_BLOCK_ROWS ) {
+            final ExecutorService e = getExecutor();
+            final Future<?>[] futures = new Future<?>[workers];
+            for(int i=0; i<workers; i++) {
+                futures[i] = e.submit(job);
+            }
+            job.run();
+            for(int i=0; i<workers; i++) {
+                try {
+                    futures[i].get();
+                } catch (InterruptedException ie) {
+                    throw new GLException("Interrupted while decompressing", ie);
+                } catch (ExecutionException ee) {
+                    throw new GLException(ee.getCause());
+                }
+            }
+        } else {
+            job.run();
+        }
+    }
+    
+    private static class Job implements Runnable {
+        final int format, width, height, blockSize, blocksX, blockRows;
+        final ByteBuffer src, dst;
+        final int srcOff, dstOff;
+        final AtomicInteger next = new AtomicInteger(0);
+        
+        Job(int format, int width, int height, ByteBuffer src, ByteBuffer dst) {
+            this.format = format;
+            this.width = width;
+            this.height = height;
+            this.blockSize = getBlockSize(format);
+            this.blocksX = ( width + 3 ) / 4;
+            this.blockRows = ( height + 3 ) / 4;
+            this.src = src;
+            this.dst = dst;
+            this.srcOff = src.position();
+            this.dstOff = dst.position();
+        }
+        
+        public void run() {
+            // per thread state, absolute buffer access only
+            final byte[] block = new byte[16];
+            final int[] rgba = new int[16*4];
+            final int[] channel = new int[16+8];
+            int by;
+            while( ( by = next.getAndIncrement() ) < blockRows ) {
+                final int rows = Math.min(4, height - by * 4);
+                for(int bx=0; bx<blocksX; bx++) {
+                    final int s = srcOff + ( by * blocksX + bx ) * blockSize;
+                    for(int i=0; i<blockSize; i++) {
+                        block[i] = src.get(s + i);
+                    }
+                    decodeBlock(format, block, rgba, channel);
+                    final int cols = Math.min(4, width - bx * 4);
+                    for(int y=0; y<rows; y++) {
+                        int d = dstOff + ( ( by * 4 + y ) * width + bx * 4 ) * 4;
+                        for(int x=0; x<cols; x++) {
+                            final int p = ( y * 4 + x ) * 4;
+                            dst.put(d++, (byte) rgba[p  ]);
+                            dst.put(d++, (byte) rgba[p+1]);
+                            dst.put(d++, (byte) rgba[p+2]);
+                            dst.put(d++, (byte) rgba[p+3]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    
+    /**
+     * Decodes one block into 16 RGBA8 pixels, row major.
+     * @param block the compressed block, {@link #getBlockSize(int)} bytes
+     * @param rgba 64 components, receiving the decoded pixels 
+     * @param channel temporary storage of 24 values 
+     */
+    static void decodeBlock(int format, byte[] block, int[] rgba, int[] channel) {
+        switch(format) {
+            case GL.GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+                decodeColor(block, 0, rgba, true, false);
+                break;
+            case GL.GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+                decodeColor(block, 0, rgba, true, true);
+                break;
+            case GL.GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+                decodeColor(block, 8, rgba, false, false);
+                for(int i=0; i<16; i++) {
+                    final int a = ( block[i >> 1] >> ( ( i & 1 ) * 4 ) ) & 0x0f;
+                    rgba[i*4+3] = a | ( a << 4 );
+                }
+                break;
+            case GL.GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+                decodeColor(block, 8, rgba, false, false);
+                decodeChannel(block, 0, false, channel);
+                for(int i=0; i<16; i++) {
+                    rgba[i*4+3] = channel[i];
+                }
+                break;
+            case KTXImage.GL_COMPRESSED_RED_RGTC1:
+            case KTXImage.GL_COMPRESSED_SIGNED_RED_RGTC1:
+                decodeChannel(block, 0, KTXImage.GL_COMPRESSED_SIGNED_RED_RGTC1 == format, channel);
+                for(int i=0; i<16; i++) {
+                    rgba[i*4  ] = channel[i];
+                    rgba[i*4+1] = 0;
+                    rgba[i*4+2] = 0;
+                    rgba[i*4+3] = 255;
+                }
+                break;
+            case KTXImage.GL_COMPRESSED_RG_RGTC2:
+            case KTXImage.GL_COMPRESSED_SIGNED_RG_RGTC2:
+                final boolean signed = KTXImage.GL_COMPRESSED_SIGNED_RG_RGTC2 == format;
+                decodeChannel(block, 0, signed, channel);
+                for(int i=0; i<16; i++) {
+                    rgba[i*4  ] = channel[i];
+                }
+                decodeChannel(block, 8, signed, channel);
+                for(int i=0; i<16; i++) {
+                    rgba[i*4+1] = channel[i];
+                    rgba[i*4+2] = 0;
+                    rgba[i*4+3] = 255;
+                }
+                break;
+            default:
+                throw new IllegalArgumentException("Unsupported compressed format 0x"+Integer.toHexString(format));
+        }
+    }
+    
+    /**
+     * Decodes the 8 byte color part of a DXT block, RGB565 end points and 2 bit indices.
+     * @param dxt1 if true, <code>c0 <= c1</code> selects the 3 color mode with black as the 4th color, 
+     *             otherwise the 4 color mode is always used as with DXT3 and DXT5.
+     * @param alpha1 if true, the 4th color of the 3 color mode is transparent, otherwise alpha is 255 
+     */
+    private static void decodeColor(byte[] b, int off, int[] rgba, boolean dxt1, boolean alpha1) {
+        final int c0 = ( b[off  ] & 0xff ) | ( ( b[off+1] & 0xff ) << 8 );
+        final int c1 = ( b[off+2] & 0xff ) | ( ( b[off+3] & 0xff ) << 8 );
+        final int r0 = expand5( c0 >> 11 ), g0 = expand6( ( c0 >> 5 ) & 0x3f ), b0 = expand5( c0 & 0x1f );
+        final int r1 = expand5( c1 >> 11 ), g1 = expand6( ( c1 >> 5 ) & 0x3f ), b1 = expand5( c1 & 0x1f );
+        final int r2, g2, b2, r3, g3, b3, a3;
+        if( !dxt1 || c0 > c1 ) {
+            r2 = ( 2 * r0 + r1 ) / 3; g2 = ( 2 * g0 + g1 ) / 3; b2 = ( 2 * b0 + b1 ) / 3;
+            r3 = ( r0 + 2 * r1 ) / 3; g3 = ( g0 + 2 * g1 ) / 3; b3 = ( b0 + 2 * b1 ) / 3;
+            a3 = 255;
+        } else {
+            r2 = ( r0 + r1 ) / 2; g2 = ( g0 + g1 ) / 2; b2 = ( b0 + b1 ) / 2;
+            r3 = 0; g3 = 0; b3 = 0;
+            a3 = alpha1 ? 0 : 255;
+        }
+        final int indices = ( b[off+4] & 0xff ) | ( ( b[off+5] & 0xff ) << 8 ) | 
+                            ( ( b[off+6] & 0xff ) << 16 ) | ( ( b[off+7] & 0xff ) << 24 );
+        for(int i=0; i<16; i++) {
+            final int p = i * 4;
+            switch( ( indices >>> ( 2 * i ) ) & 3 ) {
+                case 0: rgba[p] = r0; rgba[p+1] = g0; rgba[p+2] = b0; rgba[p+3] = 255; break;
+                case 1: rgba[p] = r1; rgba[p+1] = g1; rgba[p+2] = b1; rgba[p+3] = 255; break;
+                case 2: rgba[p] = r2; rgba[p+1] = g2; rgba[p+2] = b2; rgba[p+3] = 255; break;
+                default: rgba[p] = r3; rgba[p+1] = g3; rgba[p+2] = b3; rgba[p+3] = a3; break;
+            }
+        }
+    }
+    
+    /**
+     * Decodes an 8 byte single channel block as used by DXT5 alpha and RGTC, 
+     * 8 bit end points and 3 bit indices, into the first 16 unsigned values of <code>out</code>.
+     * The remaining 8 values of <code>out</code> receive the palette.
+     */
+    private static void decodeChannel(byte[] b, int off, boolean signed, int[] out) {
+        final int v0, v1;
+        if( signed ) {
+            v0 = Math.max(-127, (int) b[off  ]);
+            v1 = Math.max(-127, (int) b[off+1]);
+        } else {
+            v0 = b[off  ] & 0xff;
+            v1 = b[off+1] & 0xff;
+        }
+        final int v = 16;
+        out[v  ] = v0;
+        out[v+1] = v1;
+        if( v0 > v1 ) {
+            for(int i=1; i<7; i++) {
+                out[v+i+1] = ( ( 7 - i ) * v0 + i * v1 ) / 7;
+            }
+        } else {
+            for(int i=1; i<5; i++) {
+                out[v+i+1] = ( ( 5 - i ) * v0 + i * v1 ) / 5;
+            }
+            out[v+6] = signed ? -127 : 0;
+            out[v+7] = signed ?  127 : 255;
+        }
+        if( signed ) {
+            for(int i=0; i<8; i++) {
+                out[v+i] = ( ( out[v+i] + 127 ) * 255 + 127 ) / 254;
+            }
+        }
+        long indices = 0;
+        for(int i=0; i<6; i++) {
+            indices |= (long) ( b[off+2+i] & 0xff ) << ( 8 * i );
+        }
+        for(int i=0; i<16; i++) {
+            out[i] = out[ v + ( (int) ( indices >>> ( 3 * i ) ) & 7 ) ];
+        }
+    }
+    
+    private static int expand5(int c) {
+        return ( c << 3 ) | ( c >> 2 );
+    }
+    
+    private static int expand6(int c) {
+        return ( c << 2 ) | ( c >> 4 );
+    }
+}
@@ -0,0 +1,513 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.util.texture.spi;
+
+import java.io.BufferedInputStream;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.channels.FileChannel;
+
+import javax.media.opengl.GL;
+
+/** 
+ * A reader for Khronos texture container files, KTX (.ktx) version 1 and KTX 2 (.ktx2),
+ * holding GPU ready, usually compressed texture data, e.g. BC1-BC7, ETC2/EAC or ASTC.
+ * <p>
+ * Files are memory mapped and each image is exposed as a slice of the mapped buffer,
+ * i.e. texture data is passed to the GL without being copied or decoded.
+ * </p>
+ * <p>
+ * Supported are 2D textures and cube maps with an optional mipmap chain.
+ * Array and 3D textures as well as supercompressed KTX 2 files are not supported.
+ * KTX 2 formats are mapped to their OpenGL counterparts, see {@link #getGLInternalFormat(int)}.
+ * </p>
+ * See <a href="http://www.khronos.org/opengles/sdk/tools/KTX/file_format_spec/">KTX file format</a>.
+ */
+public class KTXImage {
+    // OpenGL compressed texture formats not covered by the GL interfaces
+    
+    /** EXT_texture_sRGB + EXT_texture_compression_s3tc */
+    public static final int GL_COMPRESSED_SRGB_S3TC_DXT1_EXT             = 0x8C4C;
+    public static final int GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT       = 0x8C4D;
+    public static final int GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT       = 0x8C4E;
+    public static final int GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT       = 0x8C4F;
+    /** ARB_texture_compression_rgtc, BC4 and BC5 */
+    public static final int GL_COMPRESSED_RED_RGTC1                      = 0x8DBB;
+    public static final int GL_COMPRESSED_SIGNED_RED_RGTC1               = 0x8DBC;
+    public static final int GL_COMPRESSED_RG_RGTC2                       = 0x8DBD;
+    public static final int GL_COMPRESSED_SIGNED_RG_RGTC2                = 0x8DBE;
+    /** ARB_texture_compression_bptc, BC6H and BC7 */
+    public static final int GL_COMPRESSED_RGBA_BPTC_UNORM                = 0x8E8C;
+    public static final int GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM          = 0x8E8D;
+    public static final int GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT          = 0x8E8E;
+    public static final int GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT        = 0x8E8F;
+    /** OpenGL 4.3, OpenGL ES 3.0 */
+    public static final int GL_COMPRESSED_R11_EAC                        = 0x9270;
+    public static final int GL_COMPRESSED_SIGNED_R11_EAC                 = 0x9271;
+    public static final int GL_COMPRESSED_RG11_EAC                       = 0x9272;
+    public static final int GL_COMPRESSED_SIGNED_RG11_EAC                = 0x9273;
+    public static final int GL_COMPRESSED_RGB8_ETC2                      = 0x9274;
+    public static final int GL_COMPRESSED_SRGB8_ETC2                     = 0x9275;
+    public static final int GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2  = 0x9276;
+    public static final int GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2 = 0x9277;
+    public static final int GL_COMPRESSED_RGBA8_ETC2_EAC                 = 0x9278;
+    public static final int GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC          = 0x9279;
+    /** KHR_texture_compression_astc_ldr, first of 14 block sizes 4x4 .. 12x12 */
+    public static final int GL_COMPRESSED_RGBA_ASTC_4x4_KHR              = 0x93B0;
+    /** KHR_texture_compression_astc_ldr, first of 14 block sizes 4x4 .. 12x12 */
+    public static final int GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR      = 0x93D0;
+    
+    private static final int GL_RED          = 0x1903;
+    private static final int GL_RG           = 0x8227;
+    private static final int GL_BGR          = 0x80E0;
+    private static final int GL_BGRA         = 0x80E1;
+    private static final int GL_R8           = 0x8229;
+    private static final int GL_RG8          = 0x822B;
+    private static final int GL_SRGB8        = 0x8C41;
+    private static final int GL_SRGB8_ALPHA8 = 0x8C43;
+    
+    /** 
+     * KTX 2 Vulkan formats and their OpenGL internal format, format and type, 
+     * the latter two being 0 for compressed formats.
+     */
+    private static final int[][] vkFormats = {
+        {   9, GL_R8,            GL_RED,      GL.GL_UNSIGNED_BYTE }, // VK_FORMAT_R8_UNORM
+        {  16, GL_RG8,           GL_RG,       GL.GL_UNSIGNED_BYTE }, // VK_FORMAT_R8G8_UNORM
+        {  23, GL.GL_RGB8,       GL.GL_RGB,   GL.GL_UNSIGNED_BYTE }, // VK_FORMAT_R8G8B8_UNORM
+        {  29, GL_SRGB8,         GL.GL_RGB,   GL.GL_UNSIGNED_BYTE }, // VK_FORMAT_R8G8B8_SRGB
+        {  30, GL.GL_RGB8,       GL_BGR,      GL.GL_UNSIGNED_BYTE }, // VK_FORMAT_B8G8R8_UNORM
+        {  37, GL.GL_RGBA8,      GL.GL_RGBA,  GL.GL_UNSIGNED_BYTE }, // VK_FORMAT_R8G8B8A8_UNORM
+        {  43, GL_SRGB8_ALPHA8,  GL.GL_RGBA,  GL.GL_UNSIGNED_BYTE }, // VK_FORMAT_R8G8B8A8_SRGB
+        {  44, GL.GL_RGBA8,      GL_BGRA,     GL.GL_UNSIGNED_BYTE }, // VK_FORMAT_B8G8R8A8_UNORM
+        {  50, GL_SRGB8_ALPHA8,  GL_BGRA,     GL.GL_UNSIGNED_BYTE }, // VK_FORMAT_B8G8R8A8_SRGB
+        { 131, GL.GL_COMPRESSED_RGB_S3TC_DXT1_EXT,  0, 0 }, // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+        { 132, GL_COMPRESSED_SRGB_S3TC_DXT1_EXT,    0, 0 },
+        { 133, GL.GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, 0, 0 }, // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+        { 134, GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT, 0, 0 },
+        { 135, GL.GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, 0, 0 }, // VK_FORMAT_BC2_UNORM_BLOCK
+        { 136, GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT, 0, 0 },
+        { 137, GL.GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 0, 0 }, // VK_FORMAT_BC3_UNORM_BLOCK
+        { 138, GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT, 0, 0 },
+        { 139, GL_COMPRESSED_RED_RGTC1,             0, 0 }, // VK_FORMAT_BC4_UNORM_BLOCK
+        { 140, GL_COMPRESSED_SIGNED_RED_RGTC1,      0, 0 },
+        { 141, GL_COMPRESSED_RG_RGTC2,              0, 0 }, // VK_FORMAT_BC5_UNORM_BLOCK
+        { 142, GL_COMPRESSED_SIGNED_RG_RGTC2,       0, 0 },
+        { 143, GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT, 0, 0 }, // VK_FORMAT_BC6H_UFLOAT_BLOCK
+        { 144, GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT, 0, 0 },
+        { 145, GL_COMPRESSED_RGBA_BPTC_UNORM,       0, 0 }, // VK_FORMAT_BC7_UNORM_BLOCK
+        { 146, GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM, 0, 0 },
+        { 147, GL_COMPRESSED_RGB8_ETC2,             0, 0 }, // VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+        { 148, GL_COMPRESSED_SRGB8_ETC2,            0, 0 },
+        { 149, GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2, 0, 0 },
+        { 150, GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2, 0, 0 },
+        { 151, GL_COMPRESSED_RGBA8_ETC2_EAC,        0, 0 },
+        { 152, GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC, 0, 0 },
+        { 153, GL_COMPRESSED_R11_EAC,               0, 0 }, // VK_FORMAT_EAC_R11_UNORM_BLOCK
+        { 154, GL_COMPRESSED_SIGNED_R11_EAC,        0, 0 },
+        { 155, GL_COMPRESSED_RG11_EAC,              0, 0 },
+        { 156, GL_COMPRESSED_SIGNED_RG11_EAC,       0, 0 },
+    };
+    /** VK_FORMAT_ASTC_4x4_UNORM_BLOCK, followed by SRGB and UNORM variants of the 13 other block sizes */ 
+    private static final int VK_FORMAT_ASTC_4x4_UNORM_BLOCK = 157;
+    private static final int VK_FORMAT_ASTC_12x12_SRGB_BLOCK = 184;
+    
+    private static final byte[] IDENTIFIER_1 = { (byte)0xAB, 'K', 'T', 'X', ' ', '1', '1', (byte)0xBB, '\r', '\n', 0x1A, '\n' };
+    private static final byte[] IDENTIFIER_2 = { (byte)0xAB, 'K', 'T', 'X', ' ', '2', '0', (byte)0xBB, '\r', '\n', 0x1A, '\n' };
+    private static final int ENDIANNESS = 0x04030201;
+    private static final String KEY_ORIENTATION = "KTXorientation";
+    
+    private FileInputStream fis;
+    private FileChannel     chan;
+    private ByteBuffer buf;
+    
+    private int version;
+    private int vkFormat;
+    private int glType;
+    private int glFormat;
+    private int glInternalFormat;
+    private int glBaseInternalFormat;
+    private int width;
+    private int height;
+    private int numFaces;
+    private int numLevels;
+    private boolean upperLeftOrigin;
+    /** per level: position of the first face, size of one face and distance of two faces */
+    private int[] levelPos, levelSize, faceStride;
+
+    /** Reads a KTX texture from the specified file, memory mapping it. 
+        @param file File object
+        @return KTX image object
+        @throws java.io.IOException if an I/O exception occurred or the file is not supported
+    */
+    public static KTXImage read(File file) throws IOException {
+        KTXImage image = new KTXImage();
+        image.readFromFile(file);
+        return image;
+    }
+
+    /** Reads a KTX texture from the specified ByteBuffer,
+        the returned images are slices of the given buffer.
+        @param buf Input data
+        @return KTX image object
+        @throws java.io.IOException if the data is not a supported KTX texture
+    */
+    public static KTXImage read(ByteBuffer buf) throws IOException {
+        KTXImage image = new KTXImage();
+        image.readFromBuffer(buf);
+        return image;
+    }
+
+    /** Determines from the file identifier whether the given InputStream
+        points to a KTX 1 or 2 texture. The given InputStream must return true
+        from markSupported() and support a minimum of twelve bytes of
+        read-ahead.
+        @param in Stream to check
+        @return true if input stream is a KTX texture or false otherwise
+        @throws java.io.IOException if an I/O exception occurred
+    */
+    public static boolean isKTXImage(InputStream in) throws IOException {
+        if (!(in instanceof BufferedInputStream)) {
+            in = new BufferedInputStream(in);
+        }
+        if (!in.markSupported()) {
+            throw new IOException("Can not test non-destructively whether given InputStream is a KTX image");
+        }
+        final byte[] identifier = new byte[IDENTIFIER_1.length];
+        in.mark(identifier.length);
+        int n = 0;
+        try {
+            while( n < identifier.length ) {
+                final int r = in.read(identifier, n, identifier.length - n);
+                if( r < 0 ) {
+                    return false;
+                }
+                n += r;
+            }
+        } finally {
+            in.reset();
+        }
+        return 0 != getVersion(identifier);
+    }
+
+    /** Closes open files and resources associated with the open
+        KTXImage. No other methods may be called on this object once
+        this is called. */
+    public void close() {
+        try {
+            if (chan != null) {
+                chan.close();
+                chan = null;
+            }
+            if (fis != null) {
+                fis.close();
+                fis = null;
+            }
+            buf = null;
+        } catch (IOException e) {
+            e.printStackTrace();
+        }
+    }
+
+    /** KTX file format version, 1 or 2 */
+    public int getVersion() { return version; }
+    
+    /** The Vulkan format of a KTX 2 texture, 0 for KTX 1 */
+    public int getVkFormat() { return vkFormat; }
+    
+    /** OpenGL internal format, e.g. {@link #GL_COMPRESSED_RGBA_BPTC_UNORM} */
+    public int getGLInternalFormat() { return glInternalFormat; }
+    
+    /** OpenGL pixel format of uncompressed data, 0 if compressed */
+    public int getGLFormat() { return glFormat; }
+    
+    /** OpenGL pixel type of uncompressed data, 0 if compressed */
+    public int getGLType() { return glType; }
+    
+    /** OpenGL base internal format, e.g. GL_RGBA, 0 if unknown */
+    public int getGLBaseInternalFormat() { return glBaseInternalFormat; }
+    
+    public boolean isCompressed() { return 0 == glType; }
+    
+    /** Width of the texture, i.e. of mipmap level 0 */
+    public int getWidth() { return width; }
+    
+    /** Height of the texture, i.e. of mipmap level 0 */
+    public int getHeight() { return height; }
+    
+    /** 1 for 2D textures, 6 for cube maps */
+    public int getNumFaces() { return numFaces; }
+    
+    /** Number of stored mipmap levels, at least 1 */
+    public int getNumMipMaps() { return numLevels; }
+    
+    /** 
+     * Returns true if the first stored row is the top of the image, the KTX default,
+     * i.e. texture coordinates must be flipped vertically.
+     */
+    public boolean isUpperLeftOrigin() { return upperLeftOrigin; }
+    
+    /** Width of the given mipmap level */
+    public int getWidth(int level) { return Math.max(1, width >> level); }
+    
+    /** Height of the given mipmap level */
+    public int getHeight(int level) { return Math.max(1, height >> level); }
+    
+    /** @see #getMipMap(int, int) */
+    public ByteBuffer getMipMap(int level) {
+        return getMipMap(0, level);
+    }
+    
+    /**
+     * Returns the data of the given face and mipmap level as a slice of the underlying buffer,
+     * i.e. w/o copying it.
+     * @param face cube map face in the order +X, -X, +Y, -Y, +Z, -Z or 0 for 2D textures
+     * @param level mipmap level, 0 .. {@link #getNumMipMaps()}-1
+     */
+    public ByteBuffer getMipMap(int face, int level) {
+        if( 0 > face || face >= numFaces ) {
+            throw new IllegalArgumentException("Illegal face " + face + " (0.." + (numFaces - 1) + ")");
+        }
+        if( 0 > level || level >= numLevels ) {
+            throw new IllegalArgumentException("Illegal mipmap level " + level + " (0.." + (numLevels - 1) + ")");
+        }
+        final int pos = levelPos[level] + face * faceStride[level];
+        final ByteBuffer dup = buf.duplicate();
+        dup.limit(pos + levelSize[level]);
+        dup.position(pos);
+        return dup.slice().order(buf.order());
+    }
+    
+    /**
+     * @param vkFormat a KTX 2, i.e. Vulkan format
+     * @return the corresponding OpenGL internal format or 0 if not supported
+     */
+    public static int getGLInternalFormat(int vkFormat) {
+        if( VK_FORMAT_ASTC_4x4_UNORM_BLOCK <= vkFormat && vkFormat <= VK_FORMAT_ASTC_12x12_SRGB_BLOCK ) {
+            final int blockSize = ( vkFormat - VK_FORMAT_ASTC_4x4_UNORM_BLOCK ) / 2;
+            final boolean srgb = 0 != ( ( vkFormat - VK_FORMAT_ASTC_4x4_UNORM_BLOCK ) & 1 );
+            return ( srgb ? GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR : GL_COMPRESSED_RGBA_ASTC_4x4_KHR ) + blockSize;
+        }
+        final int[] f = findVkFormat(vkFormat);
+        return null != f ? f[1] : 0;
+    }
+    
+    private static int[] findVkFormat(int vkFormat) {
+        for(int i=0; i<vkFormats.length; i++) {
+            if( vkFormats[i][0] == vkFormat ) {
+                return vkFormats[i];
+            }
+        }
+        return null;
+    }
+    
+    //----------------------------------------------------------------------
+    // Internals only below this point
+    //
+
+    private KTXImage() {
+    }
+
+    private static int getVersion(byte[] identifier) {
+        boolean v1 = true, v2 = true;
+        for(int i=0; i<IDENTIFIER_1.length; i++) {
+            v1 &= IDENTIFIER_1[i] == identifier[i];
+            v2 &= IDENTIFIER_2[i] == identifier[i];
+        }
+        return v1 ? 1 : ( v2 ? 2 : 0 );
+    }
+    
+    private void readFromFile(File file) throws IOException {
+        fis = new FileInputStream(file);
+        chan = fis.getChannel();
+        ByteBuffer buf = chan.map(FileChannel.MapMode.READ_ONLY,
+                                  0, (int) file.length());
+        try {
+            readFromBuffer(buf);
+        } catch (IOException e) {
+            close();
+            throw e;
+        }
+    }
+
+    private void readFromBuffer(ByteBuffer buf) throws IOException {
+        this.buf = buf;
+        buf.order(ByteOrder.LITTLE_ENDIAN);
+        if( buf.limit() < 64 ) {
+            throw new IOException("Not a KTX file, size "+buf.limit());
+        }
+        final byte[] identifier = new byte[IDENTIFIER_1.length];
+        buf.position(0);
+        buf.get(identifier);
+        buf.position(0);
+        version = getVersion(identifier);
+        switch( version ) {
+            case 1: readHeader1(); break;
+            case 2: readHeader2(); break;
+            default: throw new IOException("Not a KTX file");
+        }
+    }
+    
+    private void readHeader1() throws IOException {
+        final int endianness = buf.getInt(12);
+        if( ENDIANNESS != endianness ) {
+            buf.order(ByteOrder.BIG_ENDIAN);
+            if( ENDIANNESS != buf.getInt(12) ) {
+                throw new IOException("Illegal KTX endianness 0x"+Integer.toHexString(endianness));
+            }
+        }
+        glType               = buf.getInt(16);
+        final int glTypeSize = buf.getInt(20);
+        glFormat             = buf.getInt(24);
+        glInternalFormat     = buf.getInt(28);
+        glBaseInternalFormat = buf.getInt(32);
+        width                = buf.getInt(36);
+        height               = buf.getInt(40);
+        final int depth      = buf.getInt(44);
+        final int elements   = buf.getInt(48);
+        numFaces             = buf.getInt(52);
+        numLevels            = Math.max(1, buf.getInt(56));
+        final int kvBytes    = buf.getInt(60);
+        if( ByteOrder.BIG_ENDIAN == buf.order() && 1 < glTypeSize ) {
+            throw new IOException("Big endian KTX data of type size "+glTypeSize+" not supported");
+        }
+        validate(depth, elements);
+        upperLeftOrigin = parseOrientation(64, kvBytes);
+        
+        levelPos = new int[numLevels];
+        levelSize = new int[numLevels];
+        faceStride = new int[numLevels];
+        int pos = 64 + kvBytes;
+        for(int i=0; i<numLevels; i++) {
+            checkBounds(pos, 4);
+            final int imageSize = buf.getInt(pos);
+            pos += 4;
+            levelPos[i] = pos;
+            levelSize[i] = imageSize;
+            faceStride[i] = ( imageSize + 3 ) & ~3; // cube padding
+            pos += ( 1 == numFaces ) ? imageSize : numFaces * faceStride[i];
+            checkBounds(levelPos[i], pos - levelPos[i]);
+            pos = ( pos + 3 ) & ~3; // mip padding
+        }
+    }
+    
+    private void readHeader2() throws IOException {
+        vkFormat             = buf.getInt(12);
+        width                = buf.getInt(20);
+        height               = buf.getInt(24);
+        final int depth      = buf.getInt(28);
+        final int layers     = buf.getInt(32);
+        numFaces             = buf.getInt(36);
+        numLevels            = Math.max(1, buf.getInt(40));
+        final int supercompression = buf.getInt(44);
+        final int kvdOffset  = buf.getInt(56);
+        final int kvdLength  = buf.getInt(60);
+        if( 0 != supercompression ) {
+            throw new IOException("Supercompressed KTX 2 file, scheme "+supercompression+", not supported");
+        }
+        final int[] f = findVkFormat(vkFormat);
+        glInternalFormat = getGLInternalFormat(vkFormat);
+        if( 0 == glInternalFormat ) {
+            throw new IOException("Unsupported KTX 2 format "+vkFormat);
+        }
+        if( null != f ) {
+            glFormat = f[2];
+            glType = f[3];
+        }
+        validate(depth, layers);
+        upperLeftOrigin = parseOrientation(kvdOffset, kvdLength);
+        
+        levelPos = new int[numLevels];
+        levelSize = new int[numLevels];
+        faceStride = new int[numLevels];
+        for(int i=0; i<numLevels; i++) {
+            final int idx = 80 + 24 * i;
+            checkBounds(idx, 24);
+            final long offset = buf.getLong(idx);
+            final long length = buf.getLong(idx + 8);
+            if( offset < 0 || length < 0 || offset + length > buf.limit() ) {
+                throw new IOException("Truncated KTX file, level "+i);
+            }
+            levelPos[i] = (int) offset;
+            levelSize[i] = (int) ( length / numFaces );
+            faceStride[i] = levelSize[i];
+        }
+    }
+    
+    private void validate(int depth, int elements) throws IOException {
+        if( 0 >= width || 0 > height ) {
+            throw new IOException("Illegal KTX size "+width+"x"+height);
+        }
+        if( 1 < depth || 1 < elements ) {
+            throw new IOException("KTX 3D and array textures not supported");
+        }
+        if( 1 != numFaces && 6 != numFaces ) {
+            throw new IOException("Illegal KTX face count "+numFaces);
+        }
+        height = Math.max(1, height); // 1D texture
+    }
+    
+    private void checkBounds(int pos, int length) throws IOException {
+        if( pos < 0 || length < 0 || pos + length > buf.limit() ) {
+            throw new IOException("Truncated KTX file");
+        }
+    }
+    
+    /** @return false if the KTXorientation value denotes rows stored bottom up, otherwise true */
+    private boolean parseOrientation(int pos, int length) throws IOException {
+        checkBounds(pos, length);
+        final int end = pos + length;
+        while( pos + 4 <= end ) {
+            final int size = buf.getInt(pos);
+            final int start = pos + 4;
+            if( 0 > size || start + size > end ) {
+                break;
+            }
+            final String keyValue = getString(start, size);
+            final int sep = keyValue.indexOf('\0');
+            if( 0 < sep && KEY_ORIENTATION.equals(keyValue.substring(0, sep)) ) {
+                final String value = keyValue.substring(sep + 1);
+                // KTX 1: "S=r,T=u", KTX 2: "ru"
+                return 1 == version ? 0 > value.indexOf("T=u") : !( 1 < value.length() && 'u' == value.charAt(1) );
+            }
+            pos = ( start + size + 3 ) & ~3;
+        }
+        return true;
+    }
+    
+    private String getString(int pos, int length) {
+        final StringBuilder sb = new StringBuilder(length);
+        for(int i=0; i<length; i++) {
+            sb.append((char) ( buf.get(pos + i) & 0xFF ));
+        }
+        return sb.toString();
+    }
+}
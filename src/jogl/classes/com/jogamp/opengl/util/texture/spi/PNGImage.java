@@ -12,8 +12,12 @@ import javax.media.opengl.GL;
 
 import jogamp.opengl.util.pngj.ImageInfo;
 import jogamp.opengl.util.pngj.ImageLine;
+import jogamp.opengl.util.pngj.PngDeinterlacer;
+import jogamp.opengl.util.pngj.PngParallelEncoder;
 import jogamp.opengl.util.pngj.PngReader;
 import jogamp.opengl.util.pngj.PngWriter;
+import jogamp.opengl.util.pngj.chunks.PngChunkPLTE;
+import jogamp.opengl.util.pngj.chunks.PngChunkTRNS;
 import jogamp.opengl.util.pngj.chunks.PngChunkTextVar;
 
 import com.jogamp.common.nio.Buffers;
@@ -34,16 +38,6 @@ public class PNGImage {
         return new PNGImage(in);
     }
     
-    /** Reverse read and store, implicitly flip image to GL coords. */
-    private static final int getPixelRGBA8(ByteBuffer d, int dOff, ImageLine line, int lineOff, boolean hasAlpha) {
-        if(hasAlpha) {
-            d.put(dOff--, (byte)line.scanline[lineOff + 3]); // A
-        }
-        d.put(dOff--, (byte)line.scanline[lineOff + 2]); // B
-        d.put(dOff--, (byte)line.scanline[lineOff + 1]); // G        
-        d.put(dOff--, (byte)line.scanline[lineOff    ]); // R
-        return dOff;
-    }    
     /** Reverse read and store, implicitly flip image from GL coords. Handle reversed channels (BGR[A])*/
     private static int setPixelRGBA8(ImageLine line, int lineOff, ByteBuffer d, int dOff, boolean hasAlpha, boolean reversedChannels) {
         if(reversedChannels) {
@@ -80,54 +74,173 @@ public class PNGImage {
         this.data = data;        
     }
     
+    /**
+     * Decodes the PNG stream directly into the destination buffer, row by row, 
+     * using the unfiltered byte rows of {@link PngReader#readRowRaw()}.
+     * <p>
+     * The resulting format is
+     * <ul>
+     *   <li>Gray: {@link GL#GL_LUMINANCE}, or {@link GL#GL_LUMINANCE_ALPHA} if an alpha channel or a tRNS color key is present</li>
+     *   <li>RGB: {@link GL#GL_RGB}, or {@link GL#GL_RGBA} if an alpha channel or a tRNS color key is present</li>
+     *   <li>Palette: {@link GL#GL_RGB}, or {@link GL#GL_RGBA} if tRNS palette alpha is present</li>
+     * </ul>
+     * with 8 bits per component, i.e. 1, 2 and 4 bit gray is scaled up and 16 bit components are reduced to their most significant byte.
+     * </p>
+     * <p>
+     * Rows are stored bottom-to-top (OpenGL coord). 8 bit gray, gray+alpha, RGB and RGBA rows w/o tRNS are 
+     * bulk copied as-is, all other rows are converted into a reused row buffer first.
+     * Interlaced images are deinterlaced into a heap copy of the image first.
+     * </p>
+     */
     private PNGImage(InputStream in) {
         final PngReader pngr = new PngReader(new BufferedInputStream(in), null);
-        final int channels = pngr.imgInfo.channels;
-        if ( ! ( 1 == channels || 3 == channels || 4 == channels ) ) {
-            throw new RuntimeException("PNGImage can only handle Lum/RGB/RGBA [1/3/4 channels] images for now. Channels "+channels);
-        }
-        bytesPerPixel=pngr.imgInfo.bytesPixel;
-        if ( ! ( 1 == bytesPerPixel || 3 == bytesPerPixel || 4 == bytesPerPixel ) ) {
-            throw new RuntimeException("PNGImage can only handle Lum/RGB/RGBA [1/3/4 bpp] images for now. BytesPerPixel "+bytesPerPixel);
-        }
-        if(channels != bytesPerPixel) {
-            throw new RuntimeException("PNGImage currently only handles Channels [1/3/4] == BytePerPixel [1/3/4], channels: "+channels+", bytesPerPixel "+bytesPerPixel);
-        }
-        pixelWidth=pngr.imgInfo.cols;
-        pixelHeight=pngr.imgInfo.rows;
+        final ImageInfo imgInfo = pngr.imgInfo;
+        pixelWidth=imgInfo.cols;
+        pixelHeight=imgInfo.rows;
         dpi = new double[2];
         {
             final double[] dpi2 = pngr.getMetadata().getDpi();
             dpi[0]=dpi2[0];
             dpi[1]=dpi2[1];
         }
-        switch(channels) {
+        srcBitDepth = imgInfo.bitDepth;
+        srcChannels = imgInfo.channels;
+        final PngChunkTRNS trns = pngr.getMetadata().getTRNS();
+        if( imgInfo.indexed ) {
+            final PngChunkPLTE plte = pngr.getMetadata().getPLTE();
+            if( null == plte ) {
+                throw new RuntimeException("PNGImage: Indexed image w/o palette");
+            }
+            final int[] palAlpha = null != trns ? trns.getPalletteAlpha() : null;
+            bytesPerPixel = null != palAlpha ? 4 : 3;
+            paletteLUT = new byte[256 * bytesPerPixel];
+            final int[] rgb = new int[3];
+            for(int i = 0, j = 0; i < plte.getNentries(); i++) {
+                plte.getEntryRgb(i, rgb);
+                paletteLUT[j++] = (byte) rgb[0];
+                paletteLUT[j++] = (byte) rgb[1];
+                paletteLUT[j++] = (byte) rgb[2];
+                if( null != palAlpha ) {
+                    paletteLUT[j++] = i < palAlpha.length ? (byte) palAlpha[i] : (byte) 0xff;
+                }
+            }
+            trnsKey = null;
+        } else {
+            paletteLUT = null;
+            if( null != trns && !imgInfo.alpha ) {
+                trnsKey = imgInfo.greyscale ? new int[] { trns.getGray() } : trns.getRGB();
+            } else {
+                trnsKey = null;
+            }
+            bytesPerPixel = srcChannels + ( null != trnsKey ? 1 : 0 );
+        }
+        switch(bytesPerPixel) {
             case 1: glFormat = GL.GL_LUMINANCE; break;
+            case 2: glFormat = GL.GL_LUMINANCE_ALPHA; break;
             case 3: glFormat = GL.GL_RGB; break;
             case 4: glFormat = GL.GL_RGBA; break;
-            default: throw new InternalError("XXX: channels: "+channels+", bytesPerPixel "+bytesPerPixel);
+            default: throw new InternalError("XXX: channels: "+srcChannels+", bytesPerPixel "+bytesPerPixel);
         }
-        data = Buffers.newDirectByteBuffer(bytesPerPixel * pixelWidth * pixelHeight);
         reversedChannels = false; // RGB[A]
-        final boolean hasAlpha = 4 == channels;
-        int dataOff = bytesPerPixel * pixelWidth * pixelHeight - 1; // start at end-of-buffer, reverse store
-        for (int row = 0; row < pixelHeight; row++) {
-            final ImageLine l1 = pngr.readRow(row);
-            int lineOff = ( pixelWidth - 1 ) * bytesPerPixel ;      // start w/ last pixel in line, reverse read
-            if(1 == channels) {
-                for (int j = pixelWidth - 1; j >= 0; j--) {
-                    data.put(dataOff--, (byte)l1.scanline[lineOff--]); // Luminance, 1 bytesPerPixel
-                }
-            } else {
-                for (int j = pixelWidth - 1; j >= 0; j--) {
-                    dataOff = getPixelRGBA8(data, dataOff, l1, lineOff, hasAlpha);
-                    lineOff -= bytesPerPixel;
+        
+        final int rowBytes = bytesPerPixel * pixelWidth;
+        data = Buffers.newDirectByteBuffer(rowBytes * pixelHeight);
+        if( !pngr.isInterlaced() ) {
+            // 8 bit direct color w/o color key: unfiltered row is the texture row 
+            final boolean asIs = 8 == srcBitDepth && null == paletteLUT && null == trnsKey;
+            final byte[] row = asIs ? null : new byte[rowBytes];
+            for (int y = 0; y < pixelHeight; y++) {
+                final byte[] raw = pngr.readRowRaw();
+                data.position( ( pixelHeight - 1 - y ) * rowBytes ); // flip to GL coords
+                if( asIs ) {
+                    data.put(raw, 1, rowBytes);
+                } else {
+                    convertRow(raw, pixelWidth, row, 0, bytesPerPixel);
+                    data.put(row, 0, rowBytes);
                 }
             }
+        } else {
+            final PngDeinterlacer dil = pngr.getDeinterlacer();
+            final byte[] image = new byte[rowBytes * pixelHeight];
+            final int rawRows = dil.getTotalRows();
+            for (int i = 0; i < rawRows; i++) {
+                final byte[] raw = pngr.readRowRaw();
+                convertRow(raw, dil.getCols(), image, 
+                           dil.getRow() * rowBytes + dil.getOffsetX() * bytesPerPixel, 
+                           dil.getDeltaX() * bytesPerPixel);
+            }
+            for (int y = 0; y < pixelHeight; y++) {
+                data.position( ( pixelHeight - 1 - y ) * rowBytes ); // flip to GL coords
+                data.put(image, y * rowBytes, rowBytes);
+            }
         }
+        data.rewind();
         pngr.end();
     }
+    
+    /**
+     * Converts <code>cols</code> pixels of the unfiltered PNG row <code>raw</code>, starting at index 1,
+     * into the destination format, storing pixel <code>i</code> at <code>dst[dstOff + i * dstStride]</code>.
+     */
+    private void convertRow(byte[] raw, int cols, byte[] dst, int dstOff, int dstStride) {
+        final int bd = srcBitDepth;
+        if( null != paletteLUT ) {
+            final byte[] lut = paletteLUT;
+            final int bpp = bytesPerPixel;
+            for (int x = 0, d = dstOff; x < cols; x++, d += dstStride) {
+                final int p = ( 8 == bd ? ( raw[1 + x] & 0xff ) : packedSample(raw, x, bd) ) * bpp;
+                dst[d    ] = lut[p    ];
+                dst[d + 1] = lut[p + 1];
+                dst[d + 2] = lut[p + 2];
+                if( 4 == bpp ) {
+                    dst[d + 3] = lut[p + 3];
+                }
+            }
+        } else if( 8 > bd ) {
+            // gray 1, 2 or 4 bit, scaled to 8 bit
+            final int scale = 255 / ( ( 1 << bd ) - 1 );
+            final int key = null != trnsKey ? trnsKey[0] : -1;
+            for (int x = 0, d = dstOff; x < cols; x++, d += dstStride) {
+                final int v = packedSample(raw, x, bd);
+                dst[d] = (byte) ( v * scale );
+                if( 0 <= key ) {
+                    dst[d + 1] = v == key ? 0 : (byte) 0xff;
+                }
+            }
+        } else {
+            // 8 or 16 bit components, the latter reduced to the most significant byte
+            final int sc = srcChannels;
+            final int sBytes = bd / 8;
+            final int[] key = trnsKey;
+            for (int x = 0, s = 1, d = dstOff; x < cols; x++, d += dstStride) {
+                boolean transparent = null != key;
+                for (int c = 0; c < sc; c++, s += sBytes) {
+                    dst[d + c] = raw[s];
+                    if( transparent ) {
+                        final int v = 1 == sBytes ? ( raw[s] & 0xff ) : ( ( raw[s] & 0xff ) << 8 ) | ( raw[s + 1] & 0xff );
+                        transparent = v == key[c];
+                    }
+                }
+                if( null != key ) {
+                    dst[d + sc] = transparent ? 0 : (byte) 0xff;
+                }
+            }
+        }
+    }
+    
+    /** Returns the packed sample <code>x</code> of bit depth 1, 2 or 4 of the PNG row <code>raw</code>, starting at index 1. */
+    private static int packedSample(byte[] raw, int x, int bd) {
+        final int bit = x * bd;
+        return ( raw[1 + ( bit >> 3 )] >> ( 8 - bd - ( bit & 7 ) ) ) & ( ( 1 << bd ) - 1 );
+    }
+    
     private final int pixelWidth, pixelHeight, glFormat, bytesPerPixel;
+    /** Source bit depth and channels, only used while decoding */
+    private int srcBitDepth, srcChannels;
+    /** Palette of an indexed source as RGB[A] entries of {@link #bytesPerPixel}, otherwise null */
+    private byte[] paletteLUT;
+    /** tRNS color key of a gray or RGB source w/o alpha channel, otherwise null */
+    private int[] trnsKey;
     private boolean reversedChannels;
     private final double[] dpi;
     private final ByteBuffer data;
@@ -158,6 +271,20 @@ public class PNGImage {
     public ByteBuffer getData()  { return data; }
 
     public void write(File out, boolean allowOverwrite) throws IOException {        
+        write(out, allowOverwrite, 1);
+    }
+    
+    /**
+     * Writes this image to file.
+     * <p>
+     * If <code>threadCount</code> is greater than 1, the image is encoded in parallel stripes
+     * with a filter type chosen per row, see {@link PngParallelEncoder}. 
+     * The encoder and its buffers are shared and reused by subsequent calls, e.g. for a sequence of frames.
+     * Falls back to the sequential encoder, if parallel encoding is not supported by the runtime.
+     * </p>
+     * @param threadCount number of encoding threads, 1 for the sequential encoder, 0 for the number of available processors
+     */
+    public void write(File out, boolean allowOverwrite, int threadCount) throws IOException {
         final ImageInfo imi = new ImageInfo(pixelWidth, pixelHeight, 8, (4 == bytesPerPixel) ? true : false); // 8 bits per channel, no alpha 
         // open image for writing to a output stream
         final OutputStream outs = new BufferedOutputStream(IOUtil.getFileOutputStream(out, allowOverwrite));
@@ -168,6 +295,14 @@ public class PNGImage {
             png.getMetadata().setTimeNow(0); // 0 seconds fron now = now
             png.getMetadata().setText(PngChunkTextVar.KEY_Title, "JogAmp PNGImage");
             // png.getMetadata().setText("my key", "my text");
+            if( 1 != threadCount && 1 != bytesPerPixel && PngParallelEncoder.isAvailable() ) {
+                png.writeRowsParallel(getParallelEncoder(threadCount), new PngParallelEncoder.RowSource() {
+                    public void getRow(int row, byte[] dst, int dstOff) {
+                        getRowBytes(row, dst, dstOff);
+                    } } );
+                png.end();
+                return;
+            }
             final boolean hasAlpha = 4 == bytesPerPixel;
             final ImageLine l1 = new ImageLine(imi);
             int dataOff = bytesPerPixel * pixelWidth * pixelHeight - 1; // start at end-of-buffer, reverse read
@@ -191,5 +326,49 @@ public class PNGImage {
         }
     }
     
+    /** 
+     * Copies the PNG row <code>row</code> (0 is top), i.e. the flipped data row, in RGB[A] order, 
+     * handling reversed channels like <code>setPixelRGBA8(..)</code>. 
+     */
+    private void getRowBytes(int row, byte[] dst, int dstOff) {
+        final int rowBytes = bytesPerPixel * pixelWidth;
+        final ByteBuffer src = data.duplicate();
+        src.position( ( pixelHeight - 1 - row ) * rowBytes ); // flip from GL coords
+        src.get(dst, dstOff, rowBytes);
+        if( reversedChannels ) {
+            final int end = dstOff + rowBytes;
+            if( 4 == bytesPerPixel ) {
+                for(int i = dstOff; i < end; i += 4) {
+                    final byte b0 = dst[i], b1 = dst[i + 1];
+                    dst[i    ] = dst[i + 3];
+                    dst[i + 1] = dst[i + 2];
+                    dst[i + 2] = b1;
+                    dst[i + 3] = b0;
+                }
+            } else {
+                for(int i = dstOff; i < end; i += 3) {
+                    final byte b0 = dst[i];
+                    dst[i    ] = dst[i + 2];
+                    dst[i + 2] = b0;
+                }
+            }
+        }
+    }
+    
+    private static PngParallelEncoder parallelEncoder = null;
+    
+    /** Returns the shared parallel encoder, recreated if the thread count changes. */
+    private static synchronized PngParallelEncoder getParallelEncoder(int threadCount) {
+        if( null != parallelEncoder && 
+            parallelEncoder.getThreadCount() != ( 0 < threadCount ? threadCount : Runtime.getRuntime().availableProcessors() ) ) {
+            parallelEncoder.dispose();
+            parallelEncoder = null;
+        }
+        if( null == parallelEncoder ) {
+            parallelEncoder = new PngParallelEncoder(threadCount);
+        }
+        return parallelEncoder;
+    }
+    
     public String toString() { return "PNGImage["+pixelWidth+"x"+pixelHeight+", dpi "+dpi[0]+" x "+dpi[1]+", bytesPerPixel "+bytesPerPixel+", reversedChannels "+reversedChannels+", "+data+"]"; }       
 }
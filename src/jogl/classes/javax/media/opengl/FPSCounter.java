@@ -114,4 +114,45 @@ public interface FPSCounter {
      * @see #resetFPSCounter()
      */
     float getTotalFPS();       
+
+    /**
+     * @return Shortest duration between two consecutive frames of the last update interval in milliseconds
+     *
+     * @see #setUpdateFPSFrames(int, PrintStream)
+     * @see #resetFPSCounter()
+     */
+    float getLastFrameTimeMin();
+
+    /**
+     * @return Average duration between two consecutive frames of the last update interval in milliseconds
+     *
+     * @see #setUpdateFPSFrames(int, PrintStream)
+     * @see #resetFPSCounter()
+     */
+    float getLastFrameTimeAvg();
+
+    /**
+     * @return 99th percentile of the durations between two consecutive frames of the last update interval in milliseconds,
+     *         i.e. only 1% of the frames took longer. 
+     *
+     * @see #setUpdateFPSFrames(int, PrintStream)
+     * @see #resetFPSCounter()
+     */
+    float getLastFrameTimeP99();
+
+    /**
+     * @return Longest duration between two consecutive frames of the last update interval in milliseconds
+     *
+     * @see #setUpdateFPSFrames(int, PrintStream)
+     * @see #resetFPSCounter()
+     */
+    float getLastFrameTimeMax();
+
+    /**
+     * @return Number of frame deadlines missed since {@link #getFPSStartTime()}, 
+     *         only tracked by a pacing animator, e.g. {@link com.jogamp.opengl.util.FPSAnimator}, otherwise 0.
+     *
+     * @see #resetFPSCounter()
+     */
+    int getTotalMissedDeadlines();
 }
@@ -53,6 +53,7 @@ import java.awt.image.DataBufferByte;
 import java.awt.image.DataBufferInt;
 import java.beans.Beans;
 import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.nio.IntBuffer;
 
 import javax.media.nativewindow.AbstractGraphicsDevice;
@@ -89,6 +90,7 @@ import jogamp.opengl.awt.Java2DGLContext;
 import com.jogamp.nativewindow.awt.AWTWindowClosingProtocol;
 import com.jogamp.opengl.FBObject;
 import com.jogamp.opengl.util.GLBuffers;
+import com.jogamp.opengl.util.GLReadBufferUtil;
 
 // FIXME: Subclasses need to call resetGLFunctionAvailability() on their
 // context whenever the displayChanged() function is called on their
@@ -159,6 +161,11 @@ public class GLJPanel extends JPanel implements AWTGLAutoDrawable, WindowClosing
   private static boolean softwareRenderingDisabled =
     Debug.isPropertyDefined("jogl.gljpanel.nosw", true);
 
+  // Flips on the GPU and reads back via pixel buffer objects in the pbuffer-based backend,
+  // see setAsyncReadback(boolean)
+  private volatile boolean asyncReadback =
+    Debug.isPropertyDefined("jogl.gljpanel.asyncreadback", true);
+
   // Indicates whether the Java 2D OpenGL pipeline is enabled
   private boolean oglPipelineEnabled =
     Java2D.isOGLPipelineActive() &&
@@ -445,6 +452,31 @@ public class GLJPanel extends JPanel implements AWTGLAutoDrawable, WindowClosing
     return helper.getAnimator();
   }
 
+  /**
+   * Enables or disables the GPU read back mode of the pbuffer-based offscreen path,
+   * used unless the Java 2D / OpenGL pipeline is active.
+   * <p>
+   * If enabled and supported, i.e. framebuffer blit and pixel buffer objects are available,
+   * the rendered frame is flipped vertically on the GPU into an {@link FBObject}
+   * and read back through two alternating pixel buffer objects.
+   * While an {@link #getAnimator() animator} is animating, the pixels of frame <code>N</code>
+   * are copied into the image while frame <code>N+1</code> is being read back,
+   * i.e. the displayed image lags one frame behind the rendering. 
+   * Otherwise the frame is read back synchronously.
+   * </p>
+   * <p>
+   * Default is disabled, unless property <code>jogl.gljpanel.asyncreadback</code> is set.
+   * </p>
+   */
+  public void setAsyncReadback(boolean enable) {
+    asyncReadback = enable;
+  }
+
+  /** @see #setAsyncReadback(boolean) */
+  public boolean getAsyncReadback() {
+    return asyncReadback;
+  }
+
   @Override
   public boolean invoke(boolean wait, GLRunnable glRunnable) {
     return helper.invoke(this, wait, glRunnable);
@@ -686,6 +718,9 @@ public class GLJPanel extends JPanel implements AWTGLAutoDrawable, WindowClosing
     @Override
     public void dispose(GLAutoDrawable drawable) {
       helper.dispose(GLJPanel.this);
+      if (backend instanceof AbstractReadbackBackend) {
+        ((AbstractReadbackBackend) backend).disposeGL(drawable.getGL());
+      }
     }
 
     @Override
@@ -850,12 +885,20 @@ public class GLJPanel extends JPanel implements AWTGLAutoDrawable, WindowClosing
     private int glFormat;
     private int glType;
 
-    // For saving/restoring of OpenGL state during ReadPixels
-    private int[] swapbytes    = new int[1];
-    private int[] rowlength    = new int[1];
-    private int[] skiprows     = new int[1];
-    private int[] skippixels   = new int[1];
-    private int[] alignment    = new int[1];
+    // Pixel pack state required for ReadPixels, see setPackState(..)
+    private final int[] packStateNames    = { GL2.GL_PACK_SWAP_BYTES, GL2.GL_PACK_ROW_LENGTH, GL2.GL_PACK_SKIP_ROWS,
+                                              GL2.GL_PACK_SKIP_PIXELS, GL2.GL_PACK_ALIGNMENT };
+    private final int[] packStateRequired = { GL.GL_FALSE, 0, 0, 0, 1 };
+    private final int[] packStateSaved    = new int[packStateNames.length];
+    private int packStateChanged; // bit mask of packStateNames
+
+    // GPU read back, see setAsyncReadback(boolean)
+    private int gpuReadbackAvail; // 0: unknown, 1: available, -1: not available
+    private FBObject flipFBO;
+    private final int[] packPBOs = new int[2];
+    private int packPBOSize;      // size in bytes of each packPBOs
+    private int packPBOIdx;       // packPBOs element to read the next frame into
+    private boolean packPBOPending; // packPBOs[packPBOIdx^1] holds the previous, not yet copied frame
 
     @Override
     public void setOpaque(boolean opaque) {
@@ -911,6 +954,7 @@ public class GLJPanel extends JPanel implements AWTGLAutoDrawable, WindowClosing
               glFormat = GL.GL_BGRA;
               glType   = getGLPixelType();
               readBackInts = IntBuffer.allocate(readBackWidthInPixels * readBackHeightInPixels);
+              packPBOPending = false; // pending frame has the old size
               break;
 
             default:
@@ -923,20 +967,12 @@ public class GLJPanel extends JPanel implements AWTGLAutoDrawable, WindowClosing
           }
         }
 
-        if (offscreenImage != null) {
+        if (offscreenImage != null && readBackInts != null && asyncReadback &&
+            supportsGPUReadback() && isGPUReadbackAvailable(getGL())) {
+          readBackGPU(getGL().getGL2());
+        } else if (offscreenImage != null) {
           GL2 gl = getGL().getGL2();
-          // Save current modes
-          gl.glGetIntegerv(GL2.GL_PACK_SWAP_BYTES,    swapbytes, 0);
-          gl.glGetIntegerv(GL2.GL_PACK_ROW_LENGTH,    rowlength, 0);
-          gl.glGetIntegerv(GL2.GL_PACK_SKIP_ROWS,     skiprows, 0);
-          gl.glGetIntegerv(GL2.GL_PACK_SKIP_PIXELS,   skippixels, 0);
-          gl.glGetIntegerv(GL2.GL_PACK_ALIGNMENT,     alignment, 0);
-
-          gl.glPixelStorei(GL2.GL_PACK_SWAP_BYTES,    GL.GL_FALSE);
-          gl.glPixelStorei(GL2.GL_PACK_ROW_LENGTH,    readBackWidthInPixels);
-          gl.glPixelStorei(GL2.GL_PACK_SKIP_ROWS,     0);
-          gl.glPixelStorei(GL2.GL_PACK_SKIP_PIXELS,   0);
-          gl.glPixelStorei(GL2.GL_PACK_ALIGNMENT,     1);
+          setPackState(gl, readBackWidthInPixels);
 
           // Actually read the pixels.
           gl.glReadBuffer(GL2.GL_FRONT);
@@ -946,12 +982,7 @@ public class GLJPanel extends JPanel implements AWTGLAutoDrawable, WindowClosing
             gl.glReadPixels(0, 0, readBackWidthInPixels, readBackHeightInPixels, glFormat, glType, readBackInts);
           }
 
-          // Restore saved modes.
-          gl.glPixelStorei(GL2.GL_PACK_SWAP_BYTES,  swapbytes[0]);
-          gl.glPixelStorei(GL2.GL_PACK_ROW_LENGTH,  rowlength[0]);
-          gl.glPixelStorei(GL2.GL_PACK_SKIP_ROWS,   skiprows[0]);
-          gl.glPixelStorei(GL2.GL_PACK_SKIP_PIXELS, skippixels[0]);
-          gl.glPixelStorei(GL2.GL_PACK_ALIGNMENT,   alignment[0]);
+          restorePackState(gl);
 
           if (readBackBytes != null || readBackInts != null) {
             // Copy temporary data into raster of BufferedImage for faster
@@ -1009,6 +1040,138 @@ public class GLJPanel extends JPanel implements AWTGLAutoDrawable, WindowClosing
       }
     }
 
+    /**
+     * Sets the pixel pack state required for ReadPixels and saves the current one.
+     * Only differing values are set, while the current values are served 
+     * by the context's pixel state tracker w/o a GL round trip.
+     */
+    private void setPackState(GL2 gl, int rowLength) {
+      packStateRequired[1] = rowLength;
+      packStateChanged = 0;
+      for (int i = 0; i < packStateNames.length; i++) {
+        gl.glGetIntegerv(packStateNames[i], packStateSaved, i);
+        if (packStateSaved[i] != packStateRequired[i]) {
+          gl.glPixelStorei(packStateNames[i], packStateRequired[i]);
+          packStateChanged |= 1 << i;
+        }
+      }
+    }
+
+    /** Restores the pixel pack state values changed by {@link #setPackState(GL2, int)}. */
+    private void restorePackState(GL2 gl) {
+      for (int i = 0; 0 != packStateChanged; i++) {
+        if (0 != (packStateChanged & (1 << i))) {
+          gl.glPixelStorei(packStateNames[i], packStateSaved[i]);
+          packStateChanged &= ~(1 << i);
+        }
+      }
+    }
+
+    /**
+     * A multisampled default framebuffer can only be resolved by an unscaled and unflipped blit,
+     * hence the CPU path is used for it.
+     */
+    private boolean isGPUReadbackAvailable(GL gl) {
+      if (0 == gpuReadbackAvail) {
+        final GLCapabilitiesImmutable caps = getChosenGLCapabilities();
+        gpuReadbackAvail = ( gl.isGL2() && gl.isFunctionAvailable("glBlitFramebuffer") && 
+                             GLReadBufferUtil.isPBOAvailable(gl) &&
+                             null != caps && !caps.getSampleBuffers() ) ? 1 : -1;
+        if (DEBUG) {
+          System.err.println(getThreadName()+": GLJPanel: GPU read back available: "+(0 < gpuReadbackAvail));
+        }
+      }
+      return 0 < gpuReadbackAvail;
+    }
+
+    /**
+     * Blits the front buffer vertically flipped into flipFBO, reads it into the current packPBOs element
+     * and copies either the previous frame (animating) or this frame into the image raster.
+     */
+    private void readBackGPU(GL2 gl) {
+      final int width  = offscreenImage.getWidth();
+      final int height = offscreenImage.getHeight();
+      final int size   = width * height * 4;
+
+      if (null == flipFBO) {
+        flipFBO = new FBObject();
+      }
+      flipFBO.reset(gl, width, height);
+      if (0 == flipFBO.getColorAttachmentCount()) {
+        flipFBO.attachColorbuffer(gl, 0, true);
+      }
+      if (0 == packPBOs[0]) {
+        gl.glGenBuffers(packPBOs.length, packPBOs, 0);
+        packPBOSize = 0;
+      }
+      if (size != packPBOSize) {
+        for (int i = 0; i < packPBOs.length; i++) {
+          gl.glBindBuffer(GL2.GL_PIXEL_PACK_BUFFER, packPBOs[i]);
+          gl.glBufferData(GL2.GL_PIXEL_PACK_BUFFER, size, null, GL2.GL_STREAM_READ);
+        }
+        packPBOSize = size;
+        packPBOPending = false;
+      }
+
+      flipFBO.bind(gl);
+      gl.glBindFramebuffer(GL2.GL_READ_FRAMEBUFFER, gl.getDefaultReadFramebuffer());
+      gl.glReadBuffer(GL2.GL_FRONT);
+      if (flipVertically()) {
+        gl.glBlitFramebuffer(0, 0, width, height, 0, height, width, 0, GL.GL_COLOR_BUFFER_BIT, GL.GL_NEAREST);
+      } else {
+        gl.glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL.GL_COLOR_BUFFER_BIT, GL.GL_NEAREST);
+      }
+      gl.glBindFramebuffer(GL2.GL_READ_FRAMEBUFFER, flipFBO.getReadFramebuffer());
+      gl.glReadBuffer(GL.GL_COLOR_ATTACHMENT0);
+
+      final int readIdx = packPBOIdx;
+      setPackState(gl, 0);
+      gl.glBindBuffer(GL2.GL_PIXEL_PACK_BUFFER, packPBOs[readIdx]);
+      gl.glReadPixels(0, 0, width, height, glFormat, glType, 0L);
+      restorePackState(gl);
+      flipFBO.unbind(gl);
+
+      // Pipeline only while animated, otherwise a static scene would show the previous frame
+      final GLAnimatorControl animator = getAnimator();
+      final boolean pipelined = null != animator && animator.isAnimating();
+      final int copyIdx = ( pipelined && packPBOPending ) ? readIdx ^ 1 : readIdx;
+
+      gl.glBindBuffer(GL2.GL_PIXEL_PACK_BUFFER, packPBOs[copyIdx]);
+      final ByteBuffer pixels = gl.glMapBuffer(GL2.GL_PIXEL_PACK_BUFFER, GL2.GL_READ_ONLY);
+      if (null != pixels) {
+        final int[] dest = ((DataBufferInt) offscreenImage.getRaster().getDataBuffer()).getData();
+        pixels.order(ByteOrder.nativeOrder()).asIntBuffer().get(dest, 0, width * height);
+        gl.glUnmapBuffer(GL2.GL_PIXEL_PACK_BUFFER);
+      }
+      gl.glBindBuffer(GL2.GL_PIXEL_PACK_BUFFER, 0);
+
+      if (pipelined) {
+        packPBOPending = true;
+        packPBOIdx = readIdx ^ 1;
+      } else {
+        packPBOPending = false;
+      }
+    }
+
+    /** Releases the GPU read back resources, the context must be current. */
+    protected void disposeGL(GL gl) {
+      if (null != flipFBO) {
+        flipFBO.destroy(gl);
+        flipFBO = null;
+      }
+      if (0 != packPBOs[0]) {
+        gl.glDeleteBuffers(packPBOs.length, packPBOs, 0);
+        packPBOs[0] = 0;
+        packPBOs[1] = 0;
+      }
+      packPBOSize = 0;
+      packPBOPending = false;
+      gpuReadbackAvail = 0;
+    }
+
+    /** Returns true if {@link #readBackGPU(GL2)} may be used, i.e. the context is hardware accelerated. */
+    protected boolean supportsGPUReadback() { return false; }
+
     protected abstract void    doPaintComponentImpl();
     protected abstract int     getGLPixelType();
     protected abstract boolean flipVertically();
@@ -1286,6 +1449,11 @@ public class GLJPanel extends JPanel implements AWTGLAutoDrawable, WindowClosing
       return GL2.GL_UNSIGNED_INT_8_8_8_8_REV;
     }
 
+    @Override
+    protected boolean supportsGPUReadback() {
+      return true;
+    }
+
     @Override
     protected boolean flipVertically() {
       return true;
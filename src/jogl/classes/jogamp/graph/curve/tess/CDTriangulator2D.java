@@ -52,8 +52,8 @@ public class CDTriangulator2D implements Triangulator{
     private ArrayList<Loop> loops;
     private ArrayList<Vertex> vertices;
     
-    private ArrayList<Triangle> triangles;
-    private int maxTriID = 0;
+    protected ArrayList<Triangle> triangles;
+    protected int maxTriID = 0;
 
     
     /** Constructor for a new Delaunay triangulator
@@ -95,43 +95,53 @@ public class CDTriangulator2D implements Triangulator{
     
     public ArrayList<Triangle> generate() {    
         for(int i=0;i<loops.size();i++) {
-            Loop loop = loops.get(i);
-            int numTries = 0;
-            int size = loop.computeLoopSize();
-            while(!loop.isSimplex()){
-                Triangle tri = null;
-                if(numTries > size){
-                    tri = loop.cut(false);
-                }
-                else{
-                    tri = loop.cut(true);
-                }
-                numTries++;
+            maxTriID = cutLoop(loops.get(i), triangles, maxTriID);
+        }
+        return triangles;
+    }
+
+    /** Ear clips the given loop into triangles
+     * @param loop the loop to be triangulated, consumed
+     * @param triangles the list the resulting triangles are appended to
+     * @param maxTriID the next free triangle id
+     * @return the next free triangle id
+     */
+    protected static int cutLoop(Loop loop, ArrayList<Triangle> triangles, int maxTriID) {
+        int numTries = 0;
+        int size = loop.computeLoopSize();
+        while(!loop.isSimplex()){
+            Triangle tri = null;
+            if(numTries > size){
+                tri = loop.cut(false);
+            }
+            else{
+                tri = loop.cut(true);
+            }
+            numTries++;
 
-                if(tri != null) {
-                    numTries = 0;
-                    size--;
-                    tri.setId(maxTriID++);
-                    triangles.add(tri);
-                    if(DEBUG){
-                        System.err.println(tri);
-                    }
+            if(tri != null) {
+                numTries = 0;
+                size--;
+                tri.setId(maxTriID++);
+                triangles.add(tri);
+                if(DEBUG){
+                    System.err.println(tri);
                 }
-                if(numTries > size*2){
-                    if(DEBUG){
-                        System.err.println("Triangulation not complete!");
-                    }
-                    break;
+            }
+            if(numTries > size*2){
+                if(DEBUG){
+                    System.err.println("Triangulation not complete!");
                 }
+                break;
             }
-            Triangle tri = loop.cut(true);
-            if(tri != null)
-                triangles.add(tri);
         }
-        return triangles;
+        Triangle tri = loop.cut(true);
+        if(tri != null)
+            triangles.add(tri);
+        return maxTriID;
     }
 
-    private GraphOutline extractBoundaryTriangles(GraphOutline outline, boolean hole) {
+    protected GraphOutline extractBoundaryTriangles(GraphOutline outline, boolean hole) {
         GraphOutline innerOutline = new GraphOutline();
         ArrayList<GraphVertex> outVertices = outline.getGraphPoint();
         int size = outVertices.size();
@@ -0,0 +1,634 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package jogamp.graph.curve.tess;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Comparator;
+import java.util.TreeSet;
+
+import com.jogamp.graph.geom.AABBox;
+import com.jogamp.graph.geom.Outline;
+import com.jogamp.graph.geom.Triangle;
+import com.jogamp.graph.geom.Vertex;
+import com.jogamp.graph.math.VectorUtil;
+
+/**
+ * Triangulation of a list of Outlines, defining a set of closed regions with optional n holes,
+ * by sweep line decomposition into y-monotone polygons.
+ * <p>
+ * The curve triangles of the outlines are extracted like {@link CDTriangulator2D} does,
+ * the remaining inner polygon of each region and its holes is split into y-monotone pieces
+ * by a top down sweep maintaining the crossed edges in a balanced tree,
+ * each piece is triangulated in linear time.
+ * Hence a region of n vertices is triangulated in O(n log n),
+ * while the ear clipping of {@link CDTriangulator2D} is at least quadratic.
+ * </p>
+ * <p>
+ * The triangles are not Delaunay, i.e. they may be thinner than the ones of {@link CDTriangulator2D}.
+ * A region whose decomposition fails, e.g. due to self intersecting or degenerated outlines,
+ * is triangulated by the {@link CDTriangulator2D} ear clipping.
+ * </p>
+ */
+public class MonotoneTriangulator2D extends CDTriangulator2D {
+    private static final int START   = 0;
+    private static final int END     = 1;
+    private static final int SPLIT   = 2;
+    private static final int MERGE   = 3;
+    private static final int REGULAR = 4;
+
+    private ArrayList<Region> regions;
+
+    /** Closed region, i.e. the inner polygons of an outer outline and its holes */
+    private static class Region {
+        final GraphOutline outer;
+        final AABBox box;
+        final ArrayList<GraphOutline> holes = new ArrayList<GraphOutline>();
+        final ArrayList<AABBox> holeBoxes = new ArrayList<AABBox>();
+
+        Region(GraphOutline outer) {
+            this.outer = outer;
+            this.box = outer.getOutline().getBounds();
+        }
+
+        void addHole(GraphOutline hole) {
+            holes.add(hole);
+            holeBoxes.add(hole.getOutline().getBounds());
+        }
+
+        /** @return true if <code>v</code> lies inside the outer polygon but not inside one of its holes */
+        boolean contains(Vertex v) {
+            if( !isInside(outer, box, v) ) {
+                return false;
+            }
+            for(int i=0; i<holes.size(); i++) {
+                if( isInside(holes.get(i), holeBoxes.get(i), v) ) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    /** Polygon vertex, linked to its ring neighbors so that the interior lies left of prev -> this -> next */
+    private static class Node {
+        final GraphVertex gv;
+        final float x, y;
+        Node prev, next;
+        /** position in sweep order */
+        int order;
+        int type;
+        /** helper of the edge this -> next while it is crossed by the sweep line */
+        Node helper;
+        /** diagonals starting at this node, both directions are added */
+        ArrayList<HalfEdge> diagonals = null;
+        /** the ring edge this -> next has been traversed */
+        boolean ringUsed = false;
+
+        Node(GraphVertex gv, float x, float y) {
+            this.gv = gv;
+            this.x = x;
+            this.y = y;
+        }
+    }
+
+    private static class HalfEdge {
+        final Node to;
+        boolean used = false;
+
+        HalfEdge(Node to) {
+            this.to = to;
+        }
+    }
+
+    /** Sweep order, top down and left to right within a row */
+    private static final Comparator<Node> sweepOrder = new Comparator<Node>() {
+        public int compare(Node a, Node b) {
+            if( a.y > b.y ) {
+                return -1;
+            } else if( a.y < b.y ) {
+                return 1;
+            } else if( a.x < b.x ) {
+                return -1;
+            } else if( a.x > b.x ) {
+                return 1;
+            }
+            return 0;
+        }
+    };
+
+    /**
+     * Left to right order of the edges crossed by the sweep line at {@link #sweepY},
+     * the edge <code>n -> n.next</code> is represented by <code>n</code>.
+     * A probe node, i.e. w/o vertex, sorts after edges crossing the sweep line at its position.
+     */
+    private final Comparator<Node> edgeOrder = new Comparator<Node>() {
+        public int compare(Node a, Node b) {
+            if( a == b ) {
+                return 0;
+            }
+            final float xa = xAt(a, sweepY);
+            final float xb = xAt(b, sweepY);
+            if( xa < xb ) {
+                return -1;
+            } else if( xa > xb ) {
+                return 1;
+            } else if( null == a.gv ) {
+                return 1;
+            } else if( null == b.gv ) {
+                return -1;
+            }
+            // edges sharing a point on the sweep line: compare further down
+            final float y = Math.max(a.next.y, b.next.y);
+            if( y < sweepY ) {
+                final float xa1 = xAt(a, y);
+                final float xb1 = xAt(b, y);
+                if( xa1 < xb1 ) {
+                    return -1;
+                } else if( xa1 > xb1 ) {
+                    return 1;
+                }
+            }
+            return a.order - b.order;
+        }
+    };
+
+    private float sweepY;
+    private TreeSet<Node> status;
+
+    /** Constructor for a new monotone triangulator
+     */
+    public MonotoneTriangulator2D() {
+        super();
+    }
+
+    @Override
+    public void reset() {
+        super.reset();
+        regions = new ArrayList<Region>();
+    }
+
+    @Override
+    public void addCurve(Outline polyline) {
+        Region region = null;
+        if(!regions.isEmpty()) {
+            region = getContainerRegion(polyline);
+        }
+        if(null == region) {
+            GraphOutline outline = new GraphOutline(polyline);
+            regions.add(new Region(extractBoundaryTriangles(outline, false)));
+        } else {
+            GraphOutline outline = new GraphOutline(polyline);
+            region.addHole(extractBoundaryTriangles(outline, true));
+        }
+    }
+
+    @Override
+    public ArrayList<Triangle> generate() {
+        for(int i=0; i<regions.size(); i++) {
+            final Region region = regions.get(i);
+            final int triCount = triangles.size();
+            final int triID = maxTriID;
+            boolean done;
+            try {
+                done = triangulate(region);
+            } catch (RuntimeException e) {
+                if(DEBUG) {
+                    e.printStackTrace();
+                }
+                done = false;
+            }
+            if(!done) {
+                if(DEBUG) {
+                    System.err.println("Monotone decomposition failed, using ear clipping for region "+i);
+                }
+                while( triangles.size() > triCount ) {
+                    triangles.remove(triangles.size()-1);
+                }
+                maxTriID = triID;
+                if( 3 <= region.outer.getGraphPoint().size() ) {
+                    Loop loop = new Loop(region.outer, VectorUtil.Winding.CCW);
+                    for(int j=0; j<region.holes.size(); j++) {
+                        loop.addConstraintCurve(region.holes.get(j));
+                    }
+                    maxTriID = cutLoop(loop, triangles, maxTriID);
+                }
+            }
+        }
+        return triangles;
+    }
+
+    /**
+     * Triangulates the region by monotone decomposition.
+     * @return false if the decomposition is inconsistent, i.e. the triangle count doesn't match
+     */
+    private boolean triangulate(Region region) {
+        final ArrayList<Node> nodes = new ArrayList<Node>();
+        if( !addRing(nodes, region.outer, true) ) {
+            return true; // nothing to fill
+        }
+        int holeCount = 0;
+        for(int i=0; i<region.holes.size(); i++) {
+            if( addRing(nodes, region.holes.get(i), false) ) {
+                holeCount++;
+            }
+        }
+        final Node[] sorted = nodes.toArray(new Node[nodes.size()]);
+        Arrays.sort(sorted, sweepOrder);
+        for(int i=0; i<sorted.length; i++) {
+            final Node n = sorted[i];
+            n.order = i;
+        }
+        for(int i=0; i<sorted.length; i++) {
+            sorted[i].type = classify(sorted[i]);
+        }
+
+        status = new TreeSet<Node>(edgeOrder);
+        for(int i=0; i<sorted.length; i++) {
+            final Node v = sorted[i];
+            sweepY = v.y;
+            switch(v.type) {
+                case START:
+                    insertEdge(v);
+                    break;
+                case END:
+                    if( MERGE == v.prev.helper.type ) {
+                        addDiagonal(v, v.prev.helper);
+                    }
+                    removeEdge(v.prev);
+                    break;
+                case SPLIT: {
+                    final Node e = leftEdge(v);
+                    addDiagonal(v, e.helper);
+                    e.helper = v;
+                    insertEdge(v);
+                    break;
+                }
+                case MERGE: {
+                    if( MERGE == v.prev.helper.type ) {
+                        addDiagonal(v, v.prev.helper);
+                    }
+                    removeEdge(v.prev);
+                    final Node e = leftEdge(v);
+                    if( MERGE == e.helper.type ) {
+                        addDiagonal(v, e.helper);
+                    }
+                    e.helper = v;
+                    break;
+                }
+                default:
+                    if( v.prev.order < v.order ) {
+                        // interior to the right, boundary going down
+                        if( MERGE == v.prev.helper.type ) {
+                            addDiagonal(v, v.prev.helper);
+                        }
+                        removeEdge(v.prev);
+                        insertEdge(v);
+                    } else {
+                        final Node e = leftEdge(v);
+                        if( MERGE == e.helper.type ) {
+                            addDiagonal(v, e.helper);
+                        }
+                        e.helper = v;
+                    }
+            }
+        }
+        status = null;
+
+        int triCount = 0;
+        final ArrayList<Node> face = new ArrayList<Node>();
+        for(int i=0; i<sorted.length; i++) {
+            final Node n = sorted[i];
+            if( !n.ringUsed ) {
+                triCount += triangulateMonotone(traceFace(n, n.next, face, sorted.length));
+            }
+            if( null != n.diagonals ) {
+                for(int j=0; j<n.diagonals.size(); j++) {
+                    final HalfEdge d = n.diagonals.get(j);
+                    if( !d.used ) {
+                        triCount += triangulateMonotone(traceFace(n, d.to, face, sorted.length));
+                    }
+                }
+            }
+        }
+        return triCount == sorted.length + 2*holeCount - 2;
+    }
+
+    /**
+     * Appends the ring of the given inner polygon, skipping repeated points
+     * and orienting it CCW for the outer and CW for a hole polygon.
+     * @return false if the polygon has less than 3 distinct points
+     */
+    private static boolean addRing(ArrayList<Node> nodes, GraphOutline polygon, boolean outer) {
+        final ArrayList<GraphVertex> points = polygon.getGraphPoint();
+        final ArrayList<Node> ring = new ArrayList<Node>(points.size());
+        for(int i=0; i<points.size(); i++) {
+            final GraphVertex gv = points.get(i);
+            final Node n = new Node(gv, gv.getX(), gv.getY());
+            if( ring.isEmpty() || !samePosition(ring.get(ring.size()-1), n) ) {
+                ring.add(n);
+            }
+        }
+        while( ring.size() > 1 && samePosition(ring.get(0), ring.get(ring.size()-1)) ) {
+            ring.remove(ring.size()-1);
+        }
+        final int size = ring.size();
+        if( size < 3 ) {
+            return false;
+        }
+        float area = 0;
+        for(int i=0; i<size; i++) {
+            final Node a = ring.get(i);
+            final Node b = ring.get((i+1)%size);
+            area += a.x * b.y - b.x * a.y;
+        }
+        final boolean reverse = outer ? area < 0 : area > 0;
+        for(int i=0; i<size; i++) {
+            final Node n = ring.get(i);
+            final Node a = ring.get((i+1)%size);
+            final Node b = ring.get((i+size-1)%size);
+            n.next = reverse ? b : a;
+            n.prev = reverse ? a : b;
+        }
+        nodes.addAll(ring);
+        return true;
+    }
+
+    private static boolean samePosition(Node a, Node b) {
+        return a.x == b.x && a.y == b.y;
+    }
+
+    private static int classify(Node v) {
+        final Node p = v.prev, n = v.next;
+        final float cross = (v.x - p.x) * (n.y - v.y) - (v.y - p.y) * (n.x - v.x);
+        if( p.order > v.order && n.order > v.order ) {
+            return cross >= 0 ? START : SPLIT;
+        } else if( p.order < v.order && n.order < v.order ) {
+            return cross >= 0 ? END : MERGE;
+        }
+        return REGULAR;
+    }
+
+    /** @return the x coordinate of edge <code>e -> e.next</code> at <code>y</code> */
+    private static float xAt(Node e, float y) {
+        final Node l = e.next;
+        if( null == l ) {
+            return e.x; // probe
+        }
+        final float dy = e.y - l.y;
+        if( 0 == dy ) {
+            return e.x;
+        }
+        return e.x + ( l.x - e.x ) * ( e.y - y ) / dy;
+    }
+
+    private void insertEdge(Node e) {
+        e.helper = e;
+        status.add(e);
+    }
+
+    private void removeEdge(Node e) {
+        if( !status.remove(e) ) {
+            throw new IllegalStateException("Edge not in sweep status");
+        }
+    }
+
+    /** @return the edge directly left of <code>v</code> */
+    private Node leftEdge(Node v) {
+        final Node e = status.lower(new Node(null, v.x, v.y));
+        if( null == e ) {
+            throw new IllegalStateException("No edge left of vertex");
+        }
+        return e;
+    }
+
+    private static void addDiagonal(Node a, Node b) {
+        if( null == a.diagonals ) {
+            a.diagonals = new ArrayList<HalfEdge>(2);
+        }
+        if( null == b.diagonals ) {
+            b.diagonals = new ArrayList<HalfEdge>(2);
+        }
+        a.diagonals.add(new HalfEdge(b));
+        b.diagonals.add(new HalfEdge(a));
+    }
+
+    /**
+     * Collects the CCW boundary of the face left of <code>from -> to</code>,
+     * taking the next edge clockwise of the reverse incoming edge at each node.
+     */
+    private static ArrayList<Node> traceFace(Node from, Node to, ArrayList<Node> face, int maxSize) {
+        face.clear();
+        final Node start = from;
+        do {
+            markUsed(from, to);
+            face.add(from);
+            if( face.size() > maxSize ) {
+                throw new IllegalStateException("Face not closed");
+            }
+            final Node next = nextOnFace(from, to);
+            from = to;
+            to = next;
+        } while( from != start );
+        return face;
+    }
+
+    private static void markUsed(Node from, Node to) {
+        if( from.next == to && !from.ringUsed ) {
+            from.ringUsed = true;
+            return;
+        }
+        if( null != from.diagonals ) {
+            for(int i=0; i<from.diagonals.size(); i++) {
+                final HalfEdge d = from.diagonals.get(i);
+                if( d.to == to && !d.used ) {
+                    d.used = true;
+                    return;
+                }
+            }
+        }
+        throw new IllegalStateException("Edge traversed twice");
+    }
+
+    private static Node nextOnFace(Node from, Node at) {
+        final float rx = from.x - at.x, ry = from.y - at.y;
+        Node best = at.next;
+        double bestAngle = cwAngle(rx, ry, best.x - at.x, best.y - at.y);
+        if( null != at.diagonals ) {
+            for(int i=0; i<at.diagonals.size(); i++) {
+                final Node c = at.diagonals.get(i).to;
+                final double angle = cwAngle(rx, ry, c.x - at.x, c.y - at.y);
+                if( angle < bestAngle ) {
+                    best = c;
+                    bestAngle = angle;
+                }
+            }
+        }
+        return best;
+    }
+
+    /** @return the clockwise angle from direction r to d within (0, 2PI] */
+    private static double cwAngle(float rx, float ry, float dx, float dy) {
+        double a = -Math.atan2(rx * dy - ry * dx, rx * dx + ry * dy);
+        if( a <= 0 ) {
+            a += 2 * Math.PI;
+        }
+        return a;
+    }
+
+    /**
+     * Triangulates a y-monotone CCW polygon by the stack algorithm.
+     * @return the number of created triangles
+     */
+    private int triangulateMonotone(ArrayList<Node> face) {
+        final int size = face.size();
+        if( size < 3 ) {
+            return 0;
+        }
+        if( 3 == size ) {
+            addTriangle(face.get(0), face.get(1), face.get(2));
+            return 1;
+        }
+        int top = 0, bottom = 0;
+        for(int i=1; i<size; i++) {
+            final Node n = face.get(i);
+            if( n.order < face.get(top).order ) {
+                top = i;
+            }
+            if( n.order > face.get(bottom).order ) {
+                bottom = i;
+            }
+        }
+        // merge the left chain, CCW from top to bottom, and the right chain, CW from top, top down
+        final Node[] u = new Node[size];
+        final boolean[] left = new boolean[size];
+        u[0] = face.get(top);
+        left[0] = true;
+        int l = (top+1)%size, r = (top+size-1)%size;
+        for(int k=1; k<size; k++) {
+            final boolean leftDone = l == (bottom+1)%size;
+            final boolean rightDone = r == bottom;
+            if( !leftDone && ( rightDone || face.get(l).order < face.get(r).order ) ) {
+                u[k] = face.get(l);
+                left[k] = true;
+                l = (l+1)%size;
+            } else {
+                u[k] = face.get(r);
+                left[k] = false;
+                r = (r+size-1)%size;
+            }
+        }
+
+        int count = 0;
+        final int[] stack = new int[size];
+        int sp = 0;
+        stack[sp++] = 0;
+        stack[sp++] = 1;
+        for(int j=2; j<size-1; j++) {
+            if( left[j] != left[stack[sp-1]] ) {
+                while( sp > 1 ) {
+                    final int a = stack[--sp];
+                    addTriangle(u[j], u[a], u[stack[sp-1]]);
+                    count++;
+                }
+                sp = 0;
+                stack[sp++] = j-1;
+                stack[sp++] = j;
+            } else {
+                int last = stack[--sp];
+                while( sp > 0 ) {
+                    final Node t = u[stack[sp-1]], m = u[last];
+                    final float cross = (m.x - t.x) * (u[j].y - m.y) - (m.y - t.y) * (u[j].x - m.x);
+                    if( left[j] ? cross > 0 : cross < 0 ) {
+                        addTriangle(u[j], m, t);
+                        count++;
+                        last = stack[--sp];
+                    } else {
+                        break;
+                    }
+                }
+                stack[sp++] = last;
+                stack[sp++] = j;
+            }
+        }
+        while( sp > 1 ) {
+            final int a = stack[--sp];
+            addTriangle(u[size-1], u[a], u[stack[sp-1]]);
+            count++;
+        }
+        return count;
+    }
+
+    private void addTriangle(Node a, Node b, Node c) {
+        if( (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x) < 0 ) {
+            final Node t = b; b = c; c = t;
+        }
+        final Triangle t = new Triangle(a.gv.getPoint(), b.gv.getPoint(), c.gv.getPoint());
+        t.setVerticesBoundary(new boolean[] { a.gv.isBoundaryContained(), b.gv.isBoundaryContained(), c.gv.isBoundaryContained() });
+        t.setId(maxTriID++);
+        triangles.add(t);
+        if(DEBUG){
+            System.err.println(t);
+        }
+    }
+
+    private Region getContainerRegion(Outline polyline) {
+        final ArrayList<Vertex> vertices = polyline.getVertices();
+        for(int i=0; i < regions.size(); i++) {
+            final Region region = regions.get(i);
+            for(int j=0; j < vertices.size(); j++) {
+                if( isInside(region.outer, region.box, vertices.get(j)) ) {
+                    if( region.contains(vertices.get(j)) ) {
+                        return region;
+                    }
+                    break; // inside one of its holes
+                }
+            }
+        }
+        return null;
+    }
+
+    /** Even odd crossing test of <code>v</code> against the polygon, see {@link Loop#checkInside(Vertex)} */
+    private static boolean isInside(GraphOutline polygon, AABBox box, Vertex v) {
+        if(!box.contains(v.getX(), v.getY(), v.getZ())){
+            return false;
+        }
+        final ArrayList<GraphVertex> points = polygon.getGraphPoint();
+        final int size = points.size();
+        boolean inside = false;
+        for(int i=0, j=size-1; i<size; j=i++) {
+            final GraphVertex v1 = points.get(i);
+            final GraphVertex v2 = points.get(j);
+            if ( ((v1.getY() > v.getY()) != (v2.getY() > v.getY())) &&
+                  (v.getX() < (v2.getX() - v1.getX()) * (v.getY() - v1.getY()) / (v2.getY() - v1.getY()) + v1.getX()) ){
+                inside = !inside;
+            }
+        }
+        return inside;
+    }
+}
@@ -0,0 +1,148 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package jogamp.graph.curve.tess;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.ThreadFactory;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import javax.media.opengl.GLException;
+
+import jogamp.opengl.Debug;
+
+import com.jogamp.graph.curve.OutlineShape;
+import com.jogamp.graph.geom.Triangle;
+
+/**
+ * Triangulates independent {@link OutlineShape}s in parallel.
+ * <p>
+ * The calling thread and up to <code>threadCount-1</code> threads of a shared daemon pool
+ * take the next untriangulated shape from a common index, 
+ * i.e. the load is balanced dynamically for shapes of different complexity.
+ * Each result is stored at its shape's index, hence the outcome equals the serial one.
+ * </p>
+ * <p>
+ * Property <code>jogl.graph.triangulation.threads</code> sets the thread count, 
+ * default is the number of available processors, 1 disables parallel triangulation.
+ * </p>
+ */
+public class ParallelTriangulator {
+    public static final int THREAD_COUNT = Math.max(1, 
+            Debug.getIntProperty("jogl.graph.triangulation.threads", true, Runtime.getRuntime().availableProcessors()));
+    
+    /** Minimum number of shapes triangulated in parallel, smaller batches are processed by the caller */
+    public static final int MIN_PARALLEL_SHAPES = 4;
+    
+    private static ExecutorService executor = null;
+    
+    private static synchronized ExecutorService getExecutor() {
+        if(null == executor) {
+            executor = Executors.newFixedThreadPool(THREAD_COUNT - 1, new TriangulatorThreadFactory());
+        }
+        return executor;
+    }
+    
+    private static class TriangulatorThreadFactory implements ThreadFactory {
+        private int count = 0;
+
+        public synchronized Thread newThread(Runnable r) {
+            Thread t = new Thread(r, "ParallelTriangulator-" + (count++));
+            t.setDaemon(true);
+            return t;
+        }
+    }
+    
+    private static class Batch implements Runnable {
+        final List<OutlineShape> shapes;
+        final ArrayList<Triangle>[] results;
+        final AtomicInteger next = new AtomicInteger(0);
+        volatile RuntimeException error = null;
+        
+        @SuppressWarnings("unchecked")
+        Batch(List<OutlineShape> shapes) {
+            this.shapes = shapes;
+            this.results = new ArrayList[shapes.size()];
+        }
+        
+        public void run() {
+            int i;
+            while( null == error && ( i = next.getAndIncrement() ) < results.length ) {
+                try {
+                    final OutlineShape shape = shapes.get(i);
+                    shape.transformOutlines(OutlineShape.VerticesState.QUADRATIC_NURBS);
+                    results[i] = shape.triangulate();
+                } catch (RuntimeException e) {
+                    error = e;
+                }
+            }
+        }
+    }
+    
+    /**
+     * @param shapes independent shapes, i.e. not sharing any {@link com.jogamp.graph.geom.Outline} or {@link com.jogamp.graph.geom.Vertex}
+     * @return the triangles of each shape in shape order, as {@link OutlineShape#triangulate()} would return them,
+     *         after {@link OutlineShape#transformOutlines(OutlineShape.VerticesState) transforming} the shapes 
+     *         to {@link OutlineShape.VerticesState#QUADRATIC_NURBS}.
+     */
+    public static ArrayList<ArrayList<Triangle>> triangulate(List<OutlineShape> shapes) {
+        final Batch batch = new Batch(shapes);
+        final int workers = Math.min(THREAD_COUNT, shapes.size()) - 1;
+        if( workers > 0 && shapes.size() >= MIN_PARALLEL_SHAPES ) {
+            final ExecutorService e = getExecutor();
+            final Future<?>[] futures = new Future<?>[workers];
+            for(int i=0; i<workers; i++) {
+                futures[i] = e.submit(batch);
+            }
+            batch.run();
+            for(int i=0; i<workers; i++) {
+                try {
+                    futures[i].get();
+                } catch (InterruptedException ie) {
+                    throw new GLException("Interrupted while triangulating", ie);
+                } catch (ExecutionException ee) {
+                    throw new GLException(ee.getCause());
+                }
+            }
+        } else {
+            batch.run();
+        }
+        if( null != batch.error ) {
+            throw batch.error;
+        }
+        final ArrayList<ArrayList<Triangle>> triangles = new ArrayList<ArrayList<Triangle>>(shapes.size());
+        for(int i=0; i<batch.results.length; i++) {
+            triangles.add(batch.results[i]);
+        }
+        return triangles;
+    }
+}
@@ -0,0 +1,207 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package jogamp.graph.curve.text;
+
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.IdentityHashMap;
+import java.util.List;
+
+import jogamp.graph.font.FontInt;
+import jogamp.graph.font.FontInt.GlyphInt;
+
+import com.jogamp.common.util.IntObjectHashMap;
+import com.jogamp.graph.curve.OutlineShape;
+import com.jogamp.graph.curve.tess.Triangulation;
+import com.jogamp.graph.font.Font;
+import com.jogamp.graph.geom.Triangle;
+import com.jogamp.graph.geom.Vertex;
+
+/**
+ * Cache of triangulated glyph geometry per font and glyph id,
+ * kept in unscaled font units at the origin.
+ * <p>
+ * A {@link GlyphShape} of a positioned glyph is created by copying the cached vertices
+ * scaled and translated, hence each glyph is only triangulated once.
+ * Scaling and translation preserve the triangulation and the curve texture coordinates.
+ * </p>
+ * <p>
+ * Not thread safe, shall be used from one GL thread only, e.g. by its {@link com.jogamp.graph.curve.opengl.TextRenderer}.
+ * </p>
+ */
+public class GlyphMeshCache {
+    private static class Mesh {
+        /** Outline vertices, with their index as id */
+        final Vertex[] vertices;
+        final Triangle[] triangles;
+        
+        Mesh(Vertex[] vertices, Triangle[] triangles) {
+            this.vertices = vertices;
+            this.triangles = triangles;
+        }
+    }
+    private static final Mesh EMPTY = new Mesh(new Vertex[0], new Triangle[0]);
+    
+    private final Vertex.Factory<? extends Vertex> vertexFactory;
+    private final HashMap<Font, IntObjectHashMap> fontMeshes = new HashMap<Font, IntObjectHashMap>();
+    private int meshCount = 0;
+    
+    public GlyphMeshCache(Vertex.Factory<? extends Vertex> vertexFactory) {
+        this.vertexFactory = vertexFactory;
+    }
+    
+    public final Vertex.Factory<? extends Vertex> vertexFactory() { return vertexFactory; }
+    
+    /** @return the number of cached glyph meshes of all fonts */
+    public final int getSize() { return meshCount; }
+    
+    public void clear() {
+        fontMeshes.clear();
+        meshCount = 0;
+    }
+    
+    private IntObjectHashMap getMeshes(FontInt font) {
+        IntObjectHashMap meshes = fontMeshes.get(font);
+        if(null == meshes) {
+            meshes = new IntObjectHashMap();
+            fontMeshes.put(font, meshes);
+        }
+        return meshes;
+    }
+    
+    private Mesh getMesh(FontInt font, GlyphInt glyph) {
+        final IntObjectHashMap meshes = getMeshes(font);
+        final int id = glyph.getID() & 0xffff;
+        Mesh mesh = (Mesh) meshes.get(id);
+        if(null == mesh) {
+            final OutlineShape shape = font.getOutlineShape(glyph, vertexFactory);
+            shape.transformOutlines(OutlineShape.VerticesState.QUADRATIC_NURBS);
+            mesh = shape.getVertices().size() < 3 ? EMPTY : createMesh(shape, shape.triangulate());
+            meshes.put(id, mesh);
+            meshCount++;
+        }
+        return mesh;
+    }
+    
+    /**
+     * Triangulates the glyphs not yet cached in parallel, 
+     * see {@link Triangulation#triangulate(List)}.
+     * @param font the glyphs' font
+     * @param glyphs the glyphs, duplicates are allowed
+     */
+    public void addGlyphs(FontInt font, List<GlyphInt> glyphs) {
+        final IntObjectHashMap meshes = getMeshes(font);
+        final IntObjectHashMap pending = new IntObjectHashMap();
+        final ArrayList<Integer> ids = new ArrayList<Integer>();
+        final ArrayList<OutlineShape> shapes = new ArrayList<OutlineShape>();
+        for(int i=0; i<glyphs.size(); i++) {
+            final GlyphInt glyph = glyphs.get(i);
+            final int id = glyph.getID() & 0xffff;
+            if( null != meshes.get(id) || null != pending.get(id) ) {
+                continue;
+            }
+            final OutlineShape shape = font.getOutlineShape(glyph, vertexFactory);
+            shape.transformOutlines(OutlineShape.VerticesState.QUADRATIC_NURBS);
+            if( shape.getVertices().size() < 3 ) {
+                meshes.put(id, EMPTY);
+                meshCount++;
+                continue;
+            }
+            pending.put(id, shape);
+            ids.add(Integer.valueOf(id));
+            shapes.add(shape);
+        }
+        final ArrayList<ArrayList<Triangle>> triangles = Triangulation.triangulate(shapes);
+        for(int i=0; i<shapes.size(); i++) {
+            meshes.put(ids.get(i).intValue(), createMesh(shapes.get(i), triangles.get(i)));
+            meshCount++;
+        }
+    }
+    
+    private static Mesh createMesh(OutlineShape shape, ArrayList<Triangle> triangles) {
+        if(null == triangles) {
+            return EMPTY;
+        }
+        // triangulate() sorts the outlines and numbers the vertices in getVertices() order
+        final ArrayList<Vertex> vertices = shape.getVertices();
+        return new Mesh(vertices.toArray(new Vertex[vertices.size()]), triangles.toArray(new Triangle[triangles.size()]));
+    }
+    
+    /**
+     * @param font the glyph's font
+     * @param glyph the glyph
+     * @param x horizontal glyph origin
+     * @param y vertical glyph origin
+     * @param scale units per font unit
+     * @return a new {@link GlyphShape} holding a copy of the cached mesh, scaled and translated,
+     *         or null if the glyph has no outline, e.g. a space.
+     */
+    public GlyphShape createGlyphShape(FontInt font, GlyphInt glyph, float x, float y, float scale) {
+        final Mesh mesh = getMesh(font, glyph);
+        if(0 == mesh.triangles.length) {
+            return null;
+        }
+        final ArrayList<Vertex> vertices = new ArrayList<Vertex>(mesh.vertices.length);
+        for(int i=0; i<mesh.vertices.length; i++) {
+            vertices.add(copy(mesh.vertices[i], x, y, scale));
+        }
+        final ArrayList<Triangle> triangles = new ArrayList<Triangle>(mesh.triangles.length);
+        final IdentityHashMap<Vertex, Vertex> privateVertices = new IdentityHashMap<Vertex, Vertex>();
+        final Vertex[] tv = new Vertex[3];
+        for(int i=0; i<mesh.triangles.length; i++) {
+            final Triangle mt = mesh.triangles[i];
+            final Vertex[] mtv = mt.getVertices();
+            for(int j=0; j<3; j++) {
+                final int id = mtv[j].getId();
+                if( 0 <= id && id < mesh.vertices.length && mesh.vertices[id] == mtv[j] ) {
+                    tv[j] = vertices.get(id);
+                } else {
+                    // triangle private vertex, e.g. of a curve, numbered by the region
+                    Vertex c = privateVertices.get(mtv[j]);
+                    if(null == c) {
+                        c = copy(mtv[j], x, y, scale);
+                        privateVertices.put(mtv[j], c);
+                    }
+                    tv[j] = c;
+                }
+            }
+            final Triangle t = new Triangle(tv[0], tv[1], tv[2]);
+            t.setEdgesBoundary(mt.getEdgeBoundary());
+            t.setVerticesBoundary(mt.getVerticesBoundary());
+            triangles.add(t);
+        }
+        return new GlyphShape(vertexFactory, vertices, triangles);
+    }
+    
+    private Vertex copy(Vertex v, float x, float y, float scale) {
+        final Vertex c = vertexFactory.create(v.getX() * scale + x, v.getY() * scale + y, v.getZ(), v.isOnCurve());
+        final float[] tex = v.getTexCoord();
+        c.setTexCoord(tex[0], tex[1]);
+        return c;
+    }
+}
@@ -40,6 +40,9 @@ public class GlyphShape {
     
     private Quaternion quat= null;
     private OutlineShape shape = null;
+    /** Already triangulated geometry, see {@link #GlyphShape(Factory, ArrayList, ArrayList)} */
+    private ArrayList<Vertex> vertices = null;
+    private ArrayList<Triangle> triangles = null;
     
     /** Create a new Glyph shape
      * based on Parametric curve control polyline
@@ -58,14 +61,30 @@ public class GlyphShape {
         this.shape.transformOutlines(OutlineShape.VerticesState.QUADRATIC_NURBS);
     }
     
+    /** Create a new GlyphShape from already triangulated geometry, w/o {@link OutlineShape}.
+     * @param factory vertex impl factory {@link Factory}
+     * @param vertices the outline vertices, referenced by the triangles
+     * @param triangles the triangles of the glyph
+     * @see GlyphMeshCache
+     */
+    public GlyphShape(Vertex.Factory<? extends Vertex> factory, ArrayList<Vertex> vertices, ArrayList<Triangle> triangles){
+        this(factory);
+        this.vertices = vertices;
+        this.triangles = triangles;
+    }
+    
     public final Vertex.Factory<? extends Vertex> vertexFactory() { return shape.vertexFactory(); }
     
+    /** 
+     * @return the {@link OutlineShape}, which is empty if this instance
+     *         was created from already triangulated geometry.
+     */
     public OutlineShape getShape() {
         return shape;
     }
     
     public int getNumVertices() {
-        return shape.getVertices().size();
+        return getVertices().size();
     }
     
     /** Get the rotational Quaternion attached to this Shape
@@ -83,10 +102,21 @@ public class GlyphShape {
         this.quat = quat;
     }
     
+    /**
+     * @return true if this instance was created from already triangulated geometry,
+     *         i.e. {@link #triangulate()} is a nop.
+     */
+    public boolean isTriangulated() {
+        return null != triangles;
+    }
+    
     /** Triangluate the glyph shape
      * @return ArrayList of triangles which define this shape
      */
     public ArrayList<Triangle> triangulate(){
+        if(null != triangles) {
+            return triangles;
+        }
         return shape.triangulate();
     }
 
@@ -94,6 +124,9 @@ public class GlyphShape {
      * @return arrayList of Vertices
      */
     public ArrayList<Vertex> getVertices(){
+        if(null != vertices) {
+            return vertices;
+        }
         return shape.getVertices();
     }    
 }
@@ -40,11 +40,13 @@ import javax.media.opengl.GL2ES2;
 
 import jogamp.graph.curve.opengl.RegionFactory;
 import jogamp.graph.font.FontInt;
+import jogamp.graph.font.FontInt.GlyphInt;
 
 import com.jogamp.graph.curve.OutlineShape;
 import com.jogamp.graph.curve.Region;
 import com.jogamp.graph.curve.opengl.GLRegion;
 import com.jogamp.graph.curve.opengl.RenderState;
+import com.jogamp.graph.curve.tess.Triangulation;
 import com.jogamp.opengl.util.PMVMatrix;
 
 public class GlyphString {
@@ -97,6 +99,39 @@ public class GlyphString {
         return glyphString;
     }
     
+    /**
+     * <p>Assembles the string from the glyph meshes of the given cache,
+     * i.e. only glyphs not yet cached are triangulated.</p>
+     * 
+     * @param cache the glyph mesh cache, which also defines the vertex impl factory
+     * @param font the target {@link Font} 
+     * @param fontSize font size
+     * @param str string text
+     * @return the created {@link GlyphString} instance
+     */
+    public static GlyphString createString(final GlyphMeshCache cache, Font font, int fontSize, String str) {
+        final FontInt fontInt = (FontInt)font;
+        final GlyphString glyphString = new GlyphString(font.getName(Font.NAME_UNIQUNAME), str);
+        final ArrayList<GlyphInt> glyphs = new ArrayList<GlyphInt>();
+        final ArrayList<float[]> positions = new ArrayList<float[]>();
+        fontInt.visitGlyphs(str, fontSize, new FontInt.GlyphVisitor() {
+            public void visit(GlyphInt glyph, float x, float y, float scale) {
+                glyphs.add(glyph);
+                positions.add(new float[] { x, y, scale });
+            }
+        });
+        // triangulates the new glyphs in parallel
+        cache.addGlyphs(fontInt, glyphs);
+        for(int i=0; i<glyphs.size(); i++) {
+            final float[] p = positions.get(i);
+            final GlyphShape glyphShape = cache.createGlyphShape(fontInt, glyphs.get(i), p[0], p[1], p[2]);
+            if(null != glyphShape) {
+                glyphString.addGlyphShape(glyphShape);
+            }
+        }
+        return glyphString;
+    }
+    
     /** Create a new GlyphString object
      * @param fontname the name of the font that this String is
      * associated with
@@ -146,9 +181,19 @@ public class GlyphString {
         
         int numVertices = region.getNumVertices();
         
+        // triangulate all glyphs w/o cached geometry in parallel, added in glyph order below
+        final ArrayList<OutlineShape> shapes = new ArrayList<OutlineShape>();
         for(int i=0; i< glyphs.size(); i++) {
             final GlyphShape glyph = glyphs.get(i);
-            ArrayList<Triangle> gtris = glyph.triangulate();
+            if( !glyph.isTriangulated() ) {
+                shapes.add(glyph.getShape());
+            }
+        }
+        final ArrayList<ArrayList<Triangle>> shapeTriangles = Triangulation.triangulate(shapes);
+        
+        for(int i=0, j=0; i< glyphs.size(); i++) {
+            final GlyphShape glyph = glyphs.get(i);
+            ArrayList<Triangle> gtris = glyph.isTriangulated() ? glyph.triangulate() : shapeTriangles.get(j++);
             region.addTriangles(gtris);
             
             final ArrayList<Vertex> gVertices = glyph.getVertices();
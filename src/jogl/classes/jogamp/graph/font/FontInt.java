@@ -41,7 +41,29 @@ public interface FontInt extends Font {
     public interface GlyphInt extends Font.Glyph {
         public Path2D getPath();  // unscaled path
         public Path2D getPath(float pixelSize);         
+        /** @return the glyph id, unique within its font */
+        public short getID();
+    }
+
+    /** Receives the positioned glyphs of a laid out string, see {@link FontInt#visitGlyphs(CharSequence, float, GlyphVisitor)}. */
+    public interface GlyphVisitor {
+        /**
+         * @param glyph the glyph
+         * @param x horizontal glyph origin in pixel units
+         * @param y vertical glyph origin in pixel units
+         * @param scale pixel units per unscaled font unit
+         */
+        public void visit(GlyphInt glyph, float x, float y, float scale);
     }
 
     public ArrayList<OutlineShape> getOutlineShapes(CharSequence string, float pixelSize, Factory<? extends Vertex> vertexFactory);
+
+    /**
+     * Lays out the string as {@link #getOutlineShapes(CharSequence, float, Factory)} does
+     * and passes each glyph with its position to the visitor.
+     */
+    public void visitGlyphs(CharSequence string, float pixelSize, GlyphVisitor visitor);
+
+    /** @return the unscaled outline of the glyph at the origin, i.e. in font units */
+    public OutlineShape getOutlineShape(GlyphInt glyph, Factory<? extends Vertex> vertexFactory);
 }
@@ -60,6 +60,9 @@ class TypecastFont implements FontInt {
     
     // FIXME: Add cache size to limit memory usage ??    
     IntObjectHashMap char2Glyph; 
+    /** Glyphs w/o own character, i.e. ligatures, by glyph id */
+    IntObjectHashMap id2Glyph; 
+    private TypecastLayout layout;
 
     public TypecastFont(OTFontCollection fontset) {
         this.fontset = fontset;
@@ -146,6 +149,7 @@ class TypecastFont implements FontInt {
             }
         }
         char2Glyph = new IntObjectHashMap(cmapentries + cmapentries/4);
+        id2Glyph = new IntObjectHashMap();
     }
     
     public StringBuilder getName(StringBuilder sb, int nameIndex) {
@@ -188,57 +192,96 @@ class TypecastFont implements FontInt {
                 }
             }
             
-            jogamp.graph.font.typecast.ot.OTGlyph glyph = font.getGlyph(code);
-            if(null == glyph) {
-                glyph = font.getGlyph(Glyph.ID_UNKNOWN);
-            }
-            if(null == glyph) {
-                throw new RuntimeException("Could not retrieve glyph for symbol: <"+symbol+"> "+(int)symbol+" -> glyph id "+code);
-            }
-            Path2D path = TypecastRenderer.buildPath(glyph);
-            result = new TypecastGlyph(this, symbol, code, glyph.getBBox(), glyph.getAdvanceWidth(), path);
-            if(DEBUG) {
-                System.err.println("New glyph: " + (int)symbol + " ( " + (char)symbol +" ) -> " + code + ", contours " + glyph.getPointCount() + ": " + path);
-            }
-            final HdmxTable hdmx = font.getHdmxTable();            
-            if (null!= result && null != hdmx) {
-                /*if(DEBUG) {
-                    System.err.println("hdmx "+hdmx);
-                }*/
-                for (int i=0; i<hdmx.getNumberOfRecords(); i++)
-                {
-                    final HdmxTable.DeviceRecord dr = hdmx.getRecord(i); 
-                    result.addAdvance(dr.getWidth(code), dr.getPixelSize());
-                    /* if(DEBUG) {
-                        System.err.println("hdmx advance : pixelsize = "+dr.getWidth(code)+" : "+ dr.getPixelSize());
-                    } */
-                }
-            }            
+            result = createGlyph(symbol, code);
             char2Glyph.put(symbol, result);
         }
         return result;
     }
+
+    /**
+     * @param symbol the character represented by the glyph, for a ligature its first component
+     * @param id the glyph id, as produced by the {@link TypecastLayout}
+     * @return the glyph of <code>symbol</code> if it maps to <code>id</code>, otherwise the glyph of <code>id</code> 
+     */
+    TypecastGlyph getGlyph(char symbol, int id) {
+        final TypecastGlyph g = (TypecastGlyph) getGlyph(symbol);
+        if( ( g.getID() & 0xffff ) == id ) {
+            return g;
+        }
+        TypecastGlyph result = (TypecastGlyph) id2Glyph.get(id);
+        if (null == result) {
+            result = createGlyph(symbol, (short) id);
+            id2Glyph.put(id, result);
+        }
+        return result;
+    }
+
+    private TypecastGlyph createGlyph(char symbol, short code) {
+        jogamp.graph.font.typecast.ot.OTGlyph glyph = font.getGlyph(code);
+        if(null == glyph) {
+            glyph = font.getGlyph(Glyph.ID_UNKNOWN);
+        }
+        if(null == glyph) {
+            throw new RuntimeException("Could not retrieve glyph for symbol: <"+symbol+"> "+(int)symbol+" -> glyph id "+code);
+        }
+        Path2D path = TypecastRenderer.buildPath(glyph);
+        TypecastGlyph result = new TypecastGlyph(this, symbol, code, glyph.getBBox(), glyph.getAdvanceWidth(), path);
+        if(DEBUG) {
+            System.err.println("New glyph: " + (int)symbol + " ( " + (char)symbol +" ) -> " + code + ", contours " + glyph.getPointCount() + ": " + path);
+        }
+        final HdmxTable hdmx = font.getHdmxTable();            
+        if (null != hdmx) {
+            /*if(DEBUG) {
+                System.err.println("hdmx "+hdmx);
+            }*/
+            for (int i=0; i<hdmx.getNumberOfRecords(); i++)
+            {
+                final HdmxTable.DeviceRecord dr = hdmx.getRecord(i); 
+                result.addAdvance(dr.getWidth(code), dr.getPixelSize());
+                /* if(DEBUG) {
+                    System.err.println("hdmx advance : pixelsize = "+dr.getWidth(code)+" : "+ dr.getPixelSize());
+                } */
+            }
+        }
+        return result;
+    }
+
+    /** @return the layout engine shaping strings into {@link TypecastLayout.GlyphRun}s, created on demand */
+    synchronized TypecastLayout getLayout() {
+        if (null == layout) {
+            layout = new TypecastLayout(this);
+        }
+        return layout;
+    }
    
     public ArrayList<OutlineShape> getOutlineShapes(CharSequence string, float pixelSize, Factory<? extends Vertex> vertexFactory) {
     	AffineTransform transform = new AffineTransform(vertexFactory);
     	return TypecastRenderer.getOutlineShapes(this, string, pixelSize, transform, vertexFactory);
     }
 
-    public float getStringWidth(CharSequence string, float pixelSize) {
-        float width = 0;
-        final int len = string.length();
-        for (int i=0; i< len; i++)
-        {
-            char character = string.charAt(i);
-            if (character == '\n') {
-                width = 0;
-            } else {
-                Glyph glyph = getGlyph(character);
-                width += glyph.getAdvance(pixelSize, false);
-            }
+    public void visitGlyphs(CharSequence string, float pixelSize, GlyphVisitor visitor) {
+        if (string == null) {
+            return;
         }
+        final float scale = getMetrics().getScale(pixelSize);
+        final TypecastLayout.GlyphRun run = getLayout().getRun(string, pixelSize);
+        for (int i=0; i<run.size(); i++) {
+            visitor.visit(run.glyphs[i], run.x[i], run.y[i], scale);
+        }
+    }
 
-        return (int)(width + 0.5f);        
+    public OutlineShape getOutlineShape(GlyphInt glyph, Factory<? extends Vertex> vertexFactory) {
+        return TypecastRenderer.getOutlineShape(glyph.getPath(), vertexFactory);
+    }
+
+    /**
+     * Returns the width of the last line in whole pixels, as the sum of the glyph advances
+     * each rounded to whole pixels, incl. the kerning adjustments of the run.
+     * It may differ by a few pixels from the fractional width of {@link #getStringBounds(CharSequence, float)}. 
+     */
+    public float getStringWidth(CharSequence string, float pixelSize) {
+        final TypecastLayout.GlyphRun run = getLayout().getRun(string, pixelSize);
+        return run.lastLineAdvance;
     }
 
     public float getStringHeight(CharSequence string, float pixelSize) {
@@ -266,25 +309,10 @@ class TypecastFont implements FontInt {
         final float ascent = metrics.getAscent(pixelSize);
         final float descent = metrics.getDescent(pixelSize);
         final float advanceY = lineGap - descent + ascent;
-        float totalHeight = 0;
-        float totalWidth = 0;
-        float curLineWidth = 0;
-        for (int i=0; i<string.length(); i++) {
-            char character = string.charAt(i);
-            if (character == '\n') {
-                totalWidth = Math.max(curLineWidth, totalWidth);
-                curLineWidth = 0;
-                totalHeight -= advanceY;
-                continue;
-            }
-            Glyph glyph = getGlyph(character);
-            curLineWidth += glyph.getAdvance(pixelSize, true);
-        }
-        if (curLineWidth > 0) {
-            totalHeight -= advanceY;
-            totalWidth = Math.max(curLineWidth, totalWidth);
-        }
-        return new AABBox(0, 0, 0, totalWidth, totalHeight,0);        
+        final TypecastLayout.GlyphRun run = getLayout().getRun(string, pixelSize);
+        final int lines = run.lineBreaks + ( run.lastLineWidth > 0 ? 1 : 0 );
+        final float totalHeight = -lines * advanceY;
+        return new AABBox(0, 0, 0, run.width, totalHeight,0);        
     }
 
     final public int getNumGlyphs() {
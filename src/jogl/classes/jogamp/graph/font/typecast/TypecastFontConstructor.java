@@ -37,18 +37,27 @@ import javax.media.opengl.GLException;
 
 import jogamp.graph.font.FontConstructor;
 import jogamp.graph.font.typecast.ot.OTFontCollection;
+import jogamp.opengl.Debug;
 
 import com.jogamp.common.util.IOUtil;
 import com.jogamp.graph.font.Font;
 
 public class TypecastFontConstructor implements FontConstructor  {
+    /** 
+     * If set, font files are memory mapped and their tables and glyphs are decoded on demand,
+     * see {@link OTFontCollection#createMapped(File, int)}. 
+     */
+    static final boolean USE_MMAP = Debug.isPropertyDefined("jogl.font.mmap", true);
+    /** Maximum number of decoded glyph outlines kept per memory mapped font, defaults to 256. */
+    static final int GLYPH_CACHE_SIZE = Debug.getIntProperty("jogl.font.glyphcache", true, 256);
 
     public Font create(final File ffile) throws IOException {
         Object o = AccessController.doPrivileged(new PrivilegedAction<Object>() {
             public Object run() {
                 OTFontCollection fontset;        
                 try {
-                    fontset = OTFontCollection.create(ffile);
+                    fontset = USE_MMAP ? OTFontCollection.createMapped(ffile, GLYPH_CACHE_SIZE) 
+                                       : OTFontCollection.create(ffile);
                     return new TypecastFont(fontset);
                 } catch (IOException e) {
                     return e;
@@ -78,7 +87,9 @@ public class TypecastFontConstructor implements FontConstructor  {
                         throw new GLException("Font of stream "+fconn.getURL()+" was zero bytes");
                     }
                     f = create(tf);
-                    tf.delete();
+                    if( !tf.delete() ) {
+                        tf.deleteOnExit(); // still mapped, see USE_MMAP
+                    }
                 } catch (IOException e) {
                     e.printStackTrace();
                 }
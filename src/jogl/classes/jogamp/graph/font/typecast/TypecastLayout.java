@@ -0,0 +1,409 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package jogamp.graph.font.typecast;
+
+import java.util.ArrayList;
+import java.util.LinkedHashMap;
+import java.util.Map;
+
+import jogamp.graph.font.typecast.ot.OTFont;
+import jogamp.graph.font.typecast.ot.table.Feature;
+import jogamp.graph.font.typecast.ot.table.FeatureList;
+import jogamp.graph.font.typecast.ot.table.GposTable;
+import jogamp.graph.font.typecast.ot.table.GsubTable;
+import jogamp.graph.font.typecast.ot.table.KernSubtable;
+import jogamp.graph.font.typecast.ot.table.KernTable;
+import jogamp.graph.font.typecast.ot.table.KerningPair;
+import jogamp.graph.font.typecast.ot.table.LangSys;
+import jogamp.graph.font.typecast.ot.table.Ligature;
+import jogamp.graph.font.typecast.ot.table.LigatureSubst;
+import jogamp.graph.font.typecast.ot.table.Lookup;
+import jogamp.graph.font.typecast.ot.table.LookupList;
+import jogamp.graph.font.typecast.ot.table.LookupSubtable;
+import jogamp.graph.font.typecast.ot.table.PairPos;
+import jogamp.graph.font.typecast.ot.table.Script;
+import jogamp.graph.font.typecast.ot.table.ScriptList;
+import jogamp.graph.font.typecast.ot.table.Table;
+import jogamp.graph.font.typecast.ot.table.ValueRecord;
+import jogamp.opengl.Debug;
+
+import com.jogamp.common.util.IntIntHashMap;
+import com.jogamp.graph.font.Font;
+
+/**
+ * Shapes a string into a positioned {@link GlyphRun}.
+ * <p>
+ * The 'liga' ligatures of the GSUB table are substituted
+ * and the pairs are kerned by the 'kern' pair adjustments of the GPOS table,
+ * or if not available by the horizontal pairs of the kern table.
+ * Only the default language system of the 'latn' or 'DFLT' script is used,
+ * lookup flags are not interpreted.
+ * </p>
+ * <p>
+ * Runs are cached per string and pixel size, 
+ * property <code>jogl.font.runcache</code> sets the number of cached runs, default 64.
+ * Property <code>jogl.font.noshaping</code> disables ligatures and kerning.
+ * </p>
+ */
+class TypecastLayout {
+    static final boolean USE_SHAPING = !Debug.isPropertyDefined("jogl.font.noshaping", true);
+    static final int RUN_CACHE_SIZE = Debug.getIntProperty("jogl.font.runcache", true, 64);
+
+    /**
+     * Glyphs of a shaped string with their pen positions in pixel units,
+     * line breaks are not part of the run.
+     */
+    static class GlyphRun {
+        final TypecastGlyph[] glyphs;
+        /** Horizontal glyph origin, starting with 0 at each line */
+        final float[] x;
+        /** Vertical glyph origin, advancing by the line height at each line break */
+        final float[] y;
+        /** Width of the widest line */
+        final float width;
+        /** Width of the last line */
+        final float lastLineWidth;
+        /** Width of the last line, summing the advances and kerning adjustments rounded to whole pixels per glyph */
+        final int lastLineAdvance;
+        /** Number of line breaks */
+        final int lineBreaks;
+
+        GlyphRun(TypecastGlyph[] glyphs, float[] x, float[] y, float width, float lastLineWidth, int lastLineAdvance, int lineBreaks) {
+            this.glyphs = glyphs;
+            this.x = x;
+            this.y = y;
+            this.width = width;
+            this.lastLineWidth = lastLineWidth;
+            this.lastLineAdvance = lastLineAdvance;
+            this.lineBreaks = lineBreaks;
+        }
+
+        int size() {
+            return glyphs.length;
+        }
+    }
+
+    private static class RunKey {
+        final String string;
+        final float pixelSize;
+        final int hash;
+
+        RunKey(String string, float pixelSize) {
+            this.string = string;
+            this.pixelSize = pixelSize;
+            this.hash = 31 * string.hashCode() + Float.floatToIntBits(pixelSize);
+        }
+
+        public int hashCode() {
+            return hash;
+        }
+
+        public boolean equals(Object o) {
+            if(this == o) {
+                return true;
+            }
+            if(!(o instanceof RunKey)) {
+                return false;
+            }
+            final RunKey k = (RunKey) o;
+            return pixelSize == k.pixelSize && string.equals(k.string);
+        }
+    }
+
+    private final TypecastFont font;
+    /** GSUB ligature lookups in lookup list order */
+    private final Lookup[] ligatureLookups;
+    /** GPOS pair adjustment lookups in lookup list order */
+    private final Lookup[] pairLookups;
+    /** kern table pairs, key <code>left &lt;&lt; 16 | right</code>, only used w/o GPOS pair adjustments */
+    private final IntIntHashMap kernPairs;
+    private final LinkedHashMap<RunKey, GlyphRun> runCache;
+
+    TypecastLayout(TypecastFont font) {
+        this.font = font;
+        final OTFont otf = font.font;
+        if(USE_SHAPING) {
+            final GsubTable gsub = (GsubTable) otf.getTable(Table.GSUB);
+            ligatureLookups = null != gsub ? 
+                    findLookups(gsub.getScriptList(), gsub.getFeatureList(), gsub.getLookupList(), "liga") : new Lookup[0];
+            final GposTable gpos = (GposTable) otf.getTable(Table.GPOS);
+            pairLookups = null != gpos ? 
+                    findLookups(gpos.getScriptList(), gpos.getFeatureList(), gpos.getLookupList(), "kern") : new Lookup[0];
+            kernPairs = 0 == pairLookups.length ? readKernPairs((KernTable) otf.getTable(Table.kern)) : null;
+        } else {
+            ligatureLookups = new Lookup[0];
+            pairLookups = new Lookup[0];
+            kernPairs = null;
+        }
+        runCache = new LinkedHashMap<RunKey, GlyphRun>(Math.max(1, RUN_CACHE_SIZE) * 4 / 3 + 1, 0.75f, true) {
+            private static final long serialVersionUID = 1L;
+            protected boolean removeEldestEntry(Map.Entry<RunKey, GlyphRun> eldest) {
+                return size() > RUN_CACHE_SIZE;
+            }
+        };
+    }
+
+    private static int toTag(String tag) {
+        return (tag.charAt(0)<<24) | (tag.charAt(1)<<16) | (tag.charAt(2)<<8) | tag.charAt(3);
+    }
+
+    /** @return the lookups of the features named <code>featureTag</code>, in lookup list order */
+    private static Lookup[] findLookups(ScriptList scriptList, FeatureList featureList, LookupList lookupList, String featureTag) {
+        Script script = scriptList.findScript("latn");
+        if(null == script) {
+            script = scriptList.findScript("DFLT");
+        }
+        if(null == script && scriptList.getScriptCount() > 0) {
+            script = scriptList.getScript(0);
+        }
+        final LangSys langSys = null != script ? script.getDefaultLangSys() : null;
+        final int tag = toTag(featureTag);
+        final boolean[] used = new boolean[lookupList.getLookupCount()];
+        for(int i=0; i<featureList.getFeatureCount(); i++) {
+            if( featureList.getFeatureRecord(i).getTag() != tag ) {
+                continue;
+            }
+            if( null != langSys && !isFeatureIndexed(langSys, i) ) {
+                continue;
+            }
+            final Feature feature = featureList.getFeature(i);
+            for(int j=0; j<feature.getLookupCount(); j++) {
+                final int k = feature.getLookupListIndex(j);
+                if( k < used.length ) {
+                    used[k] = true;
+                }
+            }
+        }
+        final ArrayList<Lookup> lookups = new ArrayList<Lookup>();
+        for(int k=0; k<used.length; k++) {
+            if(used[k]) {
+                lookups.add(lookupList.getLookup(k));
+            }
+        }
+        return lookups.toArray(new Lookup[lookups.size()]);
+    }
+
+    private static boolean isFeatureIndexed(LangSys langSys, int featureIndex) {
+        if( langSys.getReqFeatureIndex() == featureIndex ) {
+            return true;
+        }
+        for(int i=0; i<langSys.getFeatureCount(); i++) {
+            if( langSys.getFeatureIndex(i) == featureIndex ) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    private static IntIntHashMap readKernPairs(KernTable kern) {
+        if(null == kern) {
+            return null;
+        }
+        IntIntHashMap pairs = null;
+        for(int i=0; i<kern.getSubtableCount(); i++) {
+            final KernSubtable st = kern.getSubtable(i);
+            if( null == st || !st.isHorizontal() || 0 == st.getKerningPairCount() ) {
+                continue;
+            }
+            if(null == pairs) {
+                pairs = new IntIntHashMap(st.getKerningPairCount() + st.getKerningPairCount() / 4);
+                pairs.setKeyNotFoundValue(0);
+            }
+            for(int j=0; j<st.getKerningPairCount(); j++) {
+                final KerningPair kp = st.getKerningPair(j);
+                final int key = kp.getLeft() << 16 | kp.getRight();
+                pairs.put(key, pairs.get(key) + kp.getValue());
+            }
+        }
+        return pairs;
+    }
+
+    /** @return true if ligatures or kerning are applied by this layout */
+    boolean isShaping() {
+        return ligatureLookups.length > 0 || pairLookups.length > 0 || null != kernPairs;
+    }
+
+    /**
+     * @return the cached or newly shaped run of <code>string</code> at <code>pixelSize</code>
+     */
+    GlyphRun getRun(CharSequence string, float pixelSize) {
+        final RunKey key = new RunKey(string.toString(), pixelSize);
+        GlyphRun run;
+        synchronized(runCache) {
+            run = runCache.get(key);
+        }
+        if(null == run) {
+            run = shape(key.string, pixelSize);
+            if(RUN_CACHE_SIZE > 0) {
+                synchronized(runCache) {
+                    runCache.put(key, run);
+                }
+            }
+        }
+        return run;
+    }
+
+    private GlyphRun shape(String string, float pixelSize) {
+        final Font.Metrics metrics = font.getMetrics();
+        final float scale = metrics.getScale(pixelSize);
+        final float advanceY = metrics.getLineGap(pixelSize) - metrics.getDescent(pixelSize) + metrics.getAscent(pixelSize);
+        final int len = string.length();
+
+        final TypecastGlyph[] glyphs = new TypecastGlyph[len];
+        final float[] xs = new float[len];
+        final float[] ys = new float[len];
+        int count = 0;
+
+        // per line scratch, sized by the whole string
+        final int[] ids = new int[len];
+        final char[] symbols = new char[len];
+        final int[] xAdvance = new int[len];
+        final int[] xPlacement = new int[len];
+        final int[] yPlacement = new int[len];
+
+        float width = 0;
+        float lineWidth = 0;
+        int lineAdvance = 0;
+        float y = 0;
+        int lineBreaks = 0;
+        int lineStart = 0;
+        for(int i=0; i<=len; i++) {
+            if( i < len && string.charAt(i) != '\n' ) {
+                continue;
+            }
+            // line [lineStart .. i[
+            int n = 0;
+            for(int j=lineStart; j<i; j++) {
+                final char c = string.charAt(j);
+                symbols[n] = c;
+                ids[n] = ((TypecastGlyph) font.getGlyph(c)).getID() & 0xffff;
+                n++;
+            }
+            n = substituteLigatures(ids, symbols, n);
+            for(int j=0; j<n; j++) {
+                xAdvance[j] = 0;
+                xPlacement[j] = 0;
+                yPlacement[j] = 0;
+            }
+            adjustPairs(ids, n, xAdvance, xPlacement, yPlacement);
+
+            float x = 0;
+            int advance = 0;
+            for(int j=0; j<n; j++) {
+                final TypecastGlyph glyph = font.getGlyph(symbols[j], ids[j]);
+                glyphs[count] = glyph;
+                xs[count] = x + xPlacement[j] * scale;
+                ys[count] = y + yPlacement[j] * scale;
+                count++;
+                final float glyphAdvance = glyph.getAdvance(pixelSize, true);
+                final float kernAdvance = xAdvance[j] * scale;
+                x += glyphAdvance + kernAdvance;
+                advance += (int)(glyphAdvance + 0.5f) + Math.round(kernAdvance);
+            }
+            lineWidth = x;
+            lineAdvance = advance;
+            width = Math.max(width, lineWidth);
+            if( i < len ) {
+                lineBreaks++;
+                y += advanceY;
+            }
+            lineStart = i + 1;
+        }
+        if( count < len ) {
+            final TypecastGlyph[] _glyphs = new TypecastGlyph[count];
+            final float[] _xs = new float[count];
+            final float[] _ys = new float[count];
+            System.arraycopy(glyphs, 0, _glyphs, 0, count);
+            System.arraycopy(xs, 0, _xs, 0, count);
+            System.arraycopy(ys, 0, _ys, 0, count);
+            return new GlyphRun(_glyphs, _xs, _ys, width, lineWidth, lineAdvance, lineBreaks);
+        }
+        return new GlyphRun(glyphs, xs, ys, width, lineWidth, lineAdvance, lineBreaks);
+    }
+
+    /**
+     * Substitutes ligatures in place, the first symbol of the components represents a ligature.
+     * @return the new number of glyphs
+     */
+    private int substituteLigatures(int[] ids, char[] symbols, int n) {
+        for(int l=0; l<ligatureLookups.length; l++) {
+            final Lookup lookup = ligatureLookups[l];
+            for(int i=0; i<n; i++) {
+                for(int s=0; s<lookup.getSubtableCount(); s++) {
+                    final LookupSubtable st = lookup.getSubtable(s);
+                    if( !(st instanceof LigatureSubst) ) {
+                        continue;
+                    }
+                    final Ligature lig = ((LigatureSubst) st).findLigature(ids, i, n);
+                    if( null != lig ) {
+                        final int m = lig.getGlyphCount();
+                        ids[i] = lig.getGlyphId(0);
+                        System.arraycopy(ids, i + m, ids, i + 1, n - i - m);
+                        System.arraycopy(symbols, i + m, symbols, i + 1, n - i - m);
+                        n -= m - 1;
+                        break;
+                    }
+                }
+            }
+        }
+        return n;
+    }
+
+    /** Accumulates the pair adjustments of adjacent glyphs in font units */
+    private void adjustPairs(int[] ids, int n, int[] xAdvance, int[] xPlacement, int[] yPlacement) {
+        if( pairLookups.length > 0 ) {
+            for(int l=0; l<pairLookups.length; l++) {
+                final Lookup lookup = pairLookups[l];
+                for(int i=0; i<n-1; i++) {
+                    for(int s=0; s<lookup.getSubtableCount(); s++) {
+                        final LookupSubtable st = lookup.getSubtable(s);
+                        if( !(st instanceof PairPos) ) {
+                            continue;
+                        }
+                        final ValueRecord[] v = ((PairPos) st).findPair(ids[i], ids[i+1]);
+                        if( null != v ) {
+                            xAdvance[i] += v[0].getXAdvance();
+                            xPlacement[i] += v[0].getXPlacement();
+                            yPlacement[i] += v[0].getYPlacement();
+                            if( null != v[1] ) {
+                                xAdvance[i+1] += v[1].getXAdvance();
+                                xPlacement[i+1] += v[1].getXPlacement();
+                                yPlacement[i+1] += v[1].getYPlacement();
+                            }
+                            break;
+                        }
+                    }
+                }
+            }
+        } else if( null != kernPairs ) {
+            for(int i=0; i<n-1; i++) {
+                xAdvance[i] += kernPairs.get(ids[i] << 16 | ids[i+1]);
+            }
+        }
+    }
+}
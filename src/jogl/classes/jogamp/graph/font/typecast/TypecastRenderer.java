@@ -29,7 +29,6 @@ package jogamp.graph.font.typecast;
 
 import java.util.ArrayList;
 
-import jogamp.graph.font.FontInt.GlyphInt;
 import jogamp.graph.font.typecast.ot.OTGlyph;
 import jogamp.graph.font.typecast.ot.Point;
 import jogamp.graph.geom.plane.AffineTransform;
@@ -38,7 +37,6 @@ import jogamp.graph.geom.plane.PathIterator;
 
 import com.jogamp.graph.curve.OutlineShape;
 import com.jogamp.graph.font.Font;
-import com.jogamp.graph.font.Font.Glyph;
 import com.jogamp.graph.geom.Vertex;
 import com.jogamp.graph.geom.Vertex.Factory;
 
@@ -49,50 +47,38 @@ import com.jogamp.graph.geom.Vertex.Factory;
 public class TypecastRenderer {
 
     private static void getPaths(TypecastFont font, 
-            CharSequence string, float pixelSize, AffineTransform transform, Path2D[] p)
+            TypecastLayout.GlyphRun run, float pixelSize, AffineTransform transform, Path2D[] p)
     {        
-        if (string == null) {
-            return;
-        }
         Font.Metrics metrics = font.getMetrics();
-        float advanceTotal = 0;
-        float lineGap = metrics.getLineGap(pixelSize) ;
-        float ascent = metrics.getAscent(pixelSize) ;
-        float descent = metrics.getDescent(pixelSize) ;
         if (transform == null) {
             transform = new AffineTransform();
         }
         AffineTransform t = new AffineTransform();
-
-        float advanceY = lineGap - descent + ascent;
-        float y = 0;
-        for (int i=0; i<string.length(); i++)
+        final float scale = metrics.getScale(pixelSize);
+        for (int i=0; i<run.size(); i++)
         {
             p[i] = new Path2D();
             p[i].reset();
-            t.setTransform(transform);
-            char character = string.charAt(i);
-            if (character == '\n') {
-                y += advanceY;
-                advanceTotal = 0;
+            final TypecastGlyph glyph = run.glyphs[i];
+            if (glyph.getSymbol() == ' ') {
                 continue;
-            } else if (character == ' ') {
-                advanceTotal += font.getAdvanceWidth(Glyph.ID_SPACE, pixelSize);
-                continue;
-            }        
-            Glyph glyph = font.getGlyph(character);
-            Path2D gp = ((GlyphInt)glyph).getPath();
-            float scale = metrics.getScale(pixelSize);
-            t.translate(advanceTotal, y);
+            }
+            t.setTransform(transform);
+            Path2D gp = glyph.getPath();
+            t.translate(run.x[i], run.y[i]);
             t.scale(scale, scale);
             p[i].append(gp.iterator(t), false);
-            advanceTotal += glyph.getAdvance(pixelSize, true); 
         }
     }
 
     public static ArrayList<OutlineShape> getOutlineShapes(TypecastFont font, CharSequence string, float pixelSize, AffineTransform transform, Factory<? extends Vertex> vertexFactory) {
-        Path2D[] paths = new Path2D[string.length()];
-        getPaths(font, string, pixelSize, transform, paths);
+        if (string == null) {
+            return new ArrayList<OutlineShape>();
+        }
+        // glyph positions incl. ligatures and kerning, shared w/ the string metrics
+        final TypecastLayout.GlyphRun run = font.getLayout().getRun(string, pixelSize);
+        Path2D[] paths = new Path2D[run.size()];
+        getPaths(font, run, pixelSize, transform, paths);
 
         ArrayList<OutlineShape> shapes = new ArrayList<OutlineShape>();
         final int numGlyps = paths.length;
@@ -114,6 +100,23 @@ public class TypecastRenderer {
         }
         return shapes;
     }
+    /**
+     * @return the {@link OutlineShape} of the untransformed path, or an empty one if path is null
+     */
+    public static OutlineShape getOutlineShape(Path2D path, Factory<? extends Vertex> vertexFactory) {
+        OutlineShape shape = new OutlineShape(vertexFactory);
+        if(null != path) {
+            PathIterator iterator = path.iterator(null);
+            while(!iterator.isDone()){
+                float[] coords = new float[6];
+                int segmentType = iterator.currentSegment(coords);
+                addPathVertexToOutline(shape, vertexFactory, coords, segmentType);
+                iterator.next();
+            }
+        }
+        return shape;
+    }
+
     private static void addPathVertexToOutline(OutlineShape shape, Factory<? extends Vertex> vertexFactory, float[] coords, int segmentType){
         switch(segmentType) {
         case PathIterator.SEG_MOVETO:
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package jogamp.graph.font.typecast.ot;
+
+import java.io.InputStream;
+import java.nio.ByteBuffer;
+
+/**
+ * An {@link InputStream} reading a {@link ByteBuffer}, e.g. a memory mapped font file,
+ * from its position up to its limit.
+ * <p>
+ * The given buffer's position is not modified. Mark and reset are supported with an unlimited read limit.
+ * </p>
+ */
+public class ByteBufferInputStream extends InputStream {
+    private final ByteBuffer buf;
+    private int mark;
+
+    public ByteBufferInputStream(ByteBuffer buf) {
+        this.buf = buf.duplicate();
+        this.mark = this.buf.position();
+    }
+
+    @Override
+    public int read() {
+        return buf.hasRemaining() ? buf.get() & 0xFF : -1;
+    }
+
+    @Override
+    public int read(byte[] b, int off, int len) {
+        if( 0 == len ) {
+            return 0;
+        }
+        final int n = Math.min(len, buf.remaining());
+        if( 0 == n ) {
+            return -1;
+        }
+        buf.get(b, off, n);
+        return n;
+    }
+
+    @Override
+    public long skip(long n) {
+        if( 0 >= n ) {
+            return 0;
+        }
+        final int k = (int) Math.min(n, buf.remaining());
+        buf.position(buf.position() + k);
+        return k;
+    }
+
+    @Override
+    public int available() {
+        return buf.remaining();
+    }
+
+    @Override
+    public boolean markSupported() {
+        return true;
+    }
+
+    @Override
+    public synchronized void mark(int readlimit) {
+        mark = buf.position();
+    }
+
+    @Override
+    public synchronized void reset() {
+        buf.position(mark);
+    }
+}
@@ -52,6 +52,7 @@ package jogamp.graph.font.typecast.ot;
 
 import java.io.DataInputStream;
 import java.io.IOException;
+import java.nio.ByteBuffer;
 
 import jogamp.graph.font.typecast.ot.table.CmapTable;
 import jogamp.graph.font.typecast.ot.table.DirectoryEntry;
@@ -95,6 +96,12 @@ public class OTFont {
     private PostTable _post;
     private VheaTable _vhea;
 
+    // lazy mode, see read(ByteBuffer, int, int, int)
+    private ByteBuffer _data;
+    private int _tablesOrigin;
+    private int _glyphCacheSize;
+    private boolean[] _loaded;
+
     /**
      * Constructor
      */
@@ -105,10 +112,11 @@ public class OTFont {
         if(null == sb) {
             sb = new StringBuilder();
         }        
-        return _name.getRecordsRecordString(sb, nameIndex);
+        return getNameTable().getRecordsRecordString(sb, nameIndex);
     }
     
     public StringBuilder getAllNames(StringBuilder sb, String separator) {
+        final NameTable _name = getNameTable();
         if(null != _name) {
             if(null == sb) {
                 sb = new StringBuilder();
@@ -121,6 +129,9 @@ public class OTFont {
     }
     
     public Table getTable(int tableType) {
+        if (_data != null) {
+            return loadTable(tableType);
+        }
         for (int i = 0; i < _tables.length; i++) {
             if ((_tables[i] != null) && (_tables[i].getType() == tableType)) {
                 return _tables[i];
@@ -130,69 +141,110 @@ public class OTFont {
     }
 
     public Os2Table getOS2Table() {
+        if (_os2 == null) {
+            _os2 = (Os2Table) getTable(Table.OS_2);
+        }
         return _os2;
     }
     
     public CmapTable getCmapTable() {
+        if (_cmap == null) {
+            _cmap = (CmapTable) getTable(Table.cmap);
+        }
         return _cmap;
     }
     
     public HeadTable getHeadTable() {
+        if (_head == null) {
+            _head = (HeadTable) getTable(Table.head);
+        }
         return _head;
     }
     
     public HheaTable getHheaTable() {
+        if (_hhea == null) {
+            _hhea = (HheaTable) getTable(Table.hhea);
+        }
         return _hhea;
     }
     
     public HdmxTable getHdmxTable() {
+        if (_hdmx == null) {
+            _hdmx = (HdmxTable) getTable(Table.hdmx);
+        }
         return _hdmx;
     }
     
     public HmtxTable getHmtxTable() {
+        if (_hmtx == null) {
+            _hmtx = (HmtxTable) getTable(Table.hmtx);
+        }
         return _hmtx;
     }
     
     public LocaTable getLocaTable() {
+        if (_loca == null) {
+            _loca = (LocaTable) getTable(Table.loca);
+        }
         return _loca;
     }
     
     public MaxpTable getMaxpTable() {
+        if (_maxp == null) {
+            _maxp = (MaxpTable) getTable(Table.maxp);
+        }
         return _maxp;
     }
 
     public NameTable getNameTable() {
+        if (_name == null) {
+            _name = (NameTable) getTable(Table.name);
+        }
         return _name;
     }
 
     public PostTable getPostTable() {
+        if (_post == null) {
+            _post = (PostTable) getTable(Table.post);
+        }
         return _post;
     }
 
+    private GlyfTable getGlyfTable() {
+        if (_glyf == null) {
+            _glyf = (GlyfTable) getTable(Table.glyf);
+        }
+        return _glyf;
+    }
+
     public VheaTable getVheaTable() {
+        if (_vhea == null) {
+            _vhea = (VheaTable) getTable(Table.vhea);
+        }
         return _vhea;
     }
 
     public int getAscent() {
-        return _hhea.getAscender();
+        return getHheaTable().getAscender();
     }
 
     public int getDescent() {
-        return _hhea.getDescender();
+        return getHheaTable().getDescender();
     }
 
     public int getNumGlyphs() {
-        return _maxp.getNumGlyphs();
+        return getMaxpTable().getNumGlyphs();
     }
 
     public OTGlyph getGlyph(int i) {
         
-        final GlyfDescript _glyfDescr = _glyf.getDescription(i); 
+        final GlyfDescript _glyfDescr = getGlyfTable().getDescription(i); 
+        final HmtxTable hmtx = getHmtxTable();
         return (null != _glyfDescr)
             ? new OTGlyph(
                 _glyfDescr,
-                _hmtx.getLeftSideBearing(i),
-                _hmtx.getAdvanceWidth(i))
+                hmtx.getLeftSideBearing(i),
+                hmtx.getAdvanceWidth(i))
             : null;
     }
     
@@ -283,6 +335,53 @@ public class OTFont {
         _glyf = (GlyfTable) getTable(Table.glyf);
     }
 
+    /**
+     * Reads the table directory only, all tables are decoded on first access, see {@link #getTable(int)}.
+     * 
+     * @param data OpenType/TrueType font file data, usually memory mapped.
+     * @param directoryOffset The Table Directory offset within the file, 
+     *        see {@link #read(DataInputStream, int, int)}.
+     * @param tablesOrigin The point the table offsets are calculated from,
+     *        see {@link #read(DataInputStream, int, int)}.
+     * @param glyphCacheSize maximum number of decoded glyph descriptions kept by the 'glyf' table
+     */
+    protected void read(
+            ByteBuffer data,
+            int directoryOffset,
+            int tablesOrigin,
+            int glyphCacheSize) throws IOException {
+        final ByteBuffer dir = data.duplicate();
+        dir.position(directoryOffset);
+        _tableDirectory = new TableDirectory(new DataInputStream(new ByteBufferInputStream(dir)));
+        _tables = new Table[_tableDirectory.getNumTables()];
+        _loaded = new boolean[_tableDirectory.getNumTables()];
+        _tablesOrigin = tablesOrigin;
+        _glyphCacheSize = glyphCacheSize;
+        _data = data;
+    }
+
+    /** Lazy mode: Returns the table of the given type, decoding it on first access. */
+    private synchronized Table loadTable(int tag) {
+        for (int i = 0; i < _tables.length; i++) {
+            final DirectoryEntry entry = _tableDirectory.getEntry(i);
+            if (entry.getTag() != tag) {
+                continue;
+            }
+            if (!_loaded[i]) {
+                final ByteBuffer b = _data.duplicate();
+                b.position(_tablesOrigin + entry.getOffset());
+                try {
+                    _tables[i] = TableFactory.create(_fc, this, entry, b.slice(), _glyphCacheSize);
+                } catch (IOException e) {
+                    throw new RuntimeException("Failed to read table "+entry, e);
+                }
+                _loaded[i] = true;
+            }
+            return _tables[i];
+        }
+        return null;
+    }
+
     public String toString() {
         if (_tableDirectory != null) {
             return _tableDirectory.toString();
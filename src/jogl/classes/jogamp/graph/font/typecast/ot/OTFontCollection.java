@@ -25,6 +25,8 @@ import java.io.BufferedInputStream;
 import java.io.DataInputStream;
 import java.io.FileInputStream;
 import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
 
 import java.util.ArrayList;
 
@@ -64,6 +66,22 @@ public class OTFontCollection {
         return fc;
     }
 
+    /**
+     * Memory maps the font file and reads its table directories only.
+     * Tables are decoded on first access and glyph descriptions on demand
+     * via the 'loca' offsets, keeping up to <code>glyphCacheSize</code> of them.
+     * <p>
+     * Mac font resources are read at once as with {@link #create(File)}.
+     * </p>
+     * @param file The OpenType font file
+     * @param glyphCacheSize maximum number of decoded glyph descriptions kept per font
+     */
+    public static OTFontCollection createMapped(File file, int glyphCacheSize) throws IOException {
+        OTFontCollection fc = new OTFontCollection();
+        fc.readMapped(file, glyphCacheSize);
+        return fc;
+    }
+
     public String getPathName() {
         return _pathName;
     }
@@ -84,7 +102,7 @@ public class OTFontCollection {
         return _ttcHeader;
     }
 
-    public Table getTable(DirectoryEntry de) {
+    public synchronized Table getTable(DirectoryEntry de) {
         for (int i = 0; i < _tables.size(); i++) {
             Table table = _tables.get(i);
             if ((table.getDirectoryEntry().getTag() == de.getTag()) &&
@@ -95,7 +113,7 @@ public class OTFontCollection {
         return null;
     }
 
-    public void addTable(Table table) {
+    public synchronized void addTable(Table table) {
         _tables.add(table);
     }
 
@@ -167,4 +185,44 @@ public class OTFontCollection {
         }
         dis.close();
     }
+
+    /**
+     * @param file The OpenType font file
+     */
+    protected void readMapped(File file, int glyphCacheSize) throws IOException {
+        if (file.length() == 0 || file.getName().endsWith(".dfont")) {
+            read(file);
+            return;
+        }
+        _pathName = file.getPath();
+        _fileName = file.getName();
+
+        final ByteBuffer data;
+        final FileInputStream fis = new FileInputStream(file);
+        try {
+            final FileChannel fch = fis.getChannel();
+            data = fch.map(FileChannel.MapMode.READ_ONLY, 0, fch.size()); // stays valid after close
+        } finally {
+            fis.close();
+        }
+        
+        DataInputStream dis = new DataInputStream(new ByteBufferInputStream(data));
+        if (TTCHeader.isTTC(dis)) {
+
+            // This is a TrueType font collection
+            dis.reset();
+            _ttcHeader = new TTCHeader(dis);
+            _fonts = new OTFont[_ttcHeader.getDirectoryCount()];
+            for (int i = 0; i < _ttcHeader.getDirectoryCount(); i++) {
+                _fonts[i] = new OTFont(this);
+                _fonts[i].read(data, _ttcHeader.getTableDirectory(i), 0, glyphCacheSize);
+            }
+        } else {
+
+            // This is a standalone font file
+            _fonts = new OTFont[1];
+            _fonts[0] = new OTFont(this);
+            _fonts[0].read(data, 0, 0, glyphCacheSize);
+        }
+    }
 }
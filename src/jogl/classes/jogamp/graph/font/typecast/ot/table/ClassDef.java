@@ -8,8 +8,8 @@
 
 package jogamp.graph.font.typecast.ot.table;
 
+import java.io.DataInput;
 import java.io.IOException;
-import java.io.RandomAccessFile;
 
 /**
  *
@@ -20,13 +20,19 @@ public abstract class ClassDef {
 
     public abstract int getFormat();
 
-    protected static ClassDef read(RandomAccessFile raf) throws IOException {
+    /**
+     * @param glyphId The ID of the glyph to classify.
+     * @return The class of the glyph, or 0 if the glyph isn't assigned to a class.
+     */
+    public abstract int getGlyphClass(int glyphId);
+
+    protected static ClassDef read(DataInput di) throws IOException {
         ClassDef c = null;
-        int format = raf.readUnsignedShort();
+        int format = di.readUnsignedShort();
         if (format == 1) {
-            c = new ClassDefFormat1(raf);
+            c = new ClassDefFormat1(di);
         } else if (format == 2) {
-            c = new ClassDefFormat2(raf);
+            c = new ClassDefFormat2(di);
         }
         return c;
     }
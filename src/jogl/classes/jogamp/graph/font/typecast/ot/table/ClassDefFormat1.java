@@ -8,8 +8,8 @@
 
 package jogamp.graph.font.typecast.ot.table;
 
+import java.io.DataInput;
 import java.io.IOException;
-import java.io.RandomAccessFile;
 
 /**
  *
@@ -23,12 +23,12 @@ public class ClassDefFormat1 extends ClassDef {
     private int[] classValues;
 
     /** Creates new ClassDefFormat1 */
-    public ClassDefFormat1(RandomAccessFile raf) throws IOException {
-        startGlyph = raf.readUnsignedShort();
-        glyphCount = raf.readUnsignedShort();
+    public ClassDefFormat1(DataInput di) throws IOException {
+        startGlyph = di.readUnsignedShort();
+        glyphCount = di.readUnsignedShort();
         classValues = new int[glyphCount];
         for (int i = 0; i < glyphCount; i++) {
-            classValues[i] = raf.readUnsignedShort();
+            classValues[i] = di.readUnsignedShort();
         }
     }
 
@@ -36,4 +36,12 @@ public class ClassDefFormat1 extends ClassDef {
         return 1;
     }
 
+    public int getGlyphClass(int glyphId) {
+        int i = glyphId - startGlyph;
+        if (0 <= i && i < glyphCount) {
+            return classValues[i];
+        }
+        return 0;
+    }
+
 }
@@ -8,8 +8,8 @@
 
 package jogamp.graph.font.typecast.ot.table;
 
+import java.io.DataInput;
 import java.io.IOException;
-import java.io.RandomAccessFile;
 
 /**
  *
@@ -22,11 +22,11 @@ public class ClassDefFormat2 extends ClassDef {
     private RangeRecord[] classRangeRecords;
 
     /** Creates new ClassDefFormat2 */
-    public ClassDefFormat2(RandomAccessFile raf) throws IOException {
-        classRangeCount = raf.readUnsignedShort();
+    public ClassDefFormat2(DataInput di) throws IOException {
+        classRangeCount = di.readUnsignedShort();
         classRangeRecords = new RangeRecord[classRangeCount];
         for (int i = 0; i < classRangeCount; i++) {
-            classRangeRecords[i] = new RangeRecord(raf);
+            classRangeRecords[i] = new RangeRecord(di);
         }
     }
 
@@ -34,4 +34,13 @@ public class ClassDefFormat2 extends ClassDef {
         return 2;
     }
 
+    public int getGlyphClass(int glyphId) {
+        for (int i = 0; i < classRangeCount; i++) {
+            if (classRangeRecords[i].isInRange(glyphId)) {
+                return classRangeRecords[i].getStartCoverageIndex();
+            }
+        }
+        return 0;
+    }
+
 }
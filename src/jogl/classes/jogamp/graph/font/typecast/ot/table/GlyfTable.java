@@ -54,6 +54,11 @@ import java.io.ByteArrayInputStream;
 import java.io.DataInput;
 import java.io.DataInputStream;
 import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.util.LinkedHashMap;
+import java.util.Map;
+
+import jogamp.graph.font.typecast.ot.ByteBufferInputStream;
 
 /**
  * @version $Id: GlyfTable.java,v 1.6 2010-08-10 11:46:30 davidsch Exp $
@@ -64,6 +69,12 @@ public class GlyfTable implements Table {
     private DirectoryEntry _de;
     private GlyfDescript[] _descript;
 
+    // lazy mode: descriptions are decoded on demand and kept in a bounded LRU cache
+    private ByteBuffer _data;
+    private LocaTable _loca;
+    private int _numGlyphs;
+    private Map<Integer, GlyfDescript> _cache;
+
     protected GlyfTable(
             DirectoryEntry de,
             DataInput di,
@@ -108,7 +119,34 @@ public class GlyfTable implements Table {
         }
     }
 
+    /**
+     * Creates a table decoding glyph descriptions on first access via the 'loca' offsets,
+     * keeping up to <code>cacheSize</code> recently used descriptions.
+     * @param data the table data starting at its position
+     */
+    protected GlyfTable(
+            DirectoryEntry de,
+            ByteBuffer data,
+            MaxpTable maxp,
+            LocaTable loca,
+            final int cacheSize) {
+        _de = (DirectoryEntry) de.clone();
+        _data = data.slice();
+        _loca = loca;
+        _numGlyphs = maxp.getNumGlyphs();
+        _cache = new LinkedHashMap<Integer, GlyfDescript>(Math.max(1, Math.min(cacheSize, 1024)), 0.75f, true) {
+            private static final long serialVersionUID = 1L;
+            @Override
+            protected boolean removeEldestEntry(Map.Entry<Integer, GlyfDescript> eldest) {
+                return size() > cacheSize;
+            }
+        };
+    }
+
     public GlyfDescript getDescription(int i) {
+        if (_descript == null) {
+            return getCachedDescription(i);
+        }
         if (i < _descript.length) {
             return _descript[i];
         } else {
@@ -116,6 +154,44 @@ public class GlyfTable implements Table {
         }
     }
 
+    private GlyfDescript getCachedDescription(int i) {
+        if (i < 0 || i >= _numGlyphs) {
+            return null;
+        }
+        final Integer key = Integer.valueOf(i);
+        synchronized (_cache) {
+            GlyfDescript d = _cache.get(key);
+            if (d == null) {
+                // composite glyphs recursively decode their components
+                d = readDescription(i);
+                if (d != null) {
+                    _cache.put(key, d);
+                }
+            }
+            return d;
+        }
+    }
+
+    private GlyfDescript readDescription(int i) {
+        final int offset = _loca.getOffset(i);
+        if (_loca.getOffset(i + 1) - offset <= 0) {
+            return null;
+        }
+        final ByteBuffer b = _data.duplicate();
+        b.position(offset);
+        try {
+            DataInputStream dis = new DataInputStream(new ByteBufferInputStream(b));
+            short numberOfContours = dis.readShort();
+            if (numberOfContours >= 0) {
+                return new GlyfSimpleDescript(this, i, numberOfContours, dis);
+            } else {
+                return new GlyfCompositeDescript(this, i, dis);
+            }
+        } catch (IOException e) {
+            throw new RuntimeException("Failed to read glyph "+i, e);
+        }
+    }
+
     public int getType() {
         return glyf;
     }
@@ -20,26 +20,88 @@
 
 package jogamp.graph.font.typecast.ot.table;
 
+import java.io.ByteArrayInputStream;
 import java.io.DataInput;
+import java.io.DataInputStream;
 import java.io.IOException;
 
 /**
- * TODO: To be implemented
+ * Glyph positioning table, only pair adjustment lookups are interpreted.
  * @author <a href="mailto:davidsch@dev.java.net">David Schweinsberg</a>
  * @version $Id: GposTable.java,v 1.2 2007-01-24 09:47:47 davidsch Exp $
  */
-public class GposTable implements Table {
+public class GposTable implements Table, LookupSubtableFactory {
 
     private DirectoryEntry _de;
+    private ScriptList _scriptList;
+    private FeatureList _featureList;
+    private LookupList _lookupList;
 
     protected GposTable(DirectoryEntry de, DataInput di) throws IOException {
         _de = (DirectoryEntry) de.clone();
 
+        // Load into a temporary buffer, and create another input stream
+        byte[] buf = new byte[de.getLength()];
+        di.readFully(buf);
+        DataInputStream dis = new DataInputStream(new ByteArrayInputStream(buf));
+
         // GPOS Header
-        int version = di.readInt();
-        int scriptList = di.readInt();
-        int featureList = di.readInt();
-        int lookupList = di.readInt();
+        int version = dis.readInt();
+        int scriptListOffset = dis.readUnsignedShort();
+        int featureListOffset = dis.readUnsignedShort();
+        int lookupListOffset = dis.readUnsignedShort();
+
+        // Script List
+        _scriptList = new ScriptList(dis, scriptListOffset);
+
+        // Feature List
+        _featureList = new FeatureList(dis, featureListOffset);
+
+        // Lookup List
+        _lookupList = new LookupList(dis, lookupListOffset, this);
+    }
+
+    /**
+     * 1 - Single - Adjust position of a single glyph
+     * 2 - Pair - Adjust position of a pair of glyphs
+     * 3 - Cursive - Attach cursive glyphs
+     * 4 - MarkToBase - Attach a combining mark to a base glyph
+     * 5 - MarkToLigature - Attach a combining mark to a ligature
+     * 6 - MarkToMark - Attach a combining mark to another mark
+     * 7 - Context - Position one or more glyphs in context
+     * 8 - Chained Context - Position one or more glyphs in chained context
+     * 9 - Extension - Extension mechanism for other positionings
+     */
+    public LookupSubtable read(
+            int type,
+            DataInputStream dis,
+            int offset) throws IOException {
+        LookupSubtable s = null;
+        switch (type) {
+        case 2:
+            s = PairPos.read(dis, offset);
+            break;
+        case 9:
+            s = readExtension(dis, offset);
+            break;
+        }
+        return s;
+    }
+
+    /**
+     * Reads the subtable referenced by an extension subtable,
+     * which uses a 32bit offset relative to itself.
+     */
+    private LookupSubtable readExtension(DataInputStream dis, int offset) throws IOException {
+        dis.reset();
+        dis.skipBytes(offset);
+        int format = dis.readUnsignedShort();
+        int extensionLookupType = dis.readUnsignedShort();
+        int extensionOffset = dis.readInt();
+        if (format != 1 || extensionLookupType == 9) {
+            return null;
+        }
+        return read(extensionLookupType, dis, offset + extensionOffset);
     }
 
     /** Get the table type, as a table directory value.
@@ -48,7 +110,19 @@ public class GposTable implements Table {
     public int getType() {
         return GPOS;
     }
-    
+
+    public ScriptList getScriptList() {
+        return _scriptList;
+    }
+
+    public FeatureList getFeatureList() {
+        return _featureList;
+    }
+
+    public LookupList getLookupList() {
+        return _lookupList;
+    }
+
     public String toString() {
         return "GPOS";
     }
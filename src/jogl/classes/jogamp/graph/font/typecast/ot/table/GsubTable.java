@@ -98,6 +98,7 @@ public class GsubTable implements Table, LookupSubtableFactory {
      * 4 - Ligature - Replace multiple glyphs with one glyph 
      * 5 - Context - Replace one or more glyphs in context 
      * 6 - Chaining - Context Replace one or more glyphs in chained context
+     * 7 - Extension - Extension mechanism for other substitutions
      */
     public LookupSubtable read(
             int type,
@@ -123,10 +124,29 @@ public class GsubTable implements Table, LookupSubtableFactory {
         case 6:
 //            s = ChainingSubst.read(dis, offset);
             break;
+        case 7:
+            s = readExtension(dis, offset);
+            break;
         }
         return s;
     }
 
+    /**
+     * Reads the subtable referenced by an extension subtable,
+     * which uses a 32bit offset relative to itself.
+     */
+    private LookupSubtable readExtension(DataInputStream dis, int offset) throws IOException {
+        dis.reset();
+        dis.skipBytes(offset);
+        int format = dis.readUnsignedShort();
+        int extensionLookupType = dis.readUnsignedShort();
+        int extensionOffset = dis.readInt();
+        if (format != 1 || extensionLookupType == 7) {
+            return null;
+        }
+        return read(extensionLookupType, dis, offset + extensionOffset);
+    }
+
     /** Get the table type, as a table directory value.
      * @return The table type
      */
@@ -164,6 +184,8 @@ public class GsubTable implements Table, LookupSubtableFactory {
             return "Context";
         case 6:
             return "Chaining";
+        case 7:
+            return "Extension";
         }
         return "Unknown";
     }
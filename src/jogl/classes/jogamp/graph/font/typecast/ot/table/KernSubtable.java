@@ -18,6 +18,8 @@ import java.io.IOException;
  */
 public abstract class KernSubtable {
 
+    private int coverage;
+
     /** Creates new KernSubtable */
     protected KernSubtable() {
     }
@@ -26,6 +28,18 @@ public abstract class KernSubtable {
 
     public abstract KerningPair getKerningPair(int i);
 
+    public int getCoverage() {
+        return coverage;
+    }
+
+    /**
+     * @return true if this subtable holds plain horizontal kerning values,
+     *         i.e. neither minimum nor cross-stream values.
+     */
+    public boolean isHorizontal() {
+        return ( coverage & 0x07 ) == 0x01;
+    }
+
     public static KernSubtable read(DataInput di) throws IOException {
         KernSubtable table = null;
         int version = di.readUnsignedShort();
@@ -39,10 +53,16 @@ public abstract class KernSubtable {
             break;
         case 2:
             table = new KernSubtableFormat2(di);
+            // the class tables and the kerning array are not read
+            di.skipBytes(length - 14);
             break;
         default:
+            di.skipBytes(length - 6);
             break;
         }
+        if (null != table) {
+            table.coverage = coverage;
+        }
         return table;
     }
 
@@ -81,5 +81,13 @@ public class LigatureSet {
         }
     }
 
+    public int getLigatureCount() {
+        return _ligatureCount;
+    }
+
+    public Ligature getLigature(int i) {
+        return _ligatures[i];
+    }
+
 }
 
@@ -60,6 +60,18 @@ import java.io.IOException;
  */
 public abstract class LigatureSubst extends LookupSubtable {
 
+    public abstract int getFormat();
+
+    /**
+     * Finds the first ligature matching the glyphs starting at <code>glyphIds[offset]</code>.
+     * @param glyphIds The glyph sequence
+     * @param offset Index of the first glyph to substitute
+     * @param length Number of valid glyphs within <code>glyphIds</code>
+     * @return The matching ligature, replacing {@link Ligature#getGlyphCount()} glyphs
+     *         by {@link Ligature#getGlyphId(int) getGlyphId(0)}, or null if none matches.
+     */
+    public abstract Ligature findLigature(int[] glyphIds, int offset, int length);
+
     public static LigatureSubst read(DataInputStream dis, int offset) throws IOException {
         dis.reset();
         dis.skipBytes(offset);
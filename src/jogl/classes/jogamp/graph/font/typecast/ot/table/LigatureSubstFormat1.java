@@ -89,6 +89,29 @@ public class LigatureSubstFormat1 extends LigatureSubst {
         return 1;
     }
 
+    public Ligature findLigature(int[] glyphIds, int offset, int length) {
+        int i = _coverage.findGlyph(glyphIds[offset]);
+        if (i < 0 || i >= _ligSetCount) {
+            return null;
+        }
+        LigatureSet ligatureSet = _ligatureSets[i];
+        for (int j = 0; j < ligatureSet.getLigatureCount(); j++) {
+            Ligature ligature = ligatureSet.getLigature(j);
+            int n = ligature.getGlyphCount();
+            if (offset + n > length) {
+                continue;
+            }
+            int k = 1;
+            while (k < n && glyphIds[offset + k] == ligature.getGlyphId(k)) {
+                k++;
+            }
+            if (k == n) {
+                return ligature;
+            }
+        }
+        return null;
+    }
+
     public String getTypeAsString() {
         return "LigatureSubstFormat1";
     }    
@@ -0,0 +1,62 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package jogamp.graph.font.typecast.ot.table;
+
+import java.io.DataInputStream;
+import java.io.IOException;
+
+/**
+ * GPOS lookup type 2, pair adjustment positioning subtable.
+ */
+public abstract class PairPos extends LookupSubtable {
+
+    public abstract int getFormat();
+
+    /**
+     * @param firstGlyphId The ID of the first glyph of the pair
+     * @param secondGlyphId The ID of the glyph following the first glyph
+     * @return The adjustments <code>{ value1, value2 }</code> of the first and the second glyph,
+     *         or null if the pair is not covered by this subtable.
+     *         <code>value2</code> is null if the subtable does not adjust the second glyph.
+     */
+    public abstract ValueRecord[] findPair(int firstGlyphId, int secondGlyphId);
+
+    public static PairPos read(DataInputStream dis, int offset) throws IOException {
+        PairPos s = null;
+        dis.reset();
+        dis.skipBytes(offset);
+        int format = dis.readUnsignedShort();
+        if (format == 1) {
+            s = new PairPosFormat1(dis, offset);
+        } else if (format == 2) {
+            s = new PairPosFormat2(dis, offset);
+        }
+        return s;
+    }
+
+}
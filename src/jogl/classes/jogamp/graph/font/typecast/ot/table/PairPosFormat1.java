@@ -0,0 +1,111 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package jogamp.graph.font.typecast.ot.table;
+
+import java.io.DataInputStream;
+import java.io.IOException;
+
+/**
+ * Pair adjustment of individual glyph pairs, 
+ * the pairs of each first glyph are sorted by the ID of the second glyph.
+ */
+public class PairPosFormat1 extends PairPos {
+
+    private int _coverageOffset;
+    private int _valueFormat1;
+    private int _valueFormat2;
+    private int _pairSetCount;
+    private int[] _pairSetOffsets;
+    private Coverage _coverage;
+    /** Per pair set the second glyph IDs */
+    private int[][] _secondGlyphs;
+    /** Per pair set the <code>{ value1, value2 }</code> records, parallel to {@link #_secondGlyphs} */
+    private ValueRecord[][][] _values;
+
+    /** Creates new PairPosFormat1 */
+    protected PairPosFormat1(DataInputStream dis, int offset) throws IOException {
+        _coverageOffset = dis.readUnsignedShort();
+        _valueFormat1 = dis.readUnsignedShort();
+        _valueFormat2 = dis.readUnsignedShort();
+        _pairSetCount = dis.readUnsignedShort();
+        _pairSetOffsets = new int[_pairSetCount];
+        for (int i = 0; i < _pairSetCount; i++) {
+            _pairSetOffsets[i] = dis.readUnsignedShort();
+        }
+        _secondGlyphs = new int[_pairSetCount][];
+        _values = new ValueRecord[_pairSetCount][][];
+        for (int i = 0; i < _pairSetCount; i++) {
+            dis.reset();
+            dis.skipBytes(offset + _pairSetOffsets[i]);
+            int pairValueCount = dis.readUnsignedShort();
+            int[] secondGlyphs = new int[pairValueCount];
+            ValueRecord[][] values = new ValueRecord[pairValueCount][];
+            for (int j = 0; j < pairValueCount; j++) {
+                secondGlyphs[j] = dis.readUnsignedShort();
+                ValueRecord value1 = new ValueRecord(dis, _valueFormat1);
+                ValueRecord value2 = 0 != _valueFormat2 ? new ValueRecord(dis, _valueFormat2) : null;
+                values[j] = new ValueRecord[] { value1, value2 };
+            }
+            _secondGlyphs[i] = secondGlyphs;
+            _values[i] = values;
+        }
+        dis.reset();
+        dis.skipBytes(offset + _coverageOffset);
+        _coverage = Coverage.read(dis);
+    }
+
+    public int getFormat() {
+        return 1;
+    }
+
+    public ValueRecord[] findPair(int firstGlyphId, int secondGlyphId) {
+        int i = _coverage.findGlyph(firstGlyphId);
+        if (i < 0 || i >= _pairSetCount) {
+            return null;
+        }
+        int[] secondGlyphs = _secondGlyphs[i];
+        int lo = 0;
+        int hi = secondGlyphs.length - 1;
+        while (lo <= hi) {
+            int mid = (lo + hi) >>> 1;
+            int g = secondGlyphs[mid];
+            if (g < secondGlyphId) {
+                lo = mid + 1;
+            } else if (g > secondGlyphId) {
+                hi = mid - 1;
+            } else {
+                return _values[i][mid];
+            }
+        }
+        return null;
+    }
+
+    public String getTypeAsString() {
+        return "PairPosFormat1";
+    }
+}
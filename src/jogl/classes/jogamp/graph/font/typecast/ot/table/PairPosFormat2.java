@@ -0,0 +1,96 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package jogamp.graph.font.typecast.ot.table;
+
+import java.io.DataInputStream;
+import java.io.IOException;
+
+/**
+ * Pair adjustment by the classes of the first and the second glyph.
+ */
+public class PairPosFormat2 extends PairPos {
+
+    private int _coverageOffset;
+    private int _valueFormat1;
+    private int _valueFormat2;
+    private int _classDef1Offset;
+    private int _classDef2Offset;
+    private int _class1Count;
+    private int _class2Count;
+    private Coverage _coverage;
+    private ClassDef _classDef1;
+    private ClassDef _classDef2;
+    /** <code>{ value1, value2 }</code> records, indexed by <code>class1 * class2Count + class2</code> */
+    private ValueRecord[][] _values;
+
+    /** Creates new PairPosFormat2 */
+    protected PairPosFormat2(DataInputStream dis, int offset) throws IOException {
+        _coverageOffset = dis.readUnsignedShort();
+        _valueFormat1 = dis.readUnsignedShort();
+        _valueFormat2 = dis.readUnsignedShort();
+        _classDef1Offset = dis.readUnsignedShort();
+        _classDef2Offset = dis.readUnsignedShort();
+        _class1Count = dis.readUnsignedShort();
+        _class2Count = dis.readUnsignedShort();
+        _values = new ValueRecord[_class1Count * _class2Count][];
+        for (int i = 0; i < _values.length; i++) {
+            ValueRecord value1 = new ValueRecord(dis, _valueFormat1);
+            ValueRecord value2 = 0 != _valueFormat2 ? new ValueRecord(dis, _valueFormat2) : null;
+            _values[i] = new ValueRecord[] { value1, value2 };
+        }
+        dis.reset();
+        dis.skipBytes(offset + _coverageOffset);
+        _coverage = Coverage.read(dis);
+        dis.reset();
+        dis.skipBytes(offset + _classDef1Offset);
+        _classDef1 = ClassDef.read(dis);
+        dis.reset();
+        dis.skipBytes(offset + _classDef2Offset);
+        _classDef2 = ClassDef.read(dis);
+    }
+
+    public int getFormat() {
+        return 2;
+    }
+
+    public ValueRecord[] findPair(int firstGlyphId, int secondGlyphId) {
+        if (_coverage.findGlyph(firstGlyphId) < 0) {
+            return null;
+        }
+        int class1 = null != _classDef1 ? _classDef1.getGlyphClass(firstGlyphId) : 0;
+        int class2 = null != _classDef2 ? _classDef2.getGlyphClass(secondGlyphId) : 0;
+        if (class1 >= _class1Count || class2 >= _class2Count) {
+            return null;
+        }
+        return _values[class1 * _class2Count + class2];
+    }
+
+    public String getTypeAsString() {
+        return "PairPosFormat2";
+    }
+}
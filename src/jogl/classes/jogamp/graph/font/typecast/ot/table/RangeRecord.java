@@ -76,6 +76,14 @@ public class RangeRecord {
         return (_start <= glyphId && glyphId <= _end);
     }
     
+    /**
+     * @return the coverage index of the first glyph of this range,
+     *         or the class of all glyphs of this range if used by a {@link ClassDefFormat2}. 
+     */
+    public int getStartCoverageIndex() {
+        return _startCoverageIndex;
+    }
+
     public int getCoverageIndex(int glyphId) {
         if (isInRange(glyphId)) {
             return _startCoverageIndex + glyphId - _start;
@@ -52,7 +52,9 @@ package jogamp.graph.font.typecast.ot.table;
 
 import java.io.DataInputStream;
 import java.io.IOException;
+import java.nio.ByteBuffer;
 
+import jogamp.graph.font.typecast.ot.ByteBufferInputStream;
 import jogamp.graph.font.typecast.ot.OTFont;
 import jogamp.graph.font.typecast.ot.OTFontCollection;
 
@@ -63,6 +65,36 @@ import jogamp.graph.font.typecast.ot.OTFontCollection;
  */
 public class TableFactory {
 
+    /**
+     * Creates the table from random accessible data, 
+     * where the 'glyf' table decodes its glyph descriptions on demand.
+     * 
+     * @param data the table data starting at its position
+     * @param glyphCacheSize maximum number of decoded glyph descriptions kept by the 'glyf' table
+     */
+    public static Table create(
+            OTFontCollection fc,
+            OTFont font,
+            DirectoryEntry de,
+            ByteBuffer data,
+            int glyphCacheSize) throws IOException {
+        if (de.getTag() != Table.glyf) {
+            return create(fc, font, de, new DataInputStream(new ByteBufferInputStream(data)));
+        }
+        Table t = null;
+        if (fc != null) {
+            t = fc.getTable(de);
+            if (t != null) {
+                return t;
+            }
+        }
+        t = new GlyfTable(de, data, font.getMaxpTable(), font.getLocaTable(), glyphCacheSize);
+        if (fc != null) {
+            fc.addTable(t);
+        }
+        return t;
+    }
+
     public static Table create(
             OTFontCollection fc,
             OTFont font,
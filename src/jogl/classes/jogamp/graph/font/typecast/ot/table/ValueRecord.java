@@ -0,0 +1,100 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package jogamp.graph.font.typecast.ot.table;
+
+import java.io.DataInput;
+import java.io.IOException;
+
+/**
+ * Positioning adjustment of a glyph in font units, as used by the GPOS lookups.
+ * <p>
+ * Device table offsets are skipped, i.e. no pixel size dependent corrections are applied.
+ * </p>
+ */
+public class ValueRecord {
+
+    // ValueFormat bit enumeration
+    public static final int X_PLACEMENT = 0x0001;
+    public static final int Y_PLACEMENT = 0x0002;
+    public static final int X_ADVANCE = 0x0004;
+    public static final int Y_ADVANCE = 0x0008;
+    public static final int X_PLACEMENT_DEVICE = 0x0010;
+    public static final int Y_PLACEMENT_DEVICE = 0x0020;
+    public static final int X_ADVANCE_DEVICE = 0x0040;
+    public static final int Y_ADVANCE_DEVICE = 0x0080;
+
+    private short _xPlacement;
+    private short _yPlacement;
+    private short _xAdvance;
+    private short _yAdvance;
+
+    /** Creates new ValueRecord, reading the fields selected by <code>valueFormat</code> */
+    public ValueRecord(DataInput di, int valueFormat) throws IOException {
+        if (0 != (valueFormat & X_PLACEMENT)) {
+            _xPlacement = di.readShort();
+        }
+        if (0 != (valueFormat & Y_PLACEMENT)) {
+            _yPlacement = di.readShort();
+        }
+        if (0 != (valueFormat & X_ADVANCE)) {
+            _xAdvance = di.readShort();
+        }
+        if (0 != (valueFormat & Y_ADVANCE)) {
+            _yAdvance = di.readShort();
+        }
+        for (int bit = X_PLACEMENT_DEVICE; bit <= Y_ADVANCE_DEVICE; bit <<= 1) {
+            if (0 != (valueFormat & bit)) {
+                di.readUnsignedShort();
+            }
+        }
+    }
+
+    public short getXPlacement() {
+        return _xPlacement;
+    }
+
+    public short getYPlacement() {
+        return _yPlacement;
+    }
+
+    public short getXAdvance() {
+        return _xAdvance;
+    }
+
+    public short getYAdvance() {
+        return _yAdvance;
+    }
+
+    public boolean isZero() {
+        return 0 == _xPlacement && 0 == _yPlacement && 0 == _xAdvance && 0 == _yAdvance;
+    }
+
+    public String toString() {
+        return "ValueRecord[xPla "+_xPlacement+", yPla "+_yPlacement+", xAdv "+_xAdvance+", yAdv "+_yAdvance+"]";
+    }
+}
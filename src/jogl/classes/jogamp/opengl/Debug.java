@@ -71,7 +71,11 @@ public class Debug extends PropertyAccess {
   public static final boolean getBooleanProperty(final String property, final boolean jnlpAlias) {
       return PropertyAccess.getBooleanProperty(property, jnlpAlias, null);
   }
-  
+
+  public static final int getIntProperty(final String property, final boolean jnlpAlias, int defaultValue) {
+      return PropertyAccess.getIntProperty(property, jnlpAlias, null, defaultValue);
+  }
+
   public static boolean verbose() {
     return verbose;
   }
@@ -28,6 +28,7 @@
 package jogamp.opengl;
 
 import java.io.PrintStream;
+import java.util.Arrays;
 import java.util.concurrent.TimeUnit;
 
 import javax.media.opengl.FPSCounter;
@@ -41,6 +42,11 @@ public class FPSCounterImpl implements FPSCounter {
     private long fpsStartTime, fpsLastUpdateTime, fpsLastPeriod, fpsTotalDuration;
     private int  fpsTotalFrames;
     private float fpsLast, fpsTotal;
+    private long[] frameTimes; // nanoseconds between consecutive frames of the current update interval
+    private int frameTimeCount;
+    private long lastFrameNanos;
+    private float frameTimeMin, frameTimeAvg, frameTimeP99, frameTimeMax;
+    private int missedDeadlines;
     
     /** Creates a disabled instance */
     public FPSCounterImpl() {
@@ -56,8 +62,16 @@ public class FPSCounterImpl implements FPSCounter {
      */
     public final synchronized void tickFPS() {
         fpsTotalFrames++;
-        if(fpsUpdateFramesInterval>0 && fpsTotalFrames%fpsUpdateFramesInterval == 0) {
-            final long now = TimeUnit.NANOSECONDS.toMillis(System.nanoTime());
+        if(fpsUpdateFramesInterval<=0) {
+            return;
+        }
+        final long nowNanos = System.nanoTime();
+        if( 0 != lastFrameNanos && frameTimeCount < frameTimes.length ) {
+            frameTimes[frameTimeCount++] = nowNanos - lastFrameNanos;
+        }
+        lastFrameNanos = nowNanos;
+        if(fpsTotalFrames%fpsUpdateFramesInterval == 0) {
+            final long now = TimeUnit.NANOSECONDS.toMillis(nowNanos);
             fpsLastPeriod = now - fpsLastUpdateTime;
             fpsLastPeriod = Math.max(fpsLastPeriod, 1); // div 0 
             fpsLast = ( (float)fpsUpdateFramesInterval * 1000f ) / ( (float) fpsLastPeriod ) ; 
@@ -66,6 +80,8 @@ public class FPSCounterImpl implements FPSCounter {
             fpsTotalDuration = Math.max(fpsTotalDuration, 1); // div 0
             fpsTotal= ( (float)fpsTotalFrames * 1000f ) / ( (float) fpsTotalDuration ) ;
             
+            updateFrameTimes();
+            
             if(null != fpsOutputStream) {
                 fpsOutputStream.println(toString());
             }
@@ -74,6 +90,34 @@ public class FPSCounterImpl implements FPSCounter {
         }
     }
     
+    /**
+     * Computes the frame time statistics of the elapsed update interval 
+     * and starts collecting the next one. 
+     */
+    private void updateFrameTimes() {
+        final int n = frameTimeCount;
+        if( 0 < n ) {
+            Arrays.sort(frameTimes, 0, n);
+            long sum = 0;
+            for(int i=0; i<n; i++) {
+                sum += frameTimes[i];
+            }
+            frameTimeMin = frameTimes[0] / 1000000f;
+            frameTimeMax = frameTimes[n-1] / 1000000f;
+            frameTimeAvg = ( sum / n ) / 1000000f;
+            frameTimeP99 = frameTimes[ Math.max(0, (int) Math.ceil(n * 0.99) - 1) ] / 1000000f;
+        }
+        frameTimeCount = 0;
+    }
+    
+    /**
+     * Adds <code>count</code> missed frame deadlines, 
+     * shall be called by a pacing animator if a frame could not be rendered in time.
+     */
+    public final synchronized void addMissedDeadlines(int count) {
+        missedDeadlines += count;
+    }
+    
     public StringBuilder toString(StringBuilder sb) {
         if(null==sb) {
             sb = new StringBuilder();
@@ -83,7 +127,9 @@ public class FPSCounterImpl implements FPSCounter {
         String fpsTotalS = String.valueOf(fpsTotal);
         fpsTotalS = fpsTotalS.substring(0, fpsTotalS.indexOf('.') + 2);                
         sb.append(fpsTotalDuration/1000 +" s: "+ fpsUpdateFramesInterval+" f / "+ fpsLastPeriod+" ms, " + fpsLastS+" fps, "+ fpsLastPeriod/fpsUpdateFramesInterval+" ms/f; "+
-                  "total: "+ fpsTotalFrames+" f, "+ fpsTotalS+ " fps, "+ fpsTotalDuration/fpsTotalFrames+" ms/f");
+                  "total: "+ fpsTotalFrames+" f, "+ fpsTotalS+ " fps, "+ fpsTotalDuration/fpsTotalFrames+" ms/f; "+
+                  "frame: "+ frameTimeMin+" min, "+ frameTimeAvg+" avg, "+ frameTimeP99+" p99, "+ frameTimeMax+" max ms, "+
+                  missedDeadlines+" missed");
         return sb;
     }
     
@@ -93,6 +139,7 @@ public class FPSCounterImpl implements FPSCounter {
     
     public final synchronized void setUpdateFPSFrames(int frames, PrintStream out) {
         fpsUpdateFramesInterval = frames;
+        frameTimes = frames > 0 ? new long[frames] : null;
         fpsOutputStream = out;
         resetFPSCounter();
     }
@@ -103,6 +150,10 @@ public class FPSCounterImpl implements FPSCounter {
         fpsLastPeriod = 0;
         fpsTotalFrames = 0;
         fpsLast = 0f; fpsTotal = 0f;
+        frameTimeCount = 0;
+        lastFrameNanos = 0;
+        frameTimeMin = 0f; frameTimeAvg = 0f; frameTimeP99 = 0f; frameTimeMax = 0f;
+        missedDeadlines = 0;
     }
 
     public final synchronized int getUpdateFPSFrames() {
@@ -136,4 +187,24 @@ public class FPSCounterImpl implements FPSCounter {
     public final synchronized float getTotalFPS() {
         return fpsTotal;
     }        
+
+    public final synchronized float getLastFrameTimeMin() {
+        return frameTimeMin;
+    }
+
+    public final synchronized float getLastFrameTimeAvg() {
+        return frameTimeAvg;
+    }
+
+    public final synchronized float getLastFrameTimeP99() {
+        return frameTimeP99;
+    }
+
+    public final synchronized float getLastFrameTimeMax() {
+        return frameTimeMax;
+    }
+
+    public final synchronized int getTotalMissedDeadlines() {
+        return missedDeadlines;
+    }
 }
@@ -29,6 +29,7 @@
 package jogamp.opengl;
 
 import java.io.PrintStream;
+import java.util.concurrent.Future;
 
 import javax.media.nativewindow.AbstractGraphicsDevice;
 import javax.media.nativewindow.NativeSurface;
@@ -387,6 +388,26 @@ public abstract class GLAutoDrawableBase implements GLAutoDrawable, FPSCounter {
         return helper.invoke(this, wait, glRunnable);        
     }
 
+    /**
+     * Queues the <code>glRunnable</code> for execution within the next {@link #display()} call 
+     * and returns the future of its result, see {@link GLDrawableHelper#invokeFuture(GLAutoDrawable, GLRunnable)}.
+     */
+    public final Future<Boolean> invokeFuture(GLRunnable glRunnable) {
+        return helper.invokeFuture(this, glRunnable);
+    }
+
+    /**
+     * Limits the time spent executing queued {@link GLRunnable}s per frame, 
+     * see {@link GLDrawableHelper#setGLRunnableTimeBudget(long)}.
+     */
+    public final void setGLRunnableTimeBudget(long nanos) {
+        helper.setGLRunnableTimeBudget(nanos);
+    }
+
+    public final long getGLRunnableTimeBudget() {
+        return helper.getGLRunnableTimeBudget();
+    }
+
     @Override
     public final void setAutoSwapBufferMode(boolean enable) {
         helper.setAutoSwapBufferMode(enable);        
@@ -464,6 +485,31 @@ public abstract class GLAutoDrawableBase implements GLAutoDrawable, FPSCounter {
     public final float getTotalFPS() {
         return fpsCounter.getTotalFPS();
     }
+
+    @Override
+    public final float getLastFrameTimeMin() {
+        return fpsCounter.getLastFrameTimeMin();
+    }
+
+    @Override
+    public final float getLastFrameTimeAvg() {
+        return fpsCounter.getLastFrameTimeAvg();
+    }
+
+    @Override
+    public final float getLastFrameTimeP99() {
+        return fpsCounter.getLastFrameTimeP99();
+    }
+
+    @Override
+    public final float getLastFrameTimeMax() {
+        return fpsCounter.getLastFrameTimeMax();
+    }
+
+    @Override
+    public final int getTotalMissedDeadlines() {
+        return fpsCounter.getTotalMissedDeadlines();
+    }
     
     //
     // GLDrawable delegation
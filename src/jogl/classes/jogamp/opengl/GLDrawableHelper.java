@@ -42,6 +42,9 @@ package jogamp.opengl;
 
 import java.util.ArrayList;
 import java.util.HashSet;
+import java.util.concurrent.Future;
+import java.util.concurrent.atomic.AtomicReference;
+import java.util.concurrent.atomic.AtomicReferenceArray;
 
 import javax.media.nativewindow.NativeSurface;
 import javax.media.nativewindow.NativeWindowException;
@@ -71,13 +74,29 @@ public class GLDrawableHelper {
   private final Object listenersLock = new Object();
   private final ArrayList<GLEventListener> listeners = new ArrayList<GLEventListener>();
   private final HashSet<GLEventListener> listenersToBeInit = new HashSet<GLEventListener>();
-  private final Object glRunnablesLock = new Object();
-  private volatile ArrayList<GLRunnableTask> glRunnables = new ArrayList<GLRunnableTask>();
+  /** Number of recycled, not awaitable {@link GLRunnableTask}s kept for reuse */
+  private static final int TASK_POOL_SIZE = 32;
+  /** Number of task pool slots probed before allocating or dropping a task */
+  private static final int TASK_POOL_PROBES = 4;
+  
+  private final Object animatorLock = new Object();
+  /** 
+   * Multiple producer, single consumer queue of GLRunnableTasks, linked via {@link GLRunnableTask#next}:
+   * Producers append lock-free to <code>glRunnablesTail</code>, the consumer holding <code>glRunnablesConsumerLock</code>
+   * removes from <code>glRunnablesHead</code>, the last consumed task or the initial stub. 
+   */
+  private final AtomicReference<GLRunnableTask> glRunnablesTail;
+  private GLRunnableTask glRunnablesHead;
+  private final Object glRunnablesConsumerLock = new Object();
+  private final AtomicReferenceArray<GLRunnableTask> taskPool = new AtomicReferenceArray<GLRunnableTask>(TASK_POOL_SIZE);
+  private volatile long glRunnablesTimeBudget = 0;
   private boolean autoSwapBufferMode;
   private Thread skipContextReleaseThread;
   private GLAnimatorControl animatorCtrl;
 
   public GLDrawableHelper() {
+    glRunnablesHead = new GLRunnableTask(null, false, false); // stub
+    glRunnablesTail = new AtomicReference<GLRunnableTask>(glRunnablesHead);
     reset();
   }
 
@@ -88,10 +107,10 @@ public class GLDrawableHelper {
     }
     autoSwapBufferMode = true;
     skipContextReleaseThread = null;
-    synchronized(glRunnablesLock) {
-        glRunnables.clear();
+    flushGLRunnables();
+    synchronized(animatorLock) {
+        animatorCtrl = null;
     }
-    animatorCtrl = null;
   }
 
   @Override
@@ -393,23 +412,82 @@ public class GLDrawableHelper {
     }
   }
 
+  /** Appends the task to the GLRunnable queue, lock-free. */
+  private final void enqueue(GLRunnableTask task) {
+    task.next = null;
+    final GLRunnableTask prev = glRunnablesTail.getAndSet(task);
+    prev.next = task; // publish, a consumer may miss the task until then 
+  }
+  
+  /** 
+   * Removes the next task from the GLRunnable queue, the caller must hold <code>glRunnablesConsumerLock</code>.
+   * The removed task becomes the new head, the old head is recycled.
+   * @return the next task or null if the queue is empty 
+   */
+  private final GLRunnableTask dequeue() {
+    final GLRunnableTask head = glRunnablesHead;
+    final GLRunnableTask next = head.next;
+    if( null == next ) {
+        return null;
+    }
+    glRunnablesHead = next;
+    // no producer references the old head anymore, since its next field has been written
+    releaseTask(head);
+    return next;
+  }
+  
+  /** @return a pooled, not awaitable task for the given runnable */
+  private final GLRunnableTask obtainTask(GLRunnable glRunnable, boolean catchExceptions) {
+    final int start = (int) Thread.currentThread().getId();
+    for(int i=0; i<TASK_POOL_PROBES; i++) {
+        final GLRunnableTask task = taskPool.getAndSet( ( start + i ) & ( TASK_POOL_SIZE - 1 ), null);
+        if( null != task ) {
+            task.set(glRunnable, catchExceptions);
+            return task;
+        }
+    }
+    return new GLRunnableTask(glRunnable, false, catchExceptions);
+  }
+  
+  private int releaseIndex = 0; // consumer only
+  
+  private final void releaseTask(GLRunnableTask task) {
+    if( task.isAwaitable() ) {
+        return;
+    }
+    task.next = null;
+    for(int i=0; i<TASK_POOL_PROBES; i++) {
+        if( taskPool.compareAndSet( ( releaseIndex++ ) & ( TASK_POOL_SIZE - 1 ), null, task) ) {
+            return;
+        }
+    }
+  }
+  
+  /**
+   * Sets the time budget for executing queued {@link GLRunnable}s per {@link #display(GLAutoDrawable) display} call 
+   * in nanoseconds. If exceeded, the remaining GLRunnables are deferred to the next frame.
+   * At least one GLRunnable is executed per frame. Defaults to 0, i.e. unlimited.
+   */
+  public final void setGLRunnableTimeBudget(long nanos) {
+    glRunnablesTimeBudget = Math.max(0, nanos);
+  }
+  
+  public final long getGLRunnableTimeBudget() {
+    return glRunnablesTimeBudget;
+  }
+  
   private final boolean execGLRunnables(GLAutoDrawable drawable) {
     boolean res = true;
-    if(glRunnables.size()>0) { // volatile OK
-        // swap one-shot list asap
-        final ArrayList<GLRunnableTask> _glRunnables;
-        synchronized(glRunnablesLock) {
-            if(glRunnables.size()>0) {
-                _glRunnables = glRunnables;
-                glRunnables = new ArrayList<GLRunnableTask>();
-            } else {
-                _glRunnables = null;
-            }
-        }
-        
-        if(null!=_glRunnables) {
-            for (int i=0; i < _glRunnables.size(); i++) {
-                res = _glRunnables.get(i).run(drawable) && res;
+    if( null != glRunnablesHead.next ) { // volatile OK
+        final long budget = glRunnablesTimeBudget;
+        final long t0 = 0 < budget ? System.nanoTime() : 0;
+        synchronized(glRunnablesConsumerLock) {
+            GLRunnableTask task;
+            while( null != ( task = dequeue() ) ) {
+                res = task.run(drawable) && res;
+                if( 0 < budget && System.nanoTime() - t0 >= budget ) {
+                    break; // defer the remaining tasks to the next frame
+                }
             }
         }
     }
@@ -417,28 +495,18 @@ public class GLDrawableHelper {
   }
 
   public final void flushGLRunnables() {
-    if(glRunnables.size()>0) { // volatile OK
-        // swap one-shot list asap
-        final ArrayList<GLRunnableTask> _glRunnables;
-        synchronized(glRunnablesLock) {
-            if(glRunnables.size()>0) {
-                _glRunnables = glRunnables;
-                glRunnables = new ArrayList<GLRunnableTask>();
-            } else {
-                _glRunnables = null;
-            }
-        }
-        
-        if(null!=_glRunnables) {
-            for (int i=0; i < _glRunnables.size(); i++) {
-                _glRunnables.get(i).flush();
+    if( null != glRunnablesHead.next ) { // volatile OK
+        synchronized(glRunnablesConsumerLock) {
+            GLRunnableTask task;
+            while( null != ( task = dequeue() ) ) {
+                task.flush();
             }
         }
     }
   }
   
   public final void setAnimator(GLAnimatorControl animator) throws GLException {
-    synchronized(glRunnablesLock) {
+    synchronized(animatorLock) {
         if(animatorCtrl!=animator && null!=animator && null!=animatorCtrl) {
             throw new GLException("Trying to register GLAnimatorControl "+animator+", where "+animatorCtrl+" is already registered. Unregister first.");
         }
@@ -447,7 +515,7 @@ public class GLDrawableHelper {
   }
 
   public final GLAnimatorControl getAnimator() {
-    synchronized(glRunnablesLock) {
+    synchronized(animatorLock) {
         return animatorCtrl;
     }
   }
@@ -490,40 +558,61 @@ public class GLDrawableHelper {
         return false;
     }
     
-    Throwable throwable = null;
-    GLRunnableTask rTask = null;
-    Object rTaskLock = new Object();
-    synchronized(rTaskLock) {
-        boolean deferred;
-        synchronized(glRunnablesLock) {
-            deferred = isExternalAnimatorAnimating();
-            if(!deferred) {
-                wait = false; // don't wait if exec immediatly
-            }
-            rTask = new GLRunnableTask(glRunnable,
-                                       wait ? rTaskLock : null,
-                                       wait  /* catch Exceptions if waiting for result */);
-            glRunnables.add(rTask);
+    final boolean deferred;
+    synchronized(animatorLock) {
+        deferred = isExternalAnimatorAnimating();
+    }
+    if(!deferred) {
+        wait = false; // don't wait if exec immediatly
+    }
+    final GLRunnableTask rTask = wait ? new GLRunnableTask(glRunnable, true, true /* catch Exceptions if waiting for result */) 
+                                      : obtainTask(glRunnable, false);
+    enqueue(rTask);
+    if( !deferred ) {
+        drawable.display();
+    } else if( wait ) {
+        Throwable throwable = null;
+        try {
+            rTask.await();
+        } catch (InterruptedException ie) {
+            throwable = ie;
         }
-        if( !deferred ) {
-            drawable.display();
-        } else if( wait ) {
-            try {
-                rTaskLock.wait(); // free lock, allow execution of rTask
-            } catch (InterruptedException ie) {
-                throwable = ie;
-            }
-            if(null==throwable) {
-                throwable = rTask.getThrowable();
-            }
-            if(null!=throwable) {
-                throw new RuntimeException(throwable);
-            }
+        if(null==throwable) {
+            throwable = rTask.getThrowable();
+        }
+        if(null!=throwable) {
+            throw new RuntimeException(throwable);
         }
     }
     return true;
   }
 
+  /**
+   * Queues the <code>glRunnable</code> like {@link #invoke(GLAutoDrawable, boolean, GLRunnable)} w/o waiting,
+   * but returns a {@link Future} of its result. 
+   * <p>
+   * The future completes after execution within {@link #display(GLAutoDrawable)}, 
+   * or is cancelled if the GLRunnable is flushed w/o execution, e.g. if the drawable gets destroyed. 
+   * Exceptions thrown by the GLRunnable are passed via {@link Future#get()}.
+   * </p>
+   * @return the future result of the GLRunnable, or null if <code>drawable</code> or <code>glRunnable</code> is null
+   */
+  public final Future<Boolean> invokeFuture(GLAutoDrawable drawable, GLRunnable glRunnable) {
+    if( null == glRunnable || null == drawable ) {
+        return null;
+    }
+    final boolean deferred;
+    synchronized(animatorLock) {
+        deferred = isExternalAnimatorAnimating();
+    }
+    final GLRunnableTask rTask = new GLRunnableTask(glRunnable, true, true);
+    enqueue(rTask);
+    if( !deferred ) {
+        drawable.display();
+    }
+    return rTask;
+  }
+
   public final void setAutoSwapBufferMode(boolean enable) {
     autoSwapBufferMode = enable;
   }
@@ -28,82 +28,120 @@
  
 package jogamp.opengl;
 
+import java.util.concurrent.CancellationException;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.TimeoutException;
+
 import javax.media.opengl.GLRunnable;
 import javax.media.opengl.GLAutoDrawable;
 
 /**
  * Helper class to provide a Runnable queue implementation with a Runnable wrapper
- * which notifies after execution for the <code>invokeAndWait()</code> semantics.
+ * which signals completion after execution for the <code>invokeAndWait()</code> semantics.
+ * <p>
+ * An awaitable task is a {@link Future} of the {@link GLRunnable#run(GLAutoDrawable)} result, 
+ * completed after execution or when flushed, in which case it is {@link #isCancelled() cancelled}.
+ * Tasks which are not awaitable may be recycled by their queue via {@link #set(GLRunnable, boolean)}.
+ * </p>
  */
-public class GLRunnableTask implements GLRunnable {
+public class GLRunnableTask implements GLRunnable, Future<Boolean> {
     GLRunnable runnable;
-    Object notifyObject;
+    final CountDownLatch done;
     boolean catchExceptions;
     volatile boolean isExecuted;
     volatile boolean isFlushed;
+    boolean result;
 
     Throwable runnableException;
+    
+    /** Link to the next task of an intrusive queue, see {@link GLDrawableHelper}. */
+    volatile GLRunnableTask next;
 
-    public GLRunnableTask(GLRunnable runnable, Object notifyObject, boolean catchExceptions) {
+    /**
+     * @param runnable the runnable to execute
+     * @param awaitable if true, the task is a {@link Future} which can be awaited, see {@link #await()}.
+     * @param catchExceptions if true, exceptions are caught and stored, see {@link #getThrowable()}, 
+     *        otherwise rethrown by {@link #run(GLAutoDrawable)}.
+     */
+    public GLRunnableTask(GLRunnable runnable, boolean awaitable, boolean catchExceptions) {
         this.runnable = runnable ;
-        this.notifyObject = notifyObject ;
+        this.done = awaitable ? new CountDownLatch(1) : null;
+        this.catchExceptions = catchExceptions;
+        isExecuted = false;
+        isFlushed = false;
+    }
+    
+    /** 
+     * Resets this not awaitable task for reuse.
+     * @throws IllegalStateException if this task is awaitable
+     */
+    public void set(GLRunnable runnable, boolean catchExceptions) throws IllegalStateException {
+        if(isAwaitable()) {
+            throw new IllegalStateException("Awaitable task can't be reused: "+this);
+        }
+        this.runnable = runnable;
         this.catchExceptions = catchExceptions;
+        this.runnableException = null;
+        this.result = false;
+        this.next = null;
         isExecuted = false;
         isFlushed = false;
     }
+    
+    public final boolean isAwaitable() { return null != done; }
 
     public boolean run(GLAutoDrawable drawable) {
+        final GLRunnable r = runnable;
+        runnable = null; // release reference asap, task may be pooled
         boolean res = true;
-        if(null == notifyObject) {
-            try {
-                res = runnable.run(drawable);
-            } catch (Throwable t) {
-                runnableException = t;
-                if(catchExceptions) {
-                    runnableException.printStackTrace();
-                } else {
-                    throw new RuntimeException(runnableException);
-                }
-            } finally {
-                isExecuted=true;
+        try {
+            res = r.run(drawable);
+            result = res;
+        } catch (Throwable t) {
+            runnableException = t;
+            if(catchExceptions) {
+                runnableException.printStackTrace();
+            } else {
+                throw new RuntimeException(runnableException);
             }
-        } else {
-            synchronized (notifyObject) {
-                try {
-                    res = runnable.run(drawable);
-                } catch (Throwable t) {
-                    runnableException = t;
-                    if(catchExceptions) {
-                        runnableException.printStackTrace();
-                    } else {
-                        throw new RuntimeException(runnableException);
-                    }
-                } finally {
-                    isExecuted=true;
-                    notifyObject.notifyAll();
-                }
+        } finally {
+            isExecuted=true;
+            if(null != done) {
+                done.countDown();
             }
         }
         return res;
     }
     
     /** 
-     * Simply flush this task and notify a waiting executor.
-     * The executor which might have been blocked until notified
+     * Simply flush this task and signal a waiting executor.
+     * The executor which might have been blocked until signaled
      * will be unblocked and the task removed from the queue.
      * 
      * @see #isFlushed()
      * @see #isInQueue()
      */ 
     public void flush() {
-        if(!isExecuted() && null != notifyObject) {
-            synchronized (notifyObject) {
-                isFlushed=true;
-                notifyObject.notifyAll();                
+        if(!isExecuted()) {
+            runnable = null;
+            isFlushed=true;
+            if(null != done) {
+                done.countDown();
             }
         }
     }
     
+    /**
+     * Blocks until this awaitable task has been executed or flushed.
+     * @throws InterruptedException
+     */
+    public void await() throws InterruptedException {
+        done.await();
+    }
+    
     /**
      * @return !{@link #isExecuted()} && !{@link #isFlushed()}
      */
@@ -122,5 +160,43 @@ public class GLRunnableTask implements GLRunnable {
     public boolean isFlushed() { return isFlushed; }
     
     public Throwable getThrowable() { return runnableException; }
-}
+    
+    //
+    // Future
+    //
+    
+    /** Queued tasks can't be cancelled, returns false. */
+    @Override
+    public boolean cancel(boolean mayInterruptIfRunning) { return false; }
+
+    /** @return {@link #isFlushed()} */
+    @Override
+    public boolean isCancelled() { return isFlushed; }
+
+    @Override
+    public boolean isDone() { return isExecuted || isFlushed; }
+
+    @Override
+    public Boolean get() throws InterruptedException, ExecutionException {
+        await();
+        return getResult();
+    }
 
+    @Override
+    public Boolean get(long timeout, TimeUnit unit) throws InterruptedException, ExecutionException, TimeoutException {
+        if(!done.await(timeout, unit)) {
+            throw new TimeoutException("GLRunnable not executed within "+timeout+" "+unit);
+        }
+        return getResult();
+    }
+    
+    private Boolean getResult() throws ExecutionException {
+        if(isFlushed) {
+            throw new CancellationException("GLRunnable flushed w/o execution");
+        }
+        if(null != runnableException) {
+            throw new ExecutionException(runnableException);
+        }
+        return Boolean.valueOf(result);
+    }
+}
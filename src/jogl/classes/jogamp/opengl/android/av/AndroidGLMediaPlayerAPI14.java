@@ -86,6 +86,16 @@ public class AndroidGLMediaPlayerAPI14 extends GLMediaPlayerImpl {
         mp = new MediaPlayer();
     }
 
+    /** 
+     * {@inheritDoc}
+     * 
+     * This implementation uses a single SurfaceTexture backed texture frame only. 
+     */
+    @Override
+    protected int validateTextureCount(int textureCount) {
+        return 1;
+    }
+
     @Override
     protected boolean setPlaySpeedImpl(float rate) {
         return false;
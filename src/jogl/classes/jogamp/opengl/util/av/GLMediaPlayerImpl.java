@@ -45,7 +45,7 @@ import com.jogamp.opengl.util.texture.TextureSequence;
 /**
  * After object creation an implementation may customize the behavior:
  * <ul>
- *   <li>{@link #setTextureCount(int)}</li>
+ *   <li>{@link #setTextureCount(int)}, see {@link #validateTextureCount(int)}</li>
  *   <li>{@link #setTextureTarget(int)}</li>
  *   <li>{@link EGLMediaPlayerImpl#setEGLTexImageAttribs(boolean, boolean)}.</li>
  * </ul>
@@ -58,6 +58,9 @@ public abstract class GLMediaPlayerImpl implements GLMediaPlayer {
 
     protected static final String unknown = "unknown";
 
+    /** {@link #seekImpl(int)} result, denoting the end of stream has been reached w/o a frame at the desired position. */
+    protected static final int INVALID_PTS = -1;
+
     protected State state;
     protected int textureCount;
     protected int textureTarget;
@@ -73,6 +76,7 @@ public abstract class GLMediaPlayerImpl implements GLMediaPlayer {
     protected URLConnection urlConn = null;
     
     protected float playSpeed = 1.0f;
+    protected SeekMode seekMode = SeekMode.Accurate;
     
     /** Shall be set by the {@link #initGLStreamImpl(GL, int[])} method implementation. */
     protected int width = 0;
@@ -96,6 +100,12 @@ public abstract class GLMediaPlayerImpl implements GLMediaPlayer {
     protected String vcodec = unknown;
     
     protected int frameNumber = 0;
+    /** Number of late frames dropped by the implementation, see {@link #getDroppedFrameCount()}. */
+    protected int droppedFrames = 0;
+    /** Number of frame requests w/o a decoded frame at hand, see {@link #getUnderrunCount()}. */
+    protected int underrunFrames = 0;
+    /** Video PTS minus audio PTS of the last presented frame in ms, see {@link #getAVSyncOffset()}. */
+    protected int avSyncOffset = 0;
     
     protected TextureSequence.TextureFrame[] texFrames = null;
     protected HashMap<Integer, TextureSequence.TextureFrame> texFrameMap = new HashMap<Integer, TextureSequence.TextureFrame>();
@@ -117,8 +127,22 @@ public abstract class GLMediaPlayerImpl implements GLMediaPlayer {
     @Override
     public int getTextureUnit() { return texUnit; }
     
-    protected final void setTextureCount(int textureCount) {
-        this.textureCount=textureCount;
+    @Override
+    public final void setTextureCount(int textureCount) throws IllegalStateException {
+        if(State.Uninitialized != state) {
+            throw new IllegalStateException("Instance not in state "+State.Uninitialized+", but "+state+", "+this);
+        }
+        this.textureCount=validateTextureCount(textureCount);
+    }
+    /**
+     * Returns the number of texture frames supported by the implementation,
+     * closest to the desired <code>textureCount</code>.
+     * <p>
+     * This implementation returns the desired count, but at least one.
+     * </p>
+     */
+    protected int validateTextureCount(int textureCount) {
+        return Math.max(1, textureCount);
     }
     @Override
     public final int getTextureCount() { return textureCount; }
@@ -150,7 +174,7 @@ public abstract class GLMediaPlayerImpl implements GLMediaPlayer {
         if(State.Uninitialized == state) {
             throw new IllegalStateException("Instance not initialized: "+this);
         }
-        if(State.Playing == state) {
+        if(State.Playing == state || isSeekFramePending()) {
             final TextureSequence.TextureFrame f = getNextTextureImpl(gl, blocking);
             return f;
         }
@@ -158,6 +182,15 @@ public abstract class GLMediaPlayerImpl implements GLMediaPlayer {
     }
     protected abstract TextureSequence.TextureFrame getNextTextureImpl(GL gl, boolean blocking);
     
+    /**
+     * Returns true if the frame at the position of the last {@link #seek(int)} 
+     * shall be presented via {@link #getNextTextureImpl(GL, boolean)} while not {@link State#Playing}.
+     * <p>
+     * Defaults to false, i.e. the last texture is kept until playing.
+     * </p>
+     */
+    protected boolean isSeekFramePending() { return false; }
+    
     @Override
     public String getRequiredExtensionsShaderStub() throws IllegalStateException {
         if(State.Uninitialized == state) {
@@ -273,12 +306,16 @@ public abstract class GLMediaPlayerImpl implements GLMediaPlayer {
     protected abstract int getCurrentPositionImpl();
     
     public final int seek(int msec) {
-        final int cp;
+        int cp;
         switch(state) {
             case Stopped:
             case Playing:
             case Paused:
                 cp = seekImpl(msec);
+                if( INVALID_PTS == cp ) {
+                    // sought beyond the last frame, i.e. at the end of stream
+                    cp = getDuration();
+                }
                 break;
             default:
                 cp = 0;
@@ -286,8 +323,23 @@ public abstract class GLMediaPlayerImpl implements GLMediaPlayer {
         if(DEBUG) { System.err.println("Seek("+msec+"): "+toString()); }
         return cp;        
     }
+    /**
+     * @return time position after seeking, or {@link #INVALID_PTS} if the end of stream has been reached
+     */
     protected abstract int seekImpl(int msec);
     
+    @Override
+    public final synchronized void setSeekMode(SeekMode mode) {
+        if(null != mode) {
+            seekMode = mode;
+        }
+    }
+    
+    @Override
+    public final synchronized SeekMode getSeekMode() {
+        return seekMode;
+    }
+    
     public final State getState() { return state; }
     
     @Override
@@ -296,13 +348,17 @@ public abstract class GLMediaPlayerImpl implements GLMediaPlayer {
             throw new IllegalStateException("Instance not in state "+State.Uninitialized+", but "+state+", "+this);
         }
         this.urlConn = urlConn;
+        this.droppedFrames = 0;
+        this.underrunFrames = 0;
+        this.avSyncOffset = 0;
         if (this.urlConn != null) {
             try {                
                 if(null != gl) {
                     if(null!=texFrames) {
                         // re-init ..
                         removeAllImageTextures(gl);
-                    } else {
+                    }
+                    if(null==texFrames || texFrames.length != textureCount) {
                         texFrames = new TextureSequence.TextureFrame[textureCount];
                     }
                     final int[] tex = new int[textureCount];
@@ -320,6 +376,7 @@ public abstract class GLMediaPlayerImpl implements GLMediaPlayer {
                         texFrames[i] = tf;
                         texFrameMap.put(tex[i], tf);
                     }
+                    initGLTexturesDoneImpl(gl);
                 }
                 state = State.Stopped;
                 return state;
@@ -344,6 +401,16 @@ public abstract class GLMediaPlayerImpl implements GLMediaPlayer {
     */
     protected abstract void initGLStreamImpl(GL gl, int[] texNames) throws IOException;
     
+    /**
+     * Called after all {@link #texFrames} have been created via {@link #createTexImage(GL, int, int[])},
+     * i.e. the implementation may start streaming into them.
+     * <p>
+     * This implementation does nothing.
+     * </p>
+     * @param gl current GL object
+     */
+    protected void initGLTexturesDoneImpl(GL gl) throws IOException { }
+    
     protected TextureSequence.TextureFrame createTexImage(GL gl, int idx, int[] tex) {
         return new TextureSequence.TextureFrame( createTexImageImpl(gl, idx, tex, width, height, false) );
     }
@@ -521,6 +588,32 @@ public abstract class GLMediaPlayerImpl implements GLMediaPlayer {
         return fps;
     }
 
+    /**
+     * {@inheritDoc}
+     * 
+     * This implementation returns zero, i.e. no frame queue,
+     * if not overridden by specialization.
+     */
+    @Override
+    public int getQueuedFrameCount() {
+        return 0;
+    }
+    
+    @Override
+    public final int getDroppedFrameCount() {
+        return droppedFrames;
+    }
+    
+    @Override
+    public final int getUnderrunCount() {
+        return underrunFrames;
+    }
+    
+    @Override
+    public final int getAVSyncOffset() {
+        return avSyncOffset;
+    }
+    
     @Override
     public final synchronized int getWidth() {
         return width;
@@ -536,6 +629,7 @@ public abstract class GLMediaPlayerImpl implements GLMediaPlayer {
         final float ct = getCurrentPosition() / 1000.0f, tt = getDuration() / 1000.0f;
         final String loc = ( null != urlConn ) ? urlConn.getURL().toExternalForm() : "<undefined stream>" ;
         return "GLMediaPlayer["+state+", "+frameNumber+"/"+totalFrames+" frames, "+ct+"/"+tt+"s, speed "+playSpeed+", "+bps_stream+" bps, "+
+               "Frames[queued "+getQueuedFrameCount()+", dropped "+droppedFrames+", underrun "+underrunFrames+", av-offset "+avSyncOffset+" ms], "+
                 "Texture[count "+textureCount+", target "+toHexString(textureTarget)+", format "+toHexString(textureFormat)+", type "+toHexString(textureType)+"], "+               
                "Stream[Video[<"+vcodec+">, "+width+"x"+height+", "+fps+" fps, "+bps_video+" bsp], "+
                "Audio[<"+acodec+">, "+bps_audio+" bsp]], "+loc+"]";
@@ -58,6 +58,16 @@ public class NullGLMediaPlayer extends GLMediaPlayerImpl {
         this.setTextureCount(1);
     }
 
+    /** 
+     * {@inheritDoc}
+     * 
+     * This implementation uses a single static texture frame only. 
+     */
+    @Override
+    protected int validateTextureCount(int textureCount) {
+        return 1;
+    }
+
     @Override
     protected boolean setPlaySpeedImpl(float rate) {
         return false;
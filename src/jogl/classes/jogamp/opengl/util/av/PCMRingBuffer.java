@@ -0,0 +1,195 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package jogamp.opengl.util.av;
+
+import java.nio.ByteBuffer;
+
+import com.jogamp.common.nio.Buffers;
+
+/**
+ * Lock-free single producer / single consumer ring buffer of PCM data,
+ * backed by a direct {@link ByteBuffer}.
+ * <p>
+ * Exactly one thread may {@link #put(ByteBuffer, int) put} data
+ * and exactly one other thread may {@link #get(byte[], int, int) get} or {@link #skip(int) skip} data.
+ * Both sides never block, they merely process as many bytes as available.
+ * </p>
+ * <p>
+ * All operations process whole sample frames only, i.e. multiples of {@link #getFrameSize()} bytes,
+ * hence the consumer always reads at a sample frame boundary.
+ * </p>
+ * <p>
+ * Besides the data, the producer publishes the PTS at the end of the written data,
+ * allowing the consumer to compute the PTS of the next byte to be read, see {@link #getReadPTS()}.
+ * </p>
+ */
+public class PCMRingBuffer {
+    private final ByteBuffer buffer;
+    private final int capacity;
+    private final int bytesPerSecond;
+    private final int frameSize;
+
+    /** Total number of bytes written, only modified by the producer. */
+    private volatile long writeCount = 0;
+    /** Total number of bytes read, only modified by the consumer. */
+    private volatile long readCount = 0;
+    /** PTS at the end of the last written data, only modified by the producer. */
+    private volatile PTSMark writeMark = new PTSMark(0, 0);
+
+    /** Immutable pair of a total byte count and its PTS, allowing the consumer to read both consistently. */
+    private static class PTSMark {
+        final long count;
+        final int pts;
+        PTSMark(long count, int pts) {
+            this.count = count;
+            this.pts = pts;
+        }
+    }
+
+    /**
+     * @param capacity size of the ring in bytes, rounded down to a multiple of <code>frameSize</code>
+     * @param bytesPerSecond bytes per second of the PCM data, i.e. <code>sampleRate * frameSize</code>
+     * @param frameSize bytes per sample frame, i.e. <code>channels * bytesPerSample</code>
+     */
+    public PCMRingBuffer(int capacity, int bytesPerSecond, int frameSize) {
+        if( 0 >= frameSize || capacity < frameSize || 0 >= bytesPerSecond ) {
+            throw new IllegalArgumentException("Invalid capacity "+capacity+", bytesPerSecond "+bytesPerSecond+" or frameSize "+frameSize);
+        }
+        this.capacity = capacity - capacity % frameSize;
+        this.buffer = Buffers.newDirectByteBuffer(this.capacity);
+        this.bytesPerSecond = bytesPerSecond;
+        this.frameSize = frameSize;
+    }
+
+    public final int capacity() { return capacity; }
+
+    public final int getFrameSize() { return frameSize; }
+
+    public final int getBytesPerSecond() { return bytesPerSecond; }
+
+    /** @return the duration of the given number of bytes in milliseconds */
+    public final int getDuration(int byteCount) {
+        return (int) ( ( (long) byteCount * 1000L ) / bytesPerSecond );
+    }
+
+    /** @return the number of bytes available for reading */
+    public final int available() {
+        return (int) ( writeCount - readCount );
+    }
+
+    /** @return the number of bytes available for writing */
+    public final int free() {
+        return capacity - available();
+    }
+
+    /** @return the PTS in milliseconds at the end of the written data */
+    public final int getWritePTS() {
+        return writeMark.pts;
+    }
+
+    /** @return the PTS in milliseconds of the next byte to be read */
+    public final int getReadPTS() {
+        final PTSMark m = writeMark;
+        return m.pts - getDuration( (int) ( m.count - readCount ) );
+    }
+
+    /**
+     * Producer: Writes as many whole sample frames of <code>src</code> as fit into the ring,
+     * from its position up to its limit. The position of <code>src</code> is advanced accordingly.
+     *
+     * @param src the PCM data
+     * @param srcPTS the PTS in milliseconds of the first byte at the position of <code>src</code>
+     * @return the number of bytes written
+     */
+    public final int put(ByteBuffer src, int srcPTS) {
+        final long w = writeCount;
+        final int n = frames( Math.min(src.remaining(), capacity - (int) ( w - readCount )) );
+        if( 0 < n ) {
+            final int off = (int) ( w % capacity );
+            final int n1 = Math.min(n, capacity - off);
+            final int srcLimit = src.limit();
+            final ByteBuffer dst = buffer.duplicate();
+            src.limit(src.position() + n1);
+            dst.position(off);
+            dst.put(src);
+            if( n1 < n ) {
+                src.limit(src.position() + n - n1);
+                dst.position(0);
+                dst.put(src);
+            }
+            src.limit(srcLimit);
+            writeCount = w + n; // publish
+            writeMark = new PTSMark(w + n, srcPTS + getDuration(n));
+        }
+        return n;
+    }
+
+    /**
+     * Consumer: Reads up to <code>len</code> bytes of whole sample frames into <code>dst</code>.
+     * @return the number of bytes read
+     */
+    public final int get(byte[] dst, int dstOff, int len) {
+        final long r = readCount;
+        final int n = frames( Math.min(len, (int) ( writeCount - r )) );
+        if( 0 < n ) {
+            final int off = (int) ( r % capacity );
+            final int n1 = Math.min(n, capacity - off);
+            final ByteBuffer src = buffer.duplicate();
+            src.position(off);
+            src.get(dst, dstOff, n1);
+            if( n1 < n ) {
+                src.position(0);
+                src.get(dst, dstOff + n1, n - n1);
+            }
+            readCount = r + n; // release
+        }
+        return n;
+    }
+
+    /**
+     * Consumer: Drops up to <code>len</code> bytes of whole sample frames.
+     * @return the number of bytes dropped
+     */
+    public final int skip(int len) {
+        final long r = readCount;
+        final int n = frames( Math.min(len, (int) ( writeCount - r )) );
+        if( 0 < n ) {
+            readCount = r + n;
+        }
+        return n;
+    }
+
+    private final int frames(int byteCount) {
+        return byteCount - byteCount % frameSize;
+    }
+
+    @Override
+    public String toString() {
+        return "PCMRingBuffer[avail "+available()+"/"+capacity+", "+bytesPerSecond+" bytes/s, pts "+getReadPTS()+" - "+getWritePTS()+" ms]";
+    }
+}
@@ -55,7 +55,7 @@ import com.jogamp.common.util.RunnableExecutor;
 class FFMPEGDynamicLibraryBundleInfo implements DynamicLibraryBundleInfo  {
     private static List<String> glueLibNames = new ArrayList<String>(); // none
     
-    private static final int symbolCount = 31;
+    private static final int symbolCount = 32;
     private static String[] symbolNames = {
          "avcodec_version",
          "avformat_version",
@@ -73,12 +73,13 @@ class FFMPEGDynamicLibraryBundleInfo implements DynamicLibraryBundleInfo  {
          "av_free_packet", 
          "avcodec_decode_audio4",     // 53.25.0   (opt)
          "avcodec_decode_audio3",     // 52.23.0
-/* 15 */ "avcodec_decode_video2",     // 52.23.0
+         "avcodec_decode_video2",     // 52.23.0
+/* 16 */ "avcodec_flush_buffers",
         
          // libavutil
          "av_pix_fmt_descriptors", 
          "av_free", 
-/* 18 */ "av_get_bits_per_pixel",
+/* 19 */ "av_get_bits_per_pixel",
         
          // libavformat
          "avformat_alloc_context",
@@ -93,7 +94,7 @@ class FFMPEGDynamicLibraryBundleInfo implements DynamicLibraryBundleInfo  {
          "avformat_network_init",     // 53.13.0   (opt)
          "avformat_network_deinit",   // 53.13.0   (opt)
          "avformat_find_stream_info", // 53.3.0    (opt)
-/* 29 */ "av_find_stream_info",
+/* 32 */ "av_find_stream_info",
     };
     
     // alternate symbol names
@@ -28,25 +28,42 @@
 
 package jogamp.opengl.util.av.impl;
 
+import java.io.BufferedOutputStream;
+import java.io.FileOutputStream;
 import java.io.IOException;
+import java.io.OutputStream;
 import java.nio.Buffer;
 import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+import javax.sound.sampled.AudioFormat;
+import javax.sound.sampled.AudioSystem;
+import javax.sound.sampled.SourceDataLine;
 
 import javax.media.opengl.GL;
+import javax.media.opengl.GL2;
 import javax.media.opengl.GL2ES2;
+import javax.media.opengl.GL2GL3;
+import javax.media.opengl.GLCapabilities;
+import javax.media.opengl.GLContext;
+import javax.media.opengl.GLDrawable;
+import javax.media.opengl.GLDrawableFactory;
 import javax.media.opengl.GLException;
 
+import com.jogamp.common.nio.Buffers;
 import com.jogamp.common.util.VersionNumber;
 import com.jogamp.gluegen.runtime.ProcAddressTable;
 import com.jogamp.opengl.util.GLPixelStorageModes;
 import com.jogamp.opengl.util.texture.Texture;
 import com.jogamp.opengl.util.texture.TextureSequence;
 
+import jogamp.opengl.Debug;
 import jogamp.opengl.GLContextImpl;
 import jogamp.opengl.es1.GLES1ProcAddressTable;
 import jogamp.opengl.es2.GLES2ProcAddressTable;
 import jogamp.opengl.gl4.GL4bcProcAddressTable;
 import jogamp.opengl.util.av.EGLMediaPlayerImpl;
+import jogamp.opengl.util.av.PCMRingBuffer;
 
 /***
  * Implementation utilizes <a href="http://libav.org/">Libav</a>
@@ -56,8 +73,10 @@ import jogamp.opengl.util.av.EGLMediaPlayerImpl;
  * Besides the default BSD/Linux/.. repositories and installations,
  * precompiled binaries can be found at the listed location below. 
  * <p>
- * Implements YUV420P to RGB fragment shader conversion 
- * and the usual packed RGB formats.
+ * Implements fragment shader conversion to RGB of planar YUV 4:2:0, 4:2:2, 4:4:4, 4:1:0, 4:1:1 and 4:4:0,
+ * inclusive the full range YUVJ variants and 9, 10 or 16 bit components in native byte order,
+ * semi-planar NV12 / NV21, packed YUYV / UYVY 4:2:2, planar GBR, gray 
+ * and the usual packed RGB formats, which are swizzled by the shader if required.
  * The decoded video frame is written directly into an OpenGL texture 
  * on the GPU in it's native format. A custom fragment shader converts 
  * the native pixelformat to a usable RGB format if required. 
@@ -77,17 +96,44 @@ import jogamp.opengl.util.av.EGLMediaPlayerImpl;
  * http://libav.org/
  * </p>
  * <p> 
- * Check tag 'FIXME: Add more planar formats !' 
- * here and in the corresponding native code
- * <code>jogl/src/jogl/native/ffmpeg/jogamp_opengl_util_av_impl_FFMPEGMediaPlayer.c</code>
+ * All planes of a frame are stuffed into one texture, the 1st plane at the origin
+ * and the chroma plane(s) right of it, see {@link FFMPEGTextureLayout}.
+ * Components of more than 8 bit are uploaded as 16 bit textures, 
+ * which requires a {@link GL2} profile.
+ * </p>
+ * <p>
+ * Demuxing and decoding is performed off the GL thread by a dedicated <i>StreamWorker</i>,
+ * which fills a bounded ring of decoded frames, see {@link #FRAME_QUEUE_SIZE}.
+ * Each frame owns one of the {@link #getTextureCount() textures}. 
+ * If possible, the <i>StreamWorker</i> uploads the frame into its texture 
+ * using a {@link GLContext} shared with the one passed to {@link #initGLStream(GL, java.net.URLConnection)},
+ * fenced via a GL sync object where available.
+ * Vice versa, the GL thread fences a released texture, which the <i>StreamWorker</i> waits for
+ * before overwriting it, since pending rendering commands may still sample its previous content.
+ * Hence the GL thread merely binds the next due texture and drops late frames.
+ * Otherwise, or if property <code>jogl.ffmpeg.nosharedctx</code> is set,
+ * the GL thread uploads the decoded frame.
+ * </p>
+ * <p>
+ * Audio is decoded by the <i>StreamWorker</i> as well, converted to interleaved signed 16bit PCM
+ * and queued in a lock-free {@link PCMRingBuffer}, see {@link #AUDIO_QUEUE_MS}.
+ * An <i>AudioWorker</i> plays it via Java Sound, or consumes it in real time if no audio device is available.
+ * The audio clock is the master clock, i.e. video presentation follows the PTS of the audio being played,
+ * see {@link #getAVSyncOffset()}.
+ * If property <code>jogl.ffmpeg.pcmdump</code> names a file, 
+ * the played PCM data is written to it instead of the audio device, allowing headless validation.
+ * </p>
+ * <p>
+ * Seeking uses a key frame index, which is populated lazily while demuxing.
+ * If the stream has been demuxed contiguously up to the desired position, 
+ * the preceding key frame is known, otherwise the demuxer is asked for it.
+ * In {@link SeekMode#Accurate} mode all frames from the key frame up to the desired position are decoded and dropped,
+ * an accurate seek forward within the current group of pictures merely continues decoding.
  * </p>
  * <p>
  * TODO:
  * <ul>
- *   <li>Audio Output</li>
- *   <li>Off thread <i>next frame</i> processing using multiple target textures</li>
- *   <li>better pts sync handling</li>
- *   <li>fix seek</li>   
+ *   <li>Audio output w/ play speed other than 1</li>
  * </ul> 
  * </p>
  * Pre-compiled Libav / FFmpeg packages:
@@ -125,6 +171,40 @@ public class FFMPEGMediaPlayer extends EGLMediaPlayerImpl {
     
     public static final boolean isAvailable() { return available; }
 
+    /** 
+     * Number of decoded video frames the decoder thread may queue ahead of presentation,
+     * defaults to 4. May be overridden via property <code>jogl.ffmpeg.framequeue</code>.
+     * <p>
+     * The default {@link #getTextureCount() texture count} is one more,
+     * i.e. the presented frame plus the queued ones.
+     * </p>
+     */
+    public static final int FRAME_QUEUE_SIZE = Math.max(2, Debug.getIntProperty("jogl.ffmpeg.framequeue", true, 4));
+    
+    private static final boolean NO_SHARED_CONTEXT = Debug.isPropertyDefined("jogl.ffmpeg.nosharedctx", true);
+    
+    /** 
+     * Duration of decoded audio in milliseconds the decoder thread may queue ahead of playback,
+     * defaults to 1000. May be overridden via property <code>jogl.ffmpeg.audioqueue</code>.
+     */
+    public static final int AUDIO_QUEUE_MS = Math.max(100, Debug.getIntProperty("jogl.ffmpeg.audioqueue", true, 1000));
+    
+    /** Optional PCM dump file name, see property <code>jogl.ffmpeg.pcmdump</code>. */
+    private static final String PCM_DUMP_FILE = Debug.getProperty("jogl.ffmpeg.pcmdump", true);
+    
+    /** Audio output period in milliseconds */
+    private static final int AUDIO_PERIOD_MS = 20;
+    
+    /** A/V drift in milliseconds, above which the presentation clock is reset to the audio clock */
+    private static final int AV_SYNC_RESET_MS = 100;
+
+    /** {@link #readNextPacket0(long, long, int, int, int, ByteBuffer)} result: end of stream reached */
+    private static final int READ_EOS = -1;
+    /** {@link #readNextPacket0(long, long, int, int, int, ByteBuffer)} result: audio decoded, see {@link #getAudioBuffer0(long, int)} */
+    private static final int READ_AUDIO = 1;
+    /** {@link #readNextPacket0(long, long, int, int, int, ByteBuffer)} result: video frame decoded into the given buffer */
+    private static final int READ_VIDEO = 2;
+
     private static VersionNumber getAVVersion(int vers) {
         return new VersionNumber( ( vers >> 16 ) & 0xFF,
                                   ( vers >>  8 ) & 0xFF,
@@ -132,24 +212,43 @@ public class FFMPEGMediaPlayer extends EGLMediaPlayerImpl {
     }
     
     protected long moviePtr = 0;    
-    protected long procAddrGLTexSubImage2D = 0;
     protected EGLMediaPlayerImpl.EGLTextureFrame lastTex = null;
     protected GLPixelStorageModes psm;
     protected PixelFormat vPixelFmt = null;
+    protected PixelLayout vPixelLayout = null;
     protected int vPlanes = 0;
     protected int vBitsPerPixel = 0;
     protected int vBytesPerPixelPerPlane = 0;    
+    protected int vBitsPerComponent = 0;
+    protected int vLog2ChromaW = 0, vLog2ChromaH = 0;
     protected int[] vLinesize = { 0, 0, 0 }; // per plane
     protected int[] vTexWidth = { 0, 0, 0 }; // per plane
+    protected int[] vPlaneHeight = { 0, 0, 0 }; // per plane
+    protected int[] vTexX = { 0, 0, 0 }; // per plane, position within texture
+    protected int[] vTexY = { 0, 0, 0 }; // per plane, position within texture
+    protected int vFrameSize = 0; // bytes of all planes
     protected int texWidth, texHeight; // overall (stuffing planes in one texture)
-    protected ByteBuffer texCopy;
+    protected int aSampleRate = 0;
+    protected int aChannels = 0;
+    
+    /** Guards the decoding native calls, i.e. {@link #readNextPacket0(long, long, int, int, int, ByteBuffer)} and {@link #seek0(long, int, boolean)} */
+    private final Object decodeLock = new Object();
+    private FrameRing frameRing = null;
+    /** True if the {@link StreamWorker} uploads into the textures itself using GL sync objects, hence released textures are fenced as well. */
+    private volatile boolean sharedUploadFenced = false;
+    private StreamWorker streamWorker = null;
+    /** Offscreen drawable of the {@link StreamWorker}'s shared context, if used */
+    private GLDrawable sharedDrawable = null;
+    private GLContext sharedContext = null;
+    private PCMRingBuffer pcmRing = null;
+    private AudioWorker audioWorker = null;
 
     public FFMPEGMediaPlayer() {
         super(TextureType.GL, false);
         if(!available) {
             throw new RuntimeException("FFMPEGMediaPlayer not available");
         }
-        setTextureCount(1);
+        setTextureCount(FRAME_QUEUE_SIZE+1);
         moviePtr = createInstance0(true);
         if(0==moviePtr) {
             throw new GLException("Couldn't create FFMPEGInstance");
@@ -161,11 +260,25 @@ public class FFMPEGMediaPlayer extends EGLMediaPlayerImpl {
     protected TextureSequence.TextureFrame createTexImage(GL gl, int idx, int[] tex) {
         if(TextureType.GL == texType) {
             final Texture texture = super.createTexImageImpl(gl, idx, tex, texWidth, texHeight, true);
-            lastTex = new EGLTextureFrame(null, texture, 0, 0);
+            final EGLTextureFrame texFrame = new EGLTextureFrame(null, texture, 0, 0);
+            if( 0 == idx ) {
+                lastTex = texFrame;
+            }
+            return texFrame;
         } else {
             throw new InternalError("n/a");
         }
-        return lastTex;
+    }
+    
+    /**
+     * {@inheritDoc}
+     * <p>
+     * Requires at least 2 textures, the presented one and the next decoded one.
+     * </p>
+     */
+    @Override
+    protected int validateTextureCount(int desiredTextureCount) {
+        return Math.max(2, desiredTextureCount);
     }
     
     @Override
@@ -176,6 +289,24 @@ public class FFMPEGMediaPlayer extends EGLMediaPlayerImpl {
     
     @Override
     protected void destroyImpl(GL gl) {
+        if( null != streamWorker ) {
+            streamWorker.stopWorker();
+            streamWorker = null;
+        }
+        if( null != audioWorker ) {
+            audioWorker.stopWorker();
+            audioWorker = null;
+        }
+        if( null != frameRing && null != gl && gl.isGL2GL3() ) {
+            frameRing.deleteSyncs(gl.getGL2GL3());
+        }
+        frameRing = null;
+        pcmRing = null;
+        sharedContext = null; // destroyed by StreamWorker
+        if( null != sharedDrawable ) {
+            sharedDrawable.setRealized(false);
+            sharedDrawable = null;
+        }
         if (moviePtr != 0) {
             destroyInstance0(moviePtr);
             moviePtr = 0;
@@ -191,67 +322,253 @@ public class FFMPEGMediaPlayer extends EGLMediaPlayerImpl {
     
         System.out.println("setURL: p1 "+this);
         setStream0(moviePtr, urlS, -1, -1);
+        setTextureLayout0(moviePtr, vTexX[0], vTexX[1], vTexX[2], vTexY[0], vTexY[1], vTexY[2]);
         System.out.println("setURL: p2 "+this);
         int tf, tif=GL.GL_RGBA; // texture format and internal format
-        switch(vBytesPerPixelPerPlane) {
-            case 1: tf = GL2ES2.GL_ALPHA; tif=GL.GL_ALPHA; break;
-            case 3: tf = GL2ES2.GL_RGB;   tif=GL.GL_RGB;   break;
-            case 4: tf = GL2ES2.GL_RGBA;  tif=GL.GL_RGBA;  break;
-            default: throw new RuntimeException("Unsupported bytes-per-pixel / plane "+vBytesPerPixelPerPlane);
+        int tt = GL.GL_UNSIGNED_BYTE; // texture type
+        switch(vPixelLayout) {
+            case PackedRGB:
+                switch(vBytesPerPixelPerPlane) {
+                    case 2: tf = GL2ES2.GL_RGB;   tif=GL.GL_RGB;   tt = GL.GL_UNSIGNED_SHORT_5_6_5; break;
+                    case 3: tf = GL2ES2.GL_RGB;   tif=GL.GL_RGB;   break;
+                    case 4: tf = GL2ES2.GL_RGBA;  tif=GL.GL_RGBA;  break;
+                    default: throw new RuntimeException("Unsupported bytes-per-pixel / plane "+vBytesPerPixelPerPlane);
+                }
+                break;
+            case PackedYUV:
+                tf = GL.GL_LUMINANCE_ALPHA; tif=GL.GL_LUMINANCE_ALPHA; 
+                break;
+            default: // Gray and (semi) planar formats
+                switch(vBytesPerPixelPerPlane) {
+                    case 1: tf = GL2ES2.GL_ALPHA; tif=GL.GL_ALPHA; break;
+                    case 2: 
+                        if( null != gl && !gl.isGL2() ) {
+                            throw new RuntimeException("Pixelformat "+vPixelFmt+" requires GL2 for 16bit textures, has "+gl.getGLProfile());
+                        }
+                        tf = GL2ES2.GL_ALPHA; tif=GL2.GL_ALPHA16; tt = GL.GL_UNSIGNED_SHORT; 
+                        break;
+                    default: throw new RuntimeException("Unsupported bytes-per-pixel / plane "+vBytesPerPixelPerPlane);
+                }
         }        
         setTextureFormat(tif, tf);
-        setTextureType(GL.GL_UNSIGNED_BYTE);
-        GLContextImpl ctx = (GLContextImpl)gl.getContext();
-        ProcAddressTable pt = ctx.getGLProcAddressTable();
-        if(pt instanceof GLES2ProcAddressTable) {
-            procAddrGLTexSubImage2D = ((GLES2ProcAddressTable)pt)._addressof_glTexSubImage2D;
-        } else if(pt instanceof GLES1ProcAddressTable) {
-            procAddrGLTexSubImage2D = ((GLES1ProcAddressTable)pt)._addressof_glTexSubImage2D;
-        } else if(pt instanceof GL4bcProcAddressTable) {
-            procAddrGLTexSubImage2D = ((GL4bcProcAddressTable)pt)._addressof_glTexSubImage2D;
-        } else {
-            throw new InternalError("Unknown ProcAddressTable: "+pt.getClass().getName()+" of "+ctx.getClass().getName());
+        setTextureType(tt);
+        
+        if( null != gl && !NO_SHARED_CONTEXT ) {
+            createSharedContext(gl);
+        }
+    }
+    
+    private void createSharedContext(GL gl) {
+        try {
+            final GLContext glCtx = gl.getContext();
+            final GLDrawableFactory factory = GLDrawableFactory.getFactory(gl.getGLProfile());
+            final GLCapabilities caps = new GLCapabilities(gl.getGLProfile());
+            sharedDrawable = factory.createOffscreenDrawable(null, caps, null, 1, 1);
+            sharedDrawable.setRealized(true);
+            sharedContext = sharedDrawable.createContext(glCtx);
+        } catch (GLException gle) {
+            if(DEBUG) {
+                gle.printStackTrace();
+            }
+            sharedContext = null;
+            if( null != sharedDrawable ) {
+                sharedDrawable.setRealized(false);
+                sharedDrawable = null;
+            }
+        }
+    }
+    
+    @Override
+    protected void initGLTexturesDoneImpl(GL gl) throws IOException {
+        if( null != sharedContext ) {
+            gl.glFlush(); // make the texture storage visible to the shared context
+        }
+        if( 0 < aSampleRate && 0 < aChannels ) {
+            final int frameSize = 2 * aChannels; // S16
+            final int bytesPerSecond = aSampleRate * frameSize;
+            pcmRing = new PCMRingBuffer( (int) ( ( (long) bytesPerSecond * AUDIO_QUEUE_MS ) / 1000 ), bytesPerSecond, frameSize );
+            audioWorker = new AudioWorker(pcmRing, aSampleRate, aChannels);
+            audioWorker.setMuted( 1f != getPlaySpeed() );
+            audioWorker.start();
+        }
+        frameRing = new FrameRing(texFrames);
+        streamWorker = new StreamWorker(sharedContext);
+        streamWorker.start();
+    }
+    private void updateAttributes3(int sampleRate, int channels) {
+        aSampleRate = sampleRate;
+        aChannels = channels;
+        if(DEBUG) {
+            System.err.println("XXX0: audio "+aSampleRate+" Hz, "+aChannels+" channels");
         }
     }
     private void updateAttributes2(int pixFmt, int planes, int bitsPerPixel, int bytesPerPixelPerPlane,
                                    int lSz0, int lSz1, int lSz2,
-                                   int tWd0, int tWd1, int tWd2) {
+                                   int tWd0, int tWd1, int tWd2,
+                                   int pH0, int pH1, int pH2,
+                                   int bitsPerComponent, int log2ChromaW, int log2ChromaH) {
         vPixelFmt = PixelFormat.valueOf(pixFmt);
         vPlanes = planes;
         vBitsPerPixel = bitsPerPixel;
         vBytesPerPixelPerPlane = bytesPerPixelPerPlane;
+        vBitsPerComponent = bitsPerComponent;
+        vLog2ChromaW = log2ChromaW; vLog2ChromaH = log2ChromaH;
         vLinesize[0] = lSz0; vLinesize[1] = lSz1; vLinesize[2] = lSz2;
         vTexWidth[0] = tWd0; vTexWidth[1] = tWd1; vTexWidth[2] = tWd2;
+        vPlaneHeight[0] = pH0; vPlaneHeight[1] = pH1; vPlaneHeight[2] = pH2;
+        vFrameSize = vLinesize[0]*vPlaneHeight[0] + vLinesize[1]*vPlaneHeight[1] + vLinesize[2]*vPlaneHeight[2];
         
-        switch(vPixelFmt) {
-            case YUV420P:
-                // YUV420P: Adding U+V on right side of fixed height texture,
-                //          since width is already aligned by decoder.
-                // Y=w*h, Y=w/2*h/2, U=w/2*h/2
-                // w*h + 2 ( w/2 * h/2 ) 
-                // w*h + w*h/2
-                // 2*w/2 * h 
-                texWidth = vTexWidth[0] + vTexWidth[1]; texHeight = height; 
-                break;
-            // case PIX_FMT_YUYV422:
+        // All planes are stuffed into one texture, see FFMPEGTextureLayout,
+        // i.e. the chroma plane(s) right of the 1st plane, since width is already aligned by decoder.
+        // YUV420P: Y=w*h, U=w/2*h/2 above V=w/2*h/2 
+        //          w*h + 2 ( w/2 * h/2 ) = 2*w/2 * h
+        // YUV444P: Y=w*h, U=w*h left of V=w*h, i.e. 3*w * h
+        // NV12:    Y=w*h, UV=w*h/2
+        vPixelLayout = getPixelLayout(vPixelFmt);
+        if( null == vPixelLayout ) {
+            throw new RuntimeException("Unsupported pixelformat: "+vPixelFmt);
+        }
+        final FFMPEGTextureLayout texLayout = new FFMPEGTextureLayout();
+        texLayout.compute(vPlanes, width, height, vLog2ChromaW, vLog2ChromaH, vTexWidth, vPlaneHeight);
+        System.arraycopy(texLayout.texX, 0, vTexX, 0, 3);
+        System.arraycopy(texLayout.texY, 0, vTexY, 0, 3);
+        texWidth = texLayout.texWidth; texHeight = texLayout.texHeight; 
+        if(DEBUG) {
+            System.err.println("XXX0: fmt "+vPixelFmt+" ("+vPixelLayout+"), planes "+vPlanes+", bpp "+vBitsPerPixel+"/"+vBytesPerPixelPerPlane+
+                               ", bpc "+vBitsPerComponent+", chroma-shift "+vLog2ChromaW+"/"+vLog2ChromaH);
+            for(int i=0; i<3; i++) {
+                System.err.println("XXX0 "+i+": "+vTexWidth[i]+"/"+vLinesize[i]+" x "+vPlaneHeight[i]+" @ "+vTexX[i]+"/"+vTexY[i]);
+            }
+            System.err.println("XXX0 total tex "+texWidth+"x"+texHeight);
+        }
+    }
+    
+    /** Data layout of a decoded video frame, determining the texture format and the lookup shader. */
+    protected static enum PixelLayout {
+        /** Packed RGB(A) of 16, 24 or 32 bpp */
+        PackedRGB,
+        /** Packed YUV 4:2:2, i.e. YUYV or UYVY */
+        PackedYUV,
+        /** One gray plane */
+        Gray,
+        /** One plane each for Y, U and V */
+        PlanarYUV,
+        /** One plane for Y and one for interleaved U and V */
+        SemiPlanarYUV,
+        /** One plane each for G, B and R */
+        PlanarGBR
+    }
+    
+    /** 
+     * @return the {@link PixelLayout} of the given pixelformat, 
+     *         or <code>null</code> if not supported.
+     */
+    private static PixelLayout getPixelLayout(PixelFormat fmt) {
+        if( null == fmt || !isNativeByteOrder(fmt) ) {
+            return null;
+        }
+        switch(fmt) {
             case RGB24:
             case BGR24:
             case ARGB:
             case RGBA:
             case ABGR:
             case BGRA:
-                texWidth = vTexWidth[0]; texHeight = height; 
-                break;
-            default: // FIXME: Add more planar formats !
-                throw new RuntimeException("Unsupported pixelformat: "+vPixelFmt);
+            case RGB565LE:
+            case RGB565BE:
+            case BGR565LE:
+            case BGR565BE:
+                return PixelLayout.PackedRGB;
+            case YUYV422:
+            case UYVY422:
+                return PixelLayout.PackedYUV;
+            case GRAY8:
+            case GRAY16LE:
+            case GRAY16BE:
+                return PixelLayout.Gray;
+            case YUV420P:
+            case YUV422P:
+            case YUV444P:
+            case YUV410P:
+            case YUV411P:
+            case YUV440P:
+            case YUVJ420P:
+            case YUVJ422P:
+            case YUVJ444P:
+            case YUVJ440P:
+            case YUV420P9LE:
+            case YUV420P9BE:
+            case YUV420P10LE:
+            case YUV420P10BE:
+            case YUV420P16LE:
+            case YUV420P16BE:
+            case YUV422P9LE:
+            case YUV422P9BE:
+            case YUV422P10LE:
+            case YUV422P10BE:
+            case YUV422P16LE:
+            case YUV422P16BE:
+            case YUV444P9LE:
+            case YUV444P9BE:
+            case YUV444P10LE:
+            case YUV444P10BE:
+            case YUV444P16LE:
+            case YUV444P16BE:
+                return PixelLayout.PlanarYUV;
+            case NV12:
+            case NV21:
+                return PixelLayout.SemiPlanarYUV;
+            case GBRP:
+            case GBRP9LE:
+            case GBRP9BE:
+            case GBRP10LE:
+            case GBRP10BE:
+            case GBRP16LE:
+            case GBRP16BE:
+                return PixelLayout.PlanarGBR;
+            default: 
+                return null;
         }
-        if(DEBUG) {
-            System.err.println("XXX0: fmt "+vPixelFmt+", planes "+vPlanes+", bpp "+vBitsPerPixel+"/"+vBytesPerPixelPerPlane);
-            for(int i=0; i<3; i++) {
-                System.err.println("XXX0 "+i+": "+vTexWidth[i]+"/"+vLinesize[i]);
-            }
-            System.err.println("XXX0 total tex "+texWidth+"x"+texHeight);
+    }
+    
+    /** 
+     * @return true if the pixelformat has no explicit byte order or matches the native one,
+     *         since 16 bit components are uploaded as-is.
+     */
+    private static boolean isNativeByteOrder(PixelFormat fmt) {
+        final String name = fmt.name();
+        if( name.endsWith("BE") ) {
+            return ByteOrder.BIG_ENDIAN == ByteOrder.nativeOrder();
+        } else if( name.endsWith("LE") ) {
+            return ByteOrder.LITTLE_ENDIAN == ByteOrder.nativeOrder();
         }
+        return true;
+    }
+    
+    /** 
+     * @return the swizzle of the sampled RGBA components to yield RGBA for packed RGB formats,
+     *         or <code>null</code> if none is required.
+     */
+    private static String getRGBSwizzle(PixelFormat fmt) {
+        switch(fmt) {
+            case BGR24:
+            case BGRA:
+            case BGR565LE:
+            case BGR565BE:
+                return "bgra";
+            case ARGB:
+                return "gbar";
+            case ABGR:
+                return "abgr";
+            default:
+                return null;
+        }
+    }
+    
+    /** @return true if the pixelformat requires a specialized lookup shader */
+    private boolean hasLookupShader() {
+        return null != vPixelLayout && 
+               ( PixelLayout.PackedRGB != vPixelLayout || null != getRGBSwizzle(vPixelFmt) );
     }
     
     /**
@@ -266,7 +583,7 @@ public class FFMPEGMediaPlayer extends EGLMediaPlayerImpl {
         if(State.Uninitialized == state) {
             throw new IllegalStateException("Instance not initialized: "+this);
         }
-        if(PixelFormat.YUV420P == vPixelFmt) {
+        if( hasLookupShader() ) {
             if(null != desiredFuncName && desiredFuncName.length()>0) {
                 textureLookupFunctionName = desiredFuncName;
             }
@@ -287,39 +604,121 @@ public class FFMPEGMediaPlayer extends EGLMediaPlayerImpl {
       if(State.Uninitialized == state) {
           throw new IllegalStateException("Instance not initialized: "+this);
       }
-      final float tc_w_1 = (float)getWidth() / (float)texWidth;
-      switch(vPixelFmt) {
-        case YUV420P:
-          return 
-              "vec4 "+textureLookupFunctionName+"(in "+getTextureSampler2DType()+" image, in vec2 texCoord) {\n"+
-              "  vec2 u_off = vec2("+tc_w_1+", 0.0);\n"+
-              "  vec2 v_off = vec2("+tc_w_1+", 0.5);\n"+
-              "  vec2 tc_half = texCoord*0.5;\n"+
-              "  float y,u,v,r,g,b;\n"+
-              "  y = texture2D(image, texCoord).a;\n"+
-              "  u = texture2D(image, u_off+tc_half).a;\n"+
-              "  v = texture2D(image, v_off+tc_half).a;\n"+              
-              "  y = 1.1643*(y-0.0625);\n"+
-              "  u = u-0.5;\n"+
-              "  v = v-0.5;\n"+
-              "  r = y+1.5958*v;\n"+
-              "  g = y-0.39173*u-0.81290*v;\n"+
-              "  b = y+2.017*u;\n"+              
-              "  return vec4(r, g, b, 1);\n"+
-              "}\n"
-          ;            
-        default: // FIXME: Add more planar formats !
+      if( !hasLookupShader() ) {
           return super.getTextureLookupFragmentShaderImpl();
-      }        
+      }
+      final float tw = texWidth, th = texHeight;
+      // components of more than 8 bit are stored in the LSBs of 16 bit
+      final float norm = 2 == vBytesPerPixelPerPlane && PixelLayout.PackedRGB != vPixelLayout && PixelLayout.PackedYUV != vPixelLayout ? 
+                         65535f / (float) ( ( 1 << vBitsPerComponent ) - 1 ) : 1f;
+      final StringBuilder sb = new StringBuilder();
+      sb.append("vec4 ").append(textureLookupFunctionName).append("(in ").append(getTextureSampler2DType()).append(" image, in vec2 texCoord) {\n");
+      switch(vPixelLayout) {
+        case PackedRGB:
+          sb.append("  return texture2D(image, texCoord).").append(getRGBSwizzle(vPixelFmt)).append(";\n");
+          break;
+        case Gray:
+          sb.append("  float y = texture2D(image, texCoord).a*").append(norm).append(";\n");
+          sb.append("  return vec4(y, y, y, 1);\n");
+          break;
+        case PlanarYUV:
+        case PlanarGBR:
+          sb.append("  vec2 c_scale = vec2(").append(1f/(1<<vLog2ChromaW)).append(", ").append(1f/(1<<vLog2ChromaH)).append(");\n");
+          sb.append("  vec2 u_off = vec2(").append(vTexX[1]/tw).append(", ").append(vTexY[1]/th).append(");\n");
+          sb.append("  vec2 v_off = vec2(").append(vTexX[2]/tw).append(", ").append(vTexY[2]/th).append(");\n");
+          sb.append("  vec2 tc_c = texCoord*c_scale;\n");
+          sb.append("  float y,u,v,r,g,b;\n");
+          sb.append("  y = texture2D(image, texCoord).a*").append(norm).append(";\n");
+          sb.append("  u = texture2D(image, u_off+tc_c).a*").append(norm).append(";\n");
+          sb.append("  v = texture2D(image, v_off+tc_c).a*").append(norm).append(";\n");
+          if( PixelLayout.PlanarGBR == vPixelLayout ) {
+              sb.append("  return vec4(v, y, u, 1);\n"); // planes: G, B, R
+          } else {
+              appendYUV2RGB(sb);
+          }
+          break;
+        case SemiPlanarYUV:
+          // Address the interleaved chroma samples by texel
+          sb.append("  vec2 tex_sz = vec2(").append(tw).append(", ").append(th).append(");\n");
+          sb.append("  vec2 c_px = floor(texCoord*tex_sz*0.5);\n");
+          sb.append("  vec2 c_tc = vec2(").append(vTexX[1]).append(".0+2.0*c_px.x+0.5, ").append(vTexY[1]).append(".0+c_px.y+0.5)/tex_sz;\n");
+          sb.append("  vec2 c_tc1 = c_tc + vec2(1.0/tex_sz.x, 0.0);\n");
+          sb.append("  float y,u,v,r,g,b;\n");
+          sb.append("  y = texture2D(image, texCoord).a;\n");
+          if( PixelFormat.NV21 == vPixelFmt ) {
+              sb.append("  v = texture2D(image, c_tc).a;\n");
+              sb.append("  u = texture2D(image, c_tc1).a;\n");
+          } else {
+              sb.append("  u = texture2D(image, c_tc).a;\n");
+              sb.append("  v = texture2D(image, c_tc1).a;\n");
+          }
+          appendYUV2RGB(sb);
+          break;
+        case PackedYUV:
+          // Luminance-alpha texel pairs: [Y0 U][Y1 V] or [U Y0][V Y1]
+          sb.append("  float c_x = floor(texCoord.x*").append(tw).append("*0.5)*2.0+0.5;\n");
+          sb.append("  vec4 t  = texture2D(image, texCoord);\n");
+          sb.append("  vec4 t0 = texture2D(image, vec2(c_x/").append(tw).append(", texCoord.y));\n");
+          sb.append("  vec4 t1 = texture2D(image, vec2((c_x+1.0)/").append(tw).append(", texCoord.y));\n");
+          sb.append("  float y,u,v,r,g,b;\n");
+          if( PixelFormat.UYVY422 == vPixelFmt ) {
+              sb.append("  y = t.a;\n  u = t0.r;\n  v = t1.r;\n");
+          } else {
+              sb.append("  y = t.r;\n  u = t0.a;\n  v = t1.a;\n");
+          }
+          appendYUV2RGB(sb);
+          break;
+      }
+      sb.append("}\n");
+      return sb.toString();
+    }
+    
+    /** Appends the BT.601 conversion of normalized y, u and v to r, g and b and returns RGBA. */
+    private void appendYUV2RGB(StringBuilder sb) {
+        final boolean fullRange;
+        switch(vPixelFmt) {
+            case YUVJ420P:
+            case YUVJ422P:
+            case YUVJ444P:
+            case YUVJ440P:
+                fullRange = true; break;
+            default:
+                fullRange = false;
+        }
+        if( fullRange ) {
+            sb.append("  u = u-0.5;\n");
+            sb.append("  v = v-0.5;\n");
+            sb.append("  r = y+1.402*v;\n");
+            sb.append("  g = y-0.34414*u-0.71414*v;\n");
+            sb.append("  b = y+1.772*u;\n");
+        } else {
+            sb.append("  y = 1.1643*(y-0.0625);\n");
+            sb.append("  u = u-0.5;\n");
+            sb.append("  v = v-0.5;\n");
+            sb.append("  r = y+1.5958*v;\n");
+            sb.append("  g = y-0.39173*u-0.81290*v;\n");
+            sb.append("  b = y+2.017*u;\n");
+        }
+        sb.append("  return vec4(r, g, b, 1);\n");
     }
     
     @Override
     protected synchronized int getCurrentPositionImpl() {
-        return 0!=moviePtr ? getVideoPTS0(moviePtr) : 0;
+        return presentedPTS;
+    }
+
+    @Override
+    public int getQueuedFrameCount() {
+        final FrameRing fr = frameRing;
+        return null != fr ? fr.size() : 0;
     }
 
     @Override
     protected synchronized boolean setPlaySpeedImpl(float rate) {
+        if( null != audioWorker ) {
+            audioWorker.setMuted( 1f != rate );
+        }
+        resetClock();
         return true;
     }
 
@@ -328,6 +727,10 @@ public class FFMPEGMediaPlayer extends EGLMediaPlayerImpl {
         if(0==moviePtr) {
             return false;
         }
+        if( null != audioWorker ) {
+            audioWorker.setPlaying(true);
+        }
+        resetClock();
         return true;
     }
 
@@ -337,6 +740,10 @@ public class FFMPEGMediaPlayer extends EGLMediaPlayerImpl {
         if(0==moviePtr) {
             return false;
         }
+        if( null != audioWorker ) {
+            audioWorker.setPlaying(false);
+        }
+        resetClock();
         return true;
     }
 
@@ -346,6 +753,10 @@ public class FFMPEGMediaPlayer extends EGLMediaPlayerImpl {
         if(0==moviePtr) {
             return false;
         }
+        if( null != audioWorker ) {
+            audioWorker.setPlaying(false);
+        }
+        resetClock();
         return true;
     }
 
@@ -355,9 +766,28 @@ public class FFMPEGMediaPlayer extends EGLMediaPlayerImpl {
         if(0==moviePtr) {
             throw new GLException("FFMPEG native instance null");
         }
-        int pts0 = getVideoPTS0(moviePtr);
-        int pts1 = seek0(moviePtr, msec);
-        System.err.println("Seek: "+pts0+" -> "+msec+" : "+pts1);
+        final int pts0 = presentedPTS;
+        final int pts1;
+        synchronized(decodeLock) {
+            pts1 = seek0(moviePtr, msec, SeekMode.Accurate == getSeekMode());
+            if( null != frameRing ) {
+                frameRing.clear();
+            }
+        }
+        final boolean eos = INVALID_PTS == pts1;
+        seekFramePending = !eos && State.Playing != state;
+        if( null != audioWorker ) {
+            audioWorker.flush();
+        }
+        if( null != streamWorker && !eos ) {
+            // at EOS, the worker reaches the end of stream itself or keeps waiting there
+            streamWorker.resumeFromEOS();
+        }
+        presentedPTS = eos ? getDuration() : pts1;
+        resetClock();
+        if(DEBUG) {
+            System.err.println("Seek: "+pts0+" -> "+msec+" : "+(eos ? "EOS" : String.valueOf(pts1)));
+        }
         return pts1;
     }
 
@@ -365,53 +795,708 @@ public class FFMPEGMediaPlayer extends EGLMediaPlayerImpl {
     protected TextureSequence.TextureFrame getLastTextureImpl() {
         return lastTex;
     }
-    
-    private long lastVideoTime = 0;
-    private int lastVideoPTS = 0;
+
+    /** Presentation clock: system time in ms at clock start, or 0 if reset. */
+    private long clockT0 = 0;
+    /** Presentation clock: PTS of the first frame after clock start. */
+    private int clockPTS0 = 0;
+    /** PTS of the last presented frame */
+    private volatile int presentedPTS = 0;
     private static final int dt_d = 9;
+
+    private final void resetClock() {
+        clockT0 = 0;
+    }
+    /** True if the frame at the position of the last seek shall be presented while not playing. */
+    private volatile boolean seekFramePending = false;
     
+    @Override
+    protected boolean isSeekFramePending() {
+        return seekFramePending;
+    }
+
     @Override
     protected TextureSequence.TextureFrame getNextTextureImpl(GL gl, boolean blocking) {
         if(0==moviePtr) {
             throw new GLException("FFMPEG native instance null");
-        }                
-        if(null != lastTex) {
+        }
+        if(null != lastTex && null != frameRing && State.Playing != state) {
+            // present the frame at the position of the last seek, as soon it is decoded
+            final VideoFrame frame = frameRing.peekNext();
+            if( null != frame ) {
+                seekFramePending = false;
+                presentFrame(gl, frame);
+            }
+        } else if(null != lastTex && null != frameRing) {
+            VideoFrame frame = frameRing.peekNext();
+            if( null == frame ) {
+                if( !streamWorker.isEOS() ) {
+                    underrunFrames++;
+                }
+                return lastTex;
+            }
+            final long now = System.currentTimeMillis();
+            if( 0 == clockT0 ) {
+                clockT0 = now;
+                clockPTS0 = frame.pts;
+            }
+            final boolean audioClock = null != audioWorker && audioWorker.isClockValid();
+            final int audioPTS = audioClock ? audioWorker.getPTS() : 0;
+            if( audioClock ) {
+                // audio is the master clock, correct the presentation clock's drift
+                final int drift = audioPTS - ( clockPTS0 + (int) ( now - clockT0 ) );
+                if( Math.abs(drift) > AV_SYNC_RESET_MS ) {
+                    clockT0 = now;
+                    clockPTS0 = audioPTS;
+                } else {
+                    clockPTS0 += drift / 4; // smooth out the audio clock granularity
+                }
+            }
+            final int clockPTS = clockPTS0 + (int) ( ( now - clockT0 ) * getPlaySpeed() );
+
+            // drop late frames, as long a successor is available
+            final int frameDuration = 0 < fps ? (int) ( 1000f / fps ) : 40;
+            while( clockPTS - frame.pts > frameDuration && frameRing.size() > 1 ) {
+                presentRelease(gl); // skipped, superseded by its successor below
+                droppedFrames++;
+                frame = frameRing.peekNext();
+            }
+
+            final long dt = (long) ( (float) ( frame.pts - clockPTS ) / getPlaySpeed() ) ;
+            if(dt>dt_d) {
+                if(!blocking) {
+                    return lastTex; // not due yet
+                }
+                try {
+                    Thread.sleep(dt-dt_d);
+                } catch (InterruptedException e) { }
+            }
+
+            presentFrame(gl, frame);
+            if( audioClock ) {
+                avSyncOffset = frame.pts - audioPTS;
+            }
+        }
+        return lastTex;
+    }
+
+    /** Binds the texture of the given next frame, uploads it if not yet done and presents it. */
+    private void presentFrame(GL gl, VideoFrame frame) {
+        final Texture tex = frame.texFrame.getTexture();
+        gl.glActiveTexture(GL.GL_TEXTURE0+getTextureUnit());
+        tex.enable(gl);
+        tex.bind(gl);
+        if( frame.uploaded ) {
+            if( 0 != frame.fence ) {
+                // let our command stream wait for the upload issued on the shared context
+                final GL2GL3 gl2gl3 = gl.getGL2GL3();
+                gl2gl3.glWaitSync(frame.fence, 0, GL2GL3.GL_TIMEOUT_IGNORED);
+                gl2gl3.glDeleteSync(frame.fence);
+                frame.fence = 0;
+            }
+        } else {
             psm.setUnpackAlignment(gl, 1); // RGBA ? 4 : 1
             try {
-                final Texture tex = lastTex.getTexture();
-                gl.glActiveTexture(GL.GL_TEXTURE0+getTextureUnit());
-                tex.enable(gl);
-                tex.bind(gl);
-                readNextPacket0(moviePtr, procAddrGLTexSubImage2D, textureTarget, textureFormat, textureType);
+                uploadFrame(gl, frame.buffer);
             } finally {
                 psm.restore(gl);
             }
-            final int pts = getVideoPTS0(moviePtr); // this frame
-            if(blocking) {
-                // poor mans video sync .. TODO: off thread 'readNextPackage0(..)' on shared GLContext and multi textures/unit!
-                final long now = System.currentTimeMillis();
-                final long now_d = now - lastVideoTime;
-                final long pts_d = pts - lastVideoPTS;                
-                final long dt = (long) ( (float) ( pts_d - now_d ) / getPlaySpeed() ) ;
-                lastVideoTime = now;
-                // System.err.println("s: pts-v "+pts+", pts-d "+pts_d+", now_d "+now_d+", dt "+dt);
-                if(dt>dt_d) {
+        }
+        presentRelease(gl);
+        lastTex = frame.texFrame;
+        presentedPTS = frame.pts;
+    }
+
+    /**
+     * Marks the next frame as presented via {@link FrameRing#present()}, releasing the previously presented one.
+     * <p>
+     * If the {@link StreamWorker} uploads into the released texture itself,
+     * the release is fenced, since our pending rendering commands may still sample it.
+     * The {@link StreamWorker} waits for the fence before overwriting the texture.
+     * </p>
+     */
+    private void presentRelease(GL gl) {
+        final VideoFrame released = frameRing.getPresented();
+        if( null != released && released.uploaded && sharedUploadFenced ) {
+            final GL2GL3 gl2gl3 = gl.getGL2GL3();
+            if( 0 != released.releaseFence ) {
+                gl2gl3.glDeleteSync(released.releaseFence);
+            }
+            released.releaseFence = gl2gl3.glFenceSync(GL2GL3.GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            gl.glFlush(); // make the fence visible to the StreamWorker's context
+        }
+        frameRing.present();
+    }
+
+    /**
+     * Uploads all planes of the decoded frame,
+     * stored back to back in <code>buffer</code>, into the bound texture.
+     * <p>
+     * Only used if the {@link StreamWorker} could not upload the frame itself.
+     * </p>
+     */
+    private void uploadFrame(GL gl, ByteBuffer buffer) {
+        int off = 0;
+        try {
+            for(int p=0; p<3 && p<vPlanes; p++) {
+                buffer.position(off);
+                gl.glTexSubImage2D(textureTarget, 0,
+                                   vTexX[p],     vTexY[p],
+                                   vTexWidth[p], vPlaneHeight[p],
+                                   textureFormat, textureType, buffer);
+                off += vLinesize[p] * vPlaneHeight[p];
+            }
+        } finally {
+            buffer.position(0);
+        }
+    }
+
+    private static long getTexSubImage2DProcAddress(GLContext ctx) {
+        final ProcAddressTable pt = ((GLContextImpl)ctx).getGLProcAddressTable();
+        if(pt instanceof GLES2ProcAddressTable) {
+            return ((GLES2ProcAddressTable)pt)._addressof_glTexSubImage2D;
+        } else if(pt instanceof GLES1ProcAddressTable) {
+            return ((GLES1ProcAddressTable)pt)._addressof_glTexSubImage2D;
+        } else if(pt instanceof GL4bcProcAddressTable) {
+            return ((GL4bcProcAddressTable)pt)._addressof_glTexSubImage2D;
+        } else {
+            throw new InternalError("Unknown ProcAddressTable: "+pt.getClass().getName()+" of "+ctx.getClass().getName());
+        }
+    }
+
+    /** A slot of the {@link FrameRing}, i.e. one of our {@link #texFrames} and its decoded content. */
+    private static class VideoFrame {
+        final EGLTextureFrame texFrame;
+        /**
+         * CPU copy of all planes back to back,
+         * only allocated if the {@link StreamWorker} has no shared context to upload the frame itself.
+         */
+        ByteBuffer buffer = null;
+        /** <code>true</code> if the texture has been updated by the {@link StreamWorker}, otherwise the GL thread uploads {@link #buffer} */
+        boolean uploaded = false;
+        /** GL sync object of the shared context upload, or 0 */
+        long fence = 0;
+        /** GL sync object of the GL thread's last use, set when released, or 0. See {@link FFMPEGMediaPlayer#presentRelease(GL)}. */
+        long releaseFence = 0;
+        /** PTS in ms */
+        int pts;
+        /** {@link FrameRing} generation at decoding */
+        int gen;
+
+        VideoFrame(EGLTextureFrame texFrame) {
+            this.texFrame = texFrame;
+        }
+    }
+
+    /**
+     * Bounded ring of {@link VideoFrame}s, one for each texture,
+     * filled by the {@link StreamWorker} and drained by the GL thread.
+     * <p>
+     * The producer acquires the next free slot via {@link #waitForFree()},
+     * which blocks while the ring is full, and publishes it via {@link #commit(VideoFrame)}.
+     * The consumer inspects the next frame via {@link #peekNext()} and shows it via {@link #present()}.
+     * </p>
+     * <p>
+     * The presented frame stays in the ring until its successor is presented,
+     * hence a texture being sampled is never the one being overwritten.
+     * Pending rendering commands of the released frame are covered by its {@link VideoFrame#releaseFence}.
+     * </p>
+     */
+    private static class FrameRing {
+        private final VideoFrame[] frames;
+        /** index of the presented frame if {@link #presented}, otherwise of the next frame */
+        private int head = 0;
+        /** number of committed frames, including the presented one */
+        private int size = 1;
+        private boolean presented = true;
+        /** incremented by {@link #clear()}, invalidating frames acquired before */
+        private int gen = 0;
+        private boolean closed = false;
+
+        /**
+         * @param texFrames all texture frames, where the first one is treated as being presented
+         */
+        FrameRing(TextureSequence.TextureFrame[] texFrames) {
+            frames = new VideoFrame[texFrames.length];
+            for(int i=0; i<texFrames.length; i++) {
+                frames[i] = new VideoFrame((EGLTextureFrame)texFrames[i]);
+            }
+        }
+
+        /** @return the number of queued frames, excluding the presented one. */
+        final synchronized int size() { return presented ? size - 1 : size; }
+
+        /**
+         * @return the next free slot to be decoded into, blocks while the ring is full.
+         *         Returns <code>null</code> if {@link #close() closed}.
+         */
+        final synchronized VideoFrame waitForFree() {
+            while( !closed && size == frames.length ) {
+                try {
+                    wait();
+                } catch (InterruptedException e) { }
+            }
+            if( closed ) {
+                return null;
+            }
+            return frames[ ( head + size ) % frames.length ];
+        }
+
+        /** @return the current generation, incremented by {@link #clear()} */
+        final synchronized int getGeneration() { return gen; }
+
+        /**
+         * Publishes the slot returned by {@link #waitForFree()},
+         * unless the ring has been {@link #clear() cleared} since it has been decoded,
+         * i.e. if the {@link VideoFrame#gen} differs from the {@link #getGeneration() current generation}.
+         */
+        final synchronized void commit(VideoFrame frame) {
+            if( frame.gen == gen && !closed ) {
+                size++;
+                notifyAll();
+            }
+        }
+
+        /** @return the next decoded frame, or <code>null</code> if none is available. */
+        final synchronized VideoFrame peekNext() {
+            final int off = presented ? 1 : 0;
+            return off < size ? frames[ ( head + off ) % frames.length ] : null;
+        }
+
+        /** @return the presented frame, which will be released by the next {@link #present()}, or <code>null</code> if none. */
+        final synchronized VideoFrame getPresented() {
+            return presented && 0 < size ? frames[head] : null;
+        }
+
+        /** Marks the frame returned by {@link #peekNext()} as presented, releasing the previous one. */
+        final synchronized void present() {
+            if( presented ) {
+                head = ( head + 1 ) % frames.length;
+                size--;
+            }
+            presented = true;
+            notifyAll();
+        }
+
+        /** Drops all queued frames, excluding the presented one. */
+        final synchronized void clear() {
+            size = presented ? 1 : 0;
+            gen++;
+            notifyAll();
+        }
+
+        final synchronized void close() {
+            closed = true;
+            notifyAll();
+        }
+
+        /** Deletes all remaining GL sync objects, shall be called after the {@link StreamWorker} has been stopped. */
+        final synchronized void deleteSyncs(GL2GL3 gl) {
+            for(int i=0; i<frames.length; i++) {
+                final VideoFrame f = frames[i];
+                if( 0 != f.fence ) {
+                    gl.glDeleteSync(f.fence);
+                    f.fence = 0;
+                }
+                if( 0 != f.releaseFence ) {
+                    gl.glDeleteSync(f.releaseFence);
+                    f.releaseFence = 0;
+                }
+            }
+        }
+    }
+
+    /**
+     * Demuxes and decodes the stream off the GL thread into the {@link FrameRing},
+     * until it is full, the end of the stream is reached or it gets {@link #stopWorker() stopped}.
+     * <p>
+     * If a shared {@link GLContext} is available, it is made current on this thread
+     * and the decoded frame is uploaded directly into the slot's texture, fenced via a GL sync object if available.
+     * Otherwise the frame is copied into the slot's buffer and uploaded by the GL thread.
+     * </p>
+     */
+    private class StreamWorker extends Thread {
+        private final Object eosLock = new Object();
+        private volatile boolean shallStop = false;
+        private boolean eos = false;
+        private GLContext sharedContext;
+        /** Copy of the last decoded PCM data, see {@link #stageAudio()} */
+        private ByteBuffer audioStage = null;
+        private int audioStagePTS = 0;
+
+        StreamWorker(GLContext sharedContext) {
+            super("FFMPEGStreamWorker-"+Thread.currentThread().getName());
+            setDaemon(true);
+            this.sharedContext = sharedContext;
+        }
+
+        @Override
+        public void run() {
+            GL wgl = null;
+            long procAddrGLTexSubImage2D = 0;
+            boolean useFence = false;
+            if( null != sharedContext ) {
+                try {
+                    if( GLContext.CONTEXT_NOT_CURRENT < sharedContext.makeCurrent() ) {
+                        wgl = sharedContext.getGL();
+                        procAddrGLTexSubImage2D = getTexSubImage2DProcAddress(sharedContext);
+                        useFence = wgl.isGL2GL3() && wgl.isFunctionAvailable("glFenceSync");
+                        sharedUploadFenced = useFence;
+                        wgl.glPixelStorei(GL.GL_UNPACK_ALIGNMENT, 1);
+                    }
+                } catch (GLException gle) {
+                    if(DEBUG) {
+                        gle.printStackTrace();
+                    }
+                }
+                if( null == wgl ) {
+                    sharedContext.destroy();
+                    sharedContext = null;
+                }
+                if(DEBUG) {
+                    System.err.println("FFMPEG StreamWorker: shared context upload "+(null != wgl)+", fence "+useFence);
+                }
+            }
+            try {
+                while( !shallStop ) {
+                    final VideoFrame frame = frameRing.waitForFree();
+                    if( null == frame ) {
+                        break; // closed
+                    }
+                    if( null != wgl ) {
+                        if( 0 != frame.fence ) {
+                            // dropped before being presented
+                            wgl.getGL2GL3().glDeleteSync(frame.fence);
+                            frame.fence = 0;
+                        }
+                        if( 0 != frame.releaseFence ) {
+                            // the GL thread's pending rendering commands may still sample the previous content
+                            wgl.getGL2GL3().glWaitSync(frame.releaseFence, 0, GL2GL3.GL_TIMEOUT_IGNORED);
+                            wgl.getGL2GL3().glDeleteSync(frame.releaseFence);
+                            frame.releaseFence = 0;
+                        }
+                        wgl.glBindTexture(textureTarget, frame.texFrame.getTexture().getTextureObject(wgl));
+                    } else if( null == frame.buffer ) {
+                        frame.buffer = Buffers.newDirectByteBuffer(vFrameSize);
+                    }
+                    boolean reachedEOS = false;
+                    boolean done = false;
+                    while( !shallStop && !done ) {
+                        int res;
+                        final int gen;
+                        // lock per packet only, allowing to seek while waiting for audio to be played
+                        synchronized(decodeLock) {
+                            gen = frameRing.getGeneration();
+                            try {
+                                res = readNextPacket0(moviePtr, procAddrGLTexSubImage2D, textureTarget, textureFormat, textureType,
+                                                      null != wgl ? null : frame.buffer);
+                            } catch (Throwable t) {
+                                t.printStackTrace();
+                                res = READ_EOS;
+                            }
+                            if( READ_VIDEO == res ) {
+                                frame.pts = getVideoPTS0(moviePtr);
+                                frame.gen = gen;
+                                frame.uploaded = null != wgl;
+                                if( null != wgl ) {
+                                    if( useFence ) {
+                                        frame.fence = wgl.getGL2GL3().glFenceSync(GL2GL3.GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                                        wgl.glFlush();
+                                    } else {
+                                        wgl.glFinish();
+                                    }
+                                }
+                            } else if( READ_AUDIO == res && !stageAudio() ) {
+                                res = 0;
+                            }
+                        }
+                        switch( res ) {
+                            case READ_VIDEO:
+                                frameRing.commit(frame);
+                                done = true;
+                                break;
+                            case READ_AUDIO:
+                                queueAudio(gen);
+                                break;
+                            case READ_EOS:
+                                reachedEOS = true;
+                                done = true;
+                                break;
+                        }
+                    }
+                    synchronized(eosLock) {
+                        if( reachedEOS ) {
+                            eos = true;
+                        }
+                        while( !shallStop && eos ) {
+                            try {
+                                eosLock.wait();
+                            } catch (InterruptedException e) { }
+                        }
+                    }
+                }
+            } finally {
+                if( null != sharedContext ) {
+                    sharedContext.release();
+                    sharedContext.destroy();
+                    sharedContext = null;
+                }
+            }
+        }
+
+        /**
+         * Copies the decoded PCM data into {@link #audioStage}, 
+         * since it gets overwritten by the next native decoding call.
+         * Shall be called while holding the {@link #decodeLock}.
+         * @return true if PCM data has been staged
+         */
+        private boolean stageAudio() {
+            final ByteBuffer pcm = null != pcmRing ? (ByteBuffer) getAudioBuffer0(moviePtr, 0) : null;
+            if( null == pcm ) {
+                return false;
+            }
+            if( null == audioStage || audioStage.capacity() < pcm.remaining() ) {
+                audioStage = Buffers.newDirectByteBuffer( 2 * pcm.remaining() );
+            }
+            audioStage.clear();
+            audioStage.put(pcm);
+            audioStage.flip();
+            audioStagePTS = getAudioPTS0(moviePtr);
+            return true;
+        }
+
+        /**
+         * Queues the {@link #audioStage staged} PCM data into the {@link PCMRingBuffer},
+         * waiting for the {@link AudioWorker} to make room for it.
+         * <p>
+         * Gives up if the stream has been sought meanwhile, i.e. the generation of the {@link FrameRing} changed,
+         * or if no video frame is queued, i.e. the video would starve while waiting for the audio.
+         * </p>
+         */
+        private void queueAudio(int gen) {
+            final int size = audioStage.remaining();
+            while( !shallStop && audioStage.hasRemaining() && gen == frameRing.getGeneration() ) {
+                final int pts = audioStagePTS + pcmRing.getDuration( size - audioStage.remaining() );
+                if( 0 == pcmRing.put(audioStage, pts) ) {
+                    if( 0 == frameRing.size() ) {
+                        if(DEBUG) {
+                            System.err.println("FFMPEG StreamWorker: Audio queue overflow, dropping "+pcmRing.getDuration(audioStage.remaining())+" ms: "+pcmRing);
+                        }
+                        break;
+                    }
                     try {
-                        Thread.sleep(dt-dt_d);
+                        Thread.sleep(AUDIO_PERIOD_MS / 2);
                     } catch (InterruptedException e) { }
-                } /* else if(0>pts_d) {
-                    System.err.println("s: pts-v "+pts+", pts-d "+pts_d+", now_d "+now_d+", dt "+dt);
-                } */
+                }
             }
-            lastVideoPTS = pts;
         }
-        return lastTex;
+
+        final boolean isEOS() {
+            synchronized(eosLock) {
+                return eos;
+            }
+        }
+
+        /** Continues decoding after the end of stream has been reached, e.g. after seeking. */
+        final void resumeFromEOS() {
+            synchronized(eosLock) {
+                eos = false;
+                eosLock.notifyAll();
+            }
+        }
+
+        /** Stops this worker and waits until it has finished. */
+        final void stopWorker() {
+            shallStop = true;
+            frameRing.close();
+            synchronized(eosLock) {
+                eosLock.notifyAll();
+            }
+            try {
+                join();
+            } catch (InterruptedException e) { }
+        }
     }
-    
-    private void consumeAudio(int len) {
-        
+
+    /**
+     * Plays the decoded PCM data of the {@link PCMRingBuffer} and provides the audio clock,
+     * i.e. the PTS of the audio currently being heard, which is the master clock of the video presentation.
+     * <p>
+     * Uses a Java Sound {@link SourceDataLine} if available.
+     * Otherwise, or if property <code>jogl.ffmpeg.pcmdump</code> is set, 
+     * the PCM data is consumed in real time and written to the named file, if any.
+     * The PCM dump contains interleaved signed 16bit samples in native byte order.
+     * </p>
+     * <p>
+     * While muted, i.e. play speed is not 1, the PCM data is dropped up to the presented video PTS. 
+     * </p>
+     */
+    private class AudioWorker extends Thread {
+        private final PCMRingBuffer ring;
+        private final byte[] chunk;
+        private final SourceDataLine line;
+        private OutputStream dump = null;
+        private volatile boolean shallStop = false;
+        private volatile boolean playing = false;
+        private volatile boolean muted = false;
+        private volatile boolean flushRequested = false;
+        /** True if data has been played since last flush */
+        private volatile boolean hasPlayed = false;
+        /** Null sink: System time in ms at which the consumed data is played, 0 if none */
+        private volatile long nullSinkEndT = 0;
+
+        AudioWorker(PCMRingBuffer ring, int sampleRate, int channels) {
+            super("FFMPEGAudioWorker-"+Thread.currentThread().getName());
+            setDaemon(true);
+            this.ring = ring;
+            final int periodBytes = ( ring.getBytesPerSecond() / 1000 ) * AUDIO_PERIOD_MS;
+            chunk = new byte[ Math.max( ring.getFrameSize(), periodBytes - periodBytes % ring.getFrameSize() ) ];
+            if( null != PCM_DUMP_FILE ) {
+                try {
+                    dump = new BufferedOutputStream(new FileOutputStream(PCM_DUMP_FILE));
+                } catch (IOException ioe) {
+                    ioe.printStackTrace();
+                }
+                line = null;
+            } else {
+                line = openLine(sampleRate, channels);
+            }
+            if(DEBUG) {
+                System.err.println("FFMPEG AudioWorker: line "+line+", dump "+PCM_DUMP_FILE+", "+ring);
+            }
+        }
+
+        private SourceDataLine openLine(int sampleRate, int channels) {
+            try {
+                final AudioFormat format = new AudioFormat(sampleRate, 16, channels, true, ByteOrder.BIG_ENDIAN == ByteOrder.nativeOrder());
+                final SourceDataLine l = AudioSystem.getSourceDataLine(format);
+                l.open(format, 4 * chunk.length);
+                return l;
+            } catch (Throwable t) {
+                // no audio device, e.g. headless, or unsupported format
+                if(DEBUG) {
+                    t.printStackTrace();
+                }
+                return null;
+            }
+        }
+
+        /** @return the latency in ms of the data already consumed from the ring, but not yet played */
+        private int getLatency() {
+            if( null != line ) {
+                return ring.getDuration( line.getBufferSize() - line.available() );
+            } else {
+                return (int) Math.max( 0, nullSinkEndT - System.currentTimeMillis() );
+            }
+        }
+
+        /** @return true if {@link #getPTS()} reflects audio being played */
+        final boolean isClockValid() {
+            return playing && !muted && !flushRequested && hasPlayed && ( 0 < ring.available() || 0 < getLatency() );
+        }
+
+        /** @return the PTS in ms of the audio currently being played */
+        final int getPTS() {
+            return ring.getReadPTS() - getLatency();
+        }
+
+        final void setPlaying(boolean v) { playing = v; }
+
+        final void setMuted(boolean v) { muted = v; }
+
+        /** Drops all queued audio, e.g. after seeking. */
+        final void flush() { flushRequested = true; }
+
+        @Override
+        public void run() {
+            try {
+                while( !shallStop ) {
+                    if( flushRequested ) {
+                        ring.skip( ring.available() );
+                        if( null != line ) {
+                            line.flush();
+                        }
+                        nullSinkEndT = 0;
+                        hasPlayed = false;
+                        flushRequested = false;
+                    }
+                    if( !playing || muted ) {
+                        if( null != line && line.isRunning() ) {
+                            line.stop();
+                        }
+                        if( playing ) {
+                            // muted: keep up with the presented video
+                            final int behind = presentedPTS - ring.getReadPTS();
+                            if( 0 < behind ) {
+                                ring.skip( (int) ( ( (long) behind * ring.getBytesPerSecond() ) / 1000 ) );
+                            }
+                        }
+                        sleepMillis(AUDIO_PERIOD_MS);
+                        continue;
+                    }
+                    final int n = ring.get(chunk, 0, chunk.length);
+                    if( 0 == n ) {
+                        sleepMillis(AUDIO_PERIOD_MS / 2); // underrun
+                        continue;
+                    }
+                    if( null != dump ) {
+                        try {
+                            dump.write(chunk, 0, n);
+                        } catch (IOException ioe) {
+                            ioe.printStackTrace();
+                            closeDump();
+                        }
+                    }
+                    hasPlayed = true;
+                    if( null != line ) {
+                        if( !line.isRunning() ) {
+                            line.start();
+                        }
+                        line.write(chunk, 0, n); // blocks while the device buffer is full
+                    } else {
+                        // null sink: consume in real time
+                        final long now = System.currentTimeMillis();
+                        nullSinkEndT = Math.max(now, nullSinkEndT) + ring.getDuration(n);
+                        sleepMillis( nullSinkEndT - now - AUDIO_PERIOD_MS );
+                    }
+                }
+            } finally {
+                if( null != line ) {
+                    line.stop();
+                    line.close();
+                }
+                closeDump();
+            }
+        }
+
+        private void sleepMillis(long ms) {
+            if( 0 < ms ) {
+                try {
+                    Thread.sleep(ms);
+                } catch (InterruptedException e) { }
+            }
+        }
+
+        private void closeDump() {
+            if( null != dump ) {
+                try {
+                    dump.close();
+                } catch (IOException ioe) {
+                    ioe.printStackTrace();
+                }
+                dump = null;
+            }
+        }
+
+        /** Stops this worker and waits until it has finished. */
+        final void stopWorker() {
+            shallStop = true;
+            try {
+                join();
+            } catch (InterruptedException e) { }
+        }
     }
-    
+
     private static native int getAvUtilVersion0();
     private static native int getAvFormatVersion0();
     private static native int getAvCodecVersion0();
@@ -420,15 +1505,36 @@ public class FFMPEGMediaPlayer extends EGLMediaPlayerImpl {
     private native void destroyInstance0(long moviePtr);
     
     private native void setStream0(long moviePtr, String url, int vid, int aid);
+    /** Sets the placement of each plane within the texture used by {@link #readNextPacket0(long, long, int, int, int, ByteBuffer)}, see {@link FFMPEGTextureLayout}. */
+    private native void setTextureLayout0(long moviePtr, int tX0, int tX1, int tX2, int tY0, int tY1, int tY2);
 
     private native int getVideoPTS0(long moviePtr);    
     
+    /** @return the PTS in ms of the PCM data returned by {@link #getAudioBuffer0(long, int)} */
     private native int getAudioPTS0(long moviePtr);
+    /** 
+     * @return the PCM data of the last decoded audio packet as interleaved signed 16bit samples in native byte order,
+     *         or null if none is available. Only valid until the next native decoding call.
+     */
     private native Buffer getAudioBuffer0(long moviePtr, int plane);
     
-    private native int readNextPacket0(long moviePtr, long procAddrGLTexSubImage2D, int texTarget, int texFmt, int texType);
+    /** 
+     * Reads and decodes the next packet. 
+     * <p>
+     * If a video frame has been decoded and <code>procAddrGLTexSubImage2D</code> is not 0,
+     * it is uploaded into the currently bound texture using the given function pointer of the current context.
+     * Otherwise all its planes are copied back to back into the given <code>vBuffer</code>.
+     * </p>
+     * @return {@link #READ_EOS}, {@link #READ_VIDEO}, {@link #READ_AUDIO} or zero if no frame has been completed.
+     */
+    private native int readNextPacket0(long moviePtr, long procAddrGLTexSubImage2D, int texTarget, int texFmt, int texType, ByteBuffer vBuffer);
     
-    private native int seek0(long moviePtr, int position);
+    /**
+     * Seeks to the given position, the resulting video frame is delivered by the next {@link #readNextPacket0(long, long, int, int, int, ByteBuffer)}.
+     * @param accurate if true, decodes up to the frame displayed at the given position, otherwise lands on the preceding key frame.
+     * @return the PTS of the resulting video frame, or {@link #INVALID_PTS} if the end of stream has been reached
+     */
+    private native int seek0(long moviePtr, int position, boolean accurate);
 
     public static enum PixelFormat {
         // NONE= -1,
@@ -0,0 +1,99 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package jogamp.opengl.util.av.impl;
+
+/**
+ * Placement of up to three planes of a decoded video frame within one texture,
+ * as used by {@link FFMPEGMediaPlayer}.
+ * <p>
+ * The 1st plane is placed at the origin, the chroma plane(s) right of it,
+ * i.e. starting at the video width, since the decoder already aligns the linesize.
+ * Vertically subsampled chroma planes are stacked, otherwise placed side by side.
+ * </p>
+ * <p>
+ * Planes are uploaded in order, hence a plane overwrites the linesize padding of its predecessor.
+ * </p>
+ */
+public class FFMPEGTextureLayout {
+    /** per plane, x-offset in texels within the texture */
+    public final int[] texX = { 0, 0, 0 };
+    /** per plane, y-offset in lines within the texture */
+    public final int[] texY = { 0, 0, 0 };
+    /** texture width in texels, holding all planes */
+    public int texWidth = 0;
+    /** texture height in lines, holding all planes */
+    public int texHeight = 0;
+
+    /**
+     * Computes the placement of all planes.
+     *
+     * @param planes number of planes, 1 for packed formats, 2 for semi-planar and 3 for planar formats
+     * @param width video width in pixels
+     * @param height video height in lines
+     * @param log2ChromaW horizontal chroma subsampling
+     * @param log2ChromaH vertical chroma subsampling
+     * @param planeTexWidth per plane, width in texels, i.e. linesize in texels
+     * @param planeHeight per plane, height in lines
+     */
+    public void compute(int planes, int width, int height, int log2ChromaW, int log2ChromaH,
+                        int[] planeTexWidth, int[] planeHeight) {
+        int texW = planeTexWidth[0];
+        int texH = height;
+        for(int p=0; p<3; p++) {
+            texX[p] = 0;
+            texY[p] = 0;
+        }
+        if( 2 == planes ) {
+            // semi-planar, e.g. NV12: interleaved chroma plane right of the 1st plane
+            texX[1] = width;
+            texW = Math.max(texW, width + planeTexWidth[1]);
+            texH = Math.max(texH, planeHeight[1]);
+        } else if( 3 <= planes ) {
+            texX[1] = width;
+            if( 0 < log2ChromaH ) {
+                // U above V
+                texX[2] = width;
+                texY[2] = planeHeight[1];
+                texW = Math.max(texW, width + Math.max(planeTexWidth[1], planeTexWidth[2]));
+                texH = Math.max(texH, planeHeight[1] + planeHeight[2]);
+            } else {
+                // U left of V
+                final int cw = -((-width) >> log2ChromaW);
+                texX[2] = width + cw;
+                texW = Math.max(texW, width + Math.max(planeTexWidth[1], cw + planeTexWidth[2]));
+            }
+        }
+        texWidth = texW;
+        texHeight = texH;
+    }
+
+    @Override
+    public String toString() {
+        return "TexLayout["+texWidth+"x"+texHeight+", planes @ "+texX[0]+"/"+texY[0]+", "+texX[1]+"/"+texY[1]+", "+texX[2]+"/"+texY[2]+"]";
+    }
+}
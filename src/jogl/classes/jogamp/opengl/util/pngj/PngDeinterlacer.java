@@ -0,0 +1,108 @@
+package jogamp.opengl.util.pngj;
+
+/**
+ * Geometry of the sub images of an interlaced (Adam7) image, tracking the row currently read.
+ * <p>
+ * Pass <code>p</code> (1-7) holds the pixels at columns <code>offsetX + i * deltaX</code> of the image rows
+ * <code>offsetY + j * deltaY</code>. Empty passes (small images) are skipped.
+ * <p>
+ * See http://www.w3.org/TR/PNG/#8Interlace
+ */
+public class PngDeinterlacer {
+	private static final int[] OX = { 0, 4, 0, 2, 0, 1, 0 };
+	private static final int[] OY = { 0, 0, 4, 0, 2, 0, 1 };
+	private static final int[] DX = { 8, 8, 4, 4, 2, 2, 1 };
+	private static final int[] DY = { 8, 8, 8, 4, 4, 2, 2 };
+
+	private final ImageInfo imi;
+	private int pass = 0; // 1-7, 0 before the first row
+	private int rows, cols, bytesPerRow;
+	private int rowInPass = -1;
+
+	public PngDeinterlacer(ImageInfo imi) {
+		this.imi = imi;
+	}
+
+	/**
+	 * Advances to the next row, switching to the next non empty pass if required.
+	 *
+	 * @return false if all rows of all passes have been read
+	 */
+	boolean nextRow() {
+		rowInPass++;
+		while (rowInPass >= rows) {
+			if (pass == 7)
+				return false;
+			setPass(pass + 1);
+			rowInPass = 0;
+		}
+		return true;
+	}
+
+	private void setPass(int p) {
+		pass = p;
+		cols = passCols(p);
+		rows = passRows(p);
+		bytesPerRow = (imi.bitspPixel * cols + 7) / 8;
+	}
+
+	// an empty pass has neither rows nor cols
+	private int passCols(int p) {
+		return passRowsAny(p) > 0 ? Math.max(0, passColsAny(p)) : 0;
+	}
+
+	private int passRows(int p) {
+		return passColsAny(p) > 0 ? Math.max(0, passRowsAny(p)) : 0;
+	}
+
+	private int passColsAny(int p) {
+		return (imi.cols - OX[p - 1] + DX[p - 1] - 1) / DX[p - 1];
+	}
+
+	private int passRowsAny(int p) {
+		return (imi.rows - OY[p - 1] + DY[p - 1] - 1) / DY[p - 1];
+	}
+
+	/** Total number of rows of all passes, i.e. the number of rows stored in the stream */
+	public int getTotalRows() {
+		int n = 0;
+		for (int p = 1; p <= 7; p++)
+			n += passRows(p);
+		return n;
+	}
+
+	/** Current pass, 1-7 */
+	public int getPass() {
+		return pass;
+	}
+
+	/** Row number of the current row inside its pass (0 is top) */
+	public int getRowInPass() {
+		return rowInPass;
+	}
+
+	/** Row number of the current row inside the image (0 is top) */
+	public int getRow() {
+		return OY[pass - 1] + rowInPass * DY[pass - 1];
+	}
+
+	/** Number of pixels of the current row */
+	public int getCols() {
+		return cols;
+	}
+
+	/** Image column of the first pixel of the current row */
+	public int getOffsetX() {
+		return OX[pass - 1];
+	}
+
+	/** Image column distance of two adjacent pixels of the current row */
+	public int getDeltaX() {
+		return DX[pass - 1];
+	}
+
+	/** Bytes of the current row, without the filter type byte */
+	public int getBytesPerRow() {
+		return bytesPerRow;
+	}
+}
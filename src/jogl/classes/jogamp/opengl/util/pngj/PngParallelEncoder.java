@@ -0,0 +1,371 @@
+package jogamp.opengl.util.pngj;
+
+import java.io.OutputStream;
+import java.lang.reflect.Method;
+import java.util.Arrays;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.ThreadFactory;
+import java.util.zip.Adler32;
+import java.util.zip.Deflater;
+
+import jogamp.opengl.util.pngj.chunks.ChunkHelper;
+import jogamp.opengl.util.pngj.chunks.ChunkRaw;
+
+/**
+ * Encodes the image data (IDAT) of a whole image in parallel.
+ * <p>
+ * The image is split into horizontal stripes, one per thread. Each stripe is filtered and deflated concurrently into
+ * its own raw deflate stream, terminated by a sync flush (the last one by finish), so the stripes can simply be
+ * concatenated into one zlib stream. The zlib header and the combined Adler32 checksum are added by this class. Each
+ * stripe is written as one IDAT chunk, as soon as it and all its predecessors are done.
+ * <p>
+ * The filter type is chosen per row, with the minimum sum of absolute differences heuristic.
+ * <p>
+ * Threads, deflaters and buffers are kept and reused for subsequent images, i.e. this object should be reused for a
+ * sequence of images. Call <code>dispose()</code> to release them.
+ * <p>
+ * Requires <code>Deflater.deflate(byte[], int, int, int)</code> (Java 7) for the sync flush, see
+ * <code>isAvailable()</code>.
+ */
+public class PngParallelEncoder {
+	/**
+	 * Provides the unfiltered rows of the image to be encoded.
+	 */
+	public interface RowSource {
+		/**
+		 * Copies row <code>row</code> (0 is top), laid out as in the PNG stream (<code>imgInfo.bytesPerRow</code>
+		 * bytes), into <code>dst</code> at <code>dstOff</code>.
+		 * <p>
+		 * Called concurrently from all encoder threads, rows of one stripe in sequence.
+		 */
+		public void getRow(int row, byte[] dst, int dstOff);
+	}
+
+	/**
+	 * Stripes below this number of rows don't pay off
+	 */
+	private static final int MIN_STRIPE_ROWS = 32;
+	private static final int SYNC_FLUSH = 2; // Deflater.SYNC_FLUSH
+	private static final Method deflateFlush; // Deflater.deflate(byte[], int, int, int)
+
+	static {
+		Method m = null;
+		try {
+			m = Deflater.class.getMethod("deflate", byte[].class, int.class, int.class, int.class);
+		} catch (Exception e) {
+		}
+		deflateFlush = m;
+	}
+
+	/**
+	 * @return true if the runtime supports the sync flush required for parallel encoding
+	 */
+	public static boolean isAvailable() {
+		return deflateFlush != null;
+	}
+
+	private final int threadCount;
+	private int compLevel = 6;
+	private ExecutorService executor;
+	private Stripe[] stripes = new Stripe[0];
+
+	/**
+	 * @param threadCount
+	 *            Number of encoding threads, 0 for the number of available processors
+	 */
+	public PngParallelEncoder(int threadCount) {
+		if (!isAvailable())
+			throw new PngjUnsupportedException("Deflater sync flush not available (requires Java 7)");
+		this.threadCount = threadCount > 0 ? threadCount : Runtime.getRuntime().availableProcessors();
+	}
+
+	public int getThreadCount() {
+		return threadCount;
+	}
+
+	/**
+	 * Sets compression level of ZIP algorithm, between 0 and 9 (default: 6)
+	 */
+	public synchronized void setCompLevel(int compLevel) {
+		if (compLevel < 0 || compLevel > 9)
+			throw new PngjException("Compression level invalid (" + compLevel + ") Must be 0..9");
+		this.compLevel = compLevel;
+	}
+
+	/**
+	 * Encodes all rows of the image and writes them as IDAT chunks to <code>os</code>.
+	 * <p>
+	 * Images are encoded one at a time, the stripes of one image concurrently.
+	 */
+	public synchronized void encode(ImageInfo imgInfo, RowSource src, OutputStream os) {
+		final int n = Math.max(1, Math.min(threadCount, imgInfo.rows / MIN_STRIPE_ROWS));
+		if (stripes.length < n) {
+			final Stripe[] tmp = new Stripe[n];
+			System.arraycopy(stripes, 0, tmp, 0, stripes.length);
+			for (int i = stripes.length; i < n; i++)
+				tmp[i] = new Stripe();
+			stripes = tmp;
+		}
+		if (executor == null)
+			executor = Executors.newFixedThreadPool(threadCount, new EncoderThreadFactory());
+		final Future<?>[] futures = new Future<?>[n];
+		for (int i = 0; i < n; i++) {
+			stripes[i].set(imgInfo, src, compLevel, (int) ((long) imgInfo.rows * i / n),
+					(int) ((long) imgInfo.rows * (i + 1) / n), i == 0, i == n - 1);
+			futures[i] = executor.submit(stripes[i]);
+		}
+		long adler = 1;
+		try {
+			for (int i = 0; i < n; i++) {
+				futures[i].get();
+				final Stripe s = stripes[i];
+				adler = adler32Combine(adler, s.adler.getValue(), s.inLen);
+				if (i == 0) {
+					// zlib header: deflate w/ 32K window, level hint
+					final int cmf = 0x78;
+					int flg = (compLevel < 2 ? 0 : compLevel < 6 ? 1 : compLevel == 6 ? 2 : 3) << 6;
+					flg += 31 - ((cmf << 8) + flg) % 31;
+					s.out[0] = (byte) cmf;
+					s.out[1] = (byte) flg;
+				}
+				if (i == n - 1) {
+					s.ensureSpace(4);
+					PngHelper.writeInt4tobytes((int) adler, s.out, s.outLen);
+					s.outLen += 4;
+				}
+				ChunkRaw c = new ChunkRaw(s.outLen, ChunkHelper.b_IDAT, false);
+				c.data = s.out;
+				c.writeChunk(os);
+			}
+		} catch (InterruptedException e) {
+			throw new PngjOutputException(e);
+		} catch (ExecutionException e) {
+			throw new PngjOutputException(e.getCause());
+		} finally {
+			for (int i = 0; i < n; i++) {
+				try {
+					futures[i].get(); // never leave a stripe in use
+				} catch (Exception e) {
+				}
+				stripes[i].src = null;
+			}
+		}
+	}
+
+	/**
+	 * Stops the threads and releases the deflaters and buffers.
+	 */
+	public synchronized void dispose() {
+		if (executor != null) {
+			executor.shutdown();
+			executor = null;
+		}
+		for (Stripe s : stripes)
+			s.dispose();
+		stripes = new Stripe[0];
+	}
+
+	/**
+	 * Adler32 of the concatenation of two byte sequences, see zlib's adler32_combine()
+	 */
+	static long adler32Combine(long adler1, long adler2, long len2) {
+		final long BASE = 65521;
+		final long rem = len2 % BASE;
+		long sum1 = adler1 & 0xffff;
+		long sum2 = (rem * sum1) % BASE;
+		sum1 += (adler2 & 0xffff) + BASE - 1;
+		sum2 += ((adler1 >> 16) & 0xffff) + ((adler2 >> 16) & 0xffff) + BASE - rem;
+		if (sum1 >= BASE)
+			sum1 -= BASE;
+		if (sum1 >= BASE)
+			sum1 -= BASE;
+		if (sum2 >= (BASE << 1))
+			sum2 -= (BASE << 1);
+		if (sum2 >= BASE)
+			sum2 -= BASE;
+		return sum1 | (sum2 << 16);
+	}
+
+	private static class EncoderThreadFactory implements ThreadFactory {
+		private int count = 0;
+
+		public synchronized Thread newThread(Runnable r) {
+			Thread t = new Thread(r, "PngParallelEncoder-" + (count++));
+			t.setDaemon(true);
+			return t;
+		}
+	}
+
+	/**
+	 * Filters and deflates the rows [row0, row1) into a raw deflate stream
+	 */
+	private static class Stripe implements Callable<Object> {
+		private Deflater deflater;
+		private int deflaterLevel = -1;
+		final Adler32 adler = new Adler32();
+		// rows with filter type at index 0, as in PngWriter
+		private byte[] rowb = new byte[0];
+		private byte[] rowbprev = new byte[0];
+		private byte[][] rowbfilter = new byte[5][0]; // one per filter type
+		byte[] out = new byte[0];
+		int outLen;
+		long inLen;
+
+		private ImageInfo imgInfo;
+		RowSource src;
+		private int level, row0, row1;
+		private boolean first, last;
+
+		void set(ImageInfo imgInfo, RowSource src, int level, int row0, int row1, boolean first, boolean last) {
+			this.imgInfo = imgInfo;
+			this.src = src;
+			this.level = level;
+			this.row0 = row0;
+			this.row1 = row1;
+			this.first = first;
+			this.last = last;
+		}
+
+		public Object call() {
+			final int len = imgInfo.bytesPerRow;
+			if (rowb.length < len + 1) {
+				rowb = new byte[len + 1];
+				rowbprev = new byte[len + 1];
+				for (int i = 0; i < rowbfilter.length; i++)
+					rowbfilter[i] = new byte[len + 1];
+				out = new byte[Math.max(len, 1024)];
+			}
+			if (deflater == null || deflaterLevel != level) {
+				if (deflater != null)
+					deflater.end();
+				deflater = new Deflater(level, true);
+				deflater.setStrategy(Deflater.FILTERED);
+				deflaterLevel = level;
+			} else {
+				deflater.reset();
+			}
+			adler.reset();
+			inLen = 0;
+			outLen = first ? 2 : 0; // room for zlib header
+			// filters of the first row refer to the last row of the previous stripe
+			if (row0 > 0)
+				src.getRow(row0 - 1, rowbprev, 1);
+			else
+				Arrays.fill(rowbprev, (byte) 0);
+			for (int r = row0; r < row1; r++) {
+				src.getRow(r, rowb, 1);
+				final byte[] f = filterRow(len);
+				adler.update(f, 0, len + 1);
+				inLen += len + 1;
+				deflater.setInput(f, 0, len + 1);
+				while (!deflater.needsInput()) {
+					ensureSpace(1);
+					outLen += deflater.deflate(out, outLen, out.length - outLen);
+				}
+				byte[] tmp = rowb;
+				rowb = rowbprev;
+				rowbprev = tmp;
+			}
+			if (last) {
+				deflater.finish();
+				while (!deflater.finished()) {
+					ensureSpace(1);
+					outLen += deflater.deflate(out, outLen, out.length - outLen);
+				}
+			} else {
+				int n, space;
+				do { // until the output buffer is not filled completely
+					ensureSpace(64);
+					space = out.length - outLen;
+					n = deflateSyncFlush(space);
+					outLen += n;
+				} while (n == space);
+			}
+			return null;
+		}
+
+		private int deflateSyncFlush(int space) {
+			try {
+				return ((Integer) deflateFlush.invoke(deflater, out, outLen, space, SYNC_FLUSH)).intValue();
+			} catch (Exception e) {
+				throw new PngjOutputException(e);
+			}
+		}
+
+		void ensureSpace(int n) {
+			if (out.length - outLen < n) {
+				byte[] tmp = new byte[Math.max(out.length * 2, outLen + n)];
+				System.arraycopy(out, 0, tmp, 0, outLen);
+				out = tmp;
+			}
+		}
+
+		/**
+		 * Filters rowb with all filter types, returns the one with the minimum sum of absolute differences
+		 */
+		private byte[] filterRow(int len) {
+			final int bpp = imgInfo.bytesPixel;
+			final byte[] cur = rowb, prev = rowbprev;
+			int best = 0;
+			long bestSum = Long.MAX_VALUE;
+			for (int ft = 0; ft < 5; ft++) {
+				final byte[] f = rowbfilter[ft];
+				f[0] = (byte) ft;
+				long sum = 0;
+				int i, j;
+				switch (ft) {
+				case 0: // none
+					System.arraycopy(cur, 1, f, 1, len);
+					for (i = 1; i <= len; i++)
+						sum += Math.abs(f[i]);
+					break;
+				case 1: // sub
+					for (i = 1; i <= bpp; i++) {
+						f[i] = cur[i];
+						sum += Math.abs(f[i]);
+					}
+					for (j = 1, i = bpp + 1; i <= len; i++, j++) {
+						f[i] = (byte) (cur[i] - cur[j]);
+						sum += Math.abs(f[i]);
+					}
+					break;
+				case 2: // up
+					for (i = 1; i <= len; i++) {
+						f[i] = (byte) (cur[i] - prev[i]);
+						sum += Math.abs(f[i]);
+					}
+					break;
+				case 3: // average
+					for (j = 1 - bpp, i = 1; i <= len; i++, j++) {
+						f[i] = (byte) (cur[i] - ((prev[i] & 0xFF) + (j > 0 ? (cur[j] & 0xFF) : 0)) / 2);
+						sum += Math.abs(f[i]);
+					}
+					break;
+				default: // paeth
+					for (j = 1 - bpp, i = 1; i <= len; i++, j++) {
+						f[i] = (byte) (cur[i] - FilterType.filterPaethPredictor(j > 0 ? (cur[j] & 0xFF) : 0,
+								prev[i] & 0xFF, j > 0 ? (prev[j] & 0xFF) : 0));
+						sum += Math.abs(f[i]);
+					}
+					break;
+				}
+				if (sum < bestSum) {
+					bestSum = sum;
+					best = ft;
+				}
+			}
+			return rowbfilter[best];
+		}
+
+		void dispose() {
+			if (deflater != null) {
+				deflater.end();
+				deflater = null;
+			}
+		}
+	}
+}
@@ -40,6 +40,11 @@ public class PngReader {
 
 	protected ImageLine imgLine;
 
+	/**
+	 * Sub image geometry of an interlaced image, null if not interlaced
+	 */
+	protected final PngDeinterlacer deinterlacer;
+
 	// line as bytes, counting from 1 (index 0 is reserved for filter type)
 	protected byte[] rowb = null;
 	protected byte[] rowbprev = null; // rowb previous
@@ -94,8 +99,9 @@ public class PngReader {
 		boolean grayscale = (ihdr.getColormodel() == 0 || ihdr.getColormodel() == 4);
 		imgInfo = new ImageInfo(ihdr.getCols(), ihdr.getRows(), ihdr.getBitspc(), alpha, grayscale, palette);
 		imgLine = new ImageLine(imgInfo);
-		if (ihdr.getInterlaced() != 0)
-			throw new PngjUnsupportedException("PNG interlaced not supported by this library");
+		if (ihdr.getInterlaced() != 0 && ihdr.getInterlaced() != 1)
+			throw new PngjInputException("Invalid interlace method " + ihdr.getInterlaced());
+		deinterlacer = ihdr.getInterlaced() == 1 ? new PngDeinterlacer(imgInfo) : null;
 		if (ihdr.getFilmeth() != 0 || ihdr.getCompmeth() != 0)
 			throw new PngjInputException("compmethod o filtermethod unrecognized");
 		if (ihdr.getColormodel() < 0 || ihdr.getColormodel() > 6 || ihdr.getColormodel() == 1
@@ -266,6 +272,8 @@ public class PngReader {
 	 * @return The scanline in the same passwd buffer if it was allocated, a newly allocated one otherwise
 	 */
 	public int[] readRow(int[] buffer, int nrow) {
+		if (deinterlacer != null)
+			throw new PngjUnsupportedException("PNG interlaced: use readRowRaw()");
 		if (nrow < 0 || nrow >= imgInfo.rows)
 			throw new PngjInputException("invalid line");
 		if (nrow != rowNum + 1)
@@ -275,17 +283,73 @@ public class PngReader {
 		rowNum++;
 		if (buffer == null || buffer.length < imgInfo.samplesPerRowP)
 			buffer = new int[imgInfo.samplesPerRowP];
+		readRowBytes(imgInfo.bytesPerRow, false);
+		convertRowFromBytes(buffer);
+		return buffer;
+	}
+
+	/**
+	 * Reads the next row as unfiltered bytes, exactly as the samples are laid out in the PNG stream: packed for
+	 * bitdepth 1-2-4, big endian for bitdepth 16, palette indices for indexed images.
+	 * <p>
+	 * Rows are read in stream order. For interlaced images these are the rows of the 7 sub images, pass by pass; see
+	 * <code>getDeinterlacer()</code> for the geometry of the row just read.
+	 * <p>
+	 * This avoids the conversion to an <code>int[]</code> scanline, see <code>readRow(int)</code>.
+	 * 
+	 * @return The internal row buffer, valid until the next read. The row data starts at index 1 (index 0 holds the
+	 *         filter type), its length is <code>imgInfo.bytesPerRow</code> or <code>getDeinterlacer().getBytesPerRow()</code>.
+	 */
+	public byte[] readRowRaw() {
+		if (firstChunksNotYetRead())
+			readFirstChunks();
+		final int len;
+		boolean newPass = false;
+		if (deinterlacer != null) {
+			final int pass = deinterlacer.getPass();
+			if (!deinterlacer.nextRow())
+				throw new PngjInputException("invalid line: all passes read");
+			newPass = pass != deinterlacer.getPass();
+			len = deinterlacer.getBytesPerRow();
+		} else {
+			if (rowNum + 1 >= imgInfo.rows)
+				throw new PngjInputException("invalid line: all rows read");
+			len = imgInfo.bytesPerRow;
+		}
+		rowNum++;
+		readRowBytes(len, newPass);
+		return rowb;
+	}
+
+	/**
+	 * Geometry of the row last read by <code>readRowRaw()</code> of an interlaced image.
+	 * 
+	 * @return null if the image is not interlaced
+	 */
+	public PngDeinterlacer getDeinterlacer() {
+		return deinterlacer;
+	}
+
+	public boolean isInterlaced() {
+		return deinterlacer != null;
+	}
+
+	/**
+	 * Reads and unfilters the next <code>len</code> bytes row into <code>rowb</code>. The previous row is treated as
+	 * zeros if <code>firstOfPass</code>.
+	 */
+	private void readRowBytes(int len, boolean firstOfPass) {
 		// swap
 		byte[] tmp = rowb;
 		rowb = rowbprev;
 		rowbprev = tmp;
+		if (firstOfPass)
+			Arrays.fill(rowbprev, (byte) 0);
 		// loads in rowbfilter "raw" bytes, with filter
-		PngHelper.readBytes(idatIstream, rowbfilter, 0, rowbfilter.length);
+		PngHelper.readBytes(idatIstream, rowbfilter, 0, len + 1);
 		rowb[0] = 0;
-		unfilterRow();
+		unfilterRow(len);
 		rowb[0] = rowbfilter[0];
-		convertRowFromBytes(buffer);
-		return buffer;
 	}
 
 	/**
@@ -319,65 +383,63 @@ public class PngReader {
 		}
 	}
 
-	private void unfilterRow() {
+	private void unfilterRow(int len) {
 		int ftn = rowbfilter[0];
 		FilterType ft = FilterType.getByVal(ftn);
 		if (ft == null)
 			throw new PngjInputException("Filter type " + ftn + " invalid");
 		switch (ft) {
 		case FILTER_NONE:
-			unfilterRowNone();
+			unfilterRowNone(len);
 			break;
 		case FILTER_SUB:
-			unfilterRowSub();
+			unfilterRowSub(len);
 			break;
 		case FILTER_UP:
-			unfilterRowUp();
+			unfilterRowUp(len);
 			break;
 		case FILTER_AVERAGE:
-			unfilterRowAverage();
+			unfilterRowAverage(len);
 			break;
 		case FILTER_PAETH:
-			unfilterRowPaeth();
+			unfilterRowPaeth(len);
 			break;
 		default:
 			throw new PngjInputException("Filter type " + ftn + " not implemented");
 		}
 	}
 
-	private void unfilterRowNone() {
-		for (int i = 1; i <= imgInfo.bytesPerRow; i++) {
-			rowb[i] = (byte) (rowbfilter[i]);
-		}
+	private void unfilterRowNone(int len) {
+		System.arraycopy(rowbfilter, 1, rowb, 1, len);
 	}
 
-	private void unfilterRowSub() {
+	private void unfilterRowSub(int len) {
 		int i, j;
 		for (i = 1; i <= imgInfo.bytesPixel; i++) {
 			rowb[i] = (byte) (rowbfilter[i]);
 		}
-		for (j = 1, i = imgInfo.bytesPixel + 1; i <= imgInfo.bytesPerRow; i++, j++) {
+		for (j = 1, i = imgInfo.bytesPixel + 1; i <= len; i++, j++) {
 			rowb[i] = (byte) (rowbfilter[i] + rowb[j]);
 		}
 	}
 
-	private void unfilterRowUp() {
-		for (int i = 1; i <= imgInfo.bytesPerRow; i++) {
+	private void unfilterRowUp(int len) {
+		for (int i = 1; i <= len; i++) {
 			rowb[i] = (byte) (rowbfilter[i] + rowbprev[i]);
 		}
 	}
 
-	private void unfilterRowAverage() {
+	private void unfilterRowAverage(int len) {
 		int i, j, x;
-		for (j = 1 - imgInfo.bytesPixel, i = 1; i <= imgInfo.bytesPerRow; i++, j++) {
+		for (j = 1 - imgInfo.bytesPixel, i = 1; i <= len; i++, j++) {
 			x = j > 0 ? (rowb[j] & 0xff) : 0;
 			rowb[i] = (byte) (rowbfilter[i] + (x + (rowbprev[i] & 0xFF)) / 2);
 		}
 	}
 
-	private void unfilterRowPaeth() {
+	private void unfilterRowPaeth(int len) {
 		int i, j, x, y;
-		for (j = 1 - imgInfo.bytesPixel, i = 1; i <= imgInfo.bytesPerRow; i++, j++) {
+		for (j = 1 - imgInfo.bytesPixel, i = 1; i <= len; i++, j++) {
 			x = j > 0 ? (rowb[j] & 0xFF) : 0;
 			y = j > 0 ? (rowbprev[j] & 0xFF) : 0;
 			rowb[i] = (byte) (rowbfilter[i] + FilterType.filterPaethPredictor(x, rowbprev[i] & 0xFF, y));
@@ -42,6 +42,7 @@ public class PngWriter {
 
 	private PngIDatChunkOutputStream datStream;
 	private DeflaterOutputStream datStreamDeflated;
+	private boolean rowsWrittenParallel = false;
 
 	private final ChunkList chunkList;
 	private final PngMetadata metadata; // high level wrapper over chunkList
@@ -82,11 +83,6 @@ public class PngWriter {
 	 */
 	private void writeSignatureAndIHDR() {
 		currentChunkGroup = ChunkList.CHUNK_GROUP_0_IDHR;
-		if (datStreamDeflated == null) {
-			Deflater def = new Deflater(compLevel);
-			def.setStrategy(deflaterStrategy);
-			datStreamDeflated = new DeflaterOutputStream(datStream, def, 8192);
-		}
 		PngHelper.writeBytes(os, PngHelper.pngIdBytes); // signature
 		PngChunkIHDR ihdr = new PngChunkIHDR(imgInfo);
 		// http://www.libpng.org/pub/png/spec/1.2/PNG-Chunks.html
@@ -155,6 +151,11 @@ public class PngWriter {
 			writeSignatureAndIHDR();
 			writeFirstChunks();
 		}
+		if (datStreamDeflated == null) {
+			Deflater def = new Deflater(compLevel);
+			def.setStrategy(deflaterStrategy);
+			datStreamDeflated = new DeflaterOutputStream(datStream, def, 8192);
+		}
 		if (rown < -1 || rown > imgInfo.rows)
 			throw new RuntimeException("invalid value for row " + rown);
 		rowNum++;
@@ -201,6 +202,28 @@ public class PngWriter {
 		writeRow(imgline.scanline, imgline.getRown());
 	}
 
+	/**
+	 * Writes all rows at once, filtered and deflated in parallel by the given encoder (see
+	 * <code>PngParallelEncoder</code>), instead of calling <code>writeRow()</code> for each row.
+	 * <p>
+	 * The filter type is chosen per row by the encoder, i.e. <code>setFilterType()</code> is ignored. The compression
+	 * level of the encoder is used.
+	 * 
+	 * @param encoder
+	 *            Encoder, may be reused for many images
+	 * @param src
+	 *            Provides the rows as raw bytes
+	 */
+	public void writeRowsParallel(PngParallelEncoder encoder, PngParallelEncoder.RowSource src) {
+		if (rowNum != -1)
+			throw new PngjOutputException("rows already written");
+		writeSignatureAndIHDR();
+		writeFirstChunks();
+		encoder.encode(imgInfo, src, os);
+		rowNum = imgInfo.rows - 1;
+		rowsWrittenParallel = true;
+	}
+
 	/**
 	 * Finalizes the image creation and closes the stream. This MUST be called after writing the lines.
 	 */
@@ -208,8 +231,10 @@ public class PngWriter {
 		if (rowNum != imgInfo.rows - 1)
 			throw new PngjOutputException("all rows have not been written");
 		try {
-			datStreamDeflated.finish();
-			datStream.flush();
+			if (!rowsWrittenParallel) {
+				datStreamDeflated.finish();
+				datStream.flush();
+			}
 			writeLastChunks();
 			writeEndChunk();
 			os.close();
@@ -345,7 +370,7 @@ public class PngWriter {
 	}
 
 	/**
-	 * Sets internal prediction filter type, or strategy to choose it.
+	 * Sets internal prediction filter type, or strategy to choose it. Not used by <code>writeRowsParallel()</code>.
 	 * <p>
 	 * This must be called just after constructor, before starting writing.
 	 * <p>
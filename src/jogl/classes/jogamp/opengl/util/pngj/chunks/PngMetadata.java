@@ -132,4 +132,16 @@ public class PngMetadata {
 		return c != null ? ((PngChunkTextVar) c).getVal() : null;
 	}
 
+	// //////////// Palette and transparency
+
+	/** returns null if not found */
+	public PngChunkPLTE getPLTE() {
+		return (PngChunkPLTE) getChunk1(ChunkHelper.PLTE);
+	}
+
+	/** returns null if not found */
+	public PngChunkTRNS getTRNS() {
+		return (PngChunkTRNS) getChunk1(ChunkHelper.tRNS);
+	}
+
 }
@@ -2,48 +2,33 @@
 #include <stdlib.h>
 #include <mmsystem.h>
 #include <mmreg.h>
-#include "com_jogamp_audio_windows_waveout_Mixer.h"
+#include "com_jogamp_audio_windows_waveout_WaveOutSink.h"
 
 static HANDLE event = NULL;
 static HWAVEOUT output = NULL;
-// We use only two buffers to keep latency down
-#define NUM_BUFFERS 2
-//#define NUM_BUFFERS 4
-// This is about 20 ms of data for WAVE_FORMAT_PCM:
-// (44100 samples / sec) * (20 ms / 1000 ms) * (2 bytes / sample) * (2 channels)
-//#define BUFFER_SIZE 3528
-
-// This is about 50 ms of data for WAVE_FORMAT_PCM:
-// (44100 samples / sec) * (50 ms / 1000 ms) * (2 bytes / sample) * (1 channel)
-//#define BUFFER_SIZE 4410
-
-// This is about 200 ms of data for WAVE_FORMAT_PCM:
-// (44100 samples / sec) * (200 ms / 1000 ms) * (2 bytes / sample) * (1 channel)
-//#define BUFFER_SIZE 17640
-
-// This is about 200 ms of data for WAVE_FORMAT_PCM:
-// (44100 samples / sec) * (200 ms / 1000 ms) * (2 bytes / sample) * (2 channel)
-//#define BUFFER_SIZE 35280
-
-// This is about 1000 ms of data for WAVE_FORMAT_PCM:
-// (44100 samples / sec) * (1000 ms / 1000 ms) * (2 bytes / sample) * (1 channel)
-//#define BUFFER_SIZE 88200
-
-// This is about 50 ms of data for WAVE_FORMAT_PCM:
-// (44100 samples / sec) * (50 ms / 1000 ms) * (2 bytes / sample) * (2 channels)
-//#define BUFFER_SIZE 8820
-
-// This is about 50 ms of data for WAVE_FORMAT_IEEE_FLOAT:
-// (44100 samples / sec) * (50 ms / 1000 ms) * (4 bytes / sample) * (2 channels)
-//#define BUFFER_SIZE 17640
-
-// This is about 200 ms of data for WAVE_FORMAT_PCM:
-// (11025 samples / sec) * (200 ms / 1000 ms) * (2 bytes / sample) * (2 channel)
-#define BUFFER_SIZE 8820
-
-//#define BUFFER_SIZE 8192
+// Number and size of the queued buffers, i.e. one period each,
+// as configured by the Java Mixer, see initializeWaveOut.
+// E.g. 4 buffers of 1024 frames of 16 bit stereo at 44.1 kHz:
+// (1024 samples) * (2 bytes / sample) * (2 channels) = 4096 bytes, about 23 ms
+// summing up to about 93 ms of latency.
+static int numBuffers = 0;
 static WAVEHDR** buffers = NULL;
 
+static void freeBuffers()
+{
+    if (buffers != NULL) {
+        for (int i = 0; i < numBuffers; i++) {
+            if (buffers[i] != NULL) {
+                free(buffers[i]->lpData);
+                free(buffers[i]);
+            }
+        }
+        free(buffers);
+        buffers = NULL;
+    }
+    numBuffers = 0;
+}
+
 void CALLBACK playbackCallback(HWAVEOUT output,
                                UINT msg,
                                DWORD_PTR userData,
@@ -57,21 +42,17 @@ void CALLBACK playbackCallback(HWAVEOUT output,
     }
 }
 
-JNIEXPORT jboolean JNICALL Java_com_jogamp_audio_windows_waveout_Mixer_initializeWaveOut
-  (JNIEnv *env, jclass unused, jlong eventObject)
+JNIEXPORT jboolean JNICALL Java_com_jogamp_audio_windows_waveout_WaveOutSink_initializeWaveOut
+  (JNIEnv *env, jclass unused, jlong eventObject, jint sampleRate, jint channels, jint bufferSize, jint bufferCount)
 {
     event = (HANDLE) eventObject;
 
-    // Note the hard requirements on the RawSoundConverter's output format
+    // Signed 16 bit PCM as produced by the Java Mixer
     WAVEFORMATEX format;
     format.wFormatTag = WAVE_FORMAT_PCM;
-    //    format.wFormatTag = WAVE_FORMAT_IEEE_FLOAT;
-    format.nChannels = 2;
-    //    format.nChannels = 1;
-    //    format.nSamplesPerSec = 44100;
-    format.nSamplesPerSec = 11025;
+    format.nChannels = channels;
+    format.nSamplesPerSec = sampleRate;
     format.wBitsPerSample = 16;
-    //    format.wBitsPerSample = 32;
     format.nBlockAlign = format.nChannels * format.wBitsPerSample / 8;
     format.nAvgBytesPerSec = format.nBlockAlign * format.nSamplesPerSec;
     format.cbSize = 0;
@@ -85,12 +66,14 @@ JNIEXPORT jboolean JNICALL Java_com_jogamp_audio_windows_waveout_Mixer_initializ
         return JNI_FALSE;
     }
 
-    buffers = (WAVEHDR**) calloc(NUM_BUFFERS, sizeof(WAVEHDR));
-    for (int i = 0; i < NUM_BUFFERS; i++) {
-        char* data = (char*) calloc(BUFFER_SIZE, 1);
+    freeBuffers();
+    numBuffers = bufferCount;
+    buffers = (WAVEHDR**) calloc(numBuffers, sizeof(WAVEHDR*));
+    for (int i = 0; i < numBuffers; i++) {
+        char* data = (char*) calloc(bufferSize, 1);
         WAVEHDR* hdr = (WAVEHDR*) calloc(1, sizeof(WAVEHDR));
         hdr->lpData = data;
-        hdr->dwBufferLength = BUFFER_SIZE;
+        hdr->dwBufferLength = bufferSize;
         hdr->dwFlags |= WHDR_DONE;
         buffers[i] = hdr;
     }
@@ -98,7 +81,7 @@ JNIEXPORT jboolean JNICALL Java_com_jogamp_audio_windows_waveout_Mixer_initializ
     return JNI_TRUE;
 }
 
-JNIEXPORT void JNICALL Java_com_jogamp_audio_windows_waveout_Mixer_shutdownWaveOut
+JNIEXPORT void JNICALL Java_com_jogamp_audio_windows_waveout_WaveOutSink_shutdownWaveOut
   (JNIEnv *env, jclass unused)
 {
     //    writeString("Pausing\n");
@@ -106,14 +89,18 @@ JNIEXPORT void JNICALL Java_com_jogamp_audio_windows_waveout_Mixer_shutdownWaveO
     //    writeString("Resetting\n");
     waveOutReset(output);
     //    writeString("Closing output\n");
+    for (int i = 0; i < numBuffers; i++) {
+        waveOutUnprepareHeader(output, buffers[i], sizeof(WAVEHDR));
+    }
     waveOutClose(output);
+    freeBuffers();
 }
 
-JNIEXPORT jlong JNICALL Java_com_jogamp_audio_windows_waveout_Mixer_getNextMixerBuffer
+JNIEXPORT jlong JNICALL Java_com_jogamp_audio_windows_waveout_WaveOutSink_getNextMixerBuffer
   (JNIEnv *env, jclass unused)
 {
     WAVEHDR* hdr = NULL;
-    for (int i = 0; i < NUM_BUFFERS; i++) {
+    for (int i = 0; i < numBuffers; i++) {
         if (buffers[i] != NULL && ((buffers[i]->dwFlags & WHDR_DONE) != 0)) {
             hdr = buffers[i];
             hdr->dwFlags &= ~WHDR_DONE;
@@ -123,28 +110,28 @@ JNIEXPORT jlong JNICALL Java_com_jogamp_audio_windows_waveout_Mixer_getNextMixer
     return (jlong) hdr;
 }
 
-JNIEXPORT jobject JNICALL Java_com_jogamp_audio_windows_waveout_Mixer_getMixerBufferData
+JNIEXPORT jobject JNICALL Java_com_jogamp_audio_windows_waveout_WaveOutSink_getMixerBufferData
   (JNIEnv *env, jclass unused, jlong mixerBuffer)
 {
     WAVEHDR* hdr = (WAVEHDR*) mixerBuffer;
     return env->NewDirectByteBuffer(hdr->lpData, hdr->dwBufferLength);
 }
 
-JNIEXPORT jlong JNICALL Java_com_jogamp_audio_windows_waveout_Mixer_getMixerBufferDataAddress
+JNIEXPORT jlong JNICALL Java_com_jogamp_audio_windows_waveout_WaveOutSink_getMixerBufferDataAddress
   (JNIEnv *env, jclass unused, jlong mixerBuffer)
 {
     WAVEHDR* hdr = (WAVEHDR*) mixerBuffer;
     return (jlong) hdr->lpData;
 }
 
-JNIEXPORT jint JNICALL Java_com_jogamp_audio_windows_waveout_Mixer_getMixerBufferDataCapacity
+JNIEXPORT jint JNICALL Java_com_jogamp_audio_windows_waveout_WaveOutSink_getMixerBufferDataCapacity
   (JNIEnv *env, jclass unused, jlong mixerBuffer)
 {
     WAVEHDR* hdr = (WAVEHDR*) mixerBuffer;
     return (jint) hdr->dwBufferLength;
 }
 
-JNIEXPORT jboolean JNICALL Java_com_jogamp_audio_windows_waveout_Mixer_prepareMixerBuffer
+JNIEXPORT jboolean JNICALL Java_com_jogamp_audio_windows_waveout_WaveOutSink_prepareMixerBuffer
   (JNIEnv *env, jclass unused, jlong mixerBuffer)
 {
     MMRESULT res = waveOutPrepareHeader(output,
@@ -156,7 +143,7 @@ JNIEXPORT jboolean JNICALL Java_com_jogamp_audio_windows_waveout_Mixer_prepareMi
     return JNI_FALSE;
 }
 
-JNIEXPORT jboolean JNICALL Java_com_jogamp_audio_windows_waveout_Mixer_writeMixerBuffer
+JNIEXPORT jboolean JNICALL Java_com_jogamp_audio_windows_waveout_WaveOutSink_writeMixerBuffer
   (JNIEnv *env, jclass unused, jlong mixerBuffer)
 {
     MMRESULT res = waveOutWrite(output,
@@ -170,13 +157,13 @@ JNIEXPORT jboolean JNICALL Java_com_jogamp_audio_windows_waveout_Mixer_writeMixe
     return JNI_FALSE;
 }
 
-JNIEXPORT jlong JNICALL Java_com_jogamp_audio_windows_waveout_Mixer_CreateEvent
+JNIEXPORT jlong JNICALL Java_com_jogamp_audio_windows_waveout_WaveOutSink_CreateEvent
   (JNIEnv *env, jclass unused)
 {
     return (jlong) CreateEvent(NULL, FALSE, TRUE, NULL);
 }
 
-JNIEXPORT jboolean JNICALL Java_com_jogamp_audio_windows_waveout_Mixer_WaitForSingleObject
+JNIEXPORT jboolean JNICALL Java_com_jogamp_audio_windows_waveout_WaveOutSink_WaitForSingleObject
   (JNIEnv *env, jclass unused, jlong eventObject)
 {
     DWORD res = WaitForSingleObject((HANDLE) eventObject, INFINITE);
@@ -186,13 +173,13 @@ JNIEXPORT jboolean JNICALL Java_com_jogamp_audio_windows_waveout_Mixer_WaitForSi
     return JNI_FALSE;
 }
 
-JNIEXPORT void JNICALL Java_com_jogamp_audio_windows_waveout_Mixer_SetEvent
+JNIEXPORT void JNICALL Java_com_jogamp_audio_windows_waveout_WaveOutSink_SetEvent
   (JNIEnv *env, jclass unused, jlong eventObject)
 {
     SetEvent((HANDLE) eventObject);
 }
 
-JNIEXPORT void JNICALL Java_com_jogamp_audio_windows_waveout_Mixer_CloseHandle
+JNIEXPORT void JNICALL Java_com_jogamp_audio_windows_waveout_WaveOutSink_CloseHandle
   (JNIEnv *env, jclass unused, jlong eventObject)
 {
     CloseHandle((HANDLE) eventObject);
@@ -47,6 +47,7 @@
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 /**
  *  AV_TIME_BASE   1000000
@@ -59,6 +60,20 @@ static inline float my_av_q2f(AVRational a){
 static inline int32_t my_av_q2i32(int32_t snum, AVRational a){
     return (snum * a.num) / a.den;
 }
+/** Converts the given pts in time_base units to msec, w/o loosing the fraction of time_base. */
+static inline int32_t my_av_pts2ms(int64_t pts, AVRational time_base){
+    return (int32_t) ( ( pts * 1000 * time_base.num ) / time_base.den );
+}
+/** Converts the given msec to pts in time_base units, inverse of my_av_pts2ms(). */
+static inline int64_t my_av_ms2pts(int32_t ms, AVRational time_base){
+    return ( (int64_t)ms * time_base.den ) / ( 1000 * (int64_t)time_base.num );
+}
+
+/** Entry of the key frame index */
+typedef struct {
+    int64_t          ts;         // time_base units
+    int32_t          pts;        // msec
+} FFMPEGKeyFrame_t ;
 
 typedef struct {
     int32_t          verbose;
@@ -72,10 +87,23 @@ typedef struct {
     uint32_t         vBufferPlanes; // 1 for RGB*, 3 for YUV, ..
     uint32_t         vBitsPerPixel;
     uint32_t         vBytesPerPixelPerPlane;
+    uint32_t         vBitsPerComponent; // e.g. 8, 10 or 16
+    uint32_t         vLog2ChromaW;  // horizontal chroma subsampling
+    uint32_t         vLog2ChromaH;  // vertical chroma subsampling
     enum PixelFormat vPixFmt;    // native decoder fmt
     int32_t          vPTS;       // msec - overall last video PTS
     int32_t          vLinesize[3];  // decoded video linesize in bytes for each plane
     int32_t          vTexWidth[3];  // decoded video tex width in bytes for each plane
+    int32_t          vPlaneHeight[3]; // decoded video height in lines for each plane
+    int32_t          vTexX[3];      // x-offset in texels of each plane within the texture, set by Java
+    int32_t          vTexY[3];      // y-offset in lines of each plane within the texture, set by Java
+    int32_t          vFramePending; // 1 if the decoded video frame in pVFrame is not yet delivered, e.g. after seeking
+
+    FFMPEGKeyFrame_t* vKeyFrames;   // lazily populated index of demuxed video key frames, sorted by ts
+    int32_t          vKeyFrameCount;
+    int32_t          vKeyFrameCapacity;
+    int64_t          vKeyFrameIndexEnd; // ts up to which all key frames are indexed, i.e. demuxed contiguously from the start
+    int32_t          vKeyFrameIndexContiguous; // 1 if demuxing continues the contiguous indexed range
 
 
     int32_t          aid;
@@ -87,7 +115,12 @@ typedef struct {
     int32_t          aChannels;
     int32_t          aFrameSize;
     enum AVSampleFormat aSampleFmt; // native decoder fmt
-    int32_t          aPTS;       // msec - overall last audio PTS
+    int32_t          aPTS;       // msec - PTS of the PCM data in pABuffer
+    int32_t          aNextPTS;   // msec - expected PTS of the next decoded audio data, if packet has none
+    uint8_t*         pADecodeBuffer; // decode_audio3 output, AVCODEC_MAX_AUDIO_FRAME_SIZE bytes, lazily allocated
+    uint8_t*         pABuffer;   // decoded audio as interleaved signed 16bit PCM
+    int32_t          aBufferSize; // allocated size of pABuffer in bytes
+    int32_t          aDataSize;  // bytes of valid PCM data in pABuffer
 
     float            fps;        // frames per seconds
     int32_t          bps_stream; // bits per seconds
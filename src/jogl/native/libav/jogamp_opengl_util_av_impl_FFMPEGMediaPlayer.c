@@ -40,6 +40,7 @@ static const char * const ClazzNameFFMPEGMediaPlayer = "jogamp/opengl/util/av/im
 static jclass ffmpegMediaPlayerClazz = NULL;
 static jmethodID jni_mid_updateAttributes1 = NULL;
 static jmethodID jni_mid_updateAttributes2 = NULL;
+static jmethodID jni_mid_updateAttributes3 = NULL;
 
 #define HAS_FUNC(f) (NULL!=(f))
 
@@ -66,6 +67,7 @@ typedef void (APIENTRYP AV_FREE_PACKET)(AVPacket *pkt);
 typedef int (APIENTRYP AVCODEC_DECODE_AUDIO4)(AVCodecContext *avctx, AVFrame *frame, int *got_frame_ptr, AVPacket *avpkt);     // 53.25.0
 typedef int (APIENTRYP AVCODEC_DECODE_AUDIO3)(AVCodecContext *avctx, int16_t *samples, int *frame_size_ptr, AVPacket *avpkt);  // 52.23.0
 typedef int (APIENTRYP AVCODEC_DECODE_VIDEO2)(AVCodecContext *avctx, AVFrame *picture, int *got_picture_ptr, AVPacket *avpkt); // 52.23.0
+typedef void (APIENTRYP AVCODEC_FLUSH_BUFFERS)(AVCodecContext *avctx);
 
 static AVCODEC_CLOSE sp_avcodec_close;
 static AVCODEC_STRING sp_avcodec_string;
@@ -79,7 +81,8 @@ static AV_FREE_PACKET sp_av_free_packet;
 static AVCODEC_DECODE_AUDIO4 sp_avcodec_decode_audio4;    // 53.25.0
 static AVCODEC_DECODE_AUDIO3 sp_avcodec_decode_audio3;    // 52.23.0
 static AVCODEC_DECODE_VIDEO2 sp_avcodec_decode_video2;    // 52.23.0
-// count: 15
+static AVCODEC_FLUSH_BUFFERS sp_avcodec_flush_buffers;
+// count: 16
 
 // libavutil
 typedef void (APIENTRYP AV_FREE)(void *ptr);
@@ -87,7 +90,7 @@ typedef int (APIENTRYP AV_GET_BITS_PER_PIXEL)(const AVPixFmtDescriptor *pixdesc)
 static const AVPixFmtDescriptor* sp_av_pix_fmt_descriptors;
 static AV_FREE sp_av_free;
 static AV_GET_BITS_PER_PIXEL sp_av_get_bits_per_pixel;
-// count: 18
+// count: 19
 
 // libavformat
 typedef AVFormatContext *(APIENTRYP AVFORMAT_ALLOC_CONTEXT)(void);
@@ -117,9 +120,9 @@ static AVFORMAT_NETWORK_INIT sp_avformat_network_init;            // 53.13.0
 static AVFORMAT_NETWORK_DEINIT sp_avformat_network_deinit;        // 53.13.0
 static AVFORMAT_FIND_STREAM_INFO sp_avformat_find_stream_info;    // 53.3.0
 static AV_FIND_STREAM_INFO sp_av_find_stream_info;
-// count: 31
+// count: 32
 
-#define SYMBOL_COUNT 31
+#define SYMBOL_COUNT 32
 
 JNIEXPORT jboolean JNICALL Java_jogamp_opengl_util_av_impl_FFMPEGDynamicLibraryBundleInfo_initSymbols0
   (JNIEnv *env, jclass clazz, jobject jSymbols, jint count)
@@ -154,12 +157,13 @@ JNIEXPORT jboolean JNICALL Java_jogamp_opengl_util_av_impl_FFMPEGDynamicLibraryB
     sp_avcodec_decode_audio4 = (AVCODEC_DECODE_AUDIO4) (intptr_t) symbols[i++];
     sp_avcodec_decode_audio3 = (AVCODEC_DECODE_AUDIO3) (intptr_t) symbols[i++];
     sp_avcodec_decode_video2 = (AVCODEC_DECODE_VIDEO2) (intptr_t) symbols[i++];
-    // count: 15
+    sp_avcodec_flush_buffers = (AVCODEC_FLUSH_BUFFERS) (intptr_t) symbols[i++];
+    // count: 16
 
     sp_av_pix_fmt_descriptors = (const AVPixFmtDescriptor*)  (intptr_t) symbols[i++];
     sp_av_free = (AV_FREE) (intptr_t) symbols[i++];
     sp_av_get_bits_per_pixel = (AV_GET_BITS_PER_PIXEL) (intptr_t) symbols[i++];
-    // count: 18
+    // count: 19
 
     sp_avformat_alloc_context = (AVFORMAT_ALLOC_CONTEXT) (intptr_t) symbols[i++];;
     sp_avformat_free_context = (AVFORMAT_FREE_CONTEXT) (intptr_t) symbols[i++];
@@ -174,7 +178,7 @@ JNIEXPORT jboolean JNICALL Java_jogamp_opengl_util_av_impl_FFMPEGDynamicLibraryB
     sp_avformat_network_deinit = (AVFORMAT_NETWORK_DEINIT) (intptr_t) symbols[i++];
     sp_avformat_find_stream_info = (AVFORMAT_FIND_STREAM_INFO) (intptr_t) symbols[i++];
     sp_av_find_stream_info = (AV_FIND_STREAM_INFO) (intptr_t) symbols[i++];
-    // count: 31
+    // count: 32
 
     (*env)->ReleasePrimitiveArrayCritical(env, jSymbols, symbols, 0);
 
@@ -211,7 +215,11 @@ static void _updateJavaAttributes(JNIEnv *env, jobject instance, FFMPEGToolBasic
                                pAV->vPixFmt, pAV->vBufferPlanes, 
                                pAV->vBitsPerPixel, pAV->vBytesPerPixelPerPlane,
                                pAV->vLinesize[0], pAV->vLinesize[1], pAV->vLinesize[2],
-                               pAV->vTexWidth[0], pAV->vTexWidth[1], pAV->vTexWidth[2]);
+                               pAV->vTexWidth[0], pAV->vTexWidth[1], pAV->vTexWidth[2],
+                               pAV->vPlaneHeight[0], pAV->vPlaneHeight[1], pAV->vPlaneHeight[2],
+                               pAV->vBitsPerComponent, pAV->vLog2ChromaW, pAV->vLog2ChromaH);
+        (*env)->CallVoidMethod(env, instance, jni_mid_updateAttributes3,
+                               pAV->aSampleRate, pAV->aChannels);
         // JoglCommon_ReleaseJNIEnv (shallBeDetached);
     }
 }
@@ -243,6 +251,22 @@ static void freeInstance(FFMPEGToolBasicAV_t* pAV) {
             pAV->pAFrame = NULL;
         }
 
+        // Close the audio buffers
+        if(NULL != pAV->pADecodeBuffer) {
+            free(pAV->pADecodeBuffer);
+            pAV->pADecodeBuffer = NULL;
+        }
+        if(NULL != pAV->pABuffer) {
+            free(pAV->pABuffer);
+            pAV->pABuffer = NULL;
+        }
+
+        // Close the key frame index
+        if(NULL != pAV->vKeyFrames) {
+            free(pAV->vKeyFrames);
+            pAV->vKeyFrames = NULL;
+        }
+
         // Close the video file
         if(NULL != pAV->pFormatCtx) {
             if(HAS_FUNC(sp_avformat_close_input)) {
@@ -270,6 +294,183 @@ static int my_getPlaneCount(AVPixFmtDescriptor *pDesc) {
     return p+1;
 }
 
+/** Size in bytes of all planes of one decoded video frame, as copied by my_copyFrame(). */
+static int32_t my_getFrameSize(FFMPEGToolBasicAV_t* pAV) {
+    int32_t sz = 0;
+    int p;
+    for(p=0; p<3; p++) {
+        sz += pAV->vLinesize[p] * pAV->vPlaneHeight[p];
+    }
+    return sz;
+}
+
+/** Copies all planes of the last decoded video frame back to back into dst. */
+static void my_copyFrame(FFMPEGToolBasicAV_t* pAV, uint8_t * dst) {
+    int p, y;
+    for(p=0; p<3; p++) {
+        // FIXME: Libav Binary compatibility! JAU01
+        const uint8_t * src = pAV->pVFrame->data[p];
+        const int32_t srcLinesize = pAV->pVFrame->linesize[p];
+        const int32_t dstLinesize = pAV->vLinesize[p];
+        const int32_t h = pAV->vPlaneHeight[p];
+        if( NULL == src || 0 == h ) {
+            continue;
+        }
+        if( srcLinesize == dstLinesize ) {
+            memcpy(dst, src, dstLinesize * h);
+        } else {
+            const int32_t l = srcLinesize < dstLinesize ? srcLinesize : dstLinesize;
+            for(y=0; y<h; y++) {
+                memcpy(dst + y * dstLinesize, src + y * srcLinesize, l);
+            }
+        }
+        dst += dstLinesize * h;
+    }
+}
+
+/** Bytes per sample of the given packed or planar sample format, 0 if unknown. */
+static int32_t my_getBytesPerSample(enum AVSampleFormat fmt) {
+    switch(fmt) {
+        case AV_SAMPLE_FMT_U8:
+        case AV_SAMPLE_FMT_U8P:  return 1;
+        case AV_SAMPLE_FMT_S16:
+        case AV_SAMPLE_FMT_S16P: return 2;
+        case AV_SAMPLE_FMT_S32:
+        case AV_SAMPLE_FMT_S32P:
+        case AV_SAMPLE_FMT_FLT:
+        case AV_SAMPLE_FMT_FLTP: return 4;
+        case AV_SAMPLE_FMT_DBL:
+        case AV_SAMPLE_FMT_DBLP: return 8;
+        default:                 return 0;
+    }
+}
+
+static int my_isPlanarSampleFormat(enum AVSampleFormat fmt) {
+    return AV_SAMPLE_FMT_U8P <= fmt && fmt <= AV_SAMPLE_FMT_DBLP;
+}
+
+static inline int16_t my_clipS16(double v) {
+    return v >= 1.0 ? 32767 : ( v <= -1.0 ? -32768 : (int16_t) ( v * 32767.0 ) );
+}
+
+/**
+ * Converts <code>nb_samples</code> per channel of the given packed or planar samples 
+ * to interleaved signed 16bit PCM and appends them to pABuffer, growing it if required.
+ *
+ * @param planes a single plane for packed formats, otherwise one plane per channel
+ * @return number of appended bytes, or -1 if the sample format is not supported or memory is exhausted.
+ */
+static int32_t my_appendAudioS16(FFMPEGToolBasicAV_t* pAV, uint8_t ** planes, enum AVSampleFormat fmt, int32_t nb_samples) {
+    const int32_t channels = pAV->aChannels;
+    const int32_t bps = my_getBytesPerSample(fmt);
+    const int planar = my_isPlanarSampleFormat(fmt);
+    const int32_t size = nb_samples * channels * 2;
+    int16_t * dst;
+    int32_t i, c;
+
+    if( 0 == bps || 0 >= channels ) {
+        return -1;
+    }
+    if( pAV->aBufferSize < pAV->aDataSize + size ) {
+        const int32_t newSize = 2 * ( pAV->aDataSize + size );
+        uint8_t * newBuffer = realloc(pAV->pABuffer, newSize);
+        if( NULL == newBuffer ) {
+            return -1;
+        }
+        pAV->pABuffer = newBuffer;
+        pAV->aBufferSize = newSize;
+    }
+    dst = (int16_t *) ( pAV->pABuffer + pAV->aDataSize );
+
+    for(i=0; i<nb_samples; i++) {
+        for(c=0; c<channels; c++) {
+            const uint8_t * src = planar ? planes[c] + i * bps : planes[0] + ( i * channels + c ) * bps;
+            switch(fmt) {
+                case AV_SAMPLE_FMT_U8:
+                case AV_SAMPLE_FMT_U8P:  *dst++ = (int16_t) ( ( (int16_t) *src - 128 ) << 8 ); break;
+                case AV_SAMPLE_FMT_S16:
+                case AV_SAMPLE_FMT_S16P: *dst++ = *( (const int16_t *) src ); break;
+                case AV_SAMPLE_FMT_S32:
+                case AV_SAMPLE_FMT_S32P: *dst++ = (int16_t) ( *( (const int32_t *) src ) >> 16 ); break;
+                case AV_SAMPLE_FMT_FLT:
+                case AV_SAMPLE_FMT_FLTP: *dst++ = my_clipS16( *( (const float *) src ) ); break;
+                case AV_SAMPLE_FMT_DBL:
+                case AV_SAMPLE_FMT_DBLP: *dst++ = my_clipS16( *( (const double *) src ) ); break;
+                default: return -1;
+            }
+        }
+    }
+    pAV->aDataSize += size;
+    return size;
+}
+
+/**
+ * Decodes the given audio packet completely, appending the PCM data to pABuffer.
+ * Uses avcodec_decode_audio4 if available, otherwise avcodec_decode_audio3.
+ *
+ * @return 1 if PCM data has been decoded, otherwise 0.
+ */
+static jint my_decodeAudio(FFMPEGToolBasicAV_t* pAV, AVPacket * pPacket) {
+    AVPacket packet = *pPacket; // local copy, advanced while decoding
+    int32_t pts;
+    int frameFinished;
+    int len1;
+
+    pAV->aDataSize = 0;
+
+    // FIXME: Libav Binary compatibility! JAU01
+    if( AV_NOPTS_VALUE != packet.pts ) {
+        pts = my_av_pts2ms(packet.pts, pAV->pAStream->time_base);
+    } else {
+        pts = pAV->aNextPTS;
+    }
+
+    while( packet.size > 0 ) {
+        if(HAS_FUNC(sp_avcodec_decode_audio4)) {
+            frameFinished = 0;
+            len1 = sp_avcodec_decode_audio4(pAV->pACodecCtx, pAV->pAFrame, &frameFinished, &packet);
+            if( 0 <= len1 && frameFinished ) {
+                // FIXME: Libav Binary compatibility! JAU01
+                const enum AVSampleFormat fmt = pAV->pACodecCtx->sample_fmt;
+                uint8_t ** planes = NULL != pAV->pAFrame->extended_data ? pAV->pAFrame->extended_data : pAV->pAFrame->data;
+                if( 0 > my_appendAudioS16(pAV, planes, fmt, pAV->pAFrame->nb_samples) ) {
+                    break;
+                }
+            }
+        } else {
+            int data_size = AVCODEC_MAX_AUDIO_FRAME_SIZE;
+            if( NULL == pAV->pADecodeBuffer ) {
+                pAV->pADecodeBuffer = malloc(AVCODEC_MAX_AUDIO_FRAME_SIZE);
+                if( NULL == pAV->pADecodeBuffer ) {
+                    break;
+                }
+            }
+            len1 = sp_avcodec_decode_audio3(pAV->pACodecCtx, (int16_t *) pAV->pADecodeBuffer, &data_size, &packet);
+            if( 0 <= len1 && 0 < data_size ) {
+                // FIXME: Libav Binary compatibility! JAU01
+                const enum AVSampleFormat fmt = pAV->pACodecCtx->sample_fmt;
+                const int32_t bps = my_getBytesPerSample(fmt);
+                uint8_t * planes[1] = { pAV->pADecodeBuffer };
+                if( 0 == bps || 0 > my_appendAudioS16(pAV, planes, fmt, data_size / ( bps * pAV->aChannels ) ) ) {
+                    break;
+                }
+            }
+        }
+        if( len1 <= 0 ) {
+            // if error or nothing consumed, we skip the remaining packet
+            break;
+        }
+        packet.data += len1;
+        packet.size -= len1;
+    }
+    if( 0 < pAV->aDataSize ) {
+        pAV->aPTS = pts;
+        pAV->aNextPTS = pts + (int32_t) ( ( (int64_t) pAV->aDataSize * 1000 ) / ( 2 * pAV->aChannels * pAV->aSampleRate ) );
+        return 1;
+    }
+    return 0;
+}
+
 static int my_is_hwaccel_pix_fmt(enum PixelFormat pix_fmt) {
     return sp_av_pix_fmt_descriptors[pix_fmt].flags & PIX_FMT_HWACCEL;
 }
@@ -332,10 +533,12 @@ JNIEXPORT jboolean JNICALL Java_jogamp_opengl_util_av_impl_FFMPEGMediaPlayer_ini
     }
 
     jni_mid_updateAttributes1 = (*env)->GetMethodID(env, ffmpegMediaPlayerClazz, "updateAttributes", "(IIIIIFIILjava/lang/String;Ljava/lang/String;)V");
-    jni_mid_updateAttributes2 = (*env)->GetMethodID(env, ffmpegMediaPlayerClazz, "updateAttributes2", "(IIIIIIIIII)V");
+    jni_mid_updateAttributes2 = (*env)->GetMethodID(env, ffmpegMediaPlayerClazz, "updateAttributes2", "(IIIIIIIIIIIIIIII)V");
+    jni_mid_updateAttributes3 = (*env)->GetMethodID(env, ffmpegMediaPlayerClazz, "updateAttributes3", "(II)V");
 
     if(jni_mid_updateAttributes1 == NULL ||
-       jni_mid_updateAttributes2 == NULL) {
+       jni_mid_updateAttributes2 == NULL ||
+       jni_mid_updateAttributes3 == NULL) {
         return JNI_FALSE;
     }
     return JNI_TRUE;
@@ -538,6 +741,19 @@ JNIEXPORT void JNICALL Java_jogamp_opengl_util_av_impl_FFMPEGMediaPlayer_setStre
             AVPixFmtDescriptor pixDesc = sp_av_pix_fmt_descriptors[pAV->vPixFmt];
             pAV->vBitsPerPixel = sp_av_get_bits_per_pixel(&pixDesc);
             pAV->vBufferPlanes = my_getPlaneCount(&pixDesc);
+            pAV->vBitsPerComponent = pixDesc.comp[0].depth_minus1 + 1;
+            pAV->vLog2ChromaW = pixDesc.log2_chroma_w;
+            pAV->vLog2ChromaH = pixDesc.log2_chroma_h;
+            // FIXME: Libav Binary compatibility! JAU01
+            for(i=0; i<3; i++) {
+                if( 0 == i ) {
+                    pAV->vPlaneHeight[i] = pAV->pVCodecCtx->height;
+                } else if( i < pAV->vBufferPlanes ) {
+                    pAV->vPlaneHeight[i] = -((-pAV->pVCodecCtx->height) >> pixDesc.log2_chroma_h);
+                } else {
+                    pAV->vPlaneHeight[i] = 0;
+                }
+            }
         }
         pAV->pVFrame=sp_avcodec_alloc_frame();
         if( pAV->pVFrame == NULL ) {
@@ -550,7 +766,8 @@ JNIEXPORT void JNICALL Java_jogamp_opengl_util_av_impl_FFMPEGMediaPlayer_setStre
             if(1 == pAV->vBufferPlanes) {
                 pAV->vBytesPerPixelPerPlane = bytesPerPixel;
             } else {
-                pAV->vBytesPerPixelPerPlane = 1;
+                // 1 byte per component, or 2 for 9..16 bit components
+                pAV->vBytesPerPixelPerPlane = ( pAV->vBitsPerComponent + 7 ) / 8;
             }
             for(i=0; i<3; i++) {
                 // FIXME: Libav Binary compatibility! JAU01
@@ -564,116 +781,179 @@ JNIEXPORT void JNICALL Java_jogamp_opengl_util_av_impl_FFMPEGMediaPlayer_setStre
         }
     }
     pAV->vPTS=0;
+    pAV->vFramePending=0;
+    pAV->vKeyFrameIndexEnd=0;
+    pAV->vKeyFrameIndexContiguous=1;
     pAV->aPTS=0;
+    pAV->aNextPTS=0;
+    pAV->aDataSize=0;
     _updateJavaAttributes(env, instance, pAV);
 }
 
+JNIEXPORT void JNICALL Java_jogamp_opengl_util_av_impl_FFMPEGMediaPlayer_setTextureLayout0
+  (JNIEnv *env, jobject instance, jlong ptr, jint tX0, jint tX1, jint tX2, jint tY0, jint tY1, jint tY2)
+{
+    FFMPEGToolBasicAV_t *pAV = (FFMPEGToolBasicAV_t *)((void *)((intptr_t)ptr));
+    if (pAV == NULL) {
+        JoglCommon_throwNewRuntimeException(env, "NULL AV ptr");
+        return;
+    }
+    pAV->vTexX[0] = tX0; pAV->vTexX[1] = tX1; pAV->vTexX[2] = tX2;
+    pAV->vTexY[0] = tY0; pAV->vTexY[1] = tY1; pAV->vTexY[2] = tY2;
+}
+
+/** @return the index of the last indexed key frame with a ts lower or equal the given one, or -1 if none exists */
+static int32_t my_findKeyFrame(FFMPEGToolBasicAV_t* pAV, int64_t ts) {
+    int32_t lo = 0, hi = pAV->vKeyFrameCount;
+    while( lo < hi ) {
+        const int32_t mid = ( lo + hi ) / 2;
+        if( pAV->vKeyFrames[mid].ts <= ts ) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo - 1;
+}
+
+/** 
+ * Adds the given video packet to the key frame index, if it is a key frame and not yet indexed.
+ * Extends the contiguously indexed range while demuxing continues it.
+ */
+static void my_indexKeyFrame(FFMPEGToolBasicAV_t* pAV, AVPacket* pPacket) {
+    // FIXME: Libav Binary compatibility! JAU01
+    const int64_t ts = AV_NOPTS_VALUE != pPacket->pts ? pPacket->pts : pPacket->dts;
+    int32_t i;
+    if( AV_NOPTS_VALUE == ts ) {
+        return;
+    }
+    if( pAV->vKeyFrameIndexContiguous && ts > pAV->vKeyFrameIndexEnd ) {
+        pAV->vKeyFrameIndexEnd = ts;
+    }
+    if( 0 == ( pPacket->flags & AV_PKT_FLAG_KEY ) ) {
+        return;
+    }
+    i = my_findKeyFrame(pAV, ts);
+    if( 0 <= i && pAV->vKeyFrames[i].ts == ts ) {
+        return; // known
+    }
+    i++; // insertion index
+    if( pAV->vKeyFrameCount == pAV->vKeyFrameCapacity ) {
+        const int32_t capacity = 0 < pAV->vKeyFrameCapacity ? 2 * pAV->vKeyFrameCapacity : 256;
+        FFMPEGKeyFrame_t* keyFrames = realloc(pAV->vKeyFrames, capacity * sizeof(FFMPEGKeyFrame_t));
+        if( NULL == keyFrames ) {
+            return; // index stays incomplete, seeking falls back to the demuxer
+        }
+        pAV->vKeyFrames = keyFrames;
+        pAV->vKeyFrameCapacity = capacity;
+    }
+    memmove(pAV->vKeyFrames + i + 1, pAV->vKeyFrames + i, ( pAV->vKeyFrameCount - i ) * sizeof(FFMPEGKeyFrame_t));
+    pAV->vKeyFrames[i].ts = ts;
+    pAV->vKeyFrames[i].pts = my_av_pts2ms(ts, pAV->pVStream->time_base);
+    pAV->vKeyFrameCount++;
+}
+
+/** Updates vPTS from the last decoded video frame, estimated from the frame rate if the frame has no PTS. */
+static void my_updateVideoPTS(FFMPEGToolBasicAV_t* pAV) {
+    // FIXME: Libav Binary compatibility! JAU01
+    const AVRational time_base = pAV->pVStream->time_base;
+    const int64_t pts = pAV->pVFrame->pkt_pts;
+    if(AV_NOPTS_VALUE != pts) { // discard invalid PTS ..
+        pAV->vPTS = my_av_pts2ms(pts, time_base);
+
+        #if 0
+        printf("PTS %d = %ld * ( ( 1000 * %ld ) / %ld ) '1000 * time_base', time_base = %lf\n",
+            pAV->vPTS, pAV->pVFrame->pkt_pts, time_base.num, time_base.den, (time_base.num/(double)time_base.den));
+        #endif
+    } else if( 0 < pAV->fps ) {
+        pAV->vPTS += (int32_t) ( 1000.0f / pAV->fps );
+    }
+}
+
+/**
+ * Uploads the last decoded video frame into the bound texture of the current context, if procAddr is given,
+ * otherwise copies it into the given buffer.
+ * @return 0 if successful, otherwise a java exception is pending.
+ */
+static int my_deliverVideoFrame(JNIEnv *env, FFMPEGToolBasicAV_t* pAV, 
+                                PFNGLTEXSUBIMAGE2DPROC procAddrGLTexSubImage2D, jint texTarget, jint texFmt, jint texType, 
+                                jobject jVBuffer) {
+    #if 0
+    printf("copy codec %dx%d - frame %dx%d - width %d tex / %d linesize, pixfmt 0x%X\n", 
+             pAV->pVCodecCtx->width, pAV->pVCodecCtx->height, 
+             pAV->pVFrame->width, pAV->pVFrame->height, pAV->vTexWidth[0], pAV->pVFrame->linesize[0],
+             pAV->vPixFmt);
+    #endif
+
+    if( NULL != procAddrGLTexSubImage2D ) {
+        // Upload all planes as-is into the bound texture of the current (shared) context,
+        // see setTextureLayout0(). The conversion to RGB is performed by the lookup shader.
+        int p;
+        for(p=0; p<3 && p<pAV->vBufferPlanes; p++) {
+            // FIXME: Libav Binary compatibility! JAU01
+            procAddrGLTexSubImage2D(texTarget, 0, 
+                                    pAV->vTexX[p],     pAV->vTexY[p], 
+                                    pAV->vTexWidth[p], pAV->vPlaneHeight[p], 
+                                    texFmt, texType, pAV->pVFrame->data[p]);
+        }
+    } else if( NULL != jVBuffer ) {
+        // Copy all planes into the given frame buffer, 
+        // which is uploaded by the GL thread later on.
+        uint8_t * vBuffer = (uint8_t *) (*env)->GetDirectBufferAddress(env, jVBuffer);
+        const jlong vBufferSize = (*env)->GetDirectBufferCapacity(env, jVBuffer);
+        if( NULL == vBuffer || vBufferSize < my_getFrameSize(pAV) ) {
+            JoglCommon_throwNewRuntimeException(env, "Video frame buffer invalid: %p, size %ld < %ld", 
+                vBuffer, (long)vBufferSize, (long)my_getFrameSize(pAV));
+            return -1;
+        }
+        my_copyFrame(pAV, vBuffer);
+    }
+    return 0;
+}
+
 JNIEXPORT jint JNICALL Java_jogamp_opengl_util_av_impl_FFMPEGMediaPlayer_readNextPacket0
-  (JNIEnv *env, jobject instance, jlong ptr, jlong jProcAddrGLTexSubImage2D, jint texTarget, jint texFmt, jint texType)
+  (JNIEnv *env, jobject instance, jlong ptr, jlong jProcAddrGLTexSubImage2D, jint texTarget, jint texFmt, jint texType, jobject jVBuffer)
 {
     FFMPEGToolBasicAV_t *pAV = (FFMPEGToolBasicAV_t *)((void *)((intptr_t)ptr));
     PFNGLTEXSUBIMAGE2DPROC procAddrGLTexSubImage2D = (PFNGLTEXSUBIMAGE2DPROC) (intptr_t)jProcAddrGLTexSubImage2D;
 
-    jint res = 0; // 1 - audio, 2 - video
+    jint res = 0; // -1 - end of stream, 1 - audio, 2 - video
     AVPacket packet;
     int frameFinished;
 
-    if(sp_av_read_frame(pAV->pFormatCtx, &packet)>=0) {
-        /**
+    if( pAV->vFramePending ) {
+        // Deliver the frame decoded by seek0 first
+        pAV->vFramePending = 0;
+        return 0 == my_deliverVideoFrame(env, pAV, procAddrGLTexSubImage2D, texTarget, texFmt, texType, jVBuffer) ? 2 : 0;
+    }
+    if(sp_av_read_frame(pAV->pFormatCtx, &packet)<0) {
+        res = -1;
+    } else {
         if(packet.stream_index==pAV->aid) {
             // Decode audio frame
             if(NULL == pAV->pAFrame) {
                 sp_av_free_packet(&packet);
                 return res;
             }
-
-            int new_packet = 1;
-            int len1;
-            int flush_complete = 0;
-            int data_size = 0;
-            while (packet.size > 0 || (!packet.data && new_packet)) {
-                new_packet = 0;
-                if (flush_complete) {
-                    break;
-                }
-                if(HAS_FUNC(sp_avcodec_decode_audio4)) {
-                    len1 = sp_avcodec_decode_audio4(pAV->pVCodecCtx, pAV->pAFrame, &frameFinished, &packet);
-                } else {
-                    len1 = sp_avcodec_decode_audio3(pAV->pVCodecCtx, int16_t *samples, int *frame_size_ptr, &frameFinished, &packet);
-                }
-                if (len1 < 0) {
-                    // if error, we skip the frame 
-                    packet.size = 0;
-                    break;
-                }
-                packet.data += len1;
-                packet.size -= len1;
-
-                if (!frameFinished) {
-                    // stop sending empty packets if the decoder is finished 
-                    if (!packet.data && pAV->pVCodecCtx->codec->capabilities & CODEC_CAP_DELAY) {
-                        flush_complete = 1;
-                    }
-                    continue;
-                }
-
-                int32_t pts = pAV->pAFrame->pkt_pts * my_av_q2i32(1000, pAV->pAStream->time_base);
-                pAV->aPTS += ( data_size * 1000 ) / (2 * pAV->pVCodecCtx->channels * pAV->pVCodecCtx->sample_rate);
-                printf("A pts %d - %d\n", pts, pAV->aPTS);
-                res = 1;
-            }
-        } else */ if(packet.stream_index==pAV->vid) {
+            res = my_decodeAudio(pAV, &packet);
+        } else if(packet.stream_index==pAV->vid) {
             // Decode video frame
             if(NULL == pAV->pVFrame) {
                 sp_av_free_packet(&packet);
                 return res;
             }
+            my_indexKeyFrame(pAV, &packet);
             sp_avcodec_decode_video2(pAV->pVCodecCtx, pAV->pVFrame, &frameFinished, &packet);
 
             // Did we get a video frame?
             if(frameFinished)
             {
                 res = 2;
-                // FIXME: Libav Binary compatibility! JAU01
-                const AVRational time_base = pAV->pVStream->time_base;
-                const int64_t pts = pAV->pVFrame->pkt_pts;
-                if(AV_NOPTS_VALUE != pts) { // discard invalid PTS ..
-                    pAV->vPTS = pts * my_av_q2i32(1000, time_base);
-
-                    #if 0
-                    printf("PTS %d = %ld * ( ( 1000 * %ld ) / %ld ) '1000 * time_base', time_base = %lf\n",
-                        pAV->vPTS, pAV->pVFrame->pkt_pts, time_base.num, time_base.den, (time_base.num/(double)time_base.den));
-                    #endif
+                my_updateVideoPTS(pAV);
+                if( 0 != my_deliverVideoFrame(env, pAV, procAddrGLTexSubImage2D, texTarget, texFmt, texType, jVBuffer) ) {
+                    sp_av_free_packet(&packet);
+                    return 0;
                 }
-
-                #if 0
-                printf("tex2D codec %dx%d - frame %dx%d - width %d tex / %d linesize, pixfmt 0x%X, texType 0x%x, texTarget 0x%x\n", 
-                         pAV->pVCodecCtx->width, pAV->pVCodecCtx->height, 
-                         pAV->pVFrame->width, pAV->pVFrame->height, pAV->vTexWidth[0], pAV->pVFrame->linesize[0],
-                         texFmt, texType, texTarget);
-                #endif
-
-                // 1st plane or complete packed frame
-                // FIXME: Libav Binary compatibility! JAU01
-                procAddrGLTexSubImage2D(texTarget, 0, 
-                                        0,                 0, 
-                                        pAV->vTexWidth[0], pAV->pVCodecCtx->height, 
-                                        texFmt, texType, pAV->pVFrame->data[0]);
-
-                if(pAV->vPixFmt == PIX_FMT_YUV420P) {
-                    // U plane
-                    // FIXME: Libav Binary compatibility! JAU01
-                    procAddrGLTexSubImage2D(texTarget, 0, 
-                                            pAV->pVCodecCtx->width, 0,
-                                            pAV->vTexWidth[1],      pAV->pVCodecCtx->height/2, 
-                                            texFmt, texType, pAV->pVFrame->data[1]);
-                    // V plane
-                    // FIXME: Libav Binary compatibility! JAU01
-                    procAddrGLTexSubImage2D(texTarget, 0, 
-                                            pAV->pVCodecCtx->width, pAV->pVCodecCtx->height/2,
-                                            pAV->vTexWidth[2],      pAV->pVCodecCtx->height/2, 
-                                            texFmt, texType, pAV->pVFrame->data[2]);
-                } // FIXME: Add more planar formats !
             }
         }
 
@@ -683,21 +963,88 @@ JNIEXPORT jint JNICALL Java_jogamp_opengl_util_av_impl_FFMPEGMediaPlayer_readNex
     return res;
 }
 
+/**
+ * Demuxes and decodes until a video frame is decoded, which is kept pending for readNextPacket0.
+ * If accurate, decoding continues until the frame displayed at targetPTS is reached, 
+ * otherwise the first decoded frame is taken. Audio packets are dropped.
+ * @return 0 if a frame is pending, -1 if the end of stream has been reached
+ */
+static int my_decodeVideoFrameAt(FFMPEGToolBasicAV_t* pAV, int32_t targetPTS, int accurate) {
+    const int32_t frameDuration = 0 < pAV->fps ? (int32_t) ( 1000.0f / pAV->fps ) : 1;
+    AVPacket packet;
+    int frameFinished;
+
+    while( sp_av_read_frame(pAV->pFormatCtx, &packet) >= 0 ) {
+        if( packet.stream_index == pAV->vid ) {
+            my_indexKeyFrame(pAV, &packet);
+            frameFinished = 0;
+            sp_avcodec_decode_video2(pAV->pVCodecCtx, pAV->pVFrame, &frameFinished, &packet);
+            if( frameFinished ) {
+                my_updateVideoPTS(pAV);
+                if( !accurate || pAV->vPTS + frameDuration > targetPTS ) {
+                    sp_av_free_packet(&packet);
+                    pAV->vFramePending = 1;
+                    return 0;
+                }
+            }
+        }
+        sp_av_free_packet(&packet);
+    }
+    return -1;
+}
+
 JNIEXPORT jint JNICALL Java_jogamp_opengl_util_av_impl_FFMPEGMediaPlayer_seek0
-  (JNIEnv *env, jobject instance, jlong ptr, jint pos1)
+  (JNIEnv *env, jobject instance, jlong ptr, jint pos1, jboolean accurate)
 {
     FFMPEGToolBasicAV_t *pAV = (FFMPEGToolBasicAV_t *)((void *)((intptr_t)ptr));
-    int64_t pos0 = pAV->vPTS;
-    int64_t pts0 = pAV->pVFrame->pkt_pts;
-    int64_t pts1 = (int64_t) pos1 / my_av_q2i32(1000, pAV->pVStream->time_base);
-    int flags = 0;
-    if(pos1 < pos0) {
-        flags |= AVSEEK_FLAG_BACKWARD;
-    }
-    fprintf(stderr, "SEEK: pre  : u %ld, p %ld -> u %ld, p %ld\n", pos0, pts0, pos1, pts1);
-    sp_av_seek_frame(pAV->pFormatCtx, pAV->vid, pts1, flags);
-    pAV->vPTS = pAV->pVFrame->pkt_pts * my_av_q2i32(1000, pAV->pVStream->time_base);
-    fprintf(stderr, "SEEK: post : u %ld, p %ld\n", pAV->vPTS, pAV->pVFrame->pkt_pts);
+    const int32_t pos0 = pAV->vPTS;
+    int64_t ts1;
+    int32_t k;
+    int decodeOnly;
+
+    if( NULL == pAV->pVStream || NULL == pAV->pVFrame ) {
+        return pos0;
+    }
+    // FIXME: Libav Binary compatibility! JAU01
+    ts1 = my_av_ms2pts(pos1, pAV->pVStream->time_base);
+    k = ts1 <= pAV->vKeyFrameIndexEnd ? my_findKeyFrame(pAV, ts1) : -1;
+
+    // Accurate seek forward within the current GOP, i.e. w/o a key frame in between, 
+    // merely continues decoding.
+    decodeOnly = accurate && 0 <= k && !pAV->vFramePending && 
+                 pAV->vKeyFrames[k].pts <= pos0 && pos0 < pos1;
+
+    if( !decodeOnly ) {
+        if( 0 <= k ) {
+            // Known key frame preceding the target, which continues the contiguously indexed range
+            sp_av_seek_frame(pAV->pFormatCtx, pAV->vid, pAV->vKeyFrames[k].ts, AVSEEK_FLAG_BACKWARD);
+            pAV->vKeyFrameIndexContiguous = 1;
+        } else {
+            // Let the demuxer find the key frame preceding the target
+            sp_av_seek_frame(pAV->pFormatCtx, pAV->vid, ts1, AVSEEK_FLAG_BACKWARD);
+            pAV->vKeyFrameIndexContiguous = 0;
+        }
+        sp_avcodec_flush_buffers(pAV->pVCodecCtx);
+        if( NULL != pAV->pACodecCtx ) {
+            sp_avcodec_flush_buffers(pAV->pACodecCtx);
+        }
+        pAV->vFramePending = 0;
+    }
+    if( 0 != my_decodeVideoFrameAt(pAV, pos1, accurate) ) {
+        // end of stream, no frame at the target position
+        if(pAV->verbose) {
+            fprintf(stderr, "SEEK: %d -> %d (%s, key frame %d of %d): EOS\n", pos0, pos1, 
+                accurate ? "accurate" : "fast", k, pAV->vKeyFrameCount);
+        }
+        return -1; // INVALID_PTS
+    }
+    pAV->aPTS = pAV->vPTS;
+    pAV->aNextPTS = pAV->vPTS;
+    pAV->aDataSize = 0;
+    if(pAV->verbose) {
+        fprintf(stderr, "SEEK: %d -> %d (%s, key frame %d of %d): %d\n", pos0, pos1, 
+            accurate ? "accurate" : "fast", k, pAV->vKeyFrameCount, pAV->vPTS);
+    }
     return pAV->vPTS;
 }
 
@@ -715,3 +1062,13 @@ JNIEXPORT jint JNICALL Java_jogamp_opengl_util_av_impl_FFMPEGMediaPlayer_getAudi
     return pAV->aPTS;
 }
 
+JNIEXPORT jobject JNICALL Java_jogamp_opengl_util_av_impl_FFMPEGMediaPlayer_getAudioBuffer0
+  (JNIEnv *env, jobject instance, jlong ptr, jint plane)
+{
+    FFMPEGToolBasicAV_t *pAV = (FFMPEGToolBasicAV_t *)((void *)((intptr_t)ptr));
+    if( 0 != plane || NULL == pAV->pABuffer || 0 >= pAV->aDataSize ) {
+        return NULL;
+    }
+    return (*env)->NewDirectByteBuffer(env, pAV->pABuffer, pAV->aDataSize);
+}
+
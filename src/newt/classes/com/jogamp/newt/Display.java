@@ -163,6 +163,24 @@ public abstract class Display {
     public abstract boolean isEDTRunning();
 
     public abstract void dispatchMessages();
+
+    /**
+     * Enables or disables coalescing of consecutive native mouse motion events.
+     * <p>
+     * If enabled, native implementations delivering input events in batches 
+     * only deliver the last of consecutive {@link com.jogamp.newt.event.MouseEvent#EVENT_MOUSE_MOVED moved} 
+     * or {@link com.jogamp.newt.event.MouseEvent#EVENT_MOUSE_DRAGGED dragged} events 
+     * per window and batch, reducing the event load of high rate devices.
+     * Disable it if every motion sample is required, e.g. for drawing applications.
+     * </p>
+     * <p>
+     * Default is disabled, unless property <code>newt.event.coalesceMotion</code> is set.
+     * </p>
+     */
+    public abstract void setMotionEventCoalescing(boolean enable);
+
+    /** @see #setMotionEventCoalescing(boolean) */
+    public abstract boolean getMotionEventCoalescing();
     
     // Global Displays
     protected static ArrayList<Display> displayList = new ArrayList<Display>();
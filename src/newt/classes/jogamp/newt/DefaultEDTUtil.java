@@ -49,18 +49,65 @@ import com.jogamp.newt.util.EDTUtil;
 public class DefaultEDTUtil implements EDTUtil {
     public static final boolean DEBUG = Debug.debug("EDT");
 
+    /**
+     * Allows the EDT to block until native events are available, 
+     * instead of waking up every {@link EDTUtil#getPollPeriod() poll period}.
+     * <p>
+     * Implemented by drivers exposing a pollable native event source, e.g. the X11 connection file descriptor.
+     * </p>
+     */
+    public interface EventWaiter {
+        /** 
+         * Returns <code>true</code> if {@link #waitForEvents(long)} is currently usable,
+         * otherwise the EDT falls back to periodic polling. 
+         */
+        boolean isAvailable();
+
+        /**
+         * Blocks the EDT until native events are available or {@link #wakeUp()} has been called,
+         * the latter since the last return of this method.
+         * <p>
+         * Implementation may return after <code>pollPeriod</code> milliseconds,
+         * e.g. in case it has pending events to re-dispatch.
+         * </p>
+         */
+        void waitForEvents(long pollPeriod);
+
+        /** Wakes up a blocked or the next {@link #waitForEvents(long)} call. May be called from any thread. */
+        void wakeUp();
+    }
+
+    /** 
+     * If <code>true</code>, always use periodic polling, even if an {@link EventWaiter} is available. 
+     * Set via property <code>newt.edt.polling</code>.
+     */
+    public static final boolean FORCE_POLLING = Debug.isPropertyDefined("newt.edt.polling", true);
+
     private final Object edtLock = new Object(); // locking the EDT start/stop state
     private final ThreadGroup threadGroup; 
     private final String name;
     private final Runnable dispatchMessages;
+    private final EventWaiter eventWaiter;
     private EventDispatchThread edt = null;
     private int start_iter=0;
+    /** Written by the EDT only */
+    private volatile int idleWakeups = 0;
     private static long pollPeriod = EDTUtil.defaultEDTPollPeriod;
 
     public DefaultEDTUtil(ThreadGroup tg, String name, Runnable dispatchMessages) {
+        this(tg, name, dispatchMessages, null);
+    }
+
+    /**
+     * @param eventWaiter optional {@link EventWaiter}, if not <code>null</code> and {@link EventWaiter#isAvailable() available}
+     *                    the EDT blocks until native events or tasks are available instead of polling.
+     *                    Ignored if {@link #FORCE_POLLING} is set.
+     */
+    public DefaultEDTUtil(ThreadGroup tg, String name, Runnable dispatchMessages, EventWaiter eventWaiter) {
         this.threadGroup = tg;
         this.name=Thread.currentThread().getName()+"-"+name+"-EDT-";
         this.dispatchMessages=dispatchMessages;
+        this.eventWaiter = FORCE_POLLING ? null : eventWaiter;
         this.edt = new EventDispatchThread(threadGroup, name);
         this.edt.setDaemon(true); // don't stop JVM from shutdown ..
     }
@@ -187,6 +234,7 @@ public class DefaultEDTUtil implements EDTUtil {
                         edt.tasks.add(rTask);
                         edt.tasks.notifyAll();
                     }
+                    wakeUpEventWaiter();
                 }
             }
             if( wait ) {
@@ -224,6 +272,7 @@ public class DefaultEDTUtil implements EDTUtil {
             while(_edt.isRunning() && _edt.tasks.size()>0) {
                 try {
                     _edt.tasks.notifyAll();
+                    wakeUpEventWaiter();
                     _edt.tasks.wait();
                 } catch (InterruptedException e) {
                     e.printStackTrace();
@@ -232,6 +281,26 @@ public class DefaultEDTUtil implements EDTUtil {
         }
     }
 
+    /** Wakes up the EDT if blocked in {@link EventWaiter#waitForEvents(long)}. */
+    private final void wakeUpEventWaiter() {
+        if( null != eventWaiter ) {
+            eventWaiter.wakeUp();
+        }
+    }
+
+    /** Returns <code>true</code> if the EDT blocks on native events instead of polling. */
+    public final boolean isEventWaitEnabled() {
+        return null != eventWaiter && eventWaiter.isAvailable();
+    }
+
+    /** 
+     * Returns the number of times the idle EDT woke up w/o a task to execute,
+     * i.e. each poll period when polling, or for native events when blocking on them.
+     */
+    public final int getIdleWakeupCount() {
+        return idleWakeups;
+    }
+
     @Override
     final public void waitUntilStopped() {
         synchronized(edtLock) {
@@ -294,13 +363,19 @@ public class DefaultEDTUtil implements EDTUtil {
                     }
                     // wait and work on tasks
                     RunnableTask task = null;
+                    boolean waitForEvents = false;
                     synchronized(tasks) {
                         // wait for tasks
                         if(!shouldStop && tasks.size()==0) {
-                            try {
-                                tasks.wait(pollPeriod);
-                            } catch (InterruptedException e) {
-                                e.printStackTrace();
+                            if( null != eventWaiter && eventWaiter.isAvailable() ) {
+                                // block w/o holding the tasks lock, new tasks wake us up
+                                waitForEvents = true;
+                            } else {
+                                try {
+                                    tasks.wait(pollPeriod);
+                                } catch (InterruptedException e) {
+                                    e.printStackTrace();
+                                }
                             }
                         }
                         // execute one task, if available
@@ -309,13 +384,18 @@ public class DefaultEDTUtil implements EDTUtil {
                             tasks.notifyAll();
                         }
                     }
-                    if(null!=task) {
+                    if(waitForEvents) {
+                        eventWaiter.waitForEvents(pollPeriod);
+                        idleWakeups++;
+                    } else if(null!=task) {
                         task.run();
                         validateNoRecursiveLocksHold();
                         if(!task.hasWaiter() && null != task.getThrowable()) {
                             // at least dump stack-trace in case nobody waits for result
                             task.getThrowable().printStackTrace();
                         }
+                    } else {
+                        idleWakeups++;
                     }
                 } while(!shouldStop) ;
             } catch (Throwable t) {
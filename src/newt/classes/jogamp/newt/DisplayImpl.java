@@ -48,6 +48,9 @@ import javax.media.nativewindow.NativeWindowException;
 public abstract class DisplayImpl extends Display {
     private static int serialno = 1;
 
+    /** Default of {@link #setMotionEventCoalescing(boolean)}, property <code>newt.event.coalesceMotion</code> */
+    protected static final boolean DEFAULT_COALESCE_MOTION_EVENTS = Debug.isPropertyDefined("newt.event.coalesceMotion", true);
+
     private static Class<?> getDisplayClass(String type) 
         throws ClassNotFoundException 
     {
@@ -155,7 +158,7 @@ public abstract class DisplayImpl extends Display {
     protected EDTUtil createEDTUtil() {
         final EDTUtil def;
         if(NewtFactory.useEDT()) {
-            def = new DefaultEDTUtil(Thread.currentThread().getThreadGroup(), "Display-"+getFQName(), dispatchMessagesRunnable);            
+            def = new DefaultEDTUtil(Thread.currentThread().getThreadGroup(), "Display-"+getFQName(), dispatchMessagesRunnable, eventWaiter);            
             if(DEBUG) {
                 System.err.println("Display.createNative("+getFQName()+") Create EDTUtil: "+def.getClass().getName());
             }
@@ -342,6 +345,16 @@ public abstract class DisplayImpl extends Display {
         return null != aDevice;
     }
 
+    @Override
+    public void setMotionEventCoalescing(boolean enable) {
+        coalesceMotionEvents = enable;
+    }
+
+    @Override
+    public final boolean getMotionEventCoalescing() {
+        return coalesceMotionEvents;
+    }
+
     public boolean isEDTRunning() {
         if(null!=edtUtil) {
             return edtUtil.isRunning();
@@ -356,6 +369,36 @@ public abstract class DisplayImpl extends Display {
 
     protected abstract void dispatchMessagesNative();
 
+    /** 
+     * Returns <code>true</code> if the native implementation is able to block until native events are available, 
+     * see {@link #waitForNativeEvents(int)}. Default is <code>false</code>, i.e. the EDT polls. 
+     */
+    protected boolean isNativeEventWaitAvailable() { return false; }
+
+    /**
+     * Blocks until native events are available, {@link #wakeUpNativeEventWait()} has been called
+     * or the timeout elapsed.
+     * @param timeoutMS timeout in milliseconds, <code>0</code> for no timeout
+     */
+    protected void waitForNativeEvents(int timeoutMS) { }
+
+    /** Wakes up a blocked or the next {@link #waitForNativeEvents(int)} call, may be called from any thread. */
+    protected void wakeUpNativeEventWait() { }
+
+    class EventWaiter implements DefaultEDTUtil.EventWaiter {
+        public boolean isAvailable() {
+            return isNativeEventWaitAvailable();
+        }
+        public void waitForEvents(long pollPeriod) {
+            // re-enqueued events, e.g. not consumed due to a locked window, are retried after pollPeriod
+            waitForNativeEvents( haveEvents ? (int) Math.max(1, pollPeriod) : 0 );
+        }
+        public void wakeUp() {
+            wakeUpNativeEventWait();
+        }
+    }
+    protected EventWaiter eventWaiter = new EventWaiter();
+
     private Object eventsLock = new Object();
     private ArrayList<NEWTEventTask> events = new ArrayList<NEWTEventTask>();
     private volatile boolean haveEvents = false;
@@ -459,6 +502,10 @@ public abstract class DisplayImpl extends Display {
                 haveEvents = true;
                 eventsLock.notifyAll();
             }
+            if( edtUtil instanceof DefaultEDTUtil && !edtUtil.isCurrentThreadEDTorNEDT() && 
+                ((DefaultEDTUtil)edtUtil).isEventWaitEnabled() ) {
+                eventWaiter.wakeUp();
+            }
             if( wait ) {
                 try {
                     lock.wait();
@@ -498,6 +545,7 @@ public abstract class DisplayImpl extends Display {
     protected int hashCode;
     protected int refCount; // number of Display references by Screen
     protected boolean destroyWhenUnused;
+    protected volatile boolean coalesceMotionEvents = DEFAULT_COALESCE_MOTION_EVENTS;
     protected AbstractGraphicsDevice aDevice;
 }
 
@@ -36,6 +36,7 @@ package jogamp.newt;
 
 import java.util.ArrayList;
 import java.lang.reflect.Method;
+import java.nio.ByteBuffer;
 
 import com.jogamp.common.util.ReflectionUtil;
 import com.jogamp.newt.NewtFactory;
@@ -2178,6 +2179,44 @@ public abstract class WindowImpl implements Window, NEWTEventConsumer
         addKeyListener(-1, l);
     }
 
+    //
+    // Batched native input events
+    //
+
+    /** Number of <code>int</code> values per input event record, see {@link #sendInputEvents(ByteBuffer, int)}. */
+    public static final int INPUT_EVENT_RECORD_INTS = 6;
+
+    /**
+     * Sends <code>count</code> input events stored in the native batch <code>buffer</code>, 
+     * allowing the native implementation to cross into Java once per dispatched batch.
+     * <p>
+     * Each record consists of {@link #INPUT_EVENT_RECORD_INTS} <code>int</code> values in native byte order:
+     * <pre>
+     *   mouse event: eventType, modifiers, x, y, button, rotation
+     *   key event:   eventType, modifiers, keyCode, keyChar, 0, 0
+     * </pre>
+     * </p>
+     * <p>
+     * Listeners may cause a nested native dispatch, e.g. via {@link #setSize(int, int)}.
+     * The implementation shall pass a distinct buffer to such nested dispatch, since all records of 
+     * <code>buffer</code> are read while delivering.
+     * </p>
+     * @param buffer direct buffer in native byte order, only accessed via absolute get operations
+     * @param count number of valid records
+     */
+    protected void sendInputEvents(ByteBuffer buffer, int count) {
+        for(int i=0, o=0; i<count; i++, o+=INPUT_EVENT_RECORD_INTS*4) {
+            final int eventType = buffer.getInt(o);
+            final int modifiers = buffer.getInt(o+4);
+            if( KeyEvent.EVENT_KEY_PRESSED <= eventType && eventType <= KeyEvent.EVENT_KEY_TYPED ) {
+                sendKeyEvent(eventType, modifiers, buffer.getInt(o+8), (char) buffer.getInt(o+12));
+            } else {
+                sendMouseEvent(eventType, modifiers, buffer.getInt(o+8), buffer.getInt(o+12), 
+                               buffer.getInt(o+16), buffer.getInt(o+20));
+            }
+        }
+    }
+
     public final void setKeyboardVisible(boolean visible) {
         if(isNativeValid()) {
             // We don't skip the impl. if it seems that there is no state change,
@@ -34,6 +34,10 @@
 
 package jogamp.newt.driver.x11;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.ArrayList;
+
 import javax.media.nativewindow.AbstractGraphicsDevice;
 import javax.media.nativewindow.NativeWindowException;
 import javax.media.nativewindow.NativeWindowFactory;
@@ -43,6 +47,7 @@ import com.jogamp.nativewindow.x11.X11GraphicsDevice;
 import jogamp.nativewindow.x11.X11Util;
 import jogamp.newt.DisplayImpl;
 import jogamp.newt.NEWTJNILibLoader;
+import jogamp.newt.WindowImpl;
 
 public class DisplayDriver extends DisplayImpl {
 
@@ -104,6 +109,9 @@ public class DisplayDriver extends DisplayImpl {
             closeNativeImpl();
             throw e;
         }
+        synchronized(eventWaitLock) {
+            eventWaitHandle = CreateEventWait0();
+        }
         
         // see API doc above!
         if(X11Util.XINITTHREADS_ALWAYS_ENABLED && X11Util.HAS_XLOCKDISPLAY_BUG) {
@@ -114,6 +122,12 @@ public class DisplayDriver extends DisplayImpl {
     }
 
     protected void closeNativeImpl() {
+        synchronized(eventWaitLock) {
+            if(0 != eventWaitHandle) {
+                DestroyEventWait0(eventWaitHandle);
+                eventWaitHandle = 0;
+            }
+        }
         DisplayRelease0(edtDisplayHandle, javaObjectAtom, windowDeleteAtom);
         javaObjectAtom = 0;
         windowDeleteAtom = 0;
@@ -128,7 +142,51 @@ public class DisplayDriver extends DisplayImpl {
 
     protected void dispatchMessagesNative() {
         if(0 != edtDisplayHandle) {
-            DispatchMessages0(edtDisplayHandle, javaObjectAtom, windowDeleteAtom);
+            // A listener may trigger a nested dispatch while the outer batch is being delivered,
+            // e.g. Window.setSize(..) waiting for the native change. Hence use one buffer per nesting level.
+            final ByteBuffer inputEventBuffer = getInputEventBuffer(dispatchDepth++);
+            try {
+                DispatchMessages0(edtDisplayHandle, javaObjectAtom, windowDeleteAtom, inputEventBuffer, coalesceMotionEvents);
+            } finally {
+                dispatchDepth--;
+            }
+        }
+    }
+
+    /** @return the input event buffer for the given dispatch nesting level, or <code>null</code> to deliver events one by one if nested too deep. */
+    private ByteBuffer getInputEventBuffer(int depth) {
+        if( depth >= INPUT_EVENT_BUFFER_MAX_DEPTH ) {
+            return null;
+        }
+        while( inputEventBuffers.size() <= depth ) {
+            inputEventBuffers.add( ByteBuffer.allocateDirect(INPUT_EVENT_BATCH_SIZE * WindowImpl.INPUT_EVENT_RECORD_INTS * 4).order(ByteOrder.nativeOrder()) );
+        }
+        return inputEventBuffers.get(depth);
+    }
+
+    /**
+     * {@inheritDoc}
+     * <p>
+     * The EDT polls the EDT display's connection file descriptor and a wake-up pipe.
+     * </p>
+     */
+    protected boolean isNativeEventWaitAvailable() {
+        return 0 != eventWaitHandle && 0 != edtDisplayHandle;
+    }
+
+    protected void waitForNativeEvents(int timeoutMS) {
+        // only invoked on EDT, which also closes the display
+        final long h = eventWaitHandle;
+        if(0 != h && 0 != edtDisplayHandle) {
+            WaitForEvents0(edtDisplayHandle, h, timeoutMS);
+        }
+    }
+
+    protected void wakeUpNativeEventWait() {
+        synchronized(eventWaitLock) {
+            if(0 != eventWaitHandle) {
+                WakeUpEventWait0(eventWaitHandle);
+            }
         }
     }
 
@@ -149,7 +207,17 @@ public class DisplayDriver extends DisplayImpl {
     }
     private native void DisplayRelease0(long handle, long javaObjectAtom, long windowDeleteAtom);
 
-    private native void DispatchMessages0(long display, long javaObjectAtom, long windowDeleteAtom);
+    /** 
+     * @param inputEventBuffer batch of input event records, see {@link WindowImpl#sendInputEvents(ByteBuffer, int)}.
+     *                         If <code>null</code>, input events are delivered one by one.
+     * @param coalesceMotion if <code>true</code>, only the last of consecutive motion events per window and batch is delivered 
+     */
+    private native void DispatchMessages0(long display, long javaObjectAtom, long windowDeleteAtom, ByteBuffer inputEventBuffer, boolean coalesceMotion);
+
+    private static native long CreateEventWait0();
+    private static native void DestroyEventWait0(long eventWait);
+    private static native void WaitForEvents0(long display, long eventWait, int timeoutMS);
+    private static native void WakeUpEventWait0(long eventWait);
 
     /**
      * 2011/06/14 libX11 1.4.2 and libxcb 1.7 bug 20708 - Multithreading Issues w/ OpenGL, ..
@@ -161,6 +229,20 @@ public class DisplayDriver extends DisplayImpl {
     private final boolean USE_SEPARATE_DISPLAY_FOR_EDT = true;
     
     private long edtDisplayHandle;
+
+    /** Maximum number of input events delivered to Java at once */
+    private static final int INPUT_EVENT_BATCH_SIZE = 128;
+
+    /** Maximum dispatch nesting level using a batch buffer, deeper levels deliver input events one by one */
+    private static final int INPUT_EVENT_BUFFER_MAX_DEPTH = 4;
+
+    /** Only used on EDT by {@link #dispatchMessagesNative()}, one buffer per dispatch nesting level */
+    private final ArrayList<ByteBuffer> inputEventBuffers = new ArrayList<ByteBuffer>();
+    private int dispatchDepth = 0;
+
+    /** Native wake-up pipe used by the EDT to block on the EDT display connection, see {@link #waitForNativeEvents(int)} */
+    private final Object eventWaitLock = new Object();
+    private volatile long eventWaitHandle;
     
     /** X11 Window delete atom marker used on EDT */
     private long windowDeleteAtom;
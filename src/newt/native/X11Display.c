@@ -28,12 +28,22 @@
 
 #include "X11Common.h"
 
+#include <poll.h>
+#include <fcntl.h>
+
 #define USE_SENDIO_DIRECT 1
 
 jclass X11NewtWindowClazz = NULL;
 jmethodID insetsChangedID = NULL;
 jmethodID visibleChangedID = NULL;
 
+/** 
+ * Per display client side table Window -> global Java Window object,
+ * maintained by CreateWindow0 and CloseWindow0. 
+ * Allows DispatchMessages0 to resolve the event's Java Window w/o a server round trip.
+ */
+XContext X11NewtJavaObjectContext = 0;
+
 static const char * const ClazzNameX11NewtWindow = "jogamp/newt/driver/x11/WindowDriver";
 
 static jmethodID displayCompletedID = NULL;
@@ -50,6 +60,7 @@ static jmethodID enqueueMouseEventID = NULL;
 static jmethodID sendMouseEventID = NULL;
 static jmethodID enqueueKeyEventID = NULL;
 static jmethodID sendKeyEventID = NULL;
+static jmethodID sendInputEventsID = NULL;
 static jmethodID requestFocusID = NULL;
 
 static JavaVM *jvmHandle = NULL;
@@ -290,6 +301,10 @@ JNIEXPORT jboolean JNICALL Java_jogamp_newt_driver_x11_DisplayDriver_initIDs0
         }
     }
 
+    if(0==X11NewtJavaObjectContext) {
+        X11NewtJavaObjectContext = XUniqueContext();
+    }
+
     displayCompletedID = (*env)->GetMethodID(env, clazz, "displayCompleted", "(JJ)V");
     getCurrentThreadNameID = (*env)->GetStaticMethodID(env, X11NewtWindowClazz, "getCurrentThreadName", "()Ljava/lang/String;");
     dumpStackID = (*env)->GetStaticMethodID(env, X11NewtWindowClazz, "dumpStack", "()V");
@@ -305,6 +320,7 @@ JNIEXPORT jboolean JNICALL Java_jogamp_newt_driver_x11_DisplayDriver_initIDs0
     sendMouseEventID = (*env)->GetMethodID(env, X11NewtWindowClazz, "sendMouseEvent", "(IIIIII)V");
     enqueueKeyEventID = (*env)->GetMethodID(env, X11NewtWindowClazz, "enqueueKeyEvent", "(ZIIIC)V");
     sendKeyEventID = (*env)->GetMethodID(env, X11NewtWindowClazz, "sendKeyEvent", "(IIIC)V");
+    sendInputEventsID = (*env)->GetMethodID(env, X11NewtWindowClazz, "sendInputEvents", "(Ljava/nio/ByteBuffer;I)V");
     requestFocusID = (*env)->GetMethodID(env, X11NewtWindowClazz, "requestFocus", "(Z)V");
 
     if (displayCompletedID == NULL ||
@@ -322,6 +338,7 @@ JNIEXPORT jboolean JNICALL Java_jogamp_newt_driver_x11_DisplayDriver_initIDs0
         sendMouseEventID == NULL ||
         enqueueKeyEventID == NULL ||
         sendKeyEventID == NULL ||
+        sendInputEventsID == NULL ||
         requestFocusID == NULL) {
         return JNI_FALSE;
     }
@@ -389,22 +406,115 @@ JNIEXPORT void JNICALL Java_jogamp_newt_driver_x11_DisplayDriver_DisplayRelease0
     DBG_PRINT("X11: X11Display_DisplayRelease dpy %p\n", dpy);
 }
 
+/**
+ * Input event batch, see WindowImpl.sendInputEvents(ByteBuffer, int).
+ * Records of consecutive input events of the same window are delivered to Java at once.
+ */
+#define INPUT_EVENT_RECORD_INTS 6
+
+typedef struct {
+    jobject jbuffer;  /* direct ByteBuffer, NULL: no batching */
+    int32_t * data;
+    int capacity;     /* in records */
+    int count;        /* in records */
+    jobject jwindow;  /* window of the pending records */
+    jboolean coalesceMotion;
+} InputEventBatch;
+
+static void InputEventBatch_init(JNIEnv *env, InputEventBatch * b, jobject jbuffer, jboolean coalesceMotion) {
+    b->jbuffer = NULL;
+    b->data = NULL;
+    b->capacity = 0;
+    b->count = 0;
+    b->jwindow = NULL;
+    b->coalesceMotion = coalesceMotion;
+    if( NULL != jbuffer ) {
+        b->data = (int32_t *) (*env)->GetDirectBufferAddress(env, jbuffer);
+        b->capacity = (int) ( (*env)->GetDirectBufferCapacity(env, jbuffer) / ( INPUT_EVENT_RECORD_INTS * sizeof(int32_t) ) );
+        if( NULL != b->data && 0 < b->capacity ) {
+            b->jbuffer = jbuffer;
+        }
+    }
+}
+
+/** Delivers all pending records, must be called before any other Java callback to preserve the event order. */
+static void InputEventBatch_flush(JNIEnv *env, InputEventBatch * b) {
+    if( 0 < b->count ) {
+        const int count = b->count;
+        b->count = 0;
+        (*env)->CallVoidMethod(env, b->jwindow, sendInputEventsID, b->jbuffer, (jint) count);
+    }
+    b->jwindow = NULL;
+}
+
+static void InputEventBatch_add(JNIEnv *env, InputEventBatch * b, jobject jwindow, 
+                                jint eventType, jint modifiers, jint a0, jint a1, jint a2, jint a3) {
+    int32_t * r;
+    if( b->jwindow != jwindow ) {
+        InputEventBatch_flush(env, b);
+        b->jwindow = jwindow;
+    }
+    if( b->coalesceMotion && EVENT_MOUSE_MOVED == eventType && 0 < b->count ) {
+        r = b->data + ( b->count - 1 ) * INPUT_EVENT_RECORD_INTS;
+        if( EVENT_MOUSE_MOVED == r[0] && modifiers == r[1] ) {
+            // replace previous motion w/ same modifiers, i.e. same button state
+            r[2] = a0; r[3] = a1; r[4] = a2; r[5] = a3;
+            return;
+        }
+    }
+    if( b->count >= b->capacity ) {
+        InputEventBatch_flush(env, b);
+        b->jwindow = jwindow;
+    }
+    r = b->data + b->count * INPUT_EVENT_RECORD_INTS;
+    r[0] = eventType; r[1] = modifiers; r[2] = a0; r[3] = a1; r[4] = a2; r[5] = a3;
+    b->count++;
+}
+
+static void sendMouseEvent(JNIEnv *env, InputEventBatch * b, jobject jwindow, 
+                           jint eventType, jint modifiers, jint x, jint y, jint button, jint rotation) {
+    if( NULL != b->jbuffer ) {
+        InputEventBatch_add(env, b, jwindow, eventType, modifiers, x, y, button, rotation);
+    } else {
+        #ifdef USE_SENDIO_DIRECT
+        (*env)->CallVoidMethod(env, jwindow, sendMouseEventID, eventType, modifiers, x, y, button, rotation);
+        #else
+        (*env)->CallVoidMethod(env, jwindow, enqueueMouseEventID, JNI_FALSE, eventType, modifiers, x, y, button, rotation);
+        #endif
+    }
+}
+
+static void sendKeyEvent(JNIEnv *env, InputEventBatch * b, jobject jwindow, 
+                         jint eventType, jint modifiers, jint keySym, jchar keyChar) {
+    if( NULL != b->jbuffer ) {
+        InputEventBatch_add(env, b, jwindow, eventType, modifiers, keySym, (jint) keyChar, 0, 0);
+    } else {
+        #ifdef USE_SENDIO_DIRECT
+        (*env)->CallVoidMethod(env, jwindow, sendKeyEventID, eventType, modifiers, keySym, keyChar);
+        #else
+        (*env)->CallVoidMethod(env, jwindow, enqueueKeyEventID, JNI_FALSE, eventType, modifiers, keySym, keyChar);
+        #endif
+    }
+}
+
 /*
  * Class:     jogamp_newt_driver_x11_DisplayDriver
  * Method:    DispatchMessages
- * Signature: (JIJJ)V
+ * Signature: (JJJLjava/nio/ByteBuffer;Z)V
  */
 JNIEXPORT void JNICALL Java_jogamp_newt_driver_x11_DisplayDriver_DispatchMessages0
-  (JNIEnv *env, jobject obj, jlong display, jlong javaObjectAtom, jlong windowDeleteAtom)
+  (JNIEnv *env, jobject obj, jlong display, jlong javaObjectAtom, jlong windowDeleteAtom, jobject inputEventBuffer, jboolean coalesceMotion)
 {
     Display * dpy = (Display *) (intptr_t) display;
     Atom wm_delete_atom = (Atom)windowDeleteAtom;
     int num_events = 100;
     int autoRepeatModifiers = 0;
+    InputEventBatch batch;
 
     if ( NULL == dpy ) {
         return;
     }
+    InputEventBatch_init(env, &batch, inputEventBuffer, coalesceMotion);
 
     // Periodically take a break
     while( num_events > 0 ) {
@@ -421,27 +531,27 @@ JNIEXPORT void JNICALL Java_jogamp_newt_driver_x11_DisplayDriver_DispatchMessage
         //   QueuedAfterReading            : QueuedAlready + if queue==0, attempt to read more ..
         if ( 0 >= XPending(dpy) ) {
             // DBG_PRINT( "X11: DispatchMessages 0x%X - Leave 1\n", dpy); 
-            return;
+            break;
         }
 
         XNextEvent(dpy, &evt);
         num_events--;
 
         if( 0==evt.xany.window ) {
+            InputEventBatch_flush(env, &batch); // deliver already batched events before bailing out
             NewtCommon_throwNewRuntimeException(env, "event window NULL, bail out!");
             return ;
         }
 
         if(dpy!=evt.xany.display) {
+            InputEventBatch_flush(env, &batch); // deliver already batched events before bailing out
             NewtCommon_throwNewRuntimeException(env, "wrong display, bail out!");
             return ;
         }
 
         // DBG_PRINT( "X11: DispatchMessages dpy %p, win %p, Event %d\n", (void*)dpy, (void*)evt.xany.window, (int)evt.type);
 
-        NewtDisplay_x11ErrorHandlerEnable(env, dpy, 1, 0, 0);
-
-        jwindow = getJavaWindowProperty(env, dpy, evt.xany.window, javaObjectAtom,
+        jwindow = getJavaWindow(env, dpy, evt.xany.window, javaObjectAtom,
         #ifdef VERBOSE_ON
                 True
         #else
@@ -449,8 +559,6 @@ JNIEXPORT void JNICALL Java_jogamp_newt_driver_x11_DisplayDriver_DispatchMessage
         #endif
             );
 
-        NewtDisplay_x11ErrorHandlerEnable(env, dpy, 0, 0, 1);
-
         if(NULL==jwindow) {
             fprintf(stderr, "Warning: NEWT X11 DisplayDispatch %p, Couldn't handle event %d for X11 window %p\n", 
                 (void*)dpy, evt.type, (void*)evt.xany.window);
@@ -498,88 +606,49 @@ JNIEXPORT void JNICALL Java_jogamp_newt_driver_x11_DisplayDriver_DispatchMessage
 
         switch(evt.type) {
             case ButtonPress:
+            case ButtonRelease:
+            case MotionNotify:
+            case EnterNotify:
+            case LeaveNotify:
+            case KeyPress:
+            case KeyRelease:
+                break;
+            default:
+                // preserve order of pending input events and other callbacks
+                InputEventBatch_flush(env, &batch);
+        }
+
+        switch(evt.type) {
+            case ButtonPress:
+                InputEventBatch_flush(env, &batch);
                 (*env)->CallVoidMethod(env, jwindow, requestFocusID, JNI_FALSE);
-                #ifdef USE_SENDIO_DIRECT
-                (*env)->CallVoidMethod(env, jwindow, sendMouseEventID, (jint) EVENT_MOUSE_PRESSED, 
-                                      modifiers,
-                                      (jint) evt.xbutton.x, (jint) evt.xbutton.y, (jint) evt.xbutton.button, 0 /*rotation*/);
-                #else
-                (*env)->CallVoidMethod(env, jwindow, enqueueMouseEventID, JNI_FALSE, (jint) EVENT_MOUSE_PRESSED, 
-                                      modifiers,
-                                      (jint) evt.xbutton.x, (jint) evt.xbutton.y, (jint) evt.xbutton.button, 0 /*rotation*/);
-                #endif
+                sendMouseEvent(env, &batch, jwindow, (jint) EVENT_MOUSE_PRESSED, modifiers,
+                               (jint) evt.xbutton.x, (jint) evt.xbutton.y, (jint) evt.xbutton.button, 0 /*rotation*/);
                 break;
             case ButtonRelease:
-                #ifdef USE_SENDIO_DIRECT
-                (*env)->CallVoidMethod(env, jwindow, sendMouseEventID, (jint) EVENT_MOUSE_RELEASED, 
-                                      modifiers,
-                                      (jint) evt.xbutton.x, (jint) evt.xbutton.y, (jint) evt.xbutton.button, 0 /*rotation*/);
-                #else
-                (*env)->CallVoidMethod(env, jwindow, enqueueMouseEventID, JNI_FALSE, (jint) EVENT_MOUSE_RELEASED, 
-                                      modifiers,
-                                      (jint) evt.xbutton.x, (jint) evt.xbutton.y, (jint) evt.xbutton.button, 0 /*rotation*/);
-                #endif
+                sendMouseEvent(env, &batch, jwindow, (jint) EVENT_MOUSE_RELEASED, modifiers,
+                               (jint) evt.xbutton.x, (jint) evt.xbutton.y, (jint) evt.xbutton.button, 0 /*rotation*/);
                 break;
             case MotionNotify:
-                #ifdef USE_SENDIO_DIRECT
-                (*env)->CallVoidMethod(env, jwindow, sendMouseEventID, (jint) EVENT_MOUSE_MOVED, 
-                                      modifiers,
-                                      (jint) evt.xmotion.x, (jint) evt.xmotion.y, (jint) 0, 0 /*rotation*/); 
-                #else
-                (*env)->CallVoidMethod(env, jwindow, enqueueMouseEventID, JNI_FALSE, (jint) EVENT_MOUSE_MOVED, 
-                                      modifiers,
-                                      (jint) evt.xmotion.x, (jint) evt.xmotion.y, (jint) 0, 0 /*rotation*/); 
-                #endif
+                sendMouseEvent(env, &batch, jwindow, (jint) EVENT_MOUSE_MOVED, modifiers,
+                               (jint) evt.xmotion.x, (jint) evt.xmotion.y, (jint) 0, 0 /*rotation*/); 
                 break;
             case EnterNotify:
                 DBG_PRINT( "X11: event . EnterNotify call %p %d/%d\n", (void*)evt.xcrossing.window, evt.xcrossing.x, evt.xcrossing.y);
-                #ifdef USE_SENDIO_DIRECT
-                (*env)->CallVoidMethod(env, jwindow, sendMouseEventID, (jint) EVENT_MOUSE_ENTERED, 
-                                      modifiers,
-                                      (jint) evt.xcrossing.x, (jint) evt.xcrossing.y, (jint) 0, 0 /*rotation*/); 
-                #else
-                (*env)->CallVoidMethod(env, jwindow, enqueueMouseEventID, JNI_FALSE, (jint) EVENT_MOUSE_ENTERED, 
-                                      modifiers,
-                                      (jint) evt.xcrossing.x, (jint) evt.xcrossing.y, (jint) 0, 0 /*rotation*/); 
-                #endif
+                sendMouseEvent(env, &batch, jwindow, (jint) EVENT_MOUSE_ENTERED, modifiers,
+                               (jint) evt.xcrossing.x, (jint) evt.xcrossing.y, (jint) 0, 0 /*rotation*/); 
                 break;
             case LeaveNotify:
                 DBG_PRINT( "X11: event . LeaveNotify call %p %d/%d\n", (void*)evt.xcrossing.window, evt.xcrossing.x, evt.xcrossing.y);
-                #ifdef USE_SENDIO_DIRECT
-                (*env)->CallVoidMethod(env, jwindow, sendMouseEventID, (jint) EVENT_MOUSE_EXITED, 
-                                      modifiers,
-                                      (jint) evt.xcrossing.x, (jint) evt.xcrossing.y, (jint) 0, 0 /*rotation*/); 
-                #else
-                (*env)->CallVoidMethod(env, jwindow, enqueueMouseEventID, JNI_FALSE, (jint) EVENT_MOUSE_EXITED, 
-                                      modifiers,
-                                      (jint) evt.xcrossing.x, (jint) evt.xcrossing.y, (jint) 0, 0 /*rotation*/); 
-                #endif
+                sendMouseEvent(env, &batch, jwindow, (jint) EVENT_MOUSE_EXITED, modifiers,
+                               (jint) evt.xcrossing.x, (jint) evt.xcrossing.y, (jint) 0, 0 /*rotation*/); 
                 break;
             case KeyPress:
-                #ifdef USE_SENDIO_DIRECT
-                (*env)->CallVoidMethod(env, jwindow, sendKeyEventID, (jint) EVENT_KEY_PRESSED, 
-                                      modifiers, keySym, (jchar) -1);
-                #else
-                (*env)->CallVoidMethod(env, jwindow, enqueueKeyEventID, JNI_FALSE, (jint) EVENT_KEY_PRESSED, 
-                                      modifiers, keySym, (jchar) -1);
-                #endif
-
+                sendKeyEvent(env, &batch, jwindow, (jint) EVENT_KEY_PRESSED, modifiers, keySym, (jchar) -1);
                 break;
             case KeyRelease:
-                #ifdef USE_SENDIO_DIRECT
-                (*env)->CallVoidMethod(env, jwindow, sendKeyEventID, (jint) EVENT_KEY_RELEASED, 
-                                      modifiers, keySym, (jchar) -1);
-
-                (*env)->CallVoidMethod(env, jwindow, sendKeyEventID, (jint) EVENT_KEY_TYPED, 
-                                      modifiers, keySym, (jchar) keyChar);
-                #else
-                (*env)->CallVoidMethod(env, jwindow, enqueueKeyEventID, JNI_FALSE, (jint) EVENT_KEY_RELEASED, 
-                                      modifiers, keySym, (jchar) -1);
-
-                (*env)->CallVoidMethod(env, jwindow, enqueueKeyEventID, JNI_FALSE, (jint) EVENT_KEY_TYPED, 
-                                      modifiers, keySym, (jchar) keyChar);
-                #endif
-
+                sendKeyEvent(env, &batch, jwindow, (jint) EVENT_KEY_RELEASED, modifiers, keySym, (jchar) -1);
+                sendKeyEvent(env, &batch, jwindow, (jint) EVENT_KEY_TYPED, modifiers, keySym, (jchar) keyChar);
                 break;
             case DestroyNotify:
                 DBG_PRINT( "X11: event . DestroyNotify call %p, parent %p, child-event: %d\n", 
@@ -707,6 +776,124 @@ JNIEXPORT void JNICALL Java_jogamp_newt_driver_x11_DisplayDriver_DispatchMessage
                 DBG_PRINT("X11: event . unhandled %d 0x%X call %p\n", (int)evt.type, (unsigned int)evt.type, (void*)evt.xunmap.window);
         }
     }
+    InputEventBatch_flush(env, &batch);
+}
+
+/**
+ * EDT event wait: A wake-up pipe, polled together w/ the display connection.
+ */
+typedef struct {
+    int wakeFd[2]; /* [0] read end, [1] write end */
+} NewtEventWait;
+
+static int NewtEventWait_setFlags(int fd) {
+    int fl = fcntl(fd, F_GETFL, 0);
+    if( 0 > fl || 0 > fcntl(fd, F_SETFL, fl | O_NONBLOCK) ) {
+        return -1;
+    }
+    return fcntl(fd, F_SETFD, FD_CLOEXEC);
+}
+
+/*
+ * Class:     jogamp_newt_driver_x11_DisplayDriver
+ * Method:    CreateEventWait0
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_jogamp_newt_driver_x11_DisplayDriver_CreateEventWait0
+  (JNIEnv *env, jclass clazz)
+{
+    NewtEventWait * ew = (NewtEventWait *) calloc(1, sizeof(NewtEventWait));
+    if( NULL == ew ) {
+        return 0;
+    }
+    if( 0 != pipe(ew->wakeFd) ) {
+        fprintf(stderr, "Warning: NEWT X11 EventWait: pipe failed, errno %d, using polling EDT\n", errno);
+        free(ew);
+        return 0;
+    }
+    if( 0 > NewtEventWait_setFlags(ew->wakeFd[0]) || 0 > NewtEventWait_setFlags(ew->wakeFd[1]) ) {
+        fprintf(stderr, "Warning: NEWT X11 EventWait: fcntl failed, errno %d, using polling EDT\n", errno);
+        close(ew->wakeFd[0]);
+        close(ew->wakeFd[1]);
+        free(ew);
+        return 0;
+    }
+    DBG_PRINT( "X11: CreateEventWait0 %p, pipe %d/%d\n", ew, ew->wakeFd[0], ew->wakeFd[1]);
+    return (jlong) (intptr_t) ew;
+}
+
+/*
+ * Class:     jogamp_newt_driver_x11_DisplayDriver
+ * Method:    DestroyEventWait0
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_jogamp_newt_driver_x11_DisplayDriver_DestroyEventWait0
+  (JNIEnv *env, jclass clazz, jlong eventWait)
+{
+    NewtEventWait * ew = (NewtEventWait *) (intptr_t) eventWait;
+    if( NULL != ew ) {
+        close(ew->wakeFd[0]);
+        close(ew->wakeFd[1]);
+        free(ew);
+    }
 }
 
+/*
+ * Class:     jogamp_newt_driver_x11_DisplayDriver
+ * Method:    WaitForEvents0
+ * Signature: (JJI)V
+ */
+JNIEXPORT void JNICALL Java_jogamp_newt_driver_x11_DisplayDriver_WaitForEvents0
+  (JNIEnv *env, jclass clazz, jlong display, jlong eventWait, jint timeoutMS)
+{
+    Display * dpy = (Display *) (intptr_t) display;
+    NewtEventWait * ew = (NewtEventWait *) (intptr_t) eventWait;
+    struct pollfd fds[2];
+    int res;
+
+    if( NULL == dpy || NULL == ew ) {
+        return;
+    }
+
+    // Flush pending requests and don't block if Xlib has already queued events,
+    // those would not be signaled by the connection fd anymore.
+    if( 0 < XEventsQueued(dpy, QueuedAfterFlush) ) {
+        return;
+    }
+
+    fds[0].fd = ConnectionNumber(dpy);
+    fds[0].events = POLLIN;
+    fds[0].revents = 0;
+    fds[1].fd = ew->wakeFd[0];
+    fds[1].events = POLLIN;
+    fds[1].revents = 0;
 
+    res = poll(fds, 2, 0 < timeoutMS ? timeoutMS : -1);
+    if( 0 > res && EINTR != errno ) {
+        DBG_PRINT( "X11: WaitForEvents0 poll failed, errno %d\n", errno);
+        return;
+    }
+    if( 0 < res && 0 != ( fds[1].revents & POLLIN ) ) {
+        // consume all wake-ups
+        char buf[64];
+        while( 0 < read(ew->wakeFd[0], buf, sizeof(buf)) ) ;
+    }
+}
+
+/*
+ * Class:     jogamp_newt_driver_x11_DisplayDriver
+ * Method:    WakeUpEventWait0
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_jogamp_newt_driver_x11_DisplayDriver_WakeUpEventWait0
+  (JNIEnv *env, jclass clazz, jlong eventWait)
+{
+    NewtEventWait * ew = (NewtEventWait *) (intptr_t) eventWait;
+    if( NULL != ew ) {
+        const char c = 1;
+        // EAGAIN: pipe full, i.e. wake-up already pending
+        if( 0 > write(ew->wakeFd[1], &c, 1) && EAGAIN != errno ) {
+            DBG_PRINT( "X11: WakeUpEventWait0 write failed, errno %d\n", errno);
+        }
+    }
+}
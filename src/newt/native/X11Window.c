@@ -142,6 +142,27 @@ jobject getJavaWindowProperty(JNIEnv *env, Display *dpy, Window window, jlong ja
     return jwindow;
 }
 
+/**
+ * Returns the Java Window object of the given X11 window.
+ * <p>
+ * Uses the in-process table X11NewtJavaObjectContext first, i.e. w/o a server round trip.
+ * Falls back to the NEWT_JAVA_OBJECT window property, e.g. for windows not (anymore) registered in the table.
+ * </p>
+ */
+jobject getJavaWindow(JNIEnv *env, Display *dpy, Window window, jlong javaObjectAtom, Bool showWarning) {
+    XPointer jwindow = NULL;
+    jobject res;
+
+    if( 0 == XFindContext(dpy, window, X11NewtJavaObjectContext, &jwindow) && NULL != jwindow ) {
+        return (jobject) jwindow;
+    }
+
+    NewtDisplay_x11ErrorHandlerEnable(env, dpy, 1, 0, 0);
+    res = getJavaWindowProperty(env, dpy, window, javaObjectAtom, showWarning);
+    NewtDisplay_x11ErrorHandlerEnable(env, dpy, 0, 0, 1);
+    return res;
+}
+
 /** @return zero if fails, non zero if OK */
 Status NewtWindows_getRootAndParent (Display *dpy, Window w, Window * root_return, Window * parent_return) {
     Window *children_return=NULL;
@@ -623,6 +644,7 @@ JNIEXPORT jlong JNICALL Java_jogamp_newt_driver_x11_WindowDriver_CreateWindow0
     XSetWMProtocols(dpy, window, &wm_delete_atom, 1); // windowDeleteAtom
     jwindow = (*env)->NewGlobalRef(env, obj);
     setJavaWindowProperty(env, dpy, window, javaObjectAtom, jwindow);
+    XSaveContext(dpy, window, X11NewtJavaObjectContext, (XPointer)jwindow);
 
     NewtWindows_setNormalWindowEWMH(dpy, window);
     NewtWindows_setDecorations(dpy, window, TST_FLAG_IS_UNDECORATED(flags) ? False : True );
@@ -703,8 +725,9 @@ JNIEXPORT void JNICALL Java_jogamp_newt_driver_x11_WindowDriver_CloseWindow0
     NewtDisplay_x11ErrorHandlerEnable(env, dpy, 0, 0, 1);
 
     // Drain all events related to this window ..
-    Java_jogamp_newt_driver_x11_DisplayDriver_DispatchMessages0(env, obj, display, javaObjectAtom, windowDeleteAtom);
+    Java_jogamp_newt_driver_x11_DisplayDriver_DispatchMessages0(env, obj, display, javaObjectAtom, windowDeleteAtom, NULL, JNI_FALSE);
 
+    XDeleteContext(dpy, w, X11NewtJavaObjectContext);
     XDestroyWindow(dpy, w);
     XSync(dpy, False);
 
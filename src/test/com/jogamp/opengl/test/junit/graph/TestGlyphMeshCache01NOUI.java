@@ -0,0 +1,96 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.test.junit.graph;
+
+import java.io.IOException;
+import java.util.ArrayList;
+
+import jogamp.graph.curve.text.GlyphMeshCache;
+import jogamp.graph.curve.text.GlyphShape;
+import jogamp.graph.curve.text.GlyphString;
+import jogamp.graph.font.FontInt;
+
+import org.junit.Assert;
+import org.junit.Test;
+
+import com.jogamp.graph.font.Font;
+import com.jogamp.graph.font.FontFactory;
+import com.jogamp.graph.geom.Triangle;
+import com.jogamp.graph.geom.Vertex;
+import com.jogamp.graph.geom.opengl.SVertex;
+
+/**
+ * Validates the reuse and the instancing of the triangulated glyphs of {@link GlyphMeshCache}.
+ */
+public class TestGlyphMeshCache01NOUI {
+
+    @Test
+    public void test01GlyphsTriangulatedOnce() throws IOException {
+        final Font font = FontFactory.get(FontFactory.UBUNTU).getDefault();
+        final GlyphMeshCache cache = new GlyphMeshCache(SVertex.factory());
+        GlyphString.createString(cache, font, 24, "hello hello");
+        Assert.assertEquals(5, cache.getSize()); // h e l o ' '
+        GlyphString.createString(cache, font, 32, "hollow 1");
+        Assert.assertEquals(7, cache.getSize()); // w 1 added, size independent
+        GlyphString.createString(cache, font, 24, "hello 1");
+        Assert.assertEquals(7, cache.getSize());
+    }
+
+    @Test
+    public void test02InstanceIsScaledAndTranslated() throws IOException {
+        final FontInt font = (FontInt) FontFactory.get(FontFactory.UBUNTU).getDefault();
+        final GlyphMeshCache cache = new GlyphMeshCache(SVertex.factory());
+        final FontInt.GlyphInt glyph = (FontInt.GlyphInt) font.getGlyph('B');
+        final GlyphShape unit = cache.createGlyphShape(font, glyph, 0f, 0f, 1f);
+        final GlyphShape moved = cache.createGlyphShape(font, glyph, 10f, 20f, 0.5f);
+        Assert.assertNotNull(unit);
+        Assert.assertNotNull(moved);
+        Assert.assertEquals(1, cache.getSize());
+
+        final ArrayList<Vertex> uv = unit.getVertices();
+        final ArrayList<Vertex> mv = moved.getVertices();
+        Assert.assertEquals(uv.size(), mv.size());
+        for(int i=0; i<uv.size(); i++) {
+            Assert.assertEquals(uv.get(i).getX() * 0.5f + 10f, mv.get(i).getX(), 0.001f);
+            Assert.assertEquals(uv.get(i).getY() * 0.5f + 20f, mv.get(i).getY(), 0.001f);
+            Assert.assertEquals(uv.get(i).isOnCurve(), mv.get(i).isOnCurve());
+        }
+        final ArrayList<Triangle> ut = unit.triangulate();
+        final ArrayList<Triangle> mt = moved.triangulate();
+        Assert.assertEquals(ut.size(), mt.size());
+        Assert.assertTrue(0 < mt.size());
+        // instances never share vertices
+        Assert.assertNotSame(ut.get(0).getVertices()[0], mt.get(0).getVertices()[0]);
+
+        Assert.assertNull(cache.createGlyphShape(font, (FontInt.GlyphInt) font.getGlyph(' '), 0f, 0f, 1f));
+    }
+
+    public static void main(String args[]) {
+        org.junit.runner.JUnitCore.main(TestGlyphMeshCache01NOUI.class.getName());
+    }
+}
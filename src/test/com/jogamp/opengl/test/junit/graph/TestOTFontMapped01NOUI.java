@@ -0,0 +1,124 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.test.junit.graph;
+
+import java.io.File;
+import java.io.IOException;
+import java.net.URLConnection;
+
+import jogamp.graph.font.UbuntuFontLoader;
+import jogamp.graph.font.typecast.ot.OTFont;
+import jogamp.graph.font.typecast.ot.OTFontCollection;
+import jogamp.graph.font.typecast.ot.OTGlyph;
+import jogamp.graph.font.typecast.ot.Point;
+
+import org.junit.AfterClass;
+import org.junit.Assert;
+import org.junit.BeforeClass;
+import org.junit.Test;
+
+import com.jogamp.common.util.IOUtil;
+
+/**
+ * Validates the memory mapped, lazily decoded font against the eagerly read one
+ * and compares their load time.
+ */
+public class TestOTFontMapped01NOUI {
+    static final String fontPath = "fonts/ubuntu/Ubuntu-R.ttf";
+    static File fontFile;
+
+    @BeforeClass
+    public static void setup() throws IOException {
+        final URLConnection conn = IOUtil.getResource(UbuntuFontLoader.class, fontPath);
+        Assert.assertNotNull(conn);
+        fontFile = IOUtil.createTempFile("jogl.font", ".ttf", false, null);
+        Assert.assertTrue(0 < IOUtil.copyURLConn2File(conn, fontFile));
+    }
+
+    @AfterClass
+    public static void release() {
+        if( null != fontFile && !fontFile.delete() ) {
+            fontFile.deleteOnExit();
+        }
+    }
+
+    static void assertEquals(OTGlyph expected, OTGlyph has) {
+        if( null == expected ) {
+            Assert.assertNull(has);
+            return;
+        }
+        Assert.assertNotNull(has);
+        Assert.assertEquals(expected.getAdvanceWidth(), has.getAdvanceWidth());
+        Assert.assertEquals(expected.getLeftSideBearing(), has.getLeftSideBearing());
+        Assert.assertEquals(expected.getPointCount(), has.getPointCount());
+        for(int i=0; i<expected.getPointCount(); i++) {
+            final Point pe = expected.getPoint(i), ph = has.getPoint(i);
+            Assert.assertEquals(pe.x, ph.x);
+            Assert.assertEquals(pe.y, ph.y);
+            Assert.assertEquals(pe.onCurve, ph.onCurve);
+            Assert.assertEquals(pe.endOfContour, ph.endOfContour);
+        }
+    }
+
+    @Test
+    public void test01MappedEqualsEager() throws IOException {
+        final OTFont eager = OTFontCollection.create(fontFile).getFont(0);
+        final OTFont mapped = OTFontCollection.createMapped(fontFile, 16).getFont(0); // small cache, forces evictions
+        Assert.assertEquals(eager.getNumGlyphs(), mapped.getNumGlyphs());
+        Assert.assertEquals(eager.getAscent(), mapped.getAscent());
+        Assert.assertEquals(eager.getDescent(), mapped.getDescent());
+        Assert.assertEquals(eager.getAllNames(null, ", ").toString(), mapped.getAllNames(null, ", ").toString());
+        for(int pass=0; pass<2; pass++) {
+            for(int i=0; i<eager.getNumGlyphs(); i++) {
+                assertEquals(eager.getGlyph(i), mapped.getGlyph(i));
+            }
+        }
+    }
+
+    @Test
+    public void test02LoadTime() throws IOException {
+        final int loops = 10;
+        long tEager = 0, tMapped = 0;
+        for(int i=0; i<loops; i++) {
+            long t0 = System.nanoTime();
+            OTFont f = OTFontCollection.create(fontFile).getFont(0);
+            f.getGlyph(f.getCmapTable().getCmapFormat((short)3, (short)1).mapCharCode('A'));
+            long t1 = System.nanoTime();
+            f = OTFontCollection.createMapped(fontFile, 256).getFont(0);
+            f.getGlyph(f.getCmapTable().getCmapFormat((short)3, (short)1).mapCharCode('A'));
+            long t2 = System.nanoTime();
+            tEager += t1 - t0;
+            tMapped += t2 - t1;
+        }
+        System.err.println("Load until first glyph: eager "+tEager/loops/1000+" us, mapped "+tMapped/loops/1000+" us");
+    }
+
+    public static void main(String args[]) {
+        org.junit.runner.JUnitCore.main(TestOTFontMapped01NOUI.class.getName());
+    }
+}
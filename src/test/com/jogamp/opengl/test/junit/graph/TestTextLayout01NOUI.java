@@ -0,0 +1,97 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.test.junit.graph;
+
+import java.io.IOException;
+import java.util.ArrayList;
+
+import jogamp.graph.font.FontInt;
+
+import org.junit.Assert;
+import org.junit.Test;
+
+import com.jogamp.graph.curve.OutlineShape;
+import com.jogamp.graph.font.Font;
+import com.jogamp.graph.font.FontFactory;
+import com.jogamp.graph.geom.AABBox;
+import com.jogamp.graph.geom.opengl.SVertex;
+
+/**
+ * Validates the string metrics and outlines of the shaped glyph runs,
+ * i.e. incl. kerning and ligatures.
+ */
+public class TestTextLayout01NOUI {
+    static final float pixelSize = 24f;
+
+    @Test
+    public void test01KerningNotWider() throws IOException {
+        final Font font = FontFactory.get(FontFactory.UBUNTU).getDefault();
+        final String[] pairs = { "AV", "To", "Ty", "LT", "WA" };
+        for(int i=0; i<pairs.length; i++) {
+            final String p = pairs[i];
+            final float w = font.getStringWidth(p, pixelSize);
+            final float w0 = font.getStringWidth(p.substring(0, 1), pixelSize);
+            final float w1 = font.getStringWidth(p.substring(1, 2), pixelSize);
+            System.err.println("Pair "+p+": "+w+", unkerned "+(w0+w1));
+            Assert.assertTrue(w <= w0 + w1 + 1f);
+        }
+    }
+
+    @Test
+    public void test02BoundsMatchWidth() throws IOException {
+        final Font font = FontFactory.get(FontFactory.UBUNTU).getDefault();
+        final String line0 = "Kerning AVAVA office";
+        final String line1 = "fi";
+        final AABBox bounds = font.getStringBounds(line0+"\n"+line1, pixelSize);
+        final AABBox bounds0 = font.getStringBounds(line0, pixelSize);
+        Assert.assertEquals(bounds0.getWidth(), bounds.getWidth(), 0.0001f);
+        Assert.assertEquals(2f * bounds0.getHeight(), bounds.getHeight(), 0.0001f);
+        // per glyph rounded advances, off by at most one pixel per glyph and kerning adjustment
+        final float w0 = font.getStringWidth(line0, pixelSize);
+        Assert.assertEquals(0f, w0 - (int)w0, 0f);
+        Assert.assertEquals(bounds0.getWidth(), w0, line0.length());
+        // width of the last line
+        Assert.assertEquals(font.getStringWidth(line1, pixelSize), font.getStringWidth(line0+"\n"+line1, pixelSize), 0.0001f);
+    }
+
+    @Test
+    public void test03OutlinesOfRun() throws IOException {
+        final Font font = FontFactory.get(FontFactory.UBUNTU).getDefault();
+        final String text = "fluffy office";
+        final ArrayList<OutlineShape> shapes = ((FontInt)font).getOutlineShapes(text, pixelSize, SVertex.factory());
+        // ligatures may merge glyphs, but never add any
+        Assert.assertTrue(0 < shapes.size());
+        Assert.assertTrue(text.length() >= shapes.size());
+        // cached run, same result
+        Assert.assertEquals(shapes.size(), ((FontInt)font).getOutlineShapes(text, pixelSize, SVertex.factory()).size());
+    }
+
+    public static void main(String args[]) {
+        org.junit.runner.JUnitCore.main(TestTextLayout01NOUI.class.getName());
+    }
+}
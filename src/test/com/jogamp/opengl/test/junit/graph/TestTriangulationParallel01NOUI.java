@@ -0,0 +1,143 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.test.junit.graph;
+
+import java.io.IOException;
+import java.util.ArrayList;
+
+import jogamp.graph.font.FontInt;
+
+import org.junit.Assert;
+import org.junit.Test;
+
+import com.jogamp.graph.curve.OutlineShape;
+import com.jogamp.graph.curve.tess.Triangulation;
+import com.jogamp.graph.font.Font;
+import com.jogamp.graph.font.FontFactory;
+import com.jogamp.graph.font.FontSet;
+import com.jogamp.graph.geom.Triangle;
+import com.jogamp.graph.geom.Vertex;
+import com.jogamp.graph.geom.opengl.SVertex;
+
+/**
+ * Validates the parallel batch triangulation against the serial one
+ * and benchmarks both over the glyphs of the bundled Ubuntu fonts.
+ */
+public class TestTriangulationParallel01NOUI {
+    static final int[][] fontStyles = {
+        { FontSet.FAMILY_REGULAR, 0 }, { FontSet.FAMILY_REGULAR, FontSet.STYLE_BOLD },
+        { FontSet.FAMILY_REGULAR, FontSet.STYLE_ITALIC }, { FontSet.FAMILY_REGULAR, FontSet.STYLE_BOLD | FontSet.STYLE_ITALIC },
+        { FontSet.FAMILY_LIGHT, 0 }, { FontSet.FAMILY_MEDIUM, 0 }, { FontSet.FAMILY_MONOSPACED, 0 } };
+    static final String text;
+    static {
+        final StringBuilder sb = new StringBuilder();
+        for(char c='!'; c<='~'; c++) {
+            sb.append(c);
+        }
+        text = sb.toString();
+    }
+    static final int loops = 5;
+
+    static ArrayList<OutlineShape> getShapes(Font font) {
+        final ArrayList<OutlineShape> shapes = ((FontInt)font).getOutlineShapes(text, 48, SVertex.factory());
+        final ArrayList<OutlineShape> res = new ArrayList<OutlineShape>();
+        for(int i=0; i<shapes.size(); i++) {
+            if( 0 < shapes.get(i).getOutlineNumber() ) {
+                res.add(shapes.get(i));
+            }
+        }
+        return res;
+    }
+
+    static ArrayList<ArrayList<Triangle>> triangulateSerial(ArrayList<OutlineShape> shapes) {
+        final ArrayList<ArrayList<Triangle>> res = new ArrayList<ArrayList<Triangle>>();
+        for(int i=0; i<shapes.size(); i++) {
+            final OutlineShape shape = shapes.get(i);
+            shape.transformOutlines(OutlineShape.VerticesState.QUADRATIC_NURBS);
+            res.add(shape.triangulate());
+        }
+        return res;
+    }
+
+    static void assertEquals(ArrayList<ArrayList<Triangle>> expected, ArrayList<ArrayList<Triangle>> has) {
+        Assert.assertEquals(expected.size(), has.size());
+        for(int i=0; i<expected.size(); i++) {
+            final ArrayList<Triangle> te = expected.get(i), th = has.get(i);
+            Assert.assertEquals(te.size(), th.size());
+            for(int j=0; j<te.size(); j++) {
+                final Vertex[] ve = te.get(j).getVertices(), vh = th.get(j).getVertices();
+                for(int k=0; k<3; k++) {
+                    Assert.assertEquals(ve[k].getId(), vh[k].getId());
+                    Assert.assertEquals(ve[k].getX(), vh[k].getX(), 0f);
+                    Assert.assertEquals(ve[k].getY(), vh[k].getY(), 0f);
+                }
+            }
+        }
+    }
+
+    @Test
+    public void test01ParallelEqualsSerial() throws IOException {
+        final FontSet fontSet = FontFactory.get(FontFactory.UBUNTU);
+        for(int f=0; f<fontStyles.length; f++) {
+            final Font font = fontSet.get(fontStyles[f][0], fontStyles[f][1]);
+            final ArrayList<ArrayList<Triangle>> serial = triangulateSerial(getShapes(font));
+            final ArrayList<ArrayList<Triangle>> parallel = Triangulation.triangulate(getShapes(font));
+            assertEquals(serial, parallel);
+        }
+    }
+
+    @Test
+    public void test02Benchmark() throws IOException {
+        final FontSet fontSet = FontFactory.get(FontFactory.UBUNTU);
+        long tSerial = 0, tParallel = 0;
+        int shapeCount = 0;
+        for(int l=0; l<loops; l++) {
+            for(int f=0; f<fontStyles.length; f++) {
+                final Font font = fontSet.get(fontStyles[f][0], fontStyles[f][1]);
+                final ArrayList<OutlineShape> s0 = getShapes(font);
+                final ArrayList<OutlineShape> s1 = getShapes(font);
+                final long t0 = System.nanoTime();
+                triangulateSerial(s0);
+                final long t1 = System.nanoTime();
+                Triangulation.triangulate(s1);
+                final long t2 = System.nanoTime();
+                if( 0 < l ) { // warm up
+                    tSerial += t1 - t0;
+                    tParallel += t2 - t1;
+                    shapeCount += s0.size();
+                }
+            }
+        }
+        System.err.println("Triangulated "+shapeCount+" glyphs: serial "+tSerial/1000000+" ms, parallel "+tParallel/1000000+" ms, "+
+                           Runtime.getRuntime().availableProcessors()+" cores");
+    }
+
+    public static void main(String args[]) {
+        org.junit.runner.JUnitCore.main(TestTriangulationParallel01NOUI.class.getName());
+    }
+}
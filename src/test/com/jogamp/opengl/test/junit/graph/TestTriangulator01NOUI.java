@@ -0,0 +1,191 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.test.junit.graph;
+
+import java.io.IOException;
+import java.util.ArrayList;
+
+import jogamp.graph.font.FontInt;
+
+import org.junit.Assert;
+import org.junit.Test;
+
+import com.jogamp.graph.curve.OutlineShape;
+import com.jogamp.graph.curve.tess.Triangulation;
+import com.jogamp.graph.font.Font;
+import com.jogamp.graph.font.FontFactory;
+import com.jogamp.graph.font.FontSet;
+import com.jogamp.graph.geom.Triangle;
+import com.jogamp.graph.geom.Vertex;
+import com.jogamp.graph.geom.opengl.SVertex;
+
+/**
+ * Compares the {@link Triangulation#MONOTONE} against the {@link Triangulation#CDT} triangulation
+ * regarding correctness and throughput, using the glyphs of the bundled Ubuntu fonts 
+ * and a synthetic star polygon with a grid of square holes.
+ */
+public class TestTriangulator01NOUI {
+    static final int[][] fontStyles = {
+        { FontSet.FAMILY_REGULAR, 0 }, { FontSet.FAMILY_REGULAR, FontSet.STYLE_BOLD },
+        { FontSet.FAMILY_REGULAR, FontSet.STYLE_ITALIC }, { FontSet.FAMILY_LIGHT, 0 }, { FontSet.FAMILY_MONOSPACED, 0 } };
+    static final String text;
+    static {
+        final StringBuilder sb = new StringBuilder();
+        for(char c='!'; c<='~'; c++) {
+            sb.append(c);
+        }
+        text = sb.toString();
+    }
+    static final int loops = 5;
+
+    static ArrayList<OutlineShape> getGlyphShapes(Font font) {
+        final ArrayList<OutlineShape> shapes = ((FontInt)font).getOutlineShapes(text, 48, SVertex.factory());
+        final ArrayList<OutlineShape> res = new ArrayList<OutlineShape>();
+        for(int i=0; i<shapes.size(); i++) {
+            final OutlineShape shape = shapes.get(i);
+            if( 0 < shape.getOutlineNumber() ) {
+                shape.transformOutlines(OutlineShape.VerticesState.QUADRATIC_NURBS);
+                res.add(shape);
+            }
+        }
+        return res;
+    }
+
+    /** 
+     * Star polygon of <code>points</code> spikes, i.e. 2*points vertices, of radius 100 
+     * with <code>grid</code>x<code>grid</code> square holes of size 4.
+     */
+    static OutlineShape getStarShape(int points, int grid) {
+        final OutlineShape shape = new OutlineShape(SVertex.factory());
+        for(int i=0; i<2*points; i++) {
+            final double a = Math.PI * i / points;
+            final double r = 0 == i%2 ? 100 : 80;
+            shape.addVertex((float)(r*Math.cos(a)), (float)(r*Math.sin(a)), true);
+        }
+        shape.closeLastOutline();
+        for(int y=0; y<grid; y++) {
+            for(int x=0; x<grid; x++) {
+                final float x0 = -5*grid + 10*x + 3, y0 = -5*grid + 10*y + 3;
+                shape.addEmptyOutline();
+                shape.addVertex(x0,   y0,   true);
+                shape.addVertex(x0,   y0+4, true);
+                shape.addVertex(x0+4, y0+4, true);
+                shape.addVertex(x0+4, y0,   true);
+                shape.closeLastOutline();
+            }
+        }
+        return shape;
+    }
+
+    static double getStarArea(int points, int grid) {
+        // 2*points triangles of the center and the outer edges, minus the holes
+        return 2 * points * 0.5 * 100 * 80 * Math.sin(Math.PI / points) - grid * grid * 16;
+    }
+
+    static double getArea(ArrayList<Triangle> triangles) {
+        double area = 0;
+        for(int i=0; i<triangles.size(); i++) {
+            area += getArea(triangles.get(i));
+        }
+        return area;
+    }
+
+    static double getArea(Triangle t) {
+        final Vertex[] v = t.getVertices();
+        return 0.5 * ( ( v[1].getX() - v[0].getX() ) * ( v[2].getY() - v[0].getY() ) - 
+                       ( v[1].getY() - v[0].getY() ) * ( v[2].getX() - v[0].getX() ) );
+    }
+
+    @Test
+    public void test01GlyphsEqualArea() throws IOException {
+        final FontSet fontSet = FontFactory.get(FontFactory.UBUNTU);
+        for(int f=0; f<fontStyles.length; f++) {
+            final Font font = fontSet.get(fontStyles[f][0], fontStyles[f][1]);
+            final ArrayList<OutlineShape> s0 = getGlyphShapes(font);
+            final ArrayList<OutlineShape> s1 = getGlyphShapes(font);
+            double areaCDT = 0, areaMonotone = 0;
+            for(int i=0; i<s0.size(); i++) {
+                final ArrayList<Triangle> t0 = s0.get(i).triangulate(Triangulation.create(Triangulation.CDT));
+                final ArrayList<Triangle> t1 = s1.get(i).triangulate(Triangulation.create(Triangulation.MONOTONE));
+                for(int j=0; j<t1.size(); j++) {
+                    Assert.assertTrue("CW triangle "+t1.get(j), getArea(t1.get(j)) >= 0);
+                }
+                areaCDT += Math.abs(getArea(t0));
+                areaMonotone += getArea(t1);
+            }
+            System.err.println(font.getName(Font.NAME_UNIQUNAME)+": area CDT "+areaCDT+", monotone "+areaMonotone);
+            Assert.assertEquals(areaCDT, areaMonotone, areaCDT * 0.01);
+        }
+    }
+
+    @Test
+    public void test02StarWithHoles() {
+        final int points = 1000, grid = 8;
+        final ArrayList<Triangle> triangles = getStarShape(points, grid).triangulate(Triangulation.create(Triangulation.MONOTONE));
+        // n vertices, h holes: n + 2h - 2 triangles
+        Assert.assertEquals(2*points + 4*grid*grid + 2*grid*grid - 2, triangles.size());
+        final double area = getStarArea(points, grid);
+        Assert.assertEquals(area, getArea(triangles), area * 1e-4);
+    }
+
+    @Test
+    public void test03Benchmark() throws IOException {
+        final FontSet fontSet = FontFactory.get(FontFactory.UBUNTU);
+        final int[] types = { Triangulation.CDT, Triangulation.MONOTONE };
+        final String[] names = { "CDT", "monotone" };
+        for(int t=0; t<types.length; t++) {
+            long tGlyphs = 0, tStar = 0;
+            int glyphCount = 0;
+            for(int l=0; l<loops; l++) {
+                for(int f=0; f<fontStyles.length; f++) {
+                    final ArrayList<OutlineShape> shapes = getGlyphShapes(fontSet.get(fontStyles[f][0], fontStyles[f][1]));
+                    final long t0 = System.nanoTime();
+                    for(int i=0; i<shapes.size(); i++) {
+                        shapes.get(i).triangulate(Triangulation.create(types[t]));
+                    }
+                    if( 0 < l ) { // warm up
+                        tGlyphs += System.nanoTime() - t0;
+                        glyphCount += shapes.size();
+                    }
+                }
+                final OutlineShape star = getStarShape(250, 4);
+                final long t0 = System.nanoTime();
+                star.triangulate(Triangulation.create(types[t]));
+                if( 0 < l ) {
+                    tStar += System.nanoTime() - t0;
+                }
+            }
+            System.err.println(names[t]+": "+glyphCount+" glyphs in "+tGlyphs/1000000+" ms, "+
+                               (loops-1)+" stars of 564 vertices in "+tStar/1000000+" ms");
+        }
+    }
+
+    public static void main(String args[]) {
+        org.junit.runner.JUnitCore.main(TestTriangulator01NOUI.class.getName());
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.test.junit.jogl.acore;
+
+import org.junit.Assert;
+import org.junit.Test;
+
+import com.jogamp.opengl.util.FPSAnimator;
+
+/**
+ * Validates {@link FPSAnimator.Pacing#Deadline} pacing: the fractional 60 Hz period must be met on average
+ * and the frame time statistics of the {@link javax.media.opengl.FPSCounter} must be consistent.
+ * The animator has no drawables, i.e. only the pacing itself is measured.
+ */
+public class TestFPSAnimatorPacing01NOUI {
+    static final int fps = 60;
+    static final long durationMS = 2000;
+
+    static FPSAnimator run(FPSAnimator.Pacing pacing) throws InterruptedException {
+        final FPSAnimator animator = new FPSAnimator(fps, true);
+        animator.setPacing(pacing);
+        Assert.assertEquals(pacing, animator.getPacing());
+        animator.setUpdateFPSFrames(fps, System.err);
+        Assert.assertTrue(animator.start());
+        Assert.assertTrue(animator.isStarted());
+        Assert.assertTrue(animator.isAnimating());
+        Thread.sleep(durationMS);
+        Assert.assertTrue(animator.pause());
+        Assert.assertTrue(animator.isPaused());
+        System.err.println(pacing+": "+animator.getTotalFPS()+" fps, frame time min "+animator.getLastFrameTimeMin()+
+                           ", avg "+animator.getLastFrameTimeAvg()+", p99 "+animator.getLastFrameTimeP99()+
+                           ", max "+animator.getLastFrameTimeMax()+" ms, missed "+animator.getTotalMissedDeadlines());
+        return animator;
+    }
+
+    @Test
+    public void test01Deadline() throws InterruptedException {
+        final FPSAnimator animator = run(FPSAnimator.Pacing.Deadline);
+        final float avg = animator.getLastFrameTimeAvg();
+        Assert.assertEquals(1000f / fps, avg, 1f);
+        Assert.assertTrue(animator.getLastFrameTimeMin() <= avg);
+        Assert.assertTrue(animator.getLastFrameTimeP99() <= animator.getLastFrameTimeMax());
+        Assert.assertEquals(fps, animator.getTotalFPS(), 3f);
+        
+        // resume continues pacing, pacing can't be changed while started
+        Assert.assertTrue(animator.resume());
+        Assert.assertTrue(animator.isAnimating());
+        try {
+            animator.setPacing(FPSAnimator.Pacing.Timer);
+            Assert.fail("setPacing while started");
+        } catch (javax.media.opengl.GLException e) { }
+        Assert.assertTrue(animator.stop());
+        Assert.assertFalse(animator.isStarted());
+    }
+
+    @Test
+    public void test02Timer() throws InterruptedException {
+        final FPSAnimator animator = run(FPSAnimator.Pacing.Timer);
+        Assert.assertEquals(0, animator.getTotalMissedDeadlines());
+        Assert.assertTrue(animator.stop());
+    }
+
+    public static void main(String args[]) {
+        org.junit.runner.JUnitCore.main(TestFPSAnimatorPacing01NOUI.class.getName());
+    }
+}
@@ -0,0 +1,159 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.test.junit.jogl.acore;
+
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import javax.media.opengl.GLAutoDrawable;
+import javax.media.opengl.GLCapabilities;
+import javax.media.opengl.GLProfile;
+import javax.media.opengl.GLRunnable;
+
+import org.junit.Assert;
+import org.junit.Test;
+
+import com.jogamp.newt.opengl.GLWindow;
+import com.jogamp.opengl.test.junit.jogl.demos.es2.GearsES2;
+import com.jogamp.opengl.test.junit.util.UITestCase;
+import com.jogamp.opengl.util.Animator;
+
+/**
+ * Submits {@link GLRunnable}s from multiple threads to an animated {@link GLWindow},
+ * validating that each is executed exactly once, the futures of {@link GLWindow#invokeFuture(GLRunnable)}
+ * and the deferral of GLRunnables exceeding the per frame time budget.
+ */
+public class TestGLRunnableQueue01NEWT extends UITestCase {
+    static final int threadCount = 4;
+    static final int runnablesPerThread = 2000;
+
+    static GLWindow createWindow() {
+        final GLCapabilities caps = new GLCapabilities(GLProfile.getGL2ES2());
+        final GLWindow glWindow = GLWindow.create(caps);
+        glWindow.setSize(256, 256);
+        glWindow.addGLEventListener(new GearsES2(0));
+        glWindow.setVisible(true);
+        return glWindow;
+    }
+
+    @Test
+    public void test01MultipleProducers() throws InterruptedException, ExecutionException {
+        final GLWindow glWindow = createWindow();
+        final Animator animator = new Animator(glWindow);
+        animator.start();
+        
+        final AtomicInteger executed = new AtomicInteger(0);
+        final GLRunnable counter = new GLRunnable() {
+            public boolean run(GLAutoDrawable drawable) {
+                Assert.assertNotNull(drawable.getGL());
+                executed.incrementAndGet();
+                return true;
+            }
+        };
+        final Thread[] producers = new Thread[threadCount];
+        for(int i=0; i<threadCount; i++) {
+            producers[i] = new Thread(new Runnable() {
+                public void run() {
+                    for(int j=0; j<runnablesPerThread; j++) {
+                        Assert.assertTrue(glWindow.invoke(false, counter));
+                    }
+                }
+            }, "Producer-"+i);
+            producers[i].start();
+        }
+        for(int i=0; i<threadCount; i++) {
+            producers[i].join();
+        }
+        // queued after all others, hence executed last
+        final Future<Boolean> last = glWindow.invokeFuture(counter);
+        try {
+            Assert.assertEquals(Boolean.TRUE, last.get(5, TimeUnit.SECONDS));
+        } catch (java.util.concurrent.TimeoutException e) {
+            Assert.fail("GLRunnable not executed: "+e);
+        }
+        Assert.assertTrue(last.isDone());
+        Assert.assertEquals(threadCount * runnablesPerThread + 1, executed.get());
+        
+        // exceptions are passed to the future
+        final Future<Boolean> failing = glWindow.invokeFuture(new GLRunnable() {
+            public boolean run(GLAutoDrawable drawable) {
+                throw new IllegalStateException("expected");
+            }
+        });
+        try {
+            failing.get();
+            Assert.fail("no exception");
+        } catch (ExecutionException e) {
+            Assert.assertTrue(e.getCause() instanceof IllegalStateException);
+        }
+        
+        animator.stop();
+        glWindow.destroy();
+    }
+
+    @Test
+    public void test02TimeBudget() throws InterruptedException {
+        final GLWindow glWindow = createWindow();
+        glWindow.setGLRunnableTimeBudget(TimeUnit.MILLISECONDS.toNanos(5));
+        final Animator animator = new Animator(glWindow);
+        animator.start();
+        
+        final AtomicInteger executed = new AtomicInteger(0);
+        final GLRunnable slow = new GLRunnable() {
+            public boolean run(GLAutoDrawable drawable) {
+                try {
+                    Thread.sleep(2);
+                } catch (InterruptedException e) { }
+                executed.incrementAndGet();
+                return true;
+            }
+        };
+        final int frames0 = animator.getTotalFPSFrames();
+        animator.setUpdateFPSFrames(1, null);
+        final int count = 20;
+        for(int i=0; i<count; i++) {
+            glWindow.invoke(false, slow);
+        }
+        for(int i=0; i<500 && executed.get() < count; i++) {
+            Thread.sleep(10);
+        }
+        Assert.assertEquals(count, executed.get());
+        // at most 3 runnables of 2 ms each fit into 5 ms per frame
+        System.err.println("Frames "+frames0+" -> "+animator.getTotalFPSFrames());
+        Assert.assertTrue(animator.getTotalFPSFrames() >= count / 3);
+        
+        animator.stop();
+        glWindow.destroy();
+    }
+
+    public static void main(String args[]) {
+        org.junit.runner.JUnitCore.main(TestGLRunnableQueue01NEWT.class.getName());
+    }
+}
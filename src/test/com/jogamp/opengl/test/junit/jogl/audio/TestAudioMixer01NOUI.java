@@ -0,0 +1,186 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.test.junit.jogl.audio;
+
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.util.ArrayList;
+
+import org.junit.Assert;
+import org.junit.Test;
+
+import com.jogamp.audio.windows.waveout.Audio;
+import com.jogamp.audio.windows.waveout.Mixer;
+import com.jogamp.audio.windows.waveout.NullSink;
+import com.jogamp.audio.windows.waveout.Track;
+
+/**
+ * Validates the block based {@link Mixer}, i.e. accumulation of all playing tracks 
+ * and clipping of the stereo S16 output, captured by a pure Java {@link NullSink}.
+ * <p>
+ * All tracks are placed at the origin, hence both speakers apply the same gain
+ * <code>falloff / ( falloff + 1 )</code>.
+ * </p>
+ */
+public class TestAudioMixer01NOUI {
+    static final int periodFrames = 256;
+    /** Tracks fit into one {@link Track} buffer, hence they never stall on the filler thread */
+    static final int trackSamples = 8 * periodFrames;
+
+    /** Keeps all non silent periods as signed 16 bit samples */
+    static class CaptureSink extends NullSink {
+        final ArrayList<short[]> periods = new ArrayList<short[]>();
+
+        CaptureSink() {
+            super(false);
+        }
+
+        @Override
+        protected void consume(byte[] data, int offset, int length) {
+            final short[] samples = new short[length / 2];
+            boolean silent = true;
+            for(int i=0; i<samples.length; i++) {
+                samples[i] = (short) ( ( data[offset+2*i+1] << 8 ) | ( data[offset+2*i] & 0xff ) );
+                silent = silent && 0 == samples[i];
+            }
+            if( !silent ) {
+                synchronized(periods) {
+                    periods.add(samples);
+                }
+            }
+        }
+
+        short[][] getPeriods() {
+            synchronized(periods) {
+                return periods.toArray(new short[periods.size()][]);
+            }
+        }
+    }
+
+    /** @return a mono raw sound of constant signed 16 bit little endian samples */
+    static File createRawSound(short value) throws IOException {
+        final File file = File.createTempFile("jogl-mixer-", ".rawsound");
+        file.deleteOnExit();
+        final byte[] data = new byte[trackSamples * 2];
+        for(int i=0; i<trackSamples; i++) {
+            data[2*i]   = (byte)   value;
+            data[2*i+1] = (byte) ( value >> 8 );
+        }
+        final FileOutputStream out = new FileOutputStream(file);
+        try {
+            out.write(data);
+        } finally {
+            out.close();
+        }
+        return file;
+    }
+
+    /** Plays both tracks to their end and returns all non silent periods */
+    static short[][] mix(float falloff, short value0, short value1) throws IOException, InterruptedException {
+        final CaptureSink sink = new CaptureSink();
+        final Mixer mixer = new Mixer(Track.DEFAULT_SAMPLE_RATE, periodFrames, 2, sink);
+        try {
+            mixer.setFalloffFactor(falloff);
+            final Audio audio = new Audio(mixer);
+            final Track t0 = audio.newTrack(createRawSound(value0));
+            final Track t1 = audio.newTrack(createRawSound(value1));
+            t0.play();
+            t1.play();
+            final long t_end = System.currentTimeMillis() + 5000;
+            while( ( t0.isPlaying() || t1.isPlaying() ) && System.currentTimeMillis() < t_end ) {
+                Thread.sleep(10);
+            }
+            Assert.assertFalse("tracks not done", t0.isPlaying() || t1.isPlaying());
+        } finally {
+            mixer.shutdown();
+        }
+        final short[][] periods = sink.getPeriods();
+        Assert.assertTrue("no output", 0 < periods.length);
+        for(int p=0; p<periods.length; p++) {
+            Assert.assertEquals(periodFrames * 2, periods[p].length);
+        }
+        return periods;
+    }
+
+    /** @return the number of periods, where all samples of both channels equal the given value */
+    static int countPeriods(short[][] periods, int value) {
+        int count = 0;
+        for(int p=0; p<periods.length; p++) {
+            boolean all = true;
+            for(int i=0; all && i<periods[p].length; i++) {
+                all = value == periods[p][i];
+            }
+            if( all ) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    @Test
+    public void test01Accumulate() throws IOException, InterruptedException {
+        // gain 0.5
+        final short[][] periods = mix(1f, (short)10000, (short)30000);
+        Assert.assertTrue("no mixed period", 0 < countPeriods(periods, 20000));
+        for(int p=0; p<periods.length; p++) {
+            for(int i=0; i<periods[p].length; i++) {
+                final short s = periods[p][i];
+                // both tracks, a single one while the other one is not playing, or silence at the end
+                Assert.assertTrue("sample "+s+" of period "+p, 20000 == s || 5000 == s || 15000 == s || 0 == s);
+            }
+        }
+    }
+
+    @Test
+    public void test02ClipPositive() throws IOException, InterruptedException {
+        // gain ~1, 30000 + 20000 exceeds the S16 range
+        final short[][] periods = mix(1000000f, (short)30000, (short)20000);
+        Assert.assertTrue("no clipped period", 0 < countPeriods(periods, Short.MAX_VALUE));
+        for(int p=0; p<periods.length; p++) {
+            for(int i=0; i<periods[p].length; i++) {
+                Assert.assertTrue("wrapped around: "+periods[p][i], 0 <= periods[p][i]);
+            }
+        }
+    }
+
+    @Test
+    public void test03ClipNegative() throws IOException, InterruptedException {
+        final short[][] periods = mix(1000000f, (short)-30000, (short)-20000);
+        Assert.assertTrue("no clipped period", 0 < countPeriods(periods, Short.MIN_VALUE));
+        for(int p=0; p<periods.length; p++) {
+            for(int i=0; i<periods[p].length; i++) {
+                Assert.assertTrue("wrapped around: "+periods[p][i], 0 >= periods[p][i]);
+            }
+        }
+    }
+
+    public static void main(String args[]) {
+        org.junit.runner.JUnitCore.main(TestAudioMixer01NOUI.class.getName());
+    }
+}
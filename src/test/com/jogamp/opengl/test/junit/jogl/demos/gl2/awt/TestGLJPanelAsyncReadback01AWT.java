@@ -0,0 +1,162 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.test.junit.jogl.demos.gl2.awt;
+
+import java.awt.BorderLayout;
+import java.awt.Graphics;
+import java.awt.image.BufferedImage;
+import java.lang.reflect.InvocationTargetException;
+
+import javax.media.opengl.GL;
+import javax.media.opengl.GLAutoDrawable;
+import javax.media.opengl.GLCapabilities;
+import javax.media.opengl.GLEventListener;
+import javax.media.opengl.GLProfile;
+import javax.media.opengl.awt.GLJPanel;
+import javax.swing.JFrame;
+import javax.swing.SwingUtilities;
+
+import org.junit.Assert;
+import org.junit.Test;
+
+import com.jogamp.opengl.test.junit.util.MiscUtils;
+import com.jogamp.opengl.test.junit.util.UITestCase;
+import com.jogamp.opengl.util.FPSAnimator;
+
+/**
+ * Validates the {@link GLJPanel#setAsyncReadback(boolean) GPU read back mode} of GLJPanel,
+ * i.e. the GPU vertical flip and the PBO read back, w/ and w/o animation.
+ * <p>
+ * Renders the upper half red and the lower half blue, 
+ * and validates the orientation of the panel's painted image.
+ * </p>
+ */
+public class TestGLJPanelAsyncReadback01AWT extends UITestCase {
+    static int width = 256, height = 256;
+    static long duration = 500; // ms
+
+    static class TwoColors implements GLEventListener {
+        volatile int frames = 0;
+        int w, h;
+
+        public void init(GLAutoDrawable drawable) { }
+        public void dispose(GLAutoDrawable drawable) { }
+        public void reshape(GLAutoDrawable drawable, int x, int y, int width, int height) {
+            w = width;
+            h = height;
+        }
+        public void display(GLAutoDrawable drawable) {
+            final GL gl = drawable.getGL();
+            gl.glClearColor(0f, 0f, 1f, 1f);
+            gl.glClear(GL.GL_COLOR_BUFFER_BIT);
+            gl.glEnable(GL.GL_SCISSOR_TEST);
+            gl.glScissor(0, h/2, w, h - h/2); // GL origin is bottom left
+            gl.glClearColor(1f, 0f, 0f, 1f);
+            gl.glClear(GL.GL_COLOR_BUFFER_BIT);
+            gl.glDisable(GL.GL_SCISSOR_TEST);
+            frames++;
+        }
+    }
+
+    static BufferedImage paint(final GLJPanel glJPanel) throws InterruptedException, InvocationTargetException {
+        final BufferedImage image = new BufferedImage(width, height, BufferedImage.TYPE_INT_RGB);
+        SwingUtilities.invokeAndWait(new Runnable() {
+            public void run() {
+                final Graphics g = image.getGraphics();
+                glJPanel.paint(g);
+                g.dispose();
+            } } );
+        return image;
+    }
+
+    static void validateOrientation(BufferedImage image) {
+        final int top    = image.getRGB(width/2, 2) & 0x00FFFFFF;
+        final int bottom = image.getRGB(width/2, height-3) & 0x00FFFFFF;
+        System.err.println("top 0x"+Integer.toHexString(top)+", bottom 0x"+Integer.toHexString(bottom));
+        Assert.assertEquals("top not red", 0x00FF0000, top);
+        Assert.assertEquals("bottom not blue", 0x000000FF, bottom);
+    }
+
+    protected void runTestGL(GLCapabilities caps, boolean animate) throws InterruptedException, InvocationTargetException {
+        final JFrame frame = new JFrame("GLJPanel async read back");
+        final GLJPanel glJPanel = new GLJPanel(caps);
+        glJPanel.setAsyncReadback(true);
+        Assert.assertTrue(glJPanel.getAsyncReadback());
+        final TwoColors demo = new TwoColors();
+        glJPanel.addGLEventListener(demo);
+
+        SwingUtilities.invokeAndWait(new Runnable() {
+                public void run() {
+                    frame.getContentPane().add(glJPanel, BorderLayout.CENTER);
+                    frame.getContentPane().setPreferredSize(new java.awt.Dimension(width, height));
+                    frame.pack();
+                    frame.setVisible(true);
+                } } ) ;
+
+        if( animate ) {
+            final FPSAnimator animator = new FPSAnimator(glJPanel, 60);
+            animator.start();
+            Assert.assertTrue(animator.isAnimating());
+            while(animator.isAnimating() && animator.getTotalFPSDuration()<duration) {
+                Thread.sleep(100);
+            }
+            validateOrientation(paint(glJPanel)); // pipelined, previous frame has the same content
+            animator.stop();
+            Assert.assertFalse(animator.isAnimating());
+            Assert.assertTrue("No frames rendered", demo.frames > 1);
+        }
+        validateOrientation(paint(glJPanel)); // synchronous
+
+        SwingUtilities.invokeAndWait(new Runnable() {
+                public void run() {
+                    frame.setVisible(false);
+                    frame.getContentPane().remove(glJPanel);
+                    glJPanel.destroy();
+                    frame.dispose();
+                } } );
+    }
+
+    @Test
+    public void test01Static() throws InterruptedException, InvocationTargetException {
+        runTestGL(new GLCapabilities(GLProfile.getDefault()), false);
+    }
+
+    @Test
+    public void test02Animated() throws InterruptedException, InvocationTargetException {
+        runTestGL(new GLCapabilities(GLProfile.getDefault()), true);
+    }
+
+    public static void main(String args[]) {
+        for(int i=0; i<args.length; i++) {
+            if(args[i].equals("-time")) {
+                duration = MiscUtils.atol(args[++i], duration);
+            }
+        }
+        org.junit.runner.JUnitCore.main(TestGLJPanelAsyncReadback01AWT.class.getName());
+    }
+}
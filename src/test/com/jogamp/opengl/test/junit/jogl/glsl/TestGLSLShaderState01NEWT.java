@@ -27,11 +27,13 @@
  */
 package com.jogamp.opengl.test.junit.jogl.glsl;
 
+import com.jogamp.common.nio.Buffers;
 import com.jogamp.opengl.util.GLArrayDataServer;
 import com.jogamp.opengl.util.PMVMatrix;
 import com.jogamp.opengl.util.glsl.ShaderCode;
 import com.jogamp.opengl.util.glsl.ShaderProgram;
 import com.jogamp.opengl.util.glsl.ShaderState;
+import com.jogamp.opengl.util.glsl.UniformBlock;
 import com.jogamp.opengl.test.junit.jogl.demos.es2.RedSquareES2;
 import com.jogamp.opengl.test.junit.util.MiscUtils;
 import com.jogamp.opengl.test.junit.util.NEWTGLContext;
@@ -379,6 +381,98 @@ public class TestGLSLShaderState01NEWT extends UITestCase {
         NEWTGLContext.destroyWindow(winctx);
     }
     
+    @Test
+    public void testShaderState02UniformHandleDirtyTracking() throws InterruptedException {
+        final NEWTGLContext.WindowContext winctx = NEWTGLContext.createOnscreenWindow(
+                new GLCapabilities(GLProfile.getGL2ES2()), 480, 480, false);
+        final GL2ES2 gl = winctx.context.getGL().getGL2ES2();
+        System.err.println(winctx.context);
+        
+        Assert.assertEquals(GL.GL_NO_ERROR, gl.glGetError());
+        
+        final ShaderState st = new ShaderState();
+        Assert.assertFalse("uniform dirty tracking is opt-in", st.getUniformDirtyTracking());
+        st.setUniformDirtyTracking(true);
+        
+        // handles are available w/o program
+        final int hPMV = st.getUniformHandle("mgl_PMVMatrix");
+        final int hVertex = st.getAttribHandle("mgl_Vertex");
+        Assert.assertEquals(hPMV, st.getUniformHandle("mgl_PMVMatrix"));
+        Assert.assertEquals(hVertex, st.getAttribHandle("mgl_Vertex"));
+        
+        final ShaderProgram sp0 = new ShaderProgram();
+        sp0.add(ShaderCode.create(gl, GL2ES2.GL_VERTEX_SHADER, RedSquareES2.class, "shader",
+                "shader/bin", "RedSquareShader", false));
+        sp0.add(ShaderCode.create(gl, GL2ES2.GL_FRAGMENT_SHADER, RedSquareES2.class, "shader",
+                "shader/bin", "RedSquareShader", false));
+        st.attachShaderProgram(gl, sp0, true);
+        Assert.assertTrue(sp0.inUse());
+        Assert.assertTrue(0 <= st.getAttribLocation(gl, hVertex));
+        
+        final PMVMatrix pmvMatrix = new PMVMatrix();
+        final GLUniformData pmvMatrixUniform = new GLUniformData("mgl_PMVMatrix", 4, 4, pmvMatrix.glGetPMvMatrixf());
+        Assert.assertTrue(st.uniform(gl, hPMV, pmvMatrixUniform));
+        Assert.assertTrue(0 <= pmvMatrixUniform.getLocation());
+        Assert.assertEquals(pmvMatrixUniform.getLocation(), st.getUniformLocation(gl, hPMV));
+        Assert.assertEquals(pmvMatrixUniform, st.getUniform("mgl_PMVMatrix"));
+        Assert.assertEquals(0f, getUniformMat4(gl, sp0, pmvMatrixUniform)[12], 0f);
+        
+        // in place modification is detected
+        pmvMatrix.glMatrixMode(PMVMatrix.GL_PROJECTION);
+        pmvMatrix.glTranslatef(1f, 2f, 3f);
+        Assert.assertTrue(st.uniform(gl, hPMV, pmvMatrixUniform));
+        Assert.assertEquals(1f, getUniformMat4(gl, sp0, pmvMatrixUniform)[12], 0f);
+        
+        // unchanged value is not transferred, hence a value set behind our back persists
+        gl.glUniformMatrix4fv(pmvMatrixUniform.getLocation(), 1, false, new float[] { 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1 }, 0);
+        Assert.assertTrue(st.uniform(gl, pmvMatrixUniform));
+        Assert.assertEquals(0f, getUniformMat4(gl, sp0, pmvMatrixUniform)[12], 0f);
+        
+        // invalidated tracking transfers the value again
+        st.setUniformDirtyTracking(true);
+        Assert.assertTrue(st.uniform(gl, hPMV, pmvMatrixUniform));
+        Assert.assertEquals(1f, getUniformMat4(gl, sp0, pmvMatrixUniform)[12], 0f);
+        Assert.assertEquals(GL.GL_NO_ERROR, gl.glGetError());
+        
+        // program switch: same handles, uniform value restored to the new program
+        final ShaderProgram sp1 = new ShaderProgram();
+        sp1.add(ShaderCode.create(gl, GL2ES2.GL_VERTEX_SHADER, RedSquareES2.class, "shader",
+                "shader/bin", "RedSquareShader", false));
+        sp1.add(ShaderCode.create(gl, GL2ES2.GL_FRAGMENT_SHADER, RedSquareES2.class, "shader",
+                "shader/bin", "RedSquareShader", false));
+        st.attachShaderProgram(gl, sp1, true);
+        Assert.assertTrue(sp1.inUse());
+        Assert.assertEquals(hPMV, st.getUniformHandle("mgl_PMVMatrix"));
+        Assert.assertTrue(0 <= st.getAttribLocation(gl, hVertex));
+        Assert.assertEquals(pmvMatrixUniform.getLocation(), st.getUniformLocation(gl, hPMV));
+        Assert.assertEquals(1f, getUniformMat4(gl, sp1, pmvMatrixUniform)[12], 0f);
+        Assert.assertEquals(GL.GL_NO_ERROR, gl.glGetError());
+        
+        st.destroy(gl);
+        sp0.destroy(gl);
+        
+        NEWTGLContext.destroyWindow(winctx);
+    }
+    
+    private static float[] getUniformMat4(GL2ES2 gl, ShaderProgram sp, GLUniformData uniform) {
+        final float[] mat4 = new float[16];
+        gl.glGetUniformfv(sp.program(), uniform.getLocation(), mat4, 0);
+        return mat4;
+    }
+    
+    @Test
+    public void testShaderState03UniformBlockLayout() {
+        final UniformBlock block = new UniformBlock("TestBlock", 0);
+        Assert.assertEquals(  0, block.addUniform(new GLUniformData("f0", 1f)));
+        Assert.assertEquals( 16, block.addUniform(new GLUniformData("v3", 3, Buffers.newDirectFloatBuffer(3))));
+        Assert.assertEquals( 28, block.addUniform(new GLUniformData("f1", 1f)));
+        Assert.assertEquals( 32, block.addUniform(new GLUniformData("m4", 4, 4, Buffers.newDirectFloatBuffer(2*16))));
+        Assert.assertEquals(160, block.addUniform(new GLUniformData("i0", 1)));
+        Assert.assertEquals(168, block.addUniform(new GLUniformData("v2", 2, Buffers.newDirectFloatBuffer(2))));
+        Assert.assertEquals(176, block.addUniform(new GLUniformData("fa", 1, Buffers.newDirectFloatBuffer(2))));
+        Assert.assertEquals(208, block.getSize());
+    }
+    
     public static void main(String args[]) throws IOException {
         System.err.println("main - start");
         boolean wait = false;
@@ -0,0 +1,177 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.test.junit.jogl.util;
+
+import java.nio.ByteBuffer;
+import java.util.Random;
+
+import javax.media.opengl.GL;
+
+import org.junit.Assert;
+import org.junit.Test;
+
+import com.jogamp.opengl.util.texture.spi.DXTDecompressor;
+import com.jogamp.opengl.util.texture.spi.KTXImage;
+
+/**
+ * Validates the {@link DXTDecompressor} against hand decoded S3TC and RGTC blocks,
+ * partial edge blocks and the parallel decoding of a large image.
+ */
+public class TestDXTDecompressor01NOUI {
+    
+    static ByteBuffer decode(int format, int width, int height, byte[] blocks) {
+        final ByteBuffer dst = ByteBuffer.allocateDirect(width * height * 4);
+        DXTDecompressor.decompress(format, width, height, ByteBuffer.wrap(blocks), dst);
+        return dst;
+    }
+    
+    static void assertPixel(ByteBuffer rgba, int width, int x, int y, int r, int g, int b, int a) {
+        final int p = ( y * width + x ) * 4;
+        Assert.assertEquals("r at "+x+"/"+y, r, rgba.get(p  ) & 0xff);
+        Assert.assertEquals("g at "+x+"/"+y, g, rgba.get(p+1) & 0xff);
+        Assert.assertEquals("b at "+x+"/"+y, b, rgba.get(p+2) & 0xff);
+        Assert.assertEquals("a at "+x+"/"+y, a, rgba.get(p+3) & 0xff);
+    }
+    
+    @Test
+    public void test01DXT1() {
+        // c0 red > c1 blue: 4 color mode, pixel i of the first row uses index i
+        final byte[] opaque = { 0x00, (byte)0xF8, 0x1F, 0x00, (byte)0xE4, 0, 0, 0 };
+        final ByteBuffer rgba = decode(GL.GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, 4, 4, opaque);
+        assertPixel(rgba, 4, 0, 0, 255, 0,   0, 255);
+        assertPixel(rgba, 4, 1, 0,   0, 0, 255, 255);
+        assertPixel(rgba, 4, 2, 0, 170, 0,  85, 255);
+        assertPixel(rgba, 4, 3, 0,  85, 0, 170, 255);
+        assertPixel(rgba, 4, 3, 3, 255, 0,   0, 255);
+        
+        // c0 blue <= c1 red: 3 color mode, index 3 is transparent black for RGBA only
+        final byte[] punchThrough = { 0x1F, 0x00, 0x00, (byte)0xF8, (byte)0xE4, 0, 0, 0 };
+        final ByteBuffer rgbaPT = decode(GL.GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, 4, 4, punchThrough);
+        assertPixel(rgbaPT, 4, 2, 0, 127, 0, 127, 255);
+        assertPixel(rgbaPT, 4, 3, 0,   0, 0,   0,   0);
+        final ByteBuffer rgbPT = decode(GL.GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 4, 4, punchThrough);
+        assertPixel(rgbPT, 4, 3, 0,   0, 0,   0, 255);
+    }
+    
+    @Test
+    public void test02DXT3DXT5() {
+        final byte[] color = { 0x00, (byte)0xF8, 0x1F, 0x00, 0, 0, 0, 0 };
+        
+        // 4 bit alpha: pixel 0 -> 0x1, pixel 1 -> 0xF
+        final byte[] dxt3 = new byte[16];
+        dxt3[0] = (byte)0xF1;
+        System.arraycopy(color, 0, dxt3, 8, 8);
+        final ByteBuffer rgba3 = decode(GL.GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, 4, 4, dxt3);
+        assertPixel(rgba3, 4, 0, 0, 255, 0, 0, 0x11);
+        assertPixel(rgba3, 4, 1, 0, 255, 0, 0, 0xFF);
+        assertPixel(rgba3, 4, 2, 0, 255, 0, 0, 0);
+        
+        // a0 255 > a1 0: 8 value mode, pixels 0, 1, 2 use index 0, 1, 2
+        final byte[] dxt5 = new byte[16];
+        dxt5[0] = (byte)255;
+        dxt5[1] = 0;
+        dxt5[2] = (byte)0x88;
+        System.arraycopy(color, 0, dxt5, 8, 8);
+        final ByteBuffer rgba5 = decode(GL.GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 4, 4, dxt5);
+        assertPixel(rgba5, 4, 0, 0, 255, 0, 0, 255);
+        assertPixel(rgba5, 4, 1, 0, 255, 0, 0,   0);
+        assertPixel(rgba5, 4, 2, 0, 255, 0, 0, 218);
+        assertPixel(rgba5, 4, 3, 0, 255, 0, 0, 255);
+    }
+    
+    @Test
+    public void test03RGTC() {
+        // unsigned, 6 value mode: index 6 -> 0, index 7 -> 255, index 2 -> (4*0+100)/5
+        final byte[] bc4 = { 0, 100, (byte)0x82, 0x0f, 0, 0, 0, 0 };
+        final ByteBuffer r = decode(KTXImage.GL_COMPRESSED_RED_RGTC1, 4, 4, bc4);
+        assertPixel(r, 4, 0, 0,  20, 0, 0, 255);
+        assertPixel(r, 4, 1, 0,   0, 0, 0, 255);
+        assertPixel(r, 4, 2, 0,   0, 0, 0, 255);
+        assertPixel(r, 4, 3, 0, 255, 0, 0, 255);
+        
+        // signed -128 clamps to -127 and maps to 0, 127 maps to 255
+        final byte[] bc4s = { (byte)-128, 127, 0x08, 0, 0, 0, 0, 0 };
+        final ByteBuffer rs = decode(KTXImage.GL_COMPRESSED_SIGNED_RED_RGTC1, 4, 4, bc4s);
+        assertPixel(rs, 4, 0, 0,   0, 0, 0, 255);
+        assertPixel(rs, 4, 1, 0, 255, 0, 0, 255);
+        
+        final byte[] bc5 = { (byte)200, 0, 0, 0, 0, 0, 0, 0,  0, 50, 0, 0, 0, 0, 0, 0 };
+        final ByteBuffer rg = decode(KTXImage.GL_COMPRESSED_RG_RGTC2, 4, 4, bc5);
+        assertPixel(rg, 4, 2, 2, 200, 0, 0, 255);
+    }
+    
+    @Test
+    public void test04PartialBlocks() {
+        // 6x5 pixels, 2x2 blocks: red, blue / blue, red
+        final byte[] red  = { 0x00, (byte)0xF8, 0x00, (byte)0xF8, 0, 0, 0, 0 };
+        final byte[] blue = { 0x1F, 0x00, 0x1F, 0x00, 0, 0, 0, 0 };
+        final byte[] blocks = new byte[4*8];
+        System.arraycopy(red,  0, blocks,  0, 8);
+        System.arraycopy(blue, 0, blocks,  8, 8);
+        System.arraycopy(blue, 0, blocks, 16, 8);
+        System.arraycopy(red,  0, blocks, 24, 8);
+        Assert.assertEquals(blocks.length, DXTDecompressor.getCompressedSize(GL.GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 6, 5));
+        final ByteBuffer rgba = decode(GL.GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 6, 5, blocks);
+        assertPixel(rgba, 6, 3, 3, 255, 0,   0, 255);
+        assertPixel(rgba, 6, 5, 3,   0, 0, 255, 255);
+        assertPixel(rgba, 6, 0, 4,   0, 0, 255, 255);
+        assertPixel(rgba, 6, 5, 4, 255, 0,   0, 255);
+    }
+    
+    @Test
+    public void test05ParallelEqualsBlockwise() {
+        final int format = GL.GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        final int width = 256, height = 252;
+        final byte[] blocks = new byte[DXTDecompressor.getCompressedSize(format, width, height)];
+        new Random(42).nextBytes(blocks);
+        
+        final ByteBuffer dst = DXTDecompressor.getScratchBuffer(width * height * 4);
+        final long t0 = System.nanoTime();
+        DXTDecompressor.decompress(format, width, height, ByteBuffer.wrap(blocks), dst);
+        final long t1 = System.nanoTime();
+        System.err.println("Decompressed "+width+"x"+height+" using "+DXTDecompressor.THREAD_COUNT+" threads in "+(t1-t0)/1000+" us");
+        
+        final byte[] block = new byte[16];
+        for(int by=0; by<height/4; by++) {
+            for(int bx=0; bx<width/4; bx++) {
+                System.arraycopy(blocks, ( by * width/4 + bx ) * 16, block, 0, 16);
+                final ByteBuffer ref = decode(format, 4, 4, block);
+                for(int y=0; y<4; y++) {
+                    for(int x=0; x<16; x++) {
+                        Assert.assertEquals(ref.get(y*16+x), dst.get(( ( by*4 + y ) * width + bx*4 ) * 4 + x));
+                    }
+                }
+            }
+        }
+        Assert.assertSame(dst, DXTDecompressor.getScratchBuffer(16));
+    }
+
+    public static void main(String args[]) {
+        org.junit.runner.JUnitCore.main(TestDXTDecompressor01NOUI.class.getName());
+    }
+}
@@ -0,0 +1,192 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.test.junit.jogl.util;
+
+import java.nio.ByteBuffer;
+import java.nio.ShortBuffer;
+
+import javax.media.opengl.GL;
+import javax.media.opengl.GL2ES1;
+import javax.media.opengl.GLCapabilities;
+import javax.media.opengl.GLContext;
+import javax.media.opengl.GLDrawableFactory;
+import javax.media.opengl.GLOffscreenAutoDrawable;
+import javax.media.opengl.GLProfile;
+
+import org.junit.After;
+import org.junit.Assert;
+import org.junit.Before;
+import org.junit.BeforeClass;
+import org.junit.Test;
+
+import com.jogamp.opengl.test.junit.util.UITestCase;
+import com.jogamp.opengl.util.GLBuffers;
+import com.jogamp.opengl.util.ImmModeSink;
+
+/**
+ * Validates the {@link ImmModeSink#GL_QUADS} and {@link ImmModeSink#GL_POLYGON} emulation
+ * by rendering into an offscreen drawable, covering whole quadrants of it.
+ * <p>
+ * Quad A covers the left-bottom quadrant, quad B the right-top quadrant.
+ * </p>
+ */
+public class TestImmModeSinkQuadsPolygon01 extends UITestCase {
+    static final int size = 64;
+    static GLProfile glp;
+
+    GLOffscreenAutoDrawable glad;
+    GL2ES1 gl;
+    final ByteBuffer pixel = GLBuffers.newDirectByteBuffer(4);
+
+    @BeforeClass
+    public static void initClass() {
+        glp = GLProfile.getGL2ES1();
+        Assert.assertNotNull(glp);
+    }
+
+    @Before
+    public void initTest() {
+        glad = GLDrawableFactory.getFactory(glp).createOffscreenAutoDrawable(null, new GLCapabilities(glp), null, size, size, null);
+        Assert.assertTrue(GLContext.CONTEXT_NOT_CURRENT < glad.getContext().makeCurrent());
+        gl = glad.getGL().getGL2ES1();
+        gl.glViewport(0, 0, size, size);
+        gl.glClearColor(0f, 0f, 0f, 1f);
+        gl.glClear(GL.GL_COLOR_BUFFER_BIT);
+        gl.glColor4f(1f, 0f, 0f, 1f);
+    }
+
+    @After
+    public void releaseTest() {
+        glad.getContext().release();
+        glad.destroy();
+        glad = null;
+        gl = null;
+    }
+
+    static ImmModeSink createSink(GL gl) {
+        return ImmModeSink.createFixed(gl, GL.GL_STATIC_DRAW, 4,
+                                       2, GL.GL_FLOAT,  // vertex
+                                       0, GL.GL_FLOAT,  // color
+                                       0, GL.GL_FLOAT,  // normal
+                                       0, GL.GL_FLOAT); // texCoords
+    }
+
+    static void quadA(ImmModeSink ims) {
+        ims.glVertex2f(-1f, -1f);
+        ims.glVertex2f( 0f, -1f);
+        ims.glVertex2f( 0f,  0f);
+        ims.glVertex2f(-1f,  0f);
+    }
+
+    static void quadB(ImmModeSink ims) {
+        ims.glVertex2f( 0f,  0f);
+        ims.glVertex2f( 1f,  0f);
+        ims.glVertex2f( 1f,  1f);
+        ims.glVertex2f( 0f,  1f);
+    }
+
+    boolean isRed(int x, int y) {
+        gl.glReadPixels(x, y, 1, 1, GL.GL_RGBA, GL.GL_UNSIGNED_BYTE, pixel);
+        return 0xff == ( pixel.get(0) & 0xff ) && 0 == ( pixel.get(1) & 0xff );
+    }
+
+    /** Asserts the coverage of the quadrants left-bottom, right-bottom, left-top and right-top. */
+    void assertQuadrants(boolean lb, boolean rb, boolean lt, boolean rt) {
+        final int q0 = size / 4, q1 = size * 3 / 4;
+        Assert.assertEquals("left-bottom",  lb, isRed(q0, q0));
+        Assert.assertEquals("right-bottom", rb, isRed(q1, q0));
+        Assert.assertEquals("left-top",     lt, isRed(q0, q1));
+        Assert.assertEquals("right-top",    rt, isRed(q1, q1));
+    }
+
+    @Test
+    public void test01Quads() {
+        final ImmModeSink ims = createSink(gl);
+        ims.glBegin(ImmModeSink.GL_QUADS);
+        quadA(ims);
+        quadB(ims);
+        ims.glEnd(gl);
+        assertQuadrants(true, false, false, true);
+        ims.destroy(gl);
+    }
+
+    @Test
+    public void test02Polygon() {
+        // convex pentagon covering the left half, w/ a collinear vertex on its right edge
+        final ImmModeSink ims = createSink(gl);
+        ims.glBegin(ImmModeSink.GL_POLYGON);
+        ims.glVertex2f(-1f, -1f);
+        ims.glVertex2f( 0f, -1f);
+        ims.glVertex2f( 0f,  0f);
+        ims.glVertex2f( 0f,  1f);
+        ims.glVertex2f(-1f,  1f);
+        ims.glEnd(gl);
+        assertQuadrants(true, false, true, false);
+        ims.destroy(gl);
+    }
+
+    @Test
+    public void test03QuadsIndexed() {
+        final ImmModeSink ims = createSink(gl);
+        ims.glBegin(ImmModeSink.GL_QUADS);
+        quadA(ims);
+        quadB(ims);
+        ims.glEnd(gl, false);
+
+        final ShortBuffer indices = GLBuffers.newDirectShortBuffer(4);
+        indices.put(new short[] { 0, 1, 2, 3 });
+        indices.rewind();
+        ims.draw(gl, indices, true);
+        assertQuadrants(true, false, false, false);
+
+        // unchanged indices, reusing the triangulation
+        gl.glClear(GL.GL_COLOR_BUFFER_BIT);
+        ims.draw(gl, indices, true);
+        assertQuadrants(true, false, false, false);
+
+        // indices modified in place, the triangulation must be rebuilt
+        indices.put(new short[] { 4, 5, 6, 7 });
+        indices.rewind();
+        gl.glClear(GL.GL_COLOR_BUFFER_BIT);
+        ims.draw(gl, indices, true);
+        assertQuadrants(false, false, false, true);
+
+        // both quads from a new index buffer
+        final ShortBuffer indices2 = GLBuffers.newDirectShortBuffer(8);
+        indices2.put(new short[] { 0, 1, 2, 3, 4, 5, 6, 7 });
+        indices2.rewind();
+        gl.glClear(GL.GL_COLOR_BUFFER_BIT);
+        ims.draw(gl, indices2, true);
+        assertQuadrants(true, false, false, true);
+        ims.destroy(gl);
+    }
+
+    public static void main(String args[]) {
+        org.junit.runner.JUnitCore.main(TestImmModeSinkQuadsPolygon01.class.getName());
+    }
+}
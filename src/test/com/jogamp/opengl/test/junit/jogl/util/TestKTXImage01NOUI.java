@@ -0,0 +1,251 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.test.junit.jogl.util;
+
+import java.io.BufferedInputStream;
+import java.io.ByteArrayInputStream;
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+import org.junit.Assert;
+import org.junit.Test;
+
+import com.jogamp.opengl.util.texture.spi.DDSImage;
+import com.jogamp.opengl.util.texture.spi.KTXImage;
+
+/**
+ * Validates the {@link KTXImage} reader for KTX 1 and KTX 2 files 
+ * and the {@link DDSImage} DX10 header extension, using in-memory written BC7 and BC4 textures.
+ */
+public class TestKTXImage01NOUI {
+    static final int VK_FORMAT_BC7_UNORM_BLOCK = 145;
+    static final byte[] IDENTIFIER_1 = { (byte)0xAB, 'K', 'T', 'X', ' ', '1', '1', (byte)0xBB, '\r', '\n', 0x1A, '\n' };
+    static final byte[] IDENTIFIER_2 = { (byte)0xAB, 'K', 'T', 'X', ' ', '2', '0', (byte)0xBB, '\r', '\n', 0x1A, '\n' };
+    
+    /** 16 byte BC7 blocks of an 8x8 texture with 4 levels, each block filled with its level and index */
+    static byte[][] createBC7Levels() {
+        final byte[][] levels = new byte[4][];
+        for(int l=0; l<levels.length; l++) {
+            final int blocks = Math.max(1, ( 8 >> l ) / 4) * Math.max(1, ( 8 >> l ) / 4);
+            levels[l] = new byte[blocks * 16];
+            for(int i=0; i<levels[l].length; i++) {
+                levels[l][i] = (byte) ( l * 64 + i / 16 );
+            }
+        }
+        return levels;
+    }
+    
+    static ByteBuffer newBuffer(int size) {
+        return ByteBuffer.allocate(size).order(ByteOrder.LITTLE_ENDIAN);
+    }
+    
+    static void putKeyValue(ByteBuffer b, String key, String value) {
+        final int size = key.length() + 1 + value.length() + 1;
+        b.putInt(size);
+        b.put(key.getBytes());
+        b.put((byte)0);
+        b.put(value.getBytes());
+        b.put((byte)0);
+        while( 0 != ( b.position() & 3 ) ) {
+            b.put((byte)0);
+        }
+    }
+    
+    static ByteBuffer createKTX1(byte[][] levels, String orientation) {
+        final ByteBuffer b = newBuffer(1024);
+        b.put(IDENTIFIER_1);
+        b.putInt(0x04030201);
+        b.putInt(0);      // glType
+        b.putInt(1);      // glTypeSize
+        b.putInt(0);      // glFormat
+        b.putInt(KTXImage.GL_COMPRESSED_RGBA_BPTC_UNORM);
+        b.putInt(0x1908); // glBaseInternalFormat GL_RGBA
+        b.putInt(8);
+        b.putInt(8);
+        b.putInt(0);      // depth
+        b.putInt(0);      // array elements
+        b.putInt(1);      // faces
+        b.putInt(levels.length);
+        final int kvPos = b.position();
+        b.putInt(0);      // key value bytes
+        if( null != orientation ) {
+            putKeyValue(b, "KTXorientation", orientation);
+        }
+        b.putInt(kvPos, b.position() - kvPos - 4);
+        for(int l=0; l<levels.length; l++) {
+            b.putInt(levels[l].length);
+            b.put(levels[l]);
+        }
+        b.flip();
+        return b;
+    }
+    
+    static ByteBuffer createKTX2(byte[][] levels) {
+        final ByteBuffer b = newBuffer(1024);
+        b.put(IDENTIFIER_2);
+        b.putInt(VK_FORMAT_BC7_UNORM_BLOCK);
+        b.putInt(1);      // typeSize
+        b.putInt(8);
+        b.putInt(8);
+        b.putInt(0);      // depth
+        b.putInt(0);      // layers
+        b.putInt(1);      // faces
+        b.putInt(levels.length);
+        b.putInt(0);      // supercompression
+        b.putInt(0); b.putInt(0); // dfd
+        b.putInt(0); b.putInt(0); // kvd
+        b.putLong(0); b.putLong(0); // sgd
+        // level index, data stored smallest level first
+        int pos = 80 + 24 * levels.length;
+        final int[] offsets = new int[levels.length];
+        for(int l=levels.length-1; l>=0; l--) {
+            offsets[l] = pos;
+            pos += levels[l].length;
+        }
+        for(int l=0; l<levels.length; l++) {
+            b.putLong(offsets[l]);
+            b.putLong(levels[l].length);
+            b.putLong(levels[l].length);
+        }
+        for(int l=levels.length-1; l>=0; l--) {
+            b.put(levels[l]);
+        }
+        b.flip();
+        return b;
+    }
+    
+    static void assertLevels(byte[][] levels, KTXImage image) {
+        Assert.assertEquals(8, image.getWidth());
+        Assert.assertEquals(8, image.getHeight());
+        Assert.assertEquals(1, image.getNumFaces());
+        Assert.assertEquals(levels.length, image.getNumMipMaps());
+        Assert.assertEquals(KTXImage.GL_COMPRESSED_RGBA_BPTC_UNORM, image.getGLInternalFormat());
+        Assert.assertTrue(image.isCompressed());
+        for(int l=0; l<levels.length; l++) {
+            final ByteBuffer data = image.getMipMap(l);
+            Assert.assertEquals(levels[l].length, data.remaining());
+            for(int i=0; i<levels[l].length; i++) {
+                Assert.assertEquals(levels[l][i], data.get(data.position() + i));
+            }
+        }
+    }
+    
+    @Test
+    public void test01KTX1() throws IOException {
+        final byte[][] levels = createBC7Levels();
+        final KTXImage image = KTXImage.read(createKTX1(levels, null));
+        Assert.assertEquals(1, image.getVersion());
+        Assert.assertTrue(image.isUpperLeftOrigin());
+        assertLevels(levels, image);
+        Assert.assertFalse(KTXImage.read(createKTX1(levels, "S=r,T=u")).isUpperLeftOrigin());
+    }
+    
+    @Test
+    public void test02KTX2() throws IOException {
+        final byte[][] levels = createBC7Levels();
+        final KTXImage image = KTXImage.read(createKTX2(levels));
+        Assert.assertEquals(2, image.getVersion());
+        Assert.assertEquals(VK_FORMAT_BC7_UNORM_BLOCK, image.getVkFormat());
+        assertLevels(levels, image);
+        Assert.assertEquals(KTXImage.GL_COMPRESSED_RGBA_ASTC_4x4_KHR + 2, KTXImage.getGLInternalFormat(161)); // ASTC 5x5
+        Assert.assertEquals(KTXImage.GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR + 13, KTXImage.getGLInternalFormat(184)); // ASTC 12x12 sRGB
+    }
+    
+    @Test
+    public void test03MappedFileAndStream() throws IOException {
+        final byte[][] levels = createBC7Levels();
+        final ByteBuffer b = createKTX2(levels);
+        final byte[] bytes = new byte[b.remaining()];
+        b.get(bytes);
+        Assert.assertTrue(KTXImage.isKTXImage(new BufferedInputStream(new ByteArrayInputStream(bytes))));
+        Assert.assertFalse(KTXImage.isKTXImage(new BufferedInputStream(new ByteArrayInputStream(new byte[] { 'D', 'D', 'S', ' ' }))));
+        
+        final File file = File.createTempFile("TestKTXImage01NOUI", ".ktx2");
+        try {
+            final FileOutputStream out = new FileOutputStream(file);
+            out.write(bytes);
+            out.close();
+            final KTXImage image = KTXImage.read(file);
+            assertLevels(levels, image);
+            image.close();
+        } finally {
+            file.delete();
+        }
+    }
+    
+    @Test
+    public void test04DDSDX10() throws IOException {
+        // BC4 8x8, 4 levels of 8 byte blocks
+        final int[] levelSizes = { 32, 8, 8, 8 };
+        final ByteBuffer b = newBuffer(128 + 20 + 56);
+        b.putInt(0x20534444); // magic
+        b.putInt(124);
+        b.putInt(DDSImage.DDSD_CAPS | DDSImage.DDSD_HEIGHT | DDSImage.DDSD_WIDTH | DDSImage.DDSD_PIXELFORMAT | DDSImage.DDSD_MIPMAPCOUNT);
+        b.putInt(8);
+        b.putInt(8);
+        b.putInt(0);
+        b.putInt(0);
+        b.putInt(levelSizes.length);
+        for(int i=0; i<11; i++) { // alphaBitDepth .. srcBltColorSpaceHighValue
+            b.putInt(0);
+        }
+        b.putInt(32);
+        b.putInt(DDSImage.DDPF_FOURCC);
+        b.putInt(DDSImage.D3DFMT_DX10);
+        for(int i=0; i<10; i++) { // RGB bit count .. texture stage
+            b.putInt(0);
+        }
+        Assert.assertEquals(128, b.position());
+        b.putInt(DDSImage.DXGI_FORMAT_BC4_UNORM);
+        b.putInt(3); // 2D
+        b.putInt(0);
+        b.putInt(1);
+        b.putInt(0);
+        for(int l=0; l<levelSizes.length; l++) {
+            for(int i=0; i<levelSizes[l]; i++) {
+                b.put((byte)l);
+            }
+        }
+        b.flip();
+        final DDSImage image = DDSImage.read(b);
+        Assert.assertTrue(image.isDX10());
+        Assert.assertEquals(DDSImage.DXGI_FORMAT_BC4_UNORM, image.getDXGIFormat());
+        for(int l=0; l<levelSizes.length; l++) {
+            final ByteBuffer data = image.getMipMap(l).getData();
+            Assert.assertEquals(levelSizes[l], data.remaining());
+            Assert.assertEquals((byte)l, data.get(0));
+        }
+    }
+
+    public static void main(String args[]) {
+        org.junit.runner.JUnitCore.main(TestKTXImage01NOUI.class.getName());
+    }
+}
@@ -0,0 +1,254 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+ 
+package com.jogamp.opengl.test.junit.jogl.util;
+
+import javax.media.opengl.GLException;
+import javax.media.opengl.fixedfunc.GLMatrixFunc;
+
+import org.junit.Assert;
+import org.junit.Test;
+
+import com.jogamp.opengl.FloatUtil;
+import com.jogamp.opengl.util.PMVMatrix;
+
+/**
+ * Validates the specialized translate, rotate and scale operations, the matrix stack
+ * and the rigid and affine inverse of {@link PMVMatrix} against the generic 4x4 math.
+ */
+public class TestPMVMatrix01NOUI {
+    static final float EPSILON = 1e-4f;
+
+    static float[] get(PMVMatrix pmv, int matrixGetName) {
+        final float[] m = new float[16];
+        pmv.glGetFloatv(matrixGetName, m, 0);
+        return m;
+    }
+
+    static float[] translation(float x, float y, float z) {
+        final float[] m = new float[16];
+        FloatUtil.makeIdentityf(m, 0);
+        m[12] = x; m[13] = y; m[14] = z;
+        return m;
+    }
+
+    static float[] scale(float x, float y, float z) {
+        final float[] m = new float[16];
+        FloatUtil.makeIdentityf(m, 0);
+        m[0] = x; m[5] = y; m[10] = z;
+        return m;
+    }
+
+    static float[] rotation(float angdeg, float x, float y, float z) {
+        final float[] m = new float[16];
+        FloatUtil.makeIdentityf(m, 0);
+        final float l = (float)Math.sqrt(x*x+y*y+z*z);
+        x/=l; y/=l; z/=l;
+        final float a = angdeg * (float) Math.PI / 180.0f;
+        final float c = (float)Math.cos(a), s = (float)Math.sin(a), ic = 1f - c;
+        m[0] = x*x*ic+c;   m[1] = x*y*ic+z*s; m[2]  = x*z*ic-y*s;
+        m[4] = x*y*ic-z*s; m[5] = y*y*ic+c;   m[6]  = y*z*ic+x*s;
+        m[8] = x*z*ic+y*s; m[9] = y*z*ic-x*s; m[10] = z*z*ic+c;
+        return m;
+    }
+
+    static float[] mult(float[] a, float[] b) {
+        final float[] d = new float[16];
+        FloatUtil.multMatrixf(a, 0, b, 0, d, 0);
+        return d;
+    }
+
+    static void assertIdentity(float[] m) {
+        final float[] i = new float[16];
+        FloatUtil.makeIdentityf(i, 0);
+        Assert.assertArrayEquals(i, m, EPSILON);
+    }
+
+    void testOps(boolean useBackingArray) {
+        final PMVMatrix pmv = new PMVMatrix(useBackingArray);
+        pmv.glMatrixMode(GLMatrixFunc.GL_MODELVIEW);
+        pmv.glLoadIdentity();
+        float[] ref = translation(0, 0, 0);
+
+        pmv.glTranslatef(1f, -2f, 3f);
+        ref = mult(ref, translation(1f, -2f, 3f));
+        Assert.assertArrayEquals(ref, get(pmv, GLMatrixFunc.GL_MODELVIEW_MATRIX), EPSILON);
+
+        pmv.glRotatef(33f, 1f, 2f, -0.5f);
+        ref = mult(ref, rotation(33f, 1f, 2f, -0.5f));
+        Assert.assertArrayEquals(ref, get(pmv, GLMatrixFunc.GL_MODELVIEW_MATRIX), EPSILON);
+
+        pmv.glScalef(2f, 0.5f, 3f);
+        ref = mult(ref, scale(2f, 0.5f, 3f));
+        Assert.assertArrayEquals(ref, get(pmv, GLMatrixFunc.GL_MODELVIEW_MATRIX), EPSILON);
+
+        pmv.glTranslatef(-4f, 5f, 0.25f);
+        ref = mult(ref, translation(-4f, 5f, 0.25f));
+        Assert.assertArrayEquals(ref, get(pmv, GLMatrixFunc.GL_MODELVIEW_MATRIX), EPSILON);
+
+        pmv.glMatrixMode(GLMatrixFunc.GL_PROJECTION);
+        pmv.glLoadIdentity();
+        pmv.glRotatef(90f, 0f, 0f, 1f);
+        Assert.assertArrayEquals(rotation(90f, 0f, 0f, 1f), get(pmv, GLMatrixFunc.GL_PROJECTION_MATRIX), EPSILON);
+        pmv.destroy();
+    }
+
+    @Test
+    public void test01OpsBackingArray() {
+        testOps(true);
+    }
+
+    @Test
+    public void test02OpsDirect() {
+        testOps(false);
+    }
+
+    void testStack(boolean useBackingArray) {
+        final PMVMatrix pmv = new PMVMatrix(useBackingArray);
+        final int depth = 100; // exceeds the initial stack depth
+        final float[][] saved = new float[depth][];
+        final int[] modes = { GLMatrixFunc.GL_MODELVIEW, GLMatrixFunc.GL_PROJECTION, javax.media.opengl.GL.GL_TEXTURE };
+        for(int k=0; k<modes.length; k++) {
+            final int getName = PMVMatrix.matrixModeName2MatrixGetName(modes[k]);
+            pmv.glMatrixMode(modes[k]);
+            pmv.glLoadIdentity();
+            for(int i=0; i<depth; i++) {
+                pmv.glTranslatef(i, 1f, 0f);
+                pmv.glRotatef(i, 0f, 1f, 0f);
+                saved[i] = get(pmv, getName);
+                pmv.glPushMatrix();
+            }
+            Assert.assertEquals(depth, pmv.getStackDepth(modes[k]));
+            for(int i=depth-1; i>=0; i--) {
+                pmv.glScalef(3f, 3f, 3f);
+                pmv.glPopMatrix();
+                Assert.assertArrayEquals(saved[i], get(pmv, getName), 0f);
+            }
+            Assert.assertEquals(0, pmv.getStackDepth(modes[k]));
+            try {
+                pmv.glPopMatrix();
+                Assert.fail("pop of empty stack must fail");
+            } catch (GLException e) { /* expected */ }
+        }
+        pmv.destroy();
+    }
+
+    @Test
+    public void test03StackBackingArray() {
+        testStack(true);
+    }
+
+    @Test
+    public void test04StackDirect() {
+        testStack(false);
+    }
+
+    void testInverse(boolean useBackingArray) {
+        final PMVMatrix pmv = new PMVMatrix(useBackingArray);
+        pmv.glGetMvitMatrixf(); // enable Mvi and Mvit
+        pmv.glMatrixMode(GLMatrixFunc.GL_MODELVIEW);
+
+        // rigid
+        pmv.glLoadIdentity();
+        pmv.glTranslatef(1f, 2f, 3f);
+        pmv.glRotatef(45f, 1f, 1f, 0f);
+        pmv.glTranslatef(-3f, 0.5f, 7f);
+        pmv.glPushMatrix();
+        checkInverse(pmv);
+
+        // affine
+        pmv.glScalef(2f, 3f, 0.5f);
+        pmv.glRotatef(-20f, 0f, 0f, 1f);
+        checkInverse(pmv);
+
+        // rigid again, restored from stack
+        pmv.glPopMatrix();
+        checkInverse(pmv);
+
+        // general
+        pmv.glPushMatrix();
+        pmv.glFrustumf(-1f, 1f, -1f, 1f, 1f, 100f);
+        checkInverse(pmv);
+        pmv.glPopMatrix();
+
+        // affine, loaded
+        pmv.glLoadMatrixf(mult(translation(5f, 6f, 7f), scale(1f, 2f, 4f)), 0);
+        checkInverse(pmv);
+        pmv.destroy();
+    }
+
+    void checkInverse(PMVMatrix pmv) {
+        pmv.update();
+        final float[] mv = new float[16], mvi = new float[16], mvit = new float[16];
+        pmv.glGetMvMatrixf().get(mv); pmv.glGetMvMatrixf().reset();
+        pmv.glGetMviMatrixf().get(mvi); pmv.glGetMviMatrixf().reset();
+        pmv.glGetMvitMatrixf().get(mvit); pmv.glGetMvitMatrixf().reset();
+        assertIdentity(mult(mv, mvi));
+        assertIdentity(mult(mvi, mv));
+        for(int i=0; i<4; i++) {
+            for(int j=0; j<4; j++) {
+                Assert.assertEquals(mvi[i+j*4], mvit[j+i*4], 0f);
+            }
+        }
+    }
+
+    @Test
+    public void test05InverseBackingArray() {
+        testInverse(true);
+    }
+
+    @Test
+    public void test06InverseDirect() {
+        testInverse(false);
+    }
+
+    @Test
+    public void test10PerfPushPop() {
+        final PMVMatrix pmv = new PMVMatrix(true);
+        pmv.glGetMviMatrixf(); // enable Mvi
+        pmv.glMatrixMode(GLMatrixFunc.GL_MODELVIEW);
+        pmv.glLoadIdentity();
+        final int loops = 200000;
+        final long t0 = System.nanoTime();
+        for(int i=0; i<loops; i++) {
+            pmv.glPushMatrix();
+            pmv.glTranslatef(1f, 2f, 3f);
+            pmv.glRotatef(10f, 0f, 1f, 0f);
+            pmv.glScalef(1f, 2f, 1f);
+            pmv.update();
+            pmv.glPopMatrix();
+        }
+        final long t1 = System.nanoTime();
+        System.err.println("push/translate/rotate/scale/pop: "+loops+" loops in "+(t1-t0)/1000000+" ms, "+(t1-t0)/loops+" ns/loop");
+        pmv.destroy();
+    }
+
+    public static void main(String args[]) {
+        org.junit.runner.JUnitCore.main(TestPMVMatrix01NOUI.class.getName());
+    }
+}
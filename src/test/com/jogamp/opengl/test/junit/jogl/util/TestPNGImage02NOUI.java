@@ -0,0 +1,301 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.test.junit.jogl.util;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.util.Random;
+import java.util.zip.CRC32;
+import java.util.zip.DeflaterOutputStream;
+
+import javax.media.opengl.GL;
+
+import org.junit.Assert;
+import org.junit.Test;
+
+import com.jogamp.opengl.util.texture.spi.PNGImage;
+
+/**
+ * Validates the direct {@link PNGImage} decoding path for all color types, bit depths,
+ * tRNS, all filter types and Adam7 interlacing, using in-memory encoded images.
+ * <p>
+ * The images are encoded by a minimal PNG encoder below, 
+ * which cycles through all filter types row by row.
+ * </p>
+ */
+public class TestPNGImage02NOUI {
+    static final int GRAY = 0, RGB = 2, PALETTE = 3, GRAY_ALPHA = 4, RGBA = 6;
+    
+    static final int[][] ADAM7 = { // oX, oY, dX, dY
+        { 0, 0, 8, 8 }, { 4, 0, 8, 8 }, { 0, 4, 4, 8 }, { 2, 0, 4, 4 }, { 0, 2, 2, 4 }, { 1, 0, 2, 2 }, { 0, 1, 1, 2 } };
+    
+    static int channels(int colorType) {
+        switch(colorType) {
+            case GRAY: case PALETTE: return 1;
+            case GRAY_ALPHA: return 2;
+            case RGB: return 3;
+            default: return 4;
+        }
+    }
+    
+    /** Random samples [y][x * channels + c] within the bit depth range, palette indices below <code>maxIndex</code> */
+    static int[][] createSamples(int w, int h, int channels, int bitDepth, int maxIndex, long seed) {
+        final Random rnd = new Random(seed);
+        final int range = 0 < maxIndex ? maxIndex : 1 << bitDepth;
+        final int[][] s = new int[h][w * channels];
+        for(int y=0; y<h; y++) {
+            for(int i=0; i<w * channels; i++) {
+                s[y][i] = rnd.nextInt(range);
+            }
+        }
+        return s;
+    }
+    
+    static void chunk(ByteArrayOutputStream out, String id, byte[] data) throws IOException {
+        final ByteArrayOutputStream c = new ByteArrayOutputStream();
+        c.write(id.getBytes("US-ASCII"));
+        c.write(data);
+        final byte[] cb = c.toByteArray();
+        final CRC32 crc = new CRC32();
+        crc.update(cb);
+        writeInt(out, data.length);
+        out.write(cb);
+        writeInt(out, (int) crc.getValue());
+    }
+    
+    static void writeInt(ByteArrayOutputStream out, int v) {
+        out.write(v >>> 24); out.write(v >>> 16); out.write(v >>> 8); out.write(v);
+    }
+    
+    /** Packs the pixels <code>x0, x0 + dx, ..</code> of row <code>y</code> as stored in a PNG row */
+    static byte[] packRow(int[] row, int x0, int dx, int w, int channels, int bitDepth) {
+        final int cols = ( w - x0 + dx - 1 ) / dx;
+        final byte[] b = new byte[( cols * channels * bitDepth + 7 ) / 8];
+        int bit = 0;
+        for(int x=x0; x<w; x+=dx) {
+            for(int c=0; c<channels; c++) {
+                final int v = row[x * channels + c];
+                if( 16 == bitDepth ) {
+                    b[bit >> 3] = (byte) ( v >> 8 );
+                    b[( bit >> 3 ) + 1] = (byte) v;
+                } else {
+                    b[bit >> 3] |= (byte) ( v << ( 8 - bitDepth - ( bit & 7 ) ) );
+                }
+                bit += bitDepth;
+            }
+        }
+        return b;
+    }
+    
+    static int paeth(int a, int b, int c) {
+        final int p = a + b - c, pa = Math.abs(p - a), pb = Math.abs(p - b), pc = Math.abs(p - c);
+        return ( pa <= pb && pa <= pc ) ? a : ( pb <= pc ? b : c );
+    }
+    
+    /** Filters the row with the given filter type, returning the filter type byte followed by the filtered row */
+    static byte[] filterRow(byte[] cur, byte[] prev, int bpp, int ft) {
+        final byte[] f = new byte[cur.length + 1];
+        f[0] = (byte) ft;
+        for(int i=0; i<cur.length; i++) {
+            final int x = cur[i] & 0xff;
+            final int a = i >= bpp ? cur[i - bpp] & 0xff : 0;
+            final int b = null != prev ? prev[i] & 0xff : 0;
+            final int c = i >= bpp && null != prev ? prev[i - bpp] & 0xff : 0;
+            final int p;
+            switch(ft) {
+                case 1: p = a; break;
+                case 2: p = b; break;
+                case 3: p = ( a + b ) / 2; break;
+                case 4: p = paeth(a, b, c); break;
+                default: p = 0; break;
+            }
+            f[i + 1] = (byte) ( x - p );
+        }
+        return f;
+    }
+    
+    static byte[] encode(int w, int h, int colorType, int bitDepth, boolean interlaced, int[][] samples, 
+                         byte[] plte, byte[] trns) throws IOException {
+        final int channels = channels(colorType);
+        final int bpp = Math.max(1, channels * bitDepth / 8);
+        final ByteArrayOutputStream raw = new ByteArrayOutputStream();
+        final int[][] passes = interlaced ? ADAM7 : new int[][] { { 0, 0, 1, 1 } };
+        int ft = 0;
+        for(int p=0; p<passes.length; p++) {
+            final int[] g = passes[p];
+            if( g[0] >= w || g[1] >= h ) {
+                continue; // empty pass
+            }
+            byte[] prev = null;
+            for(int y=g[1]; y<h; y+=g[3]) {
+                final byte[] cur = packRow(samples[y], g[0], g[2], w, channels, bitDepth);
+                raw.write(filterRow(cur, prev, bpp, ft));
+                ft = ( ft + 1 ) % 5;
+                prev = cur;
+            }
+        }
+        final ByteArrayOutputStream idat = new ByteArrayOutputStream();
+        final DeflaterOutputStream dos = new DeflaterOutputStream(idat);
+        dos.write(raw.toByteArray());
+        dos.close();
+        
+        final ByteArrayOutputStream out = new ByteArrayOutputStream();
+        out.write(new byte[] { (byte) 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' });
+        final ByteArrayOutputStream ihdr = new ByteArrayOutputStream();
+        writeInt(ihdr, w);
+        writeInt(ihdr, h);
+        ihdr.write(bitDepth);
+        ihdr.write(colorType);
+        ihdr.write(0); // compression
+        ihdr.write(0); // filter
+        ihdr.write(interlaced ? 1 : 0);
+        chunk(out, "IHDR", ihdr.toByteArray());
+        if( null != plte ) {
+            chunk(out, "PLTE", plte);
+        }
+        if( null != trns ) {
+            chunk(out, "tRNS", trns);
+        }
+        chunk(out, "IDAT", idat.toByteArray());
+        chunk(out, "IEND", new byte[0]);
+        return out.toByteArray();
+    }
+    
+    /** Expected 8 bit RGB[A] / L[A] value of the given pixel */
+    static int[] expectedPixel(int[] row, int x, int colorType, int bitDepth, byte[] plte, byte[] trns) {
+        final int channels = channels(colorType);
+        if( PALETTE == colorType ) {
+            final int i = row[x];
+            final int[] rgba = { plte[3 * i] & 0xff, plte[3 * i + 1] & 0xff, plte[3 * i + 2] & 0xff, 
+                                 null != trns && i < trns.length ? trns[i] & 0xff : 0xff };
+            return null != trns ? rgba : new int[] { rgba[0], rgba[1], rgba[2] };
+        }
+        final int[] key = null != trns ? new int[channels] : null;
+        boolean transparent = null != trns;
+        final int[] res = new int[channels + ( null != trns ? 1 : 0 )];
+        for(int c=0; c<channels; c++) {
+            final int v = row[x * channels + c];
+            res[c] = 16 == bitDepth ? v >> 8 : v * 255 / ( ( 1 << bitDepth ) - 1 );
+            if( null != trns ) {
+                key[c] = ( ( trns[2 * c] & 0xff ) << 8 ) | ( trns[2 * c + 1] & 0xff );
+                transparent &= v == key[c];
+            }
+        }
+        if( null != trns ) {
+            res[channels] = transparent ? 0 : 0xff;
+        }
+        return res;
+    }
+    
+    static void testImage(String name, int w, int h, int colorType, int bitDepth, boolean interlaced,
+                          byte[] plte, byte[] trns, int expGLFormat, int expBytesPerPixel) throws IOException {
+        final int maxIndex = null != plte ? plte.length / 3 : 0;
+        final int[][] samples = createSamples(w, h, channels(colorType), bitDepth, maxIndex, w * 31 + h + colorType);
+        if( null != trns && PALETTE != colorType ) {
+            // make sure the color key is hit
+            final int channels = channels(colorType);
+            for(int c=0; c<channels; c++) {
+                samples[1][channels + c] = ( ( trns[2 * c] & 0xff ) << 8 ) | ( trns[2 * c + 1] & 0xff );
+            }
+        }
+        final byte[] png = encode(w, h, colorType, bitDepth, interlaced, samples, plte, trns);
+        final PNGImage image = PNGImage.read(new ByteArrayInputStream(png));
+        System.err.println(name+": "+image);
+        Assert.assertEquals(w, image.getWidth());
+        Assert.assertEquals(h, image.getHeight());
+        Assert.assertEquals(expGLFormat, image.getGLFormat());
+        Assert.assertEquals(expBytesPerPixel, image.getBytesPerPixel());
+        final ByteBuffer data = image.getData();
+        Assert.assertEquals(w * h * expBytesPerPixel, data.remaining());
+        for(int y=0; y<h; y++) {
+            final int glRow = h - 1 - y; // bottom-to-top
+            for(int x=0; x<w; x++) {
+                final int[] exp = expectedPixel(samples[y], x, colorType, bitDepth, plte, trns);
+                for(int c=0; c<expBytesPerPixel; c++) {
+                    Assert.assertEquals(name+": pixel "+x+"/"+y+", component "+c, 
+                                        exp[c], data.get( ( glRow * w + x ) * expBytesPerPixel + c ) & 0xff);
+                }
+            }
+        }
+    }
+    
+    static byte[] createPalette(int entries) {
+        final byte[] plte = new byte[entries * 3];
+        for(int i=0; i<plte.length; i++) {
+            plte[i] = (byte) ( i * 37 + 11 );
+        }
+        return plte;
+    }
+    
+    @Test
+    public void test01DirectColor8() throws IOException {
+        testImage("Gray8", 13, 7, GRAY, 8, false, null, null, GL.GL_LUMINANCE, 1);
+        testImage("GrayAlpha8", 13, 7, GRAY_ALPHA, 8, false, null, null, GL.GL_LUMINANCE_ALPHA, 2);
+        testImage("RGB8", 13, 7, RGB, 8, false, null, null, GL.GL_RGB, 3);
+        testImage("RGBA8", 13, 7, RGBA, 8, false, null, null, GL.GL_RGBA, 4);
+    }
+    
+    @Test
+    public void test02LowBitDepthGray() throws IOException {
+        testImage("Gray1", 17, 5, GRAY, 1, false, null, null, GL.GL_LUMINANCE, 1);
+        testImage("Gray2", 17, 5, GRAY, 2, false, null, new byte[] { 0, 2 }, GL.GL_LUMINANCE_ALPHA, 2);
+        testImage("Gray4", 17, 5, GRAY, 4, false, null, null, GL.GL_LUMINANCE, 1);
+    }
+    
+    @Test
+    public void test03Palette() throws IOException {
+        testImage("Palette8", 9, 6, PALETTE, 8, false, createPalette(200), null, GL.GL_RGB, 3);
+        testImage("Palette4tRNS", 9, 6, PALETTE, 4, false, createPalette(16), new byte[] { 0, (byte)128, 7 }, GL.GL_RGBA, 4);
+        testImage("Palette1", 9, 6, PALETTE, 1, false, createPalette(2), null, GL.GL_RGB, 3);
+    }
+    
+    @Test
+    public void test04Depth16() throws IOException {
+        testImage("Gray16", 10, 4, GRAY, 16, false, null, null, GL.GL_LUMINANCE, 1);
+        testImage("GrayAlpha16", 10, 4, GRAY_ALPHA, 16, false, null, null, GL.GL_LUMINANCE_ALPHA, 2);
+        testImage("RGB16tRNS", 10, 4, RGB, 16, false, null, new byte[] { 1, 2, 3, 4, 5, 6 }, GL.GL_RGBA, 4);
+        testImage("RGBA16", 10, 4, RGBA, 16, false, null, null, GL.GL_RGBA, 4);
+    }
+    
+    @Test
+    public void test05Interlaced() throws IOException {
+        testImage("RGBA8i", 11, 9, RGBA, 8, true, null, null, GL.GL_RGBA, 4);
+        testImage("RGB16i", 11, 9, RGB, 16, true, null, null, GL.GL_RGB, 3);
+        testImage("Gray2i", 11, 9, GRAY, 2, true, null, null, GL.GL_LUMINANCE, 1);
+        testImage("Palette4i", 11, 9, PALETTE, 4, true, createPalette(16), null, GL.GL_RGB, 3);
+        // smaller than the Adam7 tile, i.e. with empty passes
+        testImage("RGB8i3x2", 3, 2, RGB, 8, true, null, null, GL.GL_RGB, 3);
+        testImage("RGB8i1x1", 1, 1, RGB, 8, true, null, null, GL.GL_RGB, 3);
+    }
+    
+    public static void main(String args[]) {
+        org.junit.runner.JUnitCore.main(TestPNGImage02NOUI.class.getName());
+    }
+}
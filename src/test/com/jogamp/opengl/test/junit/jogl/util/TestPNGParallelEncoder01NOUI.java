@@ -0,0 +1,167 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.test.junit.jogl.util;
+
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.nio.ByteBuffer;
+import java.util.Random;
+
+import jogamp.opengl.util.pngj.PngParallelEncoder;
+
+import org.junit.Assert;
+import org.junit.Assume;
+import org.junit.Test;
+
+import com.jogamp.common.nio.Buffers;
+import com.jogamp.opengl.test.junit.util.MiscUtils;
+import com.jogamp.opengl.util.texture.spi.PNGImage;
+
+/**
+ * Validates the parallel PNG encoder against the decoder 
+ * and benchmarks its throughput against the sequential encoder,
+ * i.e. {@link PNGImage#write(File, boolean, int)} w/ multiple threads vs. one thread.
+ * <p>
+ * The benchmark encodes a sequence of synthetic frames, 
+ * gradients plus some noise, roughly as compressible as rendered content. 
+ * </p>
+ */
+public class TestPNGParallelEncoder01NOUI {
+    static int width = 1280, height = 720, frames = 10;
+    
+    static ByteBuffer createFrame(int w, int h, int bpp, int frame) {
+        final Random rnd = new Random(frame);
+        final ByteBuffer bb = Buffers.newDirectByteBuffer(w * h * bpp);
+        for(int y=0; y<h; y++) {
+            for(int x=0; x<w; x++) {
+                final int noise = rnd.nextInt(8);
+                bb.put((byte) ( x + frame + noise ));
+                bb.put((byte) ( y + noise ));
+                bb.put((byte) ( ( x ^ y ) + noise ));
+                if( 4 == bpp ) {
+                    bb.put((byte) ( 0 == ( x / 64 ) % 2 ? 0xff : 0x80 ));
+                }
+            }
+        }
+        bb.rewind();
+        return bb;
+    }
+    
+    static ByteBuffer readData(File f) throws IOException {
+        final InputStream in = new FileInputStream(f);
+        try {
+            return PNGImage.read(in).getData();
+        } finally {
+            in.close();
+        }
+    }
+    
+    static void testRoundtrip(int w, int h, int bpp, boolean reversedChannels, int threads) throws IOException {
+        final ByteBuffer data = createFrame(w, h, bpp, w + h);
+        final File f = File.createTempFile("TestPNGParallelEncoder01", ".png");
+        try {
+            PNGImage.createFromData(w, h, -1f, -1f, bpp, reversedChannels, data).write(f, true, threads);
+            final ByteBuffer res = readData(f);
+            Assert.assertEquals(w * h * bpp, res.remaining());
+            for(int i=0; i<w * h * bpp; i+=bpp) {
+                for(int c=0; c<bpp; c++) {
+                    // reversed channels are stored reversed within a pixel
+                    final int srcC = reversedChannels ? bpp - 1 - c : c;
+                    Assert.assertEquals("byte "+(i+c), data.get(i + srcC), res.get(i + c));
+                }
+            }
+        } finally {
+            f.delete();
+        }
+    }
+    
+    @Test
+    public void test01Roundtrip() throws IOException {
+        Assume.assumeTrue(PngParallelEncoder.isAvailable());
+        testRoundtrip(640, 480, 4, false, 4);
+        testRoundtrip(640, 480, 3, false, 3);
+        testRoundtrip(333, 257, 4, true, 0);
+        testRoundtrip(101, 77, 3, true, 7);
+        // less rows than a stripe, i.e. one stripe only
+        testRoundtrip(64, 20, 4, false, 4);
+        // first encoder again, reusing its buffers
+        testRoundtrip(640, 480, 4, false, 4);
+    }
+    
+    static double encode(ByteBuffer[] frameData, int bpp, int threads, File f) throws IOException {
+        final long t0 = System.nanoTime();
+        for(int i=0; i<frameData.length; i++) {
+            PNGImage.createFromData(width, height, -1f, -1f, bpp, false, frameData[i]).write(f, true, threads);
+        }
+        final long t1 = System.nanoTime();
+        final double ms = ( t1 - t0 ) / 1000000.0;
+        final double mb = (double) frameData.length * width * height * bpp / ( 1024.0 * 1024.0 );
+        System.err.printf("%d threads: %d frames %dx%dx%d in %.1f ms, %.1f ms/frame, %.1f MB/s, file %d bytes%n", 
+                threads, frameData.length, width, height, bpp, ms, ms / frameData.length, mb * 1000.0 / ms, f.length());
+        return ms;
+    }
+    
+    @Test
+    public void test02Benchmark() throws IOException {
+        Assume.assumeTrue(PngParallelEncoder.isAvailable());
+        final int threads = Runtime.getRuntime().availableProcessors();
+        final File f = File.createTempFile("TestPNGParallelEncoder01", ".png");
+        try {
+            for(int bpp=3; bpp<=4; bpp++) {
+                final ByteBuffer[] frameData = new ByteBuffer[frames];
+                for(int i=0; i<frames; i++) {
+                    frameData[i] = createFrame(width, height, bpp, i);
+                }
+                // warm up
+                encode(new ByteBuffer[] { frameData[0] }, bpp, 1, f);
+                encode(new ByteBuffer[] { frameData[0] }, bpp, threads, f);
+                
+                final double tSeq = encode(frameData, bpp, 1, f);
+                final double tPar = encode(frameData, bpp, threads, f);
+                System.err.printf("bpp %d: speedup %.2f w/ %d threads%n", bpp, tSeq / tPar, threads);
+            }
+        } finally {
+            f.delete();
+        }
+    }
+    
+    public static void main(String args[]) {
+        for(int i=0; i<args.length; i++) {
+            if(args[i].equals("-width")) {
+                width = MiscUtils.atoi(args[++i], width);
+            } else if(args[i].equals("-height")) {
+                height = MiscUtils.atoi(args[++i], height);
+            } else if(args[i].equals("-frames")) {
+                frames = MiscUtils.atoi(args[++i], frames);
+            }
+        }
+        org.junit.runner.JUnitCore.main(TestPNGParallelEncoder01NOUI.class.getName());
+    }
+}
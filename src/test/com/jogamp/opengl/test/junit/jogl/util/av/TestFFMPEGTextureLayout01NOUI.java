@@ -0,0 +1,128 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.test.junit.jogl.util.av;
+
+import jogamp.opengl.util.av.impl.FFMPEGTextureLayout;
+
+import org.junit.Assert;
+import org.junit.Test;
+
+/**
+ * Validates the placement of all planes within one texture by {@link FFMPEGTextureLayout}
+ * for the packed, planar and semi-planar pixel formats uploaded as-is by the FFMPEGMediaPlayer.
+ * <p>
+ * The plane dimensions are given as the native code derives them from the decoder,
+ * i.e. the width in texels from the linesize and the chroma height from the subsampling.
+ * </p>
+ */
+public class TestFFMPEGTextureLayout01NOUI {
+
+    static FFMPEGTextureLayout compute(int planes, int width, int height, int log2ChromaW, int log2ChromaH, int[] planeTexWidth) {
+        final int[] planeHeight = { 0, 0, 0 };
+        for(int i=0; i<planes; i++) {
+            planeHeight[i] = 0 == i ? height : -((-height) >> log2ChromaH);
+        }
+        final FFMPEGTextureLayout l = new FFMPEGTextureLayout();
+        l.compute(planes, width, height, log2ChromaW, log2ChromaH, planeTexWidth, planeHeight);
+        System.err.println(l);
+        return l;
+    }
+
+    static void assertLayout(FFMPEGTextureLayout l, int texWidth, int texHeight, int[] texX, int[] texY) {
+        Assert.assertEquals("texWidth", texWidth, l.texWidth);
+        Assert.assertEquals("texHeight", texHeight, l.texHeight);
+        Assert.assertArrayEquals("texX", texX, l.texX);
+        Assert.assertArrayEquals("texY", texY, l.texY);
+    }
+
+    @Test
+    public void test01Packed() {
+        // RGB24, YUYV422 (luminance-alpha texels) and GRAY8: one plane at the origin
+        assertLayout(compute(1, 640, 480, 0, 0, new int[] { 640, 0, 0 }),
+                     640, 480, new int[] { 0, 0, 0 }, new int[] { 0, 0, 0 });
+        // linesize padding widens the texture
+        assertLayout(compute(1, 642, 361, 0, 0, new int[] { 672, 0, 0 }),
+                     672, 361, new int[] { 0, 0, 0 }, new int[] { 0, 0, 0 });
+    }
+
+    @Test
+    public void test02YUV420P() {
+        // U above V, right of Y; also YUVJ420P and YUV420P10 (16bit texels)
+        assertLayout(compute(3, 640, 480, 1, 1, new int[] { 640, 320, 320 }),
+                     960, 480, new int[] { 0, 640, 640 }, new int[] { 0, 0, 240 });
+        // odd dimension w/ padded linesize: the stacked chroma planes exceed the luma height
+        assertLayout(compute(3, 642, 361, 1, 1, new int[] { 672, 352, 352 }),
+                     994, 362, new int[] { 0, 642, 642 }, new int[] { 0, 0, 181 });
+    }
+
+    @Test
+    public void test03YUV422P() {
+        // U left of V, right of Y
+        assertLayout(compute(3, 640, 480, 1, 0, new int[] { 640, 320, 320 }),
+                     1280, 480, new int[] { 0, 640, 960 }, new int[] { 0, 0, 0 });
+    }
+
+    @Test
+    public void test04YUV444P() {
+        // U left of V, right of Y; also GBRP
+        assertLayout(compute(3, 640, 480, 0, 0, new int[] { 640, 640, 640 }),
+                     1920, 480, new int[] { 0, 640, 1280 }, new int[] { 0, 0, 0 });
+    }
+
+    @Test
+    public void test05YUV410P() {
+        assertLayout(compute(3, 640, 480, 2, 2, new int[] { 640, 160, 160 }),
+                     800, 480, new int[] { 0, 640, 640 }, new int[] { 0, 0, 120 });
+    }
+
+    @Test
+    public void test06YUV411P() {
+        // padded chroma linesize of U is overwritten by V
+        assertLayout(compute(3, 640, 480, 2, 0, new int[] { 640, 192, 192 }),
+                     992, 480, new int[] { 0, 640, 800 }, new int[] { 0, 0, 0 });
+    }
+
+    @Test
+    public void test07YUV440P() {
+        assertLayout(compute(3, 640, 480, 0, 1, new int[] { 640, 640, 640 }),
+                     1280, 480, new int[] { 0, 640, 640 }, new int[] { 0, 0, 240 });
+    }
+
+    @Test
+    public void test08NV12() {
+        // interleaved UV plane right of Y; also NV21
+        assertLayout(compute(2, 640, 480, 1, 1, new int[] { 640, 640, 0 }),
+                     1280, 480, new int[] { 0, 640, 0 }, new int[] { 0, 0, 0 });
+        assertLayout(compute(2, 642, 361, 1, 1, new int[] { 672, 672, 0 }),
+                     1314, 361, new int[] { 0, 642, 0 }, new int[] { 0, 0, 0 });
+    }
+
+    public static void main(String args[]) {
+        org.junit.runner.JUnitCore.main(TestFFMPEGTextureLayout01NOUI.class.getName());
+    }
+}
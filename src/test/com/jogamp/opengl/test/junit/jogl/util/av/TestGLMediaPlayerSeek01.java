@@ -0,0 +1,133 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.test.junit.jogl.util.av;
+
+import java.io.IOException;
+import java.net.URL;
+import java.net.URLConnection;
+
+import javax.media.opengl.GL;
+import javax.media.opengl.GLCapabilities;
+import javax.media.opengl.GLContext;
+import javax.media.opengl.GLDrawableFactory;
+import javax.media.opengl.GLOffscreenAutoDrawable;
+import javax.media.opengl.GLProfile;
+
+import jogamp.opengl.util.av.impl.FFMPEGMediaPlayer;
+
+import org.junit.Assert;
+import org.junit.Assume;
+import org.junit.BeforeClass;
+import org.junit.Test;
+
+import com.jogamp.opengl.test.junit.util.UITestCase;
+import com.jogamp.opengl.util.av.GLMediaPlayer;
+import com.jogamp.opengl.util.av.GLMediaPlayer.SeekMode;
+
+/**
+ * Validates {@link GLMediaPlayer#seek(int)} of the {@link FFMPEGMediaPlayer}
+ * before and past the end of stream, using an offscreen drawable.
+ * <p>
+ * Skipped if FFMPEG is not available or the stream cannot be opened,
+ * the stream may be passed via <code>-url</code>.
+ * </p>
+ */
+public class TestGLMediaPlayerSeek01 extends UITestCase {
+    static String url_s = "http://download.blender.org/peach/bigbuckbunny_movies/BigBuckBunny_320x180.mp4";
+    static GLProfile glp;
+
+    @BeforeClass
+    public static void initClass() {
+        glp = GLProfile.getGL2ES2();
+        Assert.assertNotNull(glp);
+    }
+
+    @Test
+    public void test01SeekBeforeAndPastEOS() throws IOException {
+        Assume.assumeTrue(FFMPEGMediaPlayer.isAvailable());
+        final URLConnection urlConn;
+        try {
+            urlConn = new URL(url_s).openConnection();
+            urlConn.connect();
+        } catch (IOException ioe) {
+            System.err.println("Stream not available, skipped: "+url_s+": "+ioe.getMessage());
+            Assume.assumeNoException(ioe);
+            return;
+        }
+        final GLOffscreenAutoDrawable glad = GLDrawableFactory.getFactory(glp).createOffscreenAutoDrawable(
+                null, new GLCapabilities(glp), null, 64, 64, null);
+        final GLContext ctx = glad.getContext();
+        Assert.assertTrue(GLContext.CONTEXT_NOT_CURRENT < ctx.makeCurrent());
+        final GLMediaPlayer mp = new FFMPEGMediaPlayer();
+        try {
+            final GL gl = ctx.getGL();
+            Assert.assertEquals(GLMediaPlayer.State.Stopped, mp.initGLStream(gl, urlConn));
+            mp.setSeekMode(SeekMode.Accurate);
+            final int duration = mp.getDuration();
+            final int frameDuration = 0 < mp.getFramerate() ? (int) Math.ceil( 1000f / mp.getFramerate() ) : 40;
+            System.err.println("Duration "+duration+" ms, frame duration "+frameDuration+" ms: "+mp);
+            Assert.assertTrue(2 * frameDuration < duration);
+
+            // before EOS: lands on the frame displayed at the desired position
+            final int target = duration / 2;
+            int pos = mp.seek(target);
+            System.err.println("Seek "+target+" -> "+pos);
+            Assert.assertTrue("landed after "+target+": "+pos, pos <= target);
+            Assert.assertTrue("landed too early before "+target+": "+pos, target - pos <= 2 * frameDuration);
+            Assert.assertEquals(pos, mp.getCurrentPosition());
+            Assert.assertNotNull(mp.getNextTexture(gl, true));
+
+            // past EOS: no frame at the desired position, reports the duration
+            pos = mp.seek(duration + 10000);
+            System.err.println("Seek "+(duration + 10000)+" -> "+pos);
+            Assert.assertEquals(duration, pos);
+            Assert.assertEquals(duration, mp.getCurrentPosition());
+
+            // back before EOS, recovers from the end of stream
+            pos = mp.seek(frameDuration);
+            System.err.println("Seek "+frameDuration+" -> "+pos);
+            Assert.assertTrue("landed after "+frameDuration+": "+pos, pos <= frameDuration);
+            Assert.assertEquals(pos, mp.getCurrentPosition());
+            Assert.assertNotNull(mp.getNextTexture(gl, true));
+        } finally {
+            mp.destroy(ctx.getGL());
+            ctx.release();
+            glad.destroy();
+        }
+    }
+
+    public static void main(String args[]) throws IOException {
+        for(int i=0; i<args.length; i++) {
+            if(args[i].equals("-url")) {
+                i++;
+                url_s = args[i];
+            }
+        }
+        org.junit.runner.JUnitCore.main(TestGLMediaPlayerSeek01.class.getName());
+    }
+}
@@ -0,0 +1,158 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ * 
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ * 
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.test.junit.jogl.util.av;
+
+import java.nio.ByteBuffer;
+
+import jogamp.opengl.util.av.PCMRingBuffer;
+
+import org.junit.Assert;
+import org.junit.Test;
+
+/**
+ * Validates the lock-free {@link PCMRingBuffer}, i.e. data integrity across wrap-around 
+ * and the PTS deltas seen by the consumer while concurrently fed by the producer.
+ */
+public class TestPCMRingBuffer01NOUI {
+    /** 16bit stereo, i.e. 4 bytes per frame */
+    static final int frameSize = 4;
+    /** 1000 frames per second, i.e. 1 frame per ms */
+    static final int bytesPerSecond = 1000 * frameSize;
+
+    static ByteBuffer createPacket(int size, int seed) {
+        final ByteBuffer bb = ByteBuffer.allocateDirect(size);
+        for(int i=0; i<size; i++) {
+            bb.put(i, (byte) ( seed + i ));
+        }
+        return bb;
+    }
+
+    @Test
+    public void test01WrapAroundAndPTS() {
+        final PCMRingBuffer ring = new PCMRingBuffer(10*frameSize, bytesPerSecond, frameSize);
+        Assert.assertEquals(40, ring.capacity());
+
+        final ByteBuffer p0 = createPacket(24, 0);
+        Assert.assertEquals(24, ring.put(p0, 100));
+        Assert.assertEquals(0, p0.remaining());
+        Assert.assertEquals(106, ring.getWritePTS());
+        Assert.assertEquals(100, ring.getReadPTS());
+
+        final byte[] dst = new byte[40];
+        Assert.assertEquals(16, ring.get(dst, 0, 16));
+        Assert.assertEquals(104, ring.getReadPTS());
+        for(int i=0; i<16; i++) {
+            Assert.assertEquals((byte)i, dst[i]);
+        }
+
+        // wraps around
+        final ByteBuffer p1 = createPacket(32, 24);
+        Assert.assertEquals(32, ring.put(p1, 106));
+        Assert.assertEquals(40, ring.available());
+        Assert.assertEquals(0, ring.free());
+        Assert.assertEquals(114, ring.getWritePTS());
+
+        Assert.assertEquals(40, ring.get(dst, 0, 40));
+        for(int i=0; i<40; i++) {
+            Assert.assertEquals((byte)(16+i), dst[i]);
+        }
+        Assert.assertEquals(114, ring.getReadPTS());
+    }
+
+    @Test
+    public void test02FrameAlignment() {
+        final PCMRingBuffer ring = new PCMRingBuffer(10*frameSize+3, bytesPerSecond, frameSize);
+        Assert.assertEquals(40, ring.capacity());
+
+        final ByteBuffer p0 = createPacket(48, 0);
+        Assert.assertEquals(40, ring.put(p0, 0));
+        Assert.assertEquals(8, p0.remaining());
+        Assert.assertEquals(0, ring.put(p0, 10));
+
+        final byte[] dst = new byte[40];
+        Assert.assertEquals(4, ring.get(dst, 0, 7));
+        Assert.assertEquals(4, ring.skip(6));
+        Assert.assertEquals(8, ring.put(p0, 10));
+        Assert.assertEquals(12, ring.getWritePTS());
+        Assert.assertEquals(2, ring.getReadPTS());
+    }
+
+    @Test
+    public void test03ConcurrentPTSDeltas() throws InterruptedException {
+        final int packetSize = 10*frameSize; // 10 ms
+        final int packetCount = 2000;
+        final PCMRingBuffer ring = new PCMRingBuffer(3*packetSize, bytesPerSecond, frameSize);
+        final Throwable[] producerError = { null };
+
+        final Thread producer = new Thread(new Runnable() {
+            public void run() {
+                try {
+                    for(int i=0; i<packetCount; i++) {
+                        final ByteBuffer p = createPacket(packetSize, i * packetSize);
+                        final int pts = i * 10;
+                        while( p.hasRemaining() ) {
+                            final int done = packetSize - p.remaining();
+                            if( 0 == ring.put(p, pts + ring.getDuration(done)) ) {
+                                Thread.yield();
+                            }
+                        }
+                    }
+                } catch (Throwable t) {
+                    producerError[0] = t;
+                }
+            }
+        }, "PCMProducer");
+        producer.start();
+
+        // consumer: reads odd sized chunks, validates data and the PTS of the data being read
+        final byte[] dst = new byte[7*frameSize];
+        long consumed = 0;
+        final long total = (long)packetCount * packetSize;
+        while( consumed < total ) {
+            final int pts = ring.getReadPTS();
+            final int n = ring.get(dst, 0, dst.length);
+            if( 0 < n ) {
+                Assert.assertEquals("PTS at "+consumed, (int) ( consumed / frameSize ), pts);
+                for(int i=0; i<n; i++) {
+                    Assert.assertEquals("Data at "+(consumed+i), (byte)(consumed+i), dst[i]);
+                }
+                consumed += n;
+            } else {
+                Thread.yield();
+            }
+        }
+        producer.join();
+        Assert.assertNull(producerError[0]);
+        Assert.assertEquals(0, ring.available());
+        Assert.assertEquals(packetCount * 10, ring.getReadPTS());
+    }
+
+    public static void main(String args[]) {
+        org.junit.runner.JUnitCore.main(TestPCMRingBuffer01NOUI.class.getName());
+    }
+}
@@ -0,0 +1,147 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.test.junit.jogl.util.texture;
+
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.List;
+
+import com.jogamp.newt.opengl.GLWindow;
+
+import javax.media.opengl.GL;
+import javax.media.opengl.GLAutoDrawable;
+import javax.media.opengl.GLCapabilities;
+import javax.media.opengl.GLEventListener;
+import javax.media.opengl.GLProfile;
+import com.jogamp.opengl.util.GLReadBufferUtil;
+import com.jogamp.opengl.util.texture.TextureData;
+
+import com.jogamp.opengl.test.junit.util.UITestCase;
+import com.jogamp.opengl.test.junit.jogl.offscreen.WindowUtilNEWT;
+
+import org.junit.Assert;
+import org.junit.BeforeClass;
+import org.junit.Test;
+
+/**
+ * Validates the asynchronous PBO ring readback of {@link GLReadBufferUtil}:
+ * each frame is cleared w/ a frame specific color and all frames must be delivered
+ * in order w/ their frame number and color, including the ones flushed at dispose.
+ */
+public class TestGLReadBufferUtilAsync01NEWT extends UITestCase {
+    static GLProfile glp;
+    static GLCapabilities caps;
+    static int width, height;
+    static final int frameCount = 20;
+
+    @BeforeClass
+    public static void initClass() {
+        glp = GLProfile.getDefault();
+        Assert.assertNotNull(glp);
+        caps = new GLCapabilities(glp);
+        Assert.assertNotNull(caps);
+        width  = 256;
+        height = 256;
+    }
+    
+    static int red(long frame) {
+        return (int) ( frame * 12 ) & 0xff;
+    }
+
+    void testAsync(final int bufferCount) throws InterruptedException {
+        final GLReadBufferUtil reader = new GLReadBufferUtil(false, false);
+        reader.setAsyncBufferCount(bufferCount);
+        final List<Long> frames = new ArrayList<Long>();
+        final List<Integer> reds = new ArrayList<Integer>();
+        reader.setFrameListener(new GLReadBufferUtil.FrameListener() {
+            public void frameRead(GLReadBufferUtil src, long frameNumber, TextureData data) {
+                frames.add(frameNumber);
+                if( GL.GL_RGB == data.getPixelFormat() && GL.GL_UNSIGNED_BYTE == data.getPixelType() ) {
+                    reds.add( ((ByteBuffer)data.getBuffer()).get(0) & 0xff );
+                } else {
+                    reds.add( red(frameNumber) );
+                }
+            }
+        });
+        final GLCapabilities caps2 = WindowUtilNEWT.fixCaps(caps, false, true, false);        
+        final GLWindow glWindow = GLWindow.create(caps2);
+        Assert.assertNotNull(glWindow);
+        glWindow.setSize(width, height);
+        final boolean[] pboAvailable = { false };
+        final int[] displayed = { 0 };
+        glWindow.addGLEventListener(new GLEventListener() {
+            long f = 0;
+            public void init(GLAutoDrawable drawable) {
+                pboAvailable[0] = GLReadBufferUtil.isPBOAvailable(drawable.getGL());
+            }
+            public void dispose(GLAutoDrawable drawable) {
+                reader.flushAsync(drawable.getGL());
+                reader.dispose(drawable.getGL());
+            }
+            public void display(GLAutoDrawable drawable) {
+                final GL gl = drawable.getGL();
+                gl.glClearColor(red(f) / 255f, 0f, 0f, 1f);
+                gl.glClear(GL.GL_COLOR_BUFFER_BIT);
+                final boolean delivered = reader.readPixels(gl, false);
+                if( pboAvailable[0] && f < bufferCount - 1 ) {
+                    Assert.assertFalse("frame "+f+" delivered while filling the ring", delivered);
+                }
+                f++;
+                displayed[0]++;
+            }
+            public void reshape(GLAutoDrawable drawable, int x, int y, int width, int height) { }
+        });
+        glWindow.setVisible(true);
+        for(int i=0; i<frameCount; i++) {
+            glWindow.display();
+        }
+        glWindow.destroy();
+        
+        System.err.println("PBO available "+pboAvailable[0]+", ring "+bufferCount+", frames "+frames);
+        Assert.assertTrue(displayed[0] >= frameCount);
+        Assert.assertEquals(displayed[0], frames.size());
+        for(int i=0; i<displayed[0]; i++) {
+            Assert.assertEquals(i, frames.get(i).longValue());
+            Assert.assertEquals("red of frame "+i, red(i), reds.get(i).intValue(), 1);
+        }
+    }
+
+    @Test
+    public void testRing1() throws InterruptedException {
+        testAsync(1);
+    }
+
+    @Test
+    public void testRing3() throws InterruptedException {
+        testAsync(3);
+    }
+
+    public static void main(String args[]) {
+        org.junit.runner.JUnitCore.main(TestGLReadBufferUtilAsync01NEWT.class.getName());
+    }
+}
@@ -0,0 +1,110 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.test.junit.newt;
+
+import java.io.IOException;
+
+import javax.media.nativewindow.Capabilities;
+import javax.media.nativewindow.NativeWindowFactory;
+
+import jogamp.newt.DefaultEDTUtil;
+
+import org.junit.Assert;
+import org.junit.BeforeClass;
+import org.junit.Test;
+
+import com.jogamp.newt.NewtFactory;
+import com.jogamp.newt.Window;
+import com.jogamp.newt.util.EDTUtil;
+import com.jogamp.opengl.test.junit.util.MiscUtils;
+import com.jogamp.opengl.test.junit.util.UITestCase;
+
+/**
+ * Validates the event driven EDT, i.e. the EDT blocking on the native event source, 
+ * by counting the {@link DefaultEDTUtil#getIdleWakeupCount() wakeups} of an idle EDT.
+ * <p>
+ * In polling mode the idle EDT wakes up each {@link EDTUtil#defaultEDTPollPeriod},
+ * in event wait mode only for native events, hence rarely w/o any input.
+ * </p>
+ */
+public class TestEDTEventWait01NEWT extends UITestCase {
+    static long idleDuration = 1000; // ms
+
+    @BeforeClass
+    public static void initClass() {
+        NativeWindowFactory.initSingleton();
+    }
+
+    @Test
+    public void testIdleWakeups() throws InterruptedException {
+        final Window window = NewtFactory.createWindow(new Capabilities());
+        window.setSize(128, 128);
+        window.setVisible(true);
+        Assert.assertTrue(window.isNativeValid());
+
+        final EDTUtil edt = window.getScreen().getDisplay().getEDTUtil();
+        Assert.assertNotNull(edt);
+        Assert.assertTrue(edt instanceof DefaultEDTUtil);
+        final DefaultEDTUtil dedt = (DefaultEDTUtil)edt;
+        final boolean eventWait = dedt.isEventWaitEnabled();
+        System.err.println("EDT "+edt.getClass().getSimpleName()+", event wait "+eventWait+", polling forced "+DefaultEDTUtil.FORCE_POLLING);
+        if( NativeWindowFactory.TYPE_X11 == NativeWindowFactory.getNativeWindowType(true) && !DefaultEDTUtil.FORCE_POLLING ) {
+            Assert.assertTrue("X11 EDT shall block on the display connection", eventWait);
+        }
+
+        Thread.sleep(500); // let the window settle, i.e. consume its mapping, exposure and focus events
+        final int wakeups0 = dedt.getIdleWakeupCount();
+        Thread.sleep(idleDuration);
+        final int wakeups = dedt.getIdleWakeupCount() - wakeups0;
+        final long pollWakeups = idleDuration / EDTUtil.defaultEDTPollPeriod;
+        System.err.println("Idle EDT wakeups within "+idleDuration+" ms: "+wakeups+", polling would be ~"+pollWakeups);
+        if( eventWait ) {
+            Assert.assertTrue("Idle EDT woke up "+wakeups+" times, polling rate is "+pollWakeups, wakeups < pollWakeups / 4);
+        } else {
+            Assert.assertTrue("Polling EDT woke up only "+wakeups+" times, expected ~"+pollWakeups, wakeups > pollWakeups / 4);
+        }
+
+        // native events are still dispatched
+        window.setSize(200, 100);
+        Assert.assertEquals(200, window.getWidth());
+        Assert.assertEquals(100, window.getHeight());
+
+        window.destroy();
+        Assert.assertFalse(window.isNativeValid());
+    }
+
+    public static void main(String args[]) throws IOException {
+        for(int i=0; i<args.length; i++) {
+            if(args[i].equals("-idle")) {
+                idleDuration = MiscUtils.atol(args[++i], idleDuration);
+            }
+        }
+        String tstname = TestEDTEventWait01NEWT.class.getName();
+        org.junit.runner.JUnitCore.main(tstname);
+    }
+}
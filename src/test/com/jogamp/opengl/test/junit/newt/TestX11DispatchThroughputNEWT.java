@@ -0,0 +1,222 @@
+/**
+ * Copyright 2012 JogAmp Community. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ *
+ *    1. Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *       of conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY JogAmp Community ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL JogAmp Community OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those of the
+ * authors and should not be interpreted as representing official policies, either expressed
+ * or implied, of JogAmp Community.
+ */
+package com.jogamp.opengl.test.junit.newt;
+
+import java.awt.AWTException;
+import java.awt.Robot;
+import java.io.IOException;
+import java.lang.reflect.InvocationTargetException;
+import java.util.ArrayList;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import javax.media.nativewindow.Capabilities;
+import javax.media.nativewindow.NativeWindowFactory;
+
+import org.junit.Assert;
+import org.junit.BeforeClass;
+import org.junit.Test;
+
+import com.jogamp.newt.NewtFactory;
+import com.jogamp.newt.Window;
+import com.jogamp.newt.event.KeyAdapter;
+import com.jogamp.newt.event.KeyEvent;
+import com.jogamp.newt.event.MouseAdapter;
+import com.jogamp.newt.event.MouseEvent;
+import com.jogamp.opengl.test.junit.util.AWTRobotUtil;
+import com.jogamp.opengl.test.junit.util.MiscUtils;
+import com.jogamp.opengl.test.junit.util.UITestCase;
+
+/**
+ * Benchmarks the X11 event dispatch throughput, i.e. native event to Java window lookup and delivery.
+ * <p>
+ * Floods the pointer w/ warps inside the last of several windows, 
+ * each resulting in one <code>MotionNotify</code> event, and measures the received mouse-moved events per second
+ * and the total dispatch time.
+ * Run against Xvfb for reproducible numbers. Only runs on X11.
+ * </p>
+ * <p>
+ * Measured w/ and w/o {@link com.jogamp.newt.Display#setMotionEventCoalescing(boolean) motion event coalescing}.
+ * </p>
+ * <p>
+ * Also validates the delivery of batched key events, while a key listener 
+ * causes a nested native dispatch via {@link Window#setSize(int, int)}.
+ * </p>
+ */
+public class TestX11DispatchThroughputNEWT extends UITestCase {
+    static int windowCount = 8;
+    static int eventCount = 20000;
+    static long timeoutMS = 20000;
+    static int width = 256, height = 256;
+
+    @BeforeClass
+    public static void initClass() {
+        NativeWindowFactory.initSingleton();
+    }
+
+    @Test
+    public void testMouseMoveThroughput() throws InterruptedException {
+        runMouseMoveThroughput(false);
+    }
+
+    @Test
+    public void testMouseMoveThroughputCoalesced() throws InterruptedException {
+        runMouseMoveThroughput(true);
+    }
+
+    void runMouseMoveThroughput(boolean coalesce) throws InterruptedException {
+        if( NativeWindowFactory.TYPE_X11 != NativeWindowFactory.getNativeWindowType(true) ) {
+            System.err.println("X11 only, skipped on "+NativeWindowFactory.getNativeWindowType(true));
+            return;
+        }
+        final Capabilities caps = new Capabilities();
+        final Window[] windows = new Window[windowCount];
+        for(int i=0; i<windowCount; i++) {
+            windows[i] = NewtFactory.createWindow(caps);
+            windows[i].setUndecorated(true);
+            windows[i].setPosition(16*i, 16*i);
+            windows[i].setSize(width, height);
+            windows[i].setVisible(true);
+            Assert.assertTrue(windows[i].isNativeValid());
+        }
+        final Window window = windows[windowCount-1];
+        window.getScreen().getDisplay().setMotionEventCoalescing(coalesce);
+        final AtomicInteger moved = new AtomicInteger(0);
+        window.addMouseListener(new MouseAdapter() {
+            public void mouseMoved(MouseEvent e) {
+                moved.incrementAndGet();
+            }
+        });
+        window.warpPointer(width/2, height/2);
+        Thread.sleep(100); // pointer enters the window
+        moved.set(0);
+
+        final long t0 = System.nanoTime();
+        final long tTimeout = t0 + timeoutMS * 1000000L;
+        int warps = 0;
+        while( warps < eventCount && System.nanoTime() < tTimeout ) {
+            // alternate positions, warping to the current position would not produce an event 
+            window.warpPointer(width/4 + ( warps & 1 ) * width/2, height/2);
+            warps++;
+            if( 0 == ( warps & 0xff ) ) {
+                Thread.yield();
+            }
+        }
+        // wait until all generated events are delivered
+        int received;
+        long t1;
+        do {
+            received = moved.get();
+            t1 = System.nanoTime();
+            Thread.sleep(50);
+        } while( received != moved.get() && System.nanoTime() < tTimeout );
+        final double secs = ( t1 - t0 ) / 1e9;
+        System.err.println("X11 dispatch: coalesce "+coalesce+", windows "+windowCount+", warps "+warps+", received "+received+
+                           " in "+(float)(secs*1000.0)+" ms, "+(int)(received/secs)+" events/s");
+
+        for(int i=windowCount-1; i>=0; i--) {
+            windows[i].destroy();
+        }
+        Assert.assertTrue("No mouse-moved event received", received > 0);
+        Assert.assertTrue("More mouse-moved events received than generated", received <= warps);
+    }
+
+    @Test
+    public void testNestedDispatchKeyListenerSetSize() throws InterruptedException, AWTException, InvocationTargetException {
+        if( NativeWindowFactory.TYPE_X11 != NativeWindowFactory.getNativeWindowType(true) ) {
+            System.err.println("X11 only, skipped on "+NativeWindowFactory.getNativeWindowType(true));
+            return;
+        }
+        final int keyCount = 52;
+        final Window window = NewtFactory.createWindow(new Capabilities());
+        window.setPosition(64, 64);
+        window.setSize(width, height);
+        window.setVisible(true);
+        Assert.assertTrue(window.isNativeValid());
+
+        final ArrayList<KeyEvent> events = new ArrayList<KeyEvent>(); // EDT only
+        final AtomicInteger typed = new AtomicInteger(0);
+        window.addKeyListener(new KeyAdapter() {
+            public void keyPressed(KeyEvent e) {
+                events.add(e);
+                // nested dispatch while delivering the current batch
+                window.setSize(width + ( events.size() & 1 ) * 32, height);
+            }
+            public void keyReleased(KeyEvent e) {
+                events.add(e);
+            }
+            public void keyTyped(KeyEvent e) {
+                events.add(e);
+                typed.incrementAndGet();
+            }
+        });
+
+        final Robot robot = new Robot();
+        AWTRobotUtil.requestFocus(robot, window);
+        Assert.assertTrue("Did not gain focus", AWTRobotUtil.waitForFocus(window));
+        robot.waitForIdle();
+
+        // type w/o waiting, so the native events are queued and delivered in batches
+        for(int i=0; i<keyCount; i++) {
+            final int keyCode = java.awt.event.KeyEvent.VK_A + ( i % 26 );
+            robot.keyPress(keyCode);
+            robot.keyRelease(keyCode);
+        }
+        final long tTimeout = System.currentTimeMillis() + timeoutMS;
+        while( typed.get() < keyCount && System.currentTimeMillis() < tTimeout ) {
+            Thread.sleep(50);
+        }
+        Thread.sleep(100); // no further events
+        window.destroy();
+
+        Assert.assertEquals("Wrong number of key events", 3*keyCount, events.size());
+        for(int i=0; i<keyCount; i++) {
+            final int keyCode = KeyEvent.VK_A + ( i % 26 );
+            final KeyEvent pressed = events.get(3*i), released = events.get(3*i+1), typedEvent = events.get(3*i+2);
+            Assert.assertEquals("Key "+i+" pressed: "+pressed, KeyEvent.EVENT_KEY_PRESSED, pressed.getEventType());
+            Assert.assertEquals("Key "+i+" pressed: "+pressed, keyCode, pressed.getKeyCode());
+            Assert.assertEquals("Key "+i+" released: "+released, KeyEvent.EVENT_KEY_RELEASED, released.getEventType());
+            Assert.assertEquals("Key "+i+" released: "+released, keyCode, released.getKeyCode());
+            Assert.assertEquals("Key "+i+" typed: "+typedEvent, KeyEvent.EVENT_KEY_TYPED, typedEvent.getEventType());
+            Assert.assertEquals("Key "+i+" typed: "+typedEvent, keyCode, typedEvent.getKeyCode());
+        }
+    }
+
+    public static void main(String args[]) throws IOException {
+        for(int i=0; i<args.length; i++) {
+            if(args[i].equals("-windows")) {
+                windowCount = MiscUtils.atoi(args[++i], windowCount);
+            } else if(args[i].equals("-events")) {
+                eventCount = MiscUtils.atoi(args[++i], eventCount);
+            } else if(args[i].equals("-timeout")) {
+                timeoutMS = MiscUtils.atol(args[++i], timeoutMS);
+            }
+        }
+        String tstname = TestX11DispatchThroughputNEWT.class.getName();
+        org.junit.runner.JUnitCore.main(tstname);
+    }
+}